@@ -0,0 +1,376 @@
+#pragma once
+
+#include <core/memory/monotonic_allocator.hpp>
+#include <core/memory/multipool_allocator.hpp>
+#include <core/memory/pool_allocator.hpp>
+#include <core/memory/stack_allocator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <random>
+#include <vector>
+
+/**
+ * Every allocator is wrapped in an adapter exposing the same interface, so a workload is written
+ * once and run against all of them:
+ *    allocate(size), deallocate(p, size)
+ *    reset()     called once every block of a batch is freed
+ *    reserved()  the bytes the allocator holds for the live blocks, 0 when it can't be known
+ * An adapter is constructed with the largest number of blocks that may be alive at once
+ */
+namespace bench
+{
+   static constexpr std::size_t min_allocation_size = 16;
+   static constexpr std::size_t max_allocation_size = 256;
+   static constexpr std::size_t allocation_alignment = alignof(std::max_align_t);
+
+   // The depths of the multipool give out blocks of 256, 128, 64, 32 and 16 bytes
+   static constexpr std::size_t multipool_depth = 5;
+
+   class malloc_adapter
+   {
+   public:
+      explicit malloc_adapter(std::size_t /*count*/) {}
+
+      auto allocate(std::size_t size) -> void* { return std::malloc(size); } // NOLINT
+      void deallocate(void* p_alloc, std::size_t /*size*/) { std::free(p_alloc); } // NOLINT
+      void reset() {}
+
+      [[nodiscard]] auto reserved() const -> std::size_t { return 0; }
+   };
+
+   class new_adapter
+   {
+   public:
+      explicit new_adapter(std::size_t /*count*/) {}
+
+      auto allocate(std::size_t size) -> void* { return ::operator new(size); }
+      void deallocate(void* p_alloc, std::size_t size) { ::operator delete(p_alloc, size); }
+      void reset() {}
+
+      [[nodiscard]] auto reserved() const -> std::size_t { return 0; }
+   };
+
+   /**
+    * Forwards to new & delete while counting the bytes it holds, to know how much memory a
+    * std::pmr resource takes to serve its blocks
+    */
+   class counting_resource final : public std::pmr::memory_resource
+   {
+   public:
+      [[nodiscard]] auto reserved() const noexcept -> std::size_t { return m_reserved; }
+
+   private:
+      auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override
+      {
+         m_reserved += bytes;
+
+         return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+      }
+      void do_deallocate(void* p_alloc, std::size_t bytes, std::size_t alignment) override
+      {
+         m_reserved -= bytes;
+
+         std::pmr::new_delete_resource()->deallocate(p_alloc, bytes, alignment);
+      }
+      [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+         -> bool override
+      {
+         return this == &other;
+      }
+
+   private:
+      std::atomic<std::size_t> m_reserved{0};
+   };
+
+   /**
+    * Wraps std::pmr::unsynchronized_pool_resource or std::pmr::synchronized_pool_resource
+    */
+   template <class resource_>
+   class pmr_pool_adapter
+   {
+   public:
+      explicit pmr_pool_adapter(std::size_t /*count*/) :
+         m_resource{std::pmr::pool_options{.max_blocks_per_chunk = 0,
+                                           .largest_required_pool_block = max_allocation_size},
+                    &m_upstream}
+      {}
+
+      auto allocate(std::size_t size) -> void*
+      {
+         return m_resource.allocate(size, allocation_alignment);
+      }
+      void deallocate(void* p_alloc, std::size_t size)
+      {
+         m_resource.deallocate(p_alloc, size, allocation_alignment);
+      }
+      void reset() {}
+
+      [[nodiscard]] auto reserved() const -> std::size_t { return m_upstream.reserved(); }
+
+   private:
+      counting_resource m_upstream;
+      resource_ m_resource;
+   };
+
+   /**
+    * Wraps a std::pmr::monotonic_buffer_resource over a buffer large enough for a whole batch,
+    * so it never goes to its upstream resource, like core::monotonic_allocator
+    */
+   class pmr_monotonic_adapter
+   {
+   public:
+      explicit pmr_monotonic_adapter(std::size_t count) :
+         m_size{count * (max_allocation_size + allocation_alignment)},
+         mp_buffer{std::make_unique<std::byte[]>(m_size)}, m_resource{mp_buffer.get(), m_size}
+      {}
+
+      auto allocate(std::size_t size) -> void*
+      {
+         return m_resource.allocate(size, allocation_alignment);
+      }
+      void deallocate(void* /*p_alloc*/, std::size_t /*size*/) {}
+      void reset() { m_resource.release(); }
+
+      [[nodiscard]] auto reserved() const -> std::size_t { return 0; }
+
+   private:
+      std::size_t m_size;
+      std::unique_ptr<std::byte[]> mp_buffer;
+      std::pmr::monotonic_buffer_resource m_resource;
+   };
+
+   class pool_adapter
+   {
+   public:
+      explicit pool_adapter(std::size_t count) :
+         m_allocator{core::pool_allocator::create_info{.pool_count = count,
+                                                       .pool_size = max_allocation_size}}
+      {}
+
+      auto allocate(std::size_t size) -> void*
+      {
+         return m_allocator.allocate(size, allocation_alignment);
+      }
+      void deallocate(void* p_alloc, std::size_t /*size*/) { m_allocator.deallocate(p_alloc); }
+      void reset() {}
+
+      [[nodiscard]] auto reserved() const -> std::size_t { return m_allocator.memory_usage(); }
+
+   private:
+      core::pool_allocator m_allocator;
+   };
+
+   /**
+    * Every depth holds count pools or more, so a batch never runs out of blocks whatever the
+    * mix of sizes is
+    */
+   class multipool_adapter
+   {
+   public:
+      explicit multipool_adapter(std::size_t count) :
+         m_allocator{core::multipool_allocator::create_info{.pool_count = count,
+                                                            .pool_size = max_allocation_size,
+                                                            .depth = multipool_depth}}
+      {}
+
+      auto allocate(std::size_t size) -> void*
+      {
+         return m_allocator.allocate(size, allocation_alignment);
+      }
+      void deallocate(void* p_alloc, std::size_t /*size*/) { m_allocator.deallocate(p_alloc); }
+      void reset() {}
+
+      [[nodiscard]] auto reserved() const -> std::size_t { return m_allocator.memory_usage(); }
+
+   private:
+      core::multipool_allocator m_allocator;
+   };
+
+   /**
+    * Only valid when blocks are freed in the reverse order of their allocation
+    */
+   class stack_adapter
+   {
+   public:
+      explicit stack_adapter(std::size_t count) :
+         m_allocator{count * (max_allocation_size + 2 * allocation_alignment)}
+      {}
+
+      auto allocate(std::size_t size) -> void*
+      {
+         return m_allocator.allocate(size, allocation_alignment);
+      }
+      void deallocate(void* p_alloc, std::size_t /*size*/) { m_allocator.free(p_alloc); }
+      void reset() {}
+
+      [[nodiscard]] auto reserved() const -> std::size_t { return m_allocator.memory_usage(); }
+
+   private:
+      core::stack_allocator m_allocator;
+   };
+
+   /**
+    * Blocks are never freed one by one, the whole allocator is released once a batch is done
+    */
+   class monotonic_adapter
+   {
+   public:
+      explicit monotonic_adapter(std::size_t count) :
+         m_allocator{count * (max_allocation_size + allocation_alignment)}
+      {}
+
+      auto allocate(std::size_t size) -> void*
+      {
+         return m_allocator.allocate(size, allocation_alignment);
+      }
+      void deallocate(void* /*p_alloc*/, std::size_t /*size*/) {}
+      void reset() { m_allocator.release(); }
+
+      [[nodiscard]] auto reserved() const -> std::size_t { return m_allocator.memory_usage(); }
+
+   private:
+      core::monotonic_allocator m_allocator;
+   };
+
+   /**
+    * Serialises the accesses to an allocator that isn't thread safe, so it may be shared
+    */
+   template <class adapter_>
+   class locked_adapter
+   {
+   public:
+      explicit locked_adapter(std::size_t count) : m_adapter{count} {}
+
+      auto allocate(std::size_t size) -> void*
+      {
+         std::scoped_lock lock{m_mutex};
+         return m_adapter.allocate(size);
+      }
+      void deallocate(void* p_alloc, std::size_t size)
+      {
+         std::scoped_lock lock{m_mutex};
+         m_adapter.deallocate(p_alloc, size);
+      }
+      void reset() {}
+
+      [[nodiscard]] auto reserved() const -> std::size_t { return 0; }
+
+   private:
+      std::mutex m_mutex;
+      adapter_ m_adapter;
+   };
+
+   enum struct free_order
+   {
+      lifo,
+      fifo,
+      random
+   };
+
+   /**
+    * The sizes of the blocks of a batch, in allocation order, and the order they are freed in
+    */
+   struct workload
+   {
+      std::vector<std::size_t> sizes{};
+      std::vector<std::size_t> frees{};
+
+      std::size_t requested{0};
+   };
+
+   inline auto make_workload(std::size_t count, free_order order, bool is_mixed_size,
+                             std::uint64_t seed = 0) -> workload
+   {
+      std::mt19937_64 engine{seed};
+
+      workload work{.sizes = std::vector<std::size_t>(count, max_allocation_size / 2),
+                    .frees = std::vector<std::size_t>(count)};
+
+      if (is_mixed_size)
+      {
+         // Small blocks are a lot more common than large ones
+         std::geometric_distribution<std::size_t> distribution{0.5};
+         for (auto& size : work.sizes)
+         {
+            const std::size_t shift = std::min(distribution(engine), std::size_t{4});
+            std::uniform_int_distribution<std::size_t> in_class{
+               std::max(min_allocation_size, (max_allocation_size >> (shift + 1)) + 1),
+               max_allocation_size >> shift};
+
+            size = in_class(engine);
+         }
+      }
+
+      std::iota(std::begin(work.frees), std::end(work.frees), std::size_t{0});
+      if (order == free_order::lifo)
+      {
+         std::reverse(std::begin(work.frees), std::end(work.frees));
+      }
+      else if (order == free_order::random)
+      {
+         std::shuffle(std::begin(work.frees), std::end(work.frees), engine);
+      }
+
+      work.requested = std::accumulate(std::begin(work.sizes), std::end(work.sizes),
+                                       std::size_t{0});
+
+      return work;
+   }
+
+   /**
+    * Allocate every block of the workload then free them, returning what the allocator reserved
+    * once every block was alive
+    */
+   template <class adapter_>
+   auto run_batch(adapter_& allocator, const workload& work, std::vector<void*>& blocks)
+      -> std::size_t
+   {
+      for (std::size_t i = 0; i < std::size(work.sizes); ++i)
+      {
+         void* p_block = allocator.allocate(work.sizes[i]);
+         benchmark::DoNotOptimize(p_block);
+
+         blocks[i] = p_block;
+      }
+
+      benchmark::ClobberMemory();
+
+      const std::size_t reserved = allocator.reserved();
+      for (auto index : work.frees)
+      {
+         allocator.deallocate(blocks[index], work.sizes[index]);
+      }
+
+      allocator.reset();
+
+      return reserved;
+   }
+
+   /**
+    * Fragmentation is the share of the reserved memory that wasn't asked for, lost to pools
+    * larger than the blocks, headers and padding
+    */
+   inline void report_fragmentation(benchmark::State& state, const workload& work,
+                                    std::size_t reserved)
+   {
+      if (reserved == 0)
+      {
+         return;
+      }
+
+      state.counters["reserved_bytes"] = static_cast<double>(reserved);
+      state.counters["fragmentation"] =
+         1.0 - static_cast<double>(work.requested) / static_cast<double>(reserved);
+   }
+} // namespace bench
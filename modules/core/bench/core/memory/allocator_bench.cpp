@@ -0,0 +1,89 @@
+#include <core/memory/allocator_adapters.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory_resource>
+#include <vector>
+
+namespace
+{
+   using bench::free_order;
+
+   using pmr_pool_adapter = bench::pmr_pool_adapter<std::pmr::unsynchronized_pool_resource>;
+
+   /**
+    * Allocate a batch of blocks then free all of them in the given order. Items are blocks
+    * allocated and freed
+    */
+   template <class adapter_, free_order order_, bool is_mixed_size_>
+   void allocate_batch(benchmark::State& state)
+   {
+      const auto count = static_cast<std::size_t>(state.range(0));
+      const auto work = bench::make_workload(count, order_, is_mixed_size_);
+
+      adapter_ allocator{count};
+      std::vector<void*> blocks(count);
+
+      std::size_t reserved = 0;
+      for ([[maybe_unused]] auto _ : state)
+      {
+         reserved = bench::run_batch(allocator, work, blocks);
+      }
+
+      state.SetItemsProcessed(state.iterations() * state.range(0));
+      bench::report_fragmentation(state, work, reserved);
+   }
+
+   template <class adapter_>
+   void lifo(benchmark::State& state)
+   {
+      allocate_batch<adapter_, free_order::lifo, false>(state);
+   }
+   template <class adapter_>
+   void fifo(benchmark::State& state)
+   {
+      allocate_batch<adapter_, free_order::fifo, false>(state);
+   }
+   template <class adapter_>
+   void random_free(benchmark::State& state)
+   {
+      allocate_batch<adapter_, free_order::random, false>(state);
+   }
+   template <class adapter_>
+   void mixed_size(benchmark::State& state)
+   {
+      allocate_batch<adapter_, free_order::random, true>(state);
+   }
+   /**
+    * The stack allocator may only free its last block, it gets a mixed size workload of its own
+    */
+   template <class adapter_>
+   void mixed_size_lifo(benchmark::State& state)
+   {
+      allocate_batch<adapter_, free_order::lifo, true>(state);
+   }
+
+   void batch_sizes(benchmark::internal::Benchmark* p_bench)
+   {
+      p_bench->RangeMultiplier(8)->Range(64, 4096);
+   }
+} // namespace
+
+#define ALLOCATOR_BENCHMARK(function)                                                              \
+   BENCHMARK_TEMPLATE(function, bench::malloc_adapter)->Apply(batch_sizes);                        \
+   BENCHMARK_TEMPLATE(function, bench::new_adapter)->Apply(batch_sizes);                           \
+   BENCHMARK_TEMPLATE(function, pmr_pool_adapter)->Apply(batch_sizes);                             \
+   BENCHMARK_TEMPLATE(function, bench::pmr_monotonic_adapter)->Apply(batch_sizes);                 \
+   BENCHMARK_TEMPLATE(function, bench::pool_adapter)->Apply(batch_sizes);                          \
+   BENCHMARK_TEMPLATE(function, bench::multipool_adapter)->Apply(batch_sizes);                     \
+   BENCHMARK_TEMPLATE(function, bench::monotonic_adapter)->Apply(batch_sizes)
+
+ALLOCATOR_BENCHMARK(lifo);
+BENCHMARK_TEMPLATE(lifo, bench::stack_adapter)->Apply(batch_sizes);
+
+ALLOCATOR_BENCHMARK(fifo);
+ALLOCATOR_BENCHMARK(random_free);
+
+ALLOCATOR_BENCHMARK(mixed_size);
+BENCHMARK_TEMPLATE(mixed_size_lifo, bench::stack_adapter)->Apply(batch_sizes);
+BENCHMARK_TEMPLATE(mixed_size_lifo, bench::malloc_adapter)->Apply(batch_sizes);
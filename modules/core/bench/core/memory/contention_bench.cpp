@@ -0,0 +1,74 @@
+#include <core/memory/allocator_adapters.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory_resource>
+#include <vector>
+
+namespace
+{
+   using bench::free_order;
+
+   static constexpr std::size_t batch_size = 1024;
+   static constexpr int max_thread_count = 8;
+
+   using pmr_pool_adapter = bench::pmr_pool_adapter<std::pmr::unsynchronized_pool_resource>;
+   using pmr_synchronized_pool_adapter =
+      bench::pmr_pool_adapter<std::pmr::synchronized_pool_resource>;
+   using locked_pool_adapter = bench::locked_adapter<bench::pool_adapter>;
+   using locked_multipool_adapter = bench::locked_adapter<bench::multipool_adapter>;
+
+   /**
+    * Every thread allocates and frees mixed size batches from the one allocator they all share
+    */
+   template <class adapter_>
+   void shared(benchmark::State& state)
+   {
+      static adapter_ allocator{batch_size * max_thread_count};
+
+      const auto work = bench::make_workload(batch_size, free_order::random, true);
+      std::vector<void*> blocks(batch_size);
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         bench::run_batch(allocator, work, blocks);
+      }
+
+      state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch_size));
+   }
+
+   /**
+    * Every thread allocates and frees mixed size batches from an allocator of its own, what
+    * sharing an allocator is weighed against
+    */
+   template <class adapter_>
+   void per_thread(benchmark::State& state)
+   {
+      adapter_ allocator{batch_size};
+
+      const auto work = bench::make_workload(batch_size, free_order::random, true);
+      std::vector<void*> blocks(batch_size);
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         bench::run_batch(allocator, work, blocks);
+      }
+
+      state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch_size));
+   }
+
+   void thread_counts(benchmark::internal::Benchmark* p_bench)
+   {
+      p_bench->ThreadRange(1, max_thread_count)->UseRealTime();
+   }
+} // namespace
+
+BENCHMARK_TEMPLATE(shared, bench::malloc_adapter)->Apply(thread_counts);
+BENCHMARK_TEMPLATE(shared, bench::new_adapter)->Apply(thread_counts);
+BENCHMARK_TEMPLATE(shared, pmr_synchronized_pool_adapter)->Apply(thread_counts);
+BENCHMARK_TEMPLATE(shared, locked_pool_adapter)->Apply(thread_counts);
+BENCHMARK_TEMPLATE(shared, locked_multipool_adapter)->Apply(thread_counts);
+
+BENCHMARK_TEMPLATE(per_thread, pmr_pool_adapter)->Apply(thread_counts);
+BENCHMARK_TEMPLATE(per_thread, bench::pool_adapter)->Apply(thread_counts);
+BENCHMARK_TEMPLATE(per_thread, bench::multipool_adapter)->Apply(thread_counts);
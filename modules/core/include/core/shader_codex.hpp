@@ -8,6 +8,8 @@
 
 #include <glslang/Public/ShaderLang.h>
 
+#include <chrono>
+
 namespace core
 {
    enum class shader_codex_error
@@ -24,6 +26,25 @@ namespace core
    auto to_string(shader_codex_error err) -> std::string;
    auto make_error(shader_codex_error err) noexcept -> error_t;
 
+   /**
+    * The time shader_codex::builder::build spent in each stage of creating its shaders, summed
+    * over all of them
+    */
+   struct shader_build_timings
+   {
+      std::chrono::nanoseconds preprocess{0};
+      std::chrono::nanoseconds parse{0};
+      std::chrono::nanoseconds link{0};
+      std::chrono::nanoseconds spirv_generation{0};
+      std::chrono::nanoseconds cache_load{0};
+      std::chrono::nanoseconds cache_write{0};
+      std::chrono::nanoseconds reflection{0};
+      std::chrono::nanoseconds module_creation{0};
+
+      std::size_t compiled_count{0};
+      std::size_t cached_count{0};
+   };
+
    class shader_codex
    {
    public:
@@ -55,15 +76,23 @@ namespace core
 
          auto allow_caching(bool is_caching_allowed = true) noexcept -> builder&;
 
+         /**
+          * Get the time the last call to build spent in each stage of creating the shaders
+          */
+         [[nodiscard]] auto timings() const noexcept -> const shader_build_timings&;
+
       private:
          auto create_shader(const std::filesystem::path& path) -> core::result<vkn::shader>;
+         auto create_module(const std::filesystem::path& path,
+                            util::dynamic_array<std::uint32_t> spirv)
+            -> core::result<vkn::shader>;
          auto compile_shader(const std::filesystem::path& path)
             -> core::result<util::dynamic_array<std::uint32_t>>;
          auto load_shader(const std::filesystem::path& path)
             -> core::result<util::dynamic_array<std::uint32_t>>;
 
          [[nodiscard]] auto cache_shader(const std::filesystem::path& path,
-                                         const util::dynamic_array<std::uint32_t>& data) const
+                                         const util::dynamic_array<std::uint32_t>& data)
             -> monad::maybe<error_t>;
 
          [[nodiscard]] auto get_shader_stage(std::string_view stage_name) const -> EShLanguage;
@@ -85,6 +114,8 @@ namespace core
 
             bool is_caching_allowed = true;
          } m_info;
+
+         shader_build_timings m_timings{};
       };
    };
 } // namespace core
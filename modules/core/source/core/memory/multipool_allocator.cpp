@@ -54,30 +54,7 @@ namespace core
       p_memory =
          std::make_unique<std::byte[]>(true_alloc_size + ((depth + 1) * sizeof(access_header)));
 
-      p_access_headers = TO_ACCESS_HEADER_PTR(p_memory.get());
-      for (size_type i = 0; i < depth; ++i)
-      {
-         size_type const depth_pow = static_cast<size_type>(std::pow(2, i));
-         size_type const depth_offset = (depth + 1) * sizeof(block_header);
-         size_type const pool_offset = pool_count * pool_size * i;
-
-         p_access_headers[i].p_first_free =
-            TO_BLOCK_HEADER_PTR(p_memory.get() + depth_offset + pool_offset);
-
-         block_header* p_first_free = p_access_headers[i].p_first_free;
-         p_first_free->depth_index = i;
-
-         for (size_type j = 1; j < pool_count * depth_pow; ++j)
-         {
-            size_type const offset = j * (pool_size / depth_pow + sizeof(block_header));
-
-            auto* p_new = TO_BLOCK_HEADER_PTR(p_memory.get() + offset + depth_offset + pool_offset);
-            p_new->depth_index = i;
-            p_first_free->p_next = p_new;
-            p_first_free = p_new;
-            p_first_free->p_next = nullptr;
-         }
-      }
+      release();
    }
 
    auto multipool_allocator::allocate(size_type size, size_type alignment) noexcept -> pointer
@@ -101,7 +78,7 @@ namespace core
          p_block_header->depth_index = depth_index;
          p_access_headers[depth_index].p_first_free = p_block_header->p_next;
 
-         used_memory += pool_size;
+         used_memory += pool_size / static_cast<size_type>(std::pow(2, depth_index));
          ++num_allocations;
 
          return static_cast<void*>(++p_block_header);
@@ -112,11 +89,15 @@ namespace core
       }
    }
 
-   // FIX
-   auto multipool_allocator::reallocate(
-      pointer p_alloc, [[maybe_unused]] size_type new_size) noexcept -> pointer
+   auto multipool_allocator::reallocate(pointer p_alloc, size_type new_size) noexcept -> pointer
    {
-      // new_size = 0;
+      assert(p_alloc != nullptr && "Cannot reallocate a nullptr");
+      assert(new_size != 0 && "Allocation size cannot be zero");
+
+      if (new_size > allocation_capacity(p_alloc))
+      {
+         return nullptr;
+      }
 
       return p_alloc;
    }
@@ -130,7 +111,7 @@ namespace core
       p_header->p_next = p_access_headers[p_header->depth_index].p_first_free;
       p_access_headers[p_header->depth_index].p_first_free = p_header;
 
-      used_memory -= pool_size;
+      used_memory -= pool_size / static_cast<size_type>(std::pow(2, p_header->depth_index));
       --num_allocations;
    }
 
@@ -146,26 +127,32 @@ namespace core
 
    auto multipool_allocator::release() noexcept -> void
    {
-      p_access_headers = reinterpret_cast<access_header*>(p_memory.get());
+      p_access_headers = TO_ACCESS_HEADER_PTR(p_memory.get());
+
+      // Each depth holds twice as many pools as the previous one, each half the size, so the
+      // depths are laid out one after the other, behind the access headers
+      size_type depth_offset = (depth + 1) * sizeof(access_header);
       for (size_type i = 0; i < depth; ++i)
       {
          size_type const depth_pow = static_cast<size_type>(std::pow(2, i));
-         size_type const depth_offset = (depth + 1) * sizeof(block_header);
-         size_type const pool_offset = pool_count * pool_size * i;
+         size_type const block_size = pool_size / depth_pow + sizeof(block_header);
 
-         p_access_headers[i].p_first_free =
-            TO_BLOCK_HEADER_PTR(p_memory.get() + depth_offset + pool_offset);
+         p_access_headers[i].p_first_free = TO_BLOCK_HEADER_PTR(p_memory.get() + depth_offset);
+
+         block_header* p_first_free = p_access_headers[i].p_first_free;
+         p_first_free->depth_index = i;
+         p_first_free->p_next = nullptr;
 
-         auto* p_base_cpy = p_access_headers[i].p_first_free;
          for (size_type j = 1; j < pool_count * depth_pow; ++j)
          {
-            size_type const offset = j * (pool_size / depth_pow + sizeof(block_header));
-
-            auto* p_new = TO_BLOCK_HEADER_PTR(p_memory.get() + offset + depth_offset + pool_offset);
-            p_base_cpy->p_next = p_new;
-            p_base_cpy = p_new;
-            p_base_cpy->p_next = nullptr;
+            auto* p_new = TO_BLOCK_HEADER_PTR(p_memory.get() + depth_offset + j * block_size);
+            p_new->depth_index = i;
+            p_new->p_next = nullptr;
+            p_first_free->p_next = p_new;
+            p_first_free = p_new;
          }
+
+         depth_offset += pool_count * depth_pow * block_size;
       }
 
       used_memory = 0;
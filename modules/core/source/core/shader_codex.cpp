@@ -1,6 +1,8 @@
 #include <core/shader_codex.hpp>
 
 #include <util/logger.hpp>
+#include <util/stats.hpp>
+#include <util/trace.hpp>
 
 #include <vkn/shader.hpp>
 
@@ -8,6 +10,7 @@
 
 #include <mpark/patterns.hpp>
 
+#include <chrono>
 #include <cstring>
 #include <fstream>
 #include <functional>
@@ -196,6 +199,7 @@ namespace core
    auto builder::build() -> core::result<shader_codex>
    {
       shader_codex codex{};
+      m_timings = {};
 
       if (!m_info.shader_directory_path.empty())
       {
@@ -278,6 +282,8 @@ namespace core
       return *this;
    }
 
+   auto builder::timings() const noexcept -> const shader_build_timings& { return m_timings; }
+
    auto builder::create_shader(const fs::path& path) -> core::result<vkn::shader>
    {
       if (m_info.is_caching_allowed)
@@ -312,6 +318,7 @@ namespace core
             if (raw_last_write >= cache_last_write) // NOLINT
             {
                util::log_info(mp_logger, R"([core] out-dated shader found in cache)");
+               util::stats::increment(util::stats::counter::shader_cache_misses);
                util::log_info(mp_logger, R"([core] recompiling shader: "{0}")", path.string());
 
                if (auto res = compile_shader(path))
@@ -323,18 +330,7 @@ namespace core
                      return monad::make_error(cache_res.value());
                   }
 
-                  const auto extension = path.extension().string();
-                  return vkn::shader::builder{*mp_device, mp_logger}
-                     .set_spirv_binary(*res.value())
-                     .set_name(path.filename().string())
-                     .set_type(get_shader_type({extension.begin() + 1, extension.end()}))
-                     .build()
-                     .map_error([&](auto&& err) {
-                        util::log_error(mp_logger, "[core] shader creation error: {}-{}",
-                                        err.type.category().name(), err.type.message());
-
-                        return make_error(shader_codex_error::failed_to_create_shader);
-                     });
+                  return create_module(path, std::move(res).value().value());
                }
                else
                {
@@ -344,22 +340,12 @@ namespace core
             else
             {
                util::log_info(mp_logger, R"([core] up-to-date shader found in cache)");
+               util::stats::increment(util::stats::counter::shader_cache_hits);
                util::log_info(mp_logger, R"([core] loading shader "{0}" from cache)", path.string(),
                               hashed_path.string());
 
                return load_shader(hashed_path).and_then([&](auto&& spirv) {
-                  const std::string extension = path.extension();
-                  return vkn::shader::builder{*mp_device, mp_logger}
-                     .set_spirv_binary(std::move(spirv))
-                     .set_name(path.filename().string())
-                     .set_type(get_shader_type({extension.begin() + 1, extension.end()}))
-                     .build()
-                     .map_error([&](auto&& err) {
-                        util::log_error(mp_logger, "[core] shader creation error: {}-{}",
-                                        err.type.category().name(), err.type.message());
-
-                        return make_error(shader_codex_error::failed_to_create_shader);
-                     });
+                  return create_module(path, std::move(spirv));
                });
             }
          }
@@ -368,6 +354,7 @@ namespace core
             util::log_info(mp_logger, R"([core] shader "{0}" not found in cache)", path.string(),
                            hashed_path.string());
             util::log_info(mp_logger, R"([core] compiling shader: "{0}")", path.string());
+            util::stats::increment(util::stats::counter::shader_cache_misses);
 
             if (auto res = compile_shader(path))
             {
@@ -378,18 +365,7 @@ namespace core
                   return monad::make_error(cache_res.value());
                }
 
-               const auto extension = path.extension().string();
-               return vkn::shader::builder{*mp_device, mp_logger}
-                  .set_spirv_binary(*res.value())
-                  .set_name(path.filename().string())
-                  .set_type(get_shader_type({extension.begin() + 1, extension.end()}))
-                  .build()
-                  .map_error([&](auto&& err) {
-                     util::log_error(mp_logger, "[core] shader creation error: {}-{}",
-                                     err.type.category().name(), err.type.message());
-
-                     return make_error(shader_codex_error::failed_to_create_shader);
-                  });
+               return create_module(path, std::move(res).value().value());
             }
             else
             {
@@ -402,27 +378,39 @@ namespace core
          util::log_info(mp_logger, "[core] compiling shader: \"{0}\"", path.string());
 
          return compile_shader(path).and_then([&](auto&& spirv) {
-            const auto extension = path.extension().string();
-            return vkn::shader::builder{*mp_device, mp_logger}
-               .set_spirv_binary(std::move(spirv))
-               .set_name(path.filename().string())
-               .set_type(get_shader_type({extension.begin() + 1, extension.end()}))
-               .build()
-               .map_error([&](auto&& err) {
-                  util::log_error(mp_logger, "[core] shader creation error: {}-{}",
-                                  err.type.category().name(), err.type.message());
-
-                  return make_error(shader_codex_error::failed_to_create_shader);
-               });
+            return create_module(path, std::move(spirv));
          });
       }
 
       return monad::make_error(make_error(shader_codex_error::failed_to_create_shader));
    }
+   auto builder::create_module(const fs::path& path, util::dynamic_array<std::uint32_t> spirv)
+      -> core::result<vkn::shader>
+   {
+      const auto extension = path.extension().string();
+
+      vkn::shader::builder shader_builder{*mp_device, mp_logger};
+      auto shader = shader_builder.set_spirv_binary(std::move(spirv))
+                       .set_name(path.filename().string())
+                       .set_type(get_shader_type({extension.begin() + 1, extension.end()}))
+                       .build();
+
+      m_timings.reflection += shader_builder.reflection_time();
+      m_timings.module_creation += shader_builder.module_creation_time();
+
+      return std::move(shader).map_error([&](auto&& err) {
+         util::log_error(mp_logger, "[core] shader creation error: {}-{}",
+                         err.type.category().name(), err.type.message());
+
+         return make_error(shader_codex_error::failed_to_create_shader);
+      });
+   }
 
    auto builder::compile_shader(const std::filesystem::path& path)
       -> core::result<util::dynamic_array<std::uint32_t>>
    {
+      UTIL_TRACE_ZONE_CAT("shader_codex::compile_shader", "shader");
+
       std::ifstream file{path};
       if (!file.is_open())
       {
@@ -451,6 +439,16 @@ namespace core
       tshader.setEnvTarget(glslang::EshTargetSpv,
                            get_spirv_version(mp_device->get_vulkan_version()));
 
+      using clock = std::chrono::steady_clock;
+
+      // Add the time spent since the previous stage ended to the given one
+      auto stage_start = clock::now();
+      const auto end_stage = [&](std::chrono::nanoseconds& stage) {
+         const auto now = clock::now();
+         stage += now - stage_start;
+         stage_start = now;
+      };
+
       const char* shader_data_cstr = shader_data.c_str();
       tshader.setStrings(&shader_data_cstr, 1);
 
@@ -468,6 +466,7 @@ namespace core
 
          return monad::make_error(make_error(shader_codex_error::failed_to_preprocess_shader));
       }
+      end_stage(m_timings.preprocess);
 
       const char* preprocessed_glsl_c_str = preprocessed_glsl.c_str();
       tshader.setStrings(&preprocessed_glsl_c_str, 1);
@@ -478,6 +477,7 @@ namespace core
 
          return monad::make_error(make_error(shader_codex_error::failed_to_parse_shader));
       }
+      end_stage(m_timings.parse);
 
       glslang::TProgram program;
       program.addShader(&tshader);
@@ -489,17 +489,24 @@ namespace core
 
          return monad::make_error(make_error(shader_codex_error::failed_to_link_shader));
       }
+      end_stage(m_timings.link);
 
       std::vector<uint32_t> spirv;
       spv::SpvBuildLogger logger;
       glslang::SpvOptions spv_options;
       glslang::GlslangToSpv(*program.getIntermediate(shader_stage), spirv, &logger, &spv_options);
+      end_stage(m_timings.spirv_generation);
+      ++m_timings.compiled_count;
 
       return util::dynamic_array<uint32_t>{spirv.begin(), spirv.end()};
    }
    auto builder::load_shader(const std::filesystem::path& path)
       -> core::result<util::dynamic_array<std::uint32_t>>
    {
+      using clock = std::chrono::steady_clock;
+
+      const auto load_start = clock::now();
+
       std::ifstream file{path, std::ios::binary};
       if (!file.is_open())
       {
@@ -512,13 +519,20 @@ namespace core
       std::memcpy(static_cast<void*>(data.data()), raw_shader_data.data(),
                   sizeof(std::uint32_t) * data.size());
 
+      m_timings.cache_load += clock::now() - load_start;
+      ++m_timings.cached_count;
+
       return data;
    }
 
    auto builder::cache_shader(const std::filesystem::path& path,
-                              const util::dynamic_array<std::uint32_t>& data) const
+                              const util::dynamic_array<std::uint32_t>& data)
       -> monad::maybe<error_t>
    {
+      using clock = std::chrono::steady_clock;
+
+      const auto write_start = clock::now();
+
       std::ofstream cache_file{path, std::ios::trunc | std::ios::binary};
       if (!cache_file.is_open())
       {
@@ -529,6 +543,8 @@ namespace core
                        data.size() * sizeof(std::uint32_t));
       cache_file.close();
 
+      m_timings.cache_write += clock::now() - write_start;
+
       return monad::none;
    }
 
@@ -0,0 +1,165 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2020 Wmbat
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <core/memory/multipool_allocator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+struct multipool_allocator_test : public testing::Test
+{
+   static constexpr std::size_t pool_count = 2;
+   static constexpr std::size_t pool_size = 256;
+   static constexpr std::size_t depth = 3;
+
+   core::multipool_allocator allocator{
+      {.pool_count = pool_count, .pool_size = pool_size, .depth = depth}};
+};
+
+TEST_F(multipool_allocator_test, allocate_picks_smallest_fitting_depth)
+{
+   void* p_large = allocator.allocate(200);
+   void* p_medium = allocator.allocate(100);
+   void* p_small = allocator.allocate(64);
+
+   ASSERT_NE(p_large, nullptr);
+   ASSERT_NE(p_medium, nullptr);
+   ASSERT_NE(p_small, nullptr);
+
+   EXPECT_EQ(allocator.allocation_capacity(p_large), 256);
+   EXPECT_EQ(allocator.allocation_capacity(p_medium), 128);
+   EXPECT_EQ(allocator.allocation_capacity(p_small), 64);
+
+   EXPECT_EQ(allocator.memory_usage(), 256 + 128 + 64);
+   EXPECT_EQ(allocator.allocation_count(), 3);
+
+   allocator.deallocate(p_medium);
+
+   EXPECT_EQ(allocator.memory_usage(), 256 + 64);
+   EXPECT_EQ(allocator.allocation_count(), 2);
+
+   allocator.deallocate(p_small);
+   allocator.deallocate(p_large);
+
+   EXPECT_EQ(allocator.memory_usage(), 0);
+   EXPECT_EQ(allocator.allocation_count(), 0);
+}
+
+TEST_F(multipool_allocator_test, exhaust_every_depth)
+{
+   // Every block of every depth is handed out once and written over in full. Overlapping blocks
+   // or blocks running past the end of the memory overwrite each other's pattern
+   std::vector<std::pair<void*, std::size_t>> allocations;
+   for (std::size_t i = 0; i < depth; ++i)
+   {
+      const std::size_t block_size = pool_size >> i;
+      for (std::size_t j = 0; j < (pool_count << i); ++j)
+      {
+         void* p_alloc = allocator.allocate(block_size);
+         ASSERT_NE(p_alloc, nullptr);
+         EXPECT_EQ(allocator.allocation_capacity(p_alloc), block_size);
+
+         std::memset(p_alloc, static_cast<int>(allocations.size() + 1), block_size);
+         allocations.emplace_back(p_alloc, block_size);
+      }
+
+      EXPECT_EQ(allocator.allocate(block_size), nullptr);
+   }
+
+   EXPECT_EQ(allocator.memory_usage(), pool_count * pool_size * depth);
+   EXPECT_EQ(allocator.allocation_count(), allocations.size());
+
+   for (std::size_t i = 0; i < allocations.size(); ++i)
+   {
+      const auto* p_bytes = static_cast<const unsigned char*>(allocations[i].first);
+      const auto expected = static_cast<unsigned char>(i + 1);
+
+      EXPECT_TRUE(std::all_of(p_bytes, p_bytes + allocations[i].second, [=](unsigned char b) {
+         return b == expected;
+      }));
+   }
+
+   for (auto [p_alloc, size] : allocations)
+   {
+      allocator.deallocate(p_alloc);
+   }
+
+   EXPECT_EQ(allocator.memory_usage(), 0);
+   EXPECT_EQ(allocator.allocation_count(), 0);
+}
+
+TEST_F(multipool_allocator_test, deallocate_then_allocate_reuses_block)
+{
+   void* p_first = allocator.allocate(60);
+   ASSERT_NE(p_first, nullptr);
+
+   allocator.deallocate(p_first);
+
+   void* p_second = allocator.allocate(40);
+
+   EXPECT_EQ(p_second, p_first);
+   EXPECT_EQ(allocator.allocation_capacity(p_second), 64);
+   EXPECT_EQ(allocator.memory_usage(), 64);
+}
+
+TEST_F(multipool_allocator_test, reallocate)
+{
+   void* p_alloc = allocator.allocate(100);
+   ASSERT_NE(p_alloc, nullptr);
+
+   EXPECT_EQ(allocator.reallocate(p_alloc, 128), p_alloc);
+   EXPECT_EQ(allocator.reallocate(p_alloc, 16), p_alloc);
+   EXPECT_EQ(allocator.reallocate(p_alloc, 129), nullptr);
+
+   EXPECT_EQ(allocator.allocation_capacity(p_alloc), 128);
+   EXPECT_EQ(allocator.memory_usage(), 128);
+   EXPECT_EQ(allocator.allocation_count(), 1);
+}
+
+TEST_F(multipool_allocator_test, release)
+{
+   for (std::size_t i = 0; i < pool_count << (depth - 1); ++i)
+   {
+      ASSERT_NE(allocator.allocate(64), nullptr);
+   }
+
+   EXPECT_EQ(allocator.allocate(64), nullptr);
+
+   allocator.release();
+
+   EXPECT_EQ(allocator.memory_usage(), 0);
+   EXPECT_EQ(allocator.allocation_count(), 0);
+
+   for (std::size_t i = 0; i < pool_count << (depth - 1); ++i)
+   {
+      void* p_alloc = allocator.allocate(64);
+      ASSERT_NE(p_alloc, nullptr);
+      EXPECT_EQ(allocator.allocation_capacity(p_alloc), 64);
+   }
+
+   EXPECT_EQ(allocator.memory_usage(), 64 * (pool_count << (depth - 1)));
+}
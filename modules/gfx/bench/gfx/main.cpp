@@ -0,0 +1,75 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2020 Wmbat
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gfx/render_bench.hpp>
+#include <gfx/shader_bench.hpp>
+
+#include <core/core.hpp>
+
+#include <gfx/context.hpp>
+#include <gfx/render_manager.hpp>
+#include <gfx/window.hpp>
+
+#include <util/logger.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+/**
+ * The window, context & render manager are created once and shared by every benchmark, a Vulkan
+ * context may only be created once per process. The shader benchmarks build their codices on the
+ * render manager's device. Running on a software driver without a display is done through Xvfb:
+ *    VK_ICD_FILENAMES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json xvfb-run ./gfx_bench
+ *       --benchmark_format=json --benchmark_out=gfx_bench.json
+ */
+auto main(int argc, char** argv) -> int
+{
+   benchmark::Initialize(&argc, argv);
+   if (benchmark::ReportUnrecognizedArguments(argc, argv))
+   {
+      return 1;
+   }
+
+   auto p_logger = std::make_shared<util::logger>("gfx_bench");
+
+   // The render manager logs every frame at the debug level, which would be timed with it
+   p_logger->get_logger().set_level(spdlog::level::warn);
+
+   core::initialize(p_logger);
+
+   gfx::context rendering_ctx{p_logger};
+   gfx::window rendering_wnd{"gfx_bench", bench::window_width, bench::window_height};
+   gfx::render_manager rendering_manager{rendering_ctx, rendering_wnd, p_logger};
+
+   rendering_manager.bake();
+
+   bench::register_render_benchmarks(rendering_manager);
+   bench::register_shader_benchmarks(rendering_manager.device(), p_logger);
+   benchmark::RunSpecifiedBenchmarks();
+
+   rendering_manager.wait();
+
+   return 0;
+}
@@ -0,0 +1,179 @@
+#include <gfx/render_bench.hpp>
+
+#include <gfx/gltf.hpp>
+#include <gfx/gpu_profiler.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <string>
+
+namespace
+{
+   static constexpr std::array renderable_counts{std::size_t{100}, std::size_t{1'000},
+                                                 std::size_t{10'000}, std::size_t{100'000}};
+   static constexpr std::array triangle_counts{std::size_t{32}, std::size_t{512},
+                                               std::size_t{8192}};
+
+   /**
+    * A flat square grid of one unit wide centered on the origin, split in enough quads to give
+    * the requested number of triangles
+    */
+   auto make_grid_mesh(std::string name, std::size_t triangle_count) -> gfx::gltf_mesh
+   {
+      const auto quads_per_side = static_cast<std::uint32_t>(
+         std::max(1.0, std::round(std::sqrt(static_cast<double>(triangle_count) / 2.0))));
+      const std::uint32_t vertices_per_side = quads_per_side + 1;
+
+      gfx::gltf_mesh mesh{.name = std::move(name)};
+      mesh.vertices.reserve(vertices_per_side * vertices_per_side);
+      for (std::uint32_t y = 0; y < vertices_per_side; ++y)
+      {
+         for (std::uint32_t x = 0; x < vertices_per_side; ++x)
+         {
+            const float u = static_cast<float>(x) / static_cast<float>(quads_per_side);
+            const float v = static_cast<float>(y) / static_cast<float>(quads_per_side);
+
+            mesh.vertices.push_back(
+               {.position = {u - 0.5F, v - 0.5F, 0.0F}, .colour = {u, v, 1.0F - u}});
+         }
+      }
+
+      mesh.indices.reserve(std::size_t{6} * quads_per_side * quads_per_side);
+      for (std::uint32_t y = 0; y < quads_per_side; ++y)
+      {
+         for (std::uint32_t x = 0; x < quads_per_side; ++x)
+         {
+            const std::uint32_t corner = y * vertices_per_side + x;
+
+            mesh.indices.insert(std::end(mesh.indices),
+                                {corner, corner + 1, corner + vertices_per_side + 1,
+                                 corner + vertices_per_side + 1, corner + vertices_per_side,
+                                 corner});
+         }
+      }
+
+      mesh.local_bounds = {.center = glm::vec3{0.0F}, .radius = std::sqrt(0.5F)};
+
+      return mesh;
+   }
+
+   /**
+    * Lay renderable_count distinct grid meshes side by side over the [-1, 1] square seen by the
+    * render manager's camera. Every mesh is placed once, so each becomes a renderable of its own
+    */
+   auto make_grid_scene(std::size_t renderable_count, std::size_t triangle_count)
+      -> gfx::gltf_scene
+   {
+      const auto tiles_per_side =
+         static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(renderable_count))));
+      const float tile_size = 2.0F / static_cast<float>(tiles_per_side);
+
+      gfx::gltf_scene scene;
+      scene.meshes.reserve(renderable_count);
+      scene.instances.reserve(renderable_count);
+      for (std::size_t i = 0; i < renderable_count; ++i)
+      {
+         const float x = -1.0F + tile_size * (static_cast<float>(i % tiles_per_side) + 0.5F);
+         const float y = -1.0F + tile_size * (static_cast<float>(i / tiles_per_side) + 0.5F);
+
+         const auto model = glm::scale(glm::translate(glm::mat4{1.0F}, glm::vec3{x, y, 0.0F}),
+                                       glm::vec3{tile_size * 0.9F});
+
+         scene.meshes.push_back(make_grid_mesh("grid_" + std::to_string(i), triangle_count));
+         scene.instances.push_back({.name = "grid_" + std::to_string(i),
+                                    .mesh = static_cast<std::uint32_t>(i),
+                                    .transform = model});
+      }
+
+      return scene;
+   }
+
+   /**
+    * Every phase of render_frame is reported through its median & 95th percentile, in
+    * milliseconds, over the frames of the run
+    */
+   void report_phases(benchmark::State& state, const gfx::gpu_profiler& profiler)
+   {
+      for (const auto& scope : profiler.report())
+      {
+         const std::string name{scope.name};
+         if (scope.cpu_sample_count > 0)
+         {
+            state.counters[name + "_cpu_median_ms"] = scope.cpu.median;
+            state.counters[name + "_cpu_p95_ms"] = scope.cpu.p95;
+         }
+         if (scope.gpu_sample_count > 0)
+         {
+            state.counters[name + "_gpu_median_ms"] = scope.gpu.median;
+            state.counters[name + "_gpu_p95_ms"] = scope.gpu.p95;
+         }
+      }
+   }
+
+   void render_frame(benchmark::State& state, gfx::render_manager& manager,
+                     std::size_t renderable_count, std::size_t triangle_count)
+   {
+      const auto handles =
+         manager.subscribe_scene(make_grid_scene(renderable_count, triangle_count));
+      if (!handles)
+      {
+         state.SkipWithError("failed to subscribe the scene");
+         return;
+      }
+
+      for (std::size_t i = 0; i < bench::warmup_frame_count; ++i)
+      {
+         manager.render_frame();
+      }
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         manager.render_frame();
+      }
+
+      report_phases(state, manager.profiler());
+      state.counters["renderables"] = static_cast<double>(renderable_count);
+      state.counters["triangles"] = static_cast<double>(renderable_count * triangle_count);
+      state.counters["frames_in_flight"] =
+         static_cast<double>(gfx::render_manager::max_frames_in_flight);
+
+      manager.wait();
+      for (auto handle : handles->renderables)
+      {
+         manager.unsubscribe_renderable(handle);
+      }
+   }
+} // namespace
+
+namespace bench
+{
+   void register_render_benchmarks(gfx::render_manager& manager)
+   {
+      for (auto renderable_count : renderable_counts)
+      {
+         for (auto triangle_count : triangle_counts)
+         {
+            if (renderable_count * triangle_count > max_scene_triangle_count)
+            {
+               continue;
+            }
+
+            const auto name = "render_frame/renderables:" + std::to_string(renderable_count) +
+               "/triangles:" + std::to_string(triangle_count);
+
+            // As many frames as the profiler keeps, so its statistics cover the whole run
+            benchmark::RegisterBenchmark(name.c_str(), render_frame, std::ref(manager),
+                                         renderable_count, triangle_count)
+               ->Iterations(gfx::gpu_profiler::history_size)
+               ->Unit(benchmark::kMillisecond)
+               ->UseRealTime();
+         }
+      }
+   }
+} // namespace bench
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <gfx/render_manager.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bench
+{
+   static constexpr std::uint32_t window_width = 1080;
+   static constexpr std::uint32_t window_height = 720;
+
+   /**
+    * Frames rendered after a scene is subscribed and before timing starts, so its uploads and
+    * the buffers retired by the previous scene are out of the way
+    */
+   static constexpr std::size_t warmup_frame_count = 8;
+
+   /**
+    * Configurations whose scene holds more triangles than this are skipped, software
+    * rasterisers take seconds per frame past it
+    */
+   static constexpr std::size_t max_scene_triangle_count = std::size_t{1} << 24U;
+
+   /**
+    * Register a render_frame benchmark for every renderable count & mesh size swept. The
+    * render manager must be baked and outlive the benchmarks
+    */
+   void register_render_benchmarks(gfx::render_manager& manager);
+} // namespace bench
@@ -0,0 +1,265 @@
+#include <gfx/shader_bench.hpp>
+
+#include <core/shader_codex.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+   static constexpr std::array shader_counts{std::size_t{10}, std::size_t{100}, std::size_t{1000}};
+   static constexpr std::array include_depths{std::size_t{0}, bench::heavy_include_depth};
+
+   enum struct cache_state
+   {
+      disabled, // shaders are compiled and never cached
+      cold,     // shaders are compiled then written to an empty cache
+      warm      // shaders are all loaded from an up to date cache
+   };
+
+   auto to_string(cache_state state) -> std::string
+   {
+      switch (state)
+      {
+         case cache_state::disabled:
+            return "disabled";
+         case cache_state::cold:
+            return "cold";
+         case cache_state::warm:
+            return "warm";
+      }
+
+      return "";
+   }
+
+   auto node_name(std::size_t depth, std::size_t index) -> std::string
+   {
+      return "node_" + std::to_string(depth) + "_" + std::to_string(index);
+   }
+
+   /**
+    * Write a binary tree of headers, every header including its two children behind include
+    * guards. The root is include/node_0_0.glsl
+    */
+   void write_include_tree(const fs::path& directory, std::size_t depth)
+   {
+      fs::create_directories(directory);
+
+      for (std::size_t level = 0; level < depth; ++level)
+      {
+         for (std::size_t i = 0; i < (std::size_t{1} << level); ++i)
+         {
+            const auto name = node_name(level, i);
+            const bool is_leaf = level + 1 == depth;
+
+            std::ofstream file{directory / (name + ".glsl")};
+            file << "#ifndef " << name << "_glsl\n#define " << name << "_glsl\n\n";
+            if (is_leaf)
+            {
+               file << "vec3 " << name << "(vec3 v)\n{\n   return sin(v * "
+                    << std::to_string(level + i + 1) << ".0);\n}\n";
+            }
+            else
+            {
+               const auto left = node_name(level + 1, 2 * i);
+               const auto right = node_name(level + 1, 2 * i + 1);
+
+               file << "#include \"" << left << ".glsl\"\n#include \"" << right << ".glsl\"\n\n";
+               file << "vec3 " << name << "(vec3 v)\n{\n   return " << left << "(v) * 0.5 + "
+                    << right << "(v.zyx) * 0.5;\n}\n";
+            }
+            file << "\n#endif\n";
+         }
+      }
+   }
+
+   /**
+    * Write shader_count distinct shaders, alternating between vertex & fragment shaders, all
+    * reaching the whole include tree when there is one
+    */
+   auto write_shader_set(std::size_t shader_count, std::size_t include_depth)
+      -> util::dynamic_array<fs::path>
+   {
+      const auto directory = fs::temp_directory_path() / "vermillon_shader_bench" /
+         ("shaders_" + std::to_string(shader_count) + "_" + std::to_string(include_depth));
+
+      fs::remove_all(directory);
+      write_include_tree(directory / "include", include_depth);
+
+      // Without an include tree the call becomes a parenthesised expression
+      const std::string shade = include_depth > 0 ? "node_0_0" : "";
+
+      util::dynamic_array<fs::path> paths;
+      paths.reserve(shader_count);
+      for (std::size_t i = 0; i < shader_count; ++i)
+      {
+         const bool is_vertex = i % 2 == 0;
+         const auto path =
+            directory / ("shader_" + std::to_string(i) + (is_vertex ? ".vert" : ".frag"));
+
+         std::ofstream file{path};
+         file << "#version 450\n#extension GL_GOOGLE_include_directive : enable\n\n";
+         if (include_depth > 0)
+         {
+            file << "#include \"include/node_0_0.glsl\"\n\n";
+         }
+         file << "const float shader_index = " << std::to_string(i) << ".0;\n\n";
+
+         if (is_vertex)
+         {
+            file << "layout(set = 0, binding = 0) uniform camera_buffer_object\n{\n"
+                    "   mat4 proj;\n   mat4 view;\n} cbo;\n\n"
+                    "layout(location = 0) in vec3 in_position;\n"
+                    "layout(location = 1) in vec3 in_colour;\n\n"
+                    "layout(location = 0) out vec3 frag_colour;\n\n"
+                    "void main()\n{\n"
+                    "   gl_Position = cbo.proj * cbo.view * vec4(in_position, 1.0);\n"
+                    "   frag_colour = "
+                 << shade << "(in_colour) * shader_index;\n}\n";
+         }
+         else
+         {
+            file << "layout(location = 0) in vec3 frag_colour;\n\n"
+                    "layout(location = 0) out vec4 out_colour;\n\n"
+                    "void main()\n{\n"
+                    "   out_colour = vec4("
+                 << shade << "(frag_colour) + shader_index, 1.0);\n}\n";
+         }
+
+         paths.push_back(path);
+      }
+
+      return paths;
+   }
+
+   auto build_codex(const vkn::device& device, const std::shared_ptr<util::logger>& p_logger,
+                    const util::dynamic_array<fs::path>& paths, const fs::path& cache_directory,
+                    bool is_caching_allowed, core::shader_build_timings& timings) -> bool
+   {
+      core::shader_codex::builder builder{device, p_logger};
+      builder.set_cache_directory(cache_directory).allow_caching(is_caching_allowed);
+      for (const auto& path : paths)
+      {
+         builder.add_shader_filepath(path);
+      }
+
+      auto codex = builder.build();
+      benchmark::DoNotOptimize(codex);
+
+      timings = builder.timings();
+
+      return codex.is_value();
+   }
+
+   /**
+    * Every stage is reported as the milliseconds it took per build, summed over the shaders
+    */
+   void report_stages(benchmark::State& state, const core::shader_build_timings& totals)
+   {
+      using milliseconds = std::chrono::duration<double, std::milli>;
+
+      const auto add = [&](const std::string& name, std::chrono::nanoseconds total) {
+         state.counters[name + "_ms"] = benchmark::Counter(milliseconds(total).count(),
+                                                           benchmark::Counter::kAvgIterations);
+      };
+
+      add("preprocess", totals.preprocess);
+      add("parse", totals.parse);
+      add("link", totals.link);
+      add("spirv_generation", totals.spirv_generation);
+      add("cache_load", totals.cache_load);
+      add("cache_write", totals.cache_write);
+      add("reflection", totals.reflection);
+      add("module_creation", totals.module_creation);
+
+      state.counters["compiled"] = benchmark::Counter(static_cast<double>(totals.compiled_count),
+                                                      benchmark::Counter::kAvgIterations);
+      state.counters["cached"] = benchmark::Counter(static_cast<double>(totals.cached_count),
+                                                    benchmark::Counter::kAvgIterations);
+   }
+
+   void accumulate(core::shader_build_timings& totals, const core::shader_build_timings& timings)
+   {
+      totals.preprocess += timings.preprocess;
+      totals.parse += timings.parse;
+      totals.link += timings.link;
+      totals.spirv_generation += timings.spirv_generation;
+      totals.cache_load += timings.cache_load;
+      totals.cache_write += timings.cache_write;
+      totals.reflection += timings.reflection;
+      totals.module_creation += timings.module_creation;
+      totals.compiled_count += timings.compiled_count;
+      totals.cached_count += timings.cached_count;
+   }
+
+   void build_shaders(benchmark::State& state, const vkn::device& device,
+                      const std::shared_ptr<util::logger>& p_logger, std::size_t shader_count,
+                      std::size_t include_depth, cache_state cache)
+   {
+      const auto paths = write_shader_set(shader_count, include_depth);
+      const auto cache_directory = paths[0].parent_path() / "cache";
+
+      core::shader_build_timings timings{};
+      if (cache == cache_state::warm &&
+          !build_codex(device, p_logger, paths, cache_directory, true, timings))
+      {
+         state.SkipWithError("failed to fill the shader cache");
+         return;
+      }
+
+      core::shader_build_timings totals{};
+      for ([[maybe_unused]] auto _ : state)
+      {
+         if (cache == cache_state::cold)
+         {
+            state.PauseTiming();
+            fs::remove_all(cache_directory);
+            state.ResumeTiming();
+         }
+
+         if (!build_codex(device, p_logger, paths, cache_directory,
+                          cache != cache_state::disabled, timings))
+         {
+            state.SkipWithError("failed to build the shader codex");
+            break;
+         }
+
+         accumulate(totals, timings);
+      }
+
+      report_stages(state, totals);
+      state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(shader_count));
+   }
+} // namespace
+
+namespace bench
+{
+   void register_shader_benchmarks(const vkn::device& device,
+                                   const std::shared_ptr<util::logger>& p_logger)
+   {
+      for (auto cache : {cache_state::disabled, cache_state::cold, cache_state::warm})
+      {
+         for (auto include_depth : include_depths)
+         {
+            for (auto shader_count : shader_counts)
+            {
+               const auto name = "build_shaders/" + to_string(cache) + "/shaders:" +
+                  std::to_string(shader_count) + "/include_depth:" + std::to_string(include_depth);
+
+               benchmark::RegisterBenchmark(name.c_str(), build_shaders, std::cref(device),
+                                            p_logger, shader_count, include_depth, cache)
+                  ->Unit(benchmark::kMillisecond)
+                  ->UseRealTime();
+            }
+         }
+      }
+   }
+} // namespace bench
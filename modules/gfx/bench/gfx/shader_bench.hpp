@@ -0,0 +1,24 @@
+#pragma once
+
+#include <util/logger.hpp>
+
+#include <vkn/device.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace bench
+{
+   /**
+    * Depth of the include tree shared by every shader of the heavy sets, each header includes
+    * two others down to the leaves
+    */
+   static constexpr std::size_t heavy_include_depth = 6;
+
+   /**
+    * Register a shader_codex::builder::build benchmark for every shader set swept, written to
+    * the temporary directory. The device must outlive the benchmarks
+    */
+   void register_shader_benchmarks(const vkn::device& device,
+                                   const std::shared_ptr<util::logger>& p_logger);
+} // namespace bench
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <gfx/commons.hpp>
+
+#include <util/containers/dynamic_array.hpp>
+#include <util/logger.hpp>
+
+#include <vkn/descriptor_allocator.hpp>
+#include <vkn/descriptor_set_layout.hpp>
+#include <vkn/device.hpp>
+
+#include <limits>
+
+namespace gfx
+{
+   enum struct bindless_table_error
+   {
+      descriptor_indexing_not_supported,
+      failed_to_create_set_layout,
+      failed_to_allocate_set
+   };
+
+   auto to_string(bindless_table_error err) -> std::string;
+   auto make_error(bindless_table_error err) noexcept -> error_t;
+
+   /**
+    * A single large descriptor set holding every storage buffer and sampled image in use, which
+    * shaders access by index. The set is bound once per frame and, being update-after-bind and
+    * partially bound, may have resources added while command buffers using it are recorded or
+    * pending
+    */
+   class bindless_table
+   {
+   public:
+      static constexpr std::uint32_t storage_buffer_binding = 0;
+      static constexpr std::uint32_t sampled_image_binding = 1;
+
+      static constexpr std::uint32_t max_storage_buffers = 1024;
+      static constexpr std::uint32_t max_sampled_images = 4096;
+
+      static constexpr std::uint32_t invalid_index = std::numeric_limits<std::uint32_t>::max();
+
+      struct create_info
+      {
+         const vkn::device* p_device;
+
+         std::shared_ptr<util::logger> p_logger;
+      };
+
+      static auto make(create_info&& info) noexcept -> gfx::result<bindless_table>;
+
+      /**
+       * Get the Vulkan 1.2 features the table requires
+       */
+      static auto required_features() noexcept -> vk::PhysicalDeviceVulkan12Features;
+      /**
+       * Check whether the given features include every feature the table requires
+       */
+      static auto is_supported(const vk::PhysicalDeviceVulkan12Features& features) noexcept
+         -> bool;
+
+      /**
+       * Get the bindings of the table's layout, for pipelines to declare a compatible set
+       */
+      static auto layout_bindings() -> util::dynamic_array<vk::DescriptorSetLayoutBinding>;
+      static auto layout_binding_flags() -> util::dynamic_array<vk::DescriptorBindingFlags>;
+      static auto layout_flags() noexcept -> vk::DescriptorSetLayoutCreateFlags;
+
+      /**
+       * Write a storage buffer range in the table and return the index shaders refer to it by,
+       * or invalid_index if the table is full
+       */
+      auto add_storage_buffer(vk::Buffer buffer, vk::DeviceSize offset, vk::DeviceSize range)
+         -> std::uint32_t;
+      /**
+       * Write a sampled image in the table and return the index shaders refer to it by, or
+       * invalid_index if the table is full
+       */
+      auto add_sampled_image(vk::ImageView view, vk::Sampler sampler,
+                             vk::ImageLayout layout = vk::ImageLayout::eShaderReadOnlyOptimal)
+         -> std::uint32_t;
+
+      /**
+       * Free an index for reuse. The caller must make sure no pending frame still reads it
+       */
+      void remove_storage_buffer(std::uint32_t index);
+      /**
+       * Free an index for reuse. The caller must make sure no pending frame still reads it
+       */
+      void remove_sampled_image(std::uint32_t index);
+
+      [[nodiscard]] auto set() const noexcept -> vk::DescriptorSet;
+      [[nodiscard]] auto layout() const noexcept -> vk::DescriptorSetLayout;
+
+   private:
+      struct slot_range
+      {
+         std::uint32_t capacity{0};
+         std::uint32_t count{0};
+         util::dynamic_array<std::uint32_t> free_indices{};
+
+         auto acquire() -> std::uint32_t;
+      };
+
+      void write(const vk::WriteDescriptorSet& write) const;
+
+   private:
+      vk::Device m_device;
+
+      vkn::descriptor_set_layout m_layout;
+      vkn::descriptor_allocator m_allocator;
+      vk::DescriptorSet m_set{};
+
+      slot_range m_storage_buffers{.capacity = max_storage_buffers};
+      slot_range m_sampled_images{.capacity = max_sampled_images};
+
+      std::shared_ptr<util::logger> mp_logger;
+   };
+} // namespace gfx
+
+namespace std
+{
+   template <>
+   struct is_error_code_enum<gfx::bindless_table_error> : true_type
+   {
+   };
+} // namespace std
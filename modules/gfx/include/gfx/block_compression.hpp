@@ -0,0 +1,61 @@
+#pragma once
+
+#include <util/containers/dynamic_array.hpp>
+
+#include <vkn/core.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace gfx
+{
+   /**
+    * The texel encodings textures may be stored in on disk
+    */
+   enum struct texel_format : std::uint32_t
+   {
+      rgba8,
+      bc1,
+      bc3,
+      bc5,
+      bc7,
+      count
+   };
+
+   static constexpr std::size_t texel_format_count = static_cast<std::size_t>(texel_format::count);
+
+   [[nodiscard]] auto is_block_compressed(texel_format format) noexcept -> bool;
+   /**
+    * Get the size in bytes of a 4x4 block, or of a single texel for uncompressed formats
+    */
+   [[nodiscard]] auto block_size(texel_format format) noexcept -> std::uint32_t;
+   /**
+    * Get the size in bytes of an image of the given extent. Block compressed images are padded
+    * to whole blocks
+    */
+   [[nodiscard]] auto image_size(texel_format format, const vk::Extent2D& extent) noexcept
+      -> std::size_t;
+   /**
+    * Get the Vulkan format of a texel format. BC5 has no sRGB variant, its UNORM format is
+    * returned instead
+    */
+   [[nodiscard]] auto to_vk_format(texel_format format, bool is_srgb) noexcept -> vk::Format;
+
+   /**
+    * Decode a block compressed image into tightly packed RGBA8 texels, for devices that cannot
+    * sample the compressed format. BC5's two channels are written to red and green. Returns an
+    * empty array if the data is smaller than the image
+    */
+   [[nodiscard]] auto decompress_to_rgba8(texel_format format, const vk::Extent2D& extent,
+                                          std::span<const std::byte> data)
+      -> util::dynamic_array<std::byte>;
+   /**
+    * Encode tightly packed RGBA8 texels into a block compressed format. BC1 is encoded opaque,
+    * BC5 keeps red and green and BC7 uses a single mode favouring speed over quality. Returns
+    * an empty array if the texels are fewer than the image's
+    */
+   [[nodiscard]] auto compress_from_rgba8(texel_format format, const vk::Extent2D& extent,
+                                          std::span<const std::byte> texels)
+      -> util::dynamic_array<std::byte>;
+} // namespace gfx
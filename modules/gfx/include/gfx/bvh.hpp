@@ -0,0 +1,114 @@
+#pragma once
+
+#include <gfx/culling.hpp>
+
+#include <util/containers/dynamic_array.hpp>
+
+#include <glm/glm.hpp>
+
+#include <limits>
+#include <optional>
+
+namespace gfx
+{
+   struct aabb
+   {
+      glm::vec3 min{0.0F};
+      glm::vec3 max{0.0F};
+
+      [[nodiscard]] auto contains(const aabb& other) const noexcept -> bool;
+      [[nodiscard]] auto overlaps(const aabb& other) const noexcept -> bool;
+      [[nodiscard]] auto surface_area() const noexcept -> float;
+   };
+
+   auto merge(const aabb& lhs, const aabb& rhs) noexcept -> aabb;
+   auto to_aabb(const bounding_sphere& sphere) noexcept -> aabb;
+
+   struct ray_hit
+   {
+      std::uint32_t user_data;
+      float distance;
+   };
+
+   /**
+    * A dynamic bounding volume hierarchy over axis aligned boxes. Leaves store an enlarged
+    * ("fat") box so objects moving by small amounts do not require the tree to be updated. The
+    * tree is kept balanced using tree rotations on insertion & removal.
+    */
+   class bvh
+   {
+   public:
+      static constexpr std::uint32_t null_node = std::numeric_limits<std::uint32_t>::max();
+
+      explicit bvh(float margin = 0.1F) noexcept;
+
+      /**
+       * Insert a new leaf in the tree and return its proxy id
+       */
+      auto insert(const aabb& bounds, std::uint32_t user_data) -> std::uint32_t;
+      void remove(std::uint32_t proxy);
+      /**
+       * Update the bounds of a leaf. The leaf is only reinserted when the new bounds escape its
+       * fat box. Returns whether the tree was modified
+       */
+      auto move(std::uint32_t proxy, const aabb& bounds) -> bool;
+
+      void set_user_data(std::uint32_t proxy, std::uint32_t user_data) noexcept;
+      [[nodiscard]] auto user_data(std::uint32_t proxy) const noexcept -> std::uint32_t;
+      [[nodiscard]] auto fat_bounds(std::uint32_t proxy) const noexcept -> const aabb&;
+
+      /**
+       * Append the user data of every leaf intersecting the frustum
+       */
+      void query_frustum(const frustum& frustum, util::dynamic_array<std::uint32_t>& out) const;
+      /**
+       * Append the user data of every leaf overlapping the box
+       */
+      void query_aabb(const aabb& bounds, util::dynamic_array<std::uint32_t>& out) const;
+      /**
+       * Find the closest leaf whose tight bounds are hit by the ray
+       */
+      [[nodiscard]] auto raycast(const glm::vec3& origin, const glm::vec3& direction,
+                                 float max_distance = std::numeric_limits<float>::max()) const
+         -> std::optional<ray_hit>;
+
+      [[nodiscard]] auto height() const noexcept -> std::int32_t;
+      [[nodiscard]] auto size() const noexcept -> std::size_t;
+      void clear() noexcept;
+
+   private:
+      struct node
+      {
+         aabb fat;
+         aabb tight;
+
+         std::uint32_t parent{null_node};
+         std::uint32_t child_a{null_node};
+         std::uint32_t child_b{null_node};
+
+         std::int32_t height{-1};
+         std::uint32_t user_data{0};
+
+         [[nodiscard]] auto is_leaf() const noexcept -> bool { return child_a == null_node; }
+      };
+
+      auto allocate_node() -> std::uint32_t;
+      void free_node(std::uint32_t index) noexcept;
+
+      void insert_leaf(std::uint32_t leaf);
+      void remove_leaf(std::uint32_t leaf);
+      void refit_ancestors(std::uint32_t index);
+      auto balance(std::uint32_t index) -> std::uint32_t;
+
+      void collect_leaves(std::uint32_t index, util::dynamic_array<std::uint32_t>& out) const;
+
+   private:
+      util::dynamic_array<node> m_nodes;
+
+      std::uint32_t m_root{null_node};
+      std::uint32_t m_free_list{null_node};
+      std::size_t m_leaf_count{0};
+
+      float m_margin;
+   };
+} // namespace gfx
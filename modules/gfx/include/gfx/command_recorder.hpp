@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vkn/core.hpp>
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace gfx
+{
+   /**
+    * Records draws in a command buffer while remembering the bound state. Binds that would not
+    * change anything are skipped and counted in util::stats::counter::elided_binds
+    */
+   class command_recorder
+   {
+      static constexpr std::size_t max_descriptor_sets = 4;
+      static constexpr std::size_t max_vertex_bindings = 4;
+
+   public:
+      explicit command_recorder(vk::CommandBuffer buffer) noexcept;
+
+      void bind_pipeline(vk::Pipeline pipeline, vk::PipelineLayout layout);
+      /**
+       * Bind descriptor sets. When dynamic offsets are given, each set is expected to hold a
+       * single dynamic descriptor
+       */
+      void bind_descriptor_sets(std::uint32_t first_set, std::span<const vk::DescriptorSet> sets,
+                                std::span<const std::uint32_t> dynamic_offsets = {});
+      void bind_vertex_buffer(std::uint32_t binding, vk::Buffer buffer,
+                              vk::DeviceSize offset = 0);
+      void bind_index_buffer(vk::Buffer buffer, vk::IndexType type, vk::DeviceSize offset = 0);
+
+      void push_constants(vk::ShaderStageFlags stages, std::uint32_t offset, std::uint32_t size,
+                          const void* p_values);
+
+      void draw_indexed(std::uint32_t index_count, std::uint32_t instance_count = 1,
+                        std::uint32_t first_index = 0, std::int32_t vertex_offset = 0,
+                        std::uint32_t first_instance = 0);
+      /**
+       * Draw the indexed draw commands stored in a buffer. Each command counts as a draw
+       */
+      void draw_indexed_indirect(vk::Buffer buffer, vk::DeviceSize offset,
+                                 std::uint32_t draw_count,
+                                 std::uint32_t stride = sizeof(vk::DrawIndexedIndirectCommand));
+
+      /**
+       * Forget the bound state, to be called whenever commands are recorded without going
+       * through the recorder
+       */
+      void reset() noexcept;
+
+      [[nodiscard]] auto buffer() const noexcept -> vk::CommandBuffer;
+      [[nodiscard]] auto elided_bind_count() const noexcept -> std::uint32_t;
+      [[nodiscard]] auto draw_count() const noexcept -> std::uint32_t;
+
+   private:
+      vk::CommandBuffer m_buffer;
+
+      vk::Pipeline m_pipeline{};
+      vk::PipelineLayout m_layout{};
+      std::array<vk::DescriptorSet, max_descriptor_sets> m_descriptor_sets{};
+      std::array<std::uint32_t, max_descriptor_sets> m_dynamic_offsets{};
+      std::array<vk::Buffer, max_vertex_bindings> m_vertex_buffers{};
+      std::array<vk::DeviceSize, max_vertex_bindings> m_vertex_offsets{};
+      vk::Buffer m_index_buffer{};
+      vk::DeviceSize m_index_offset{0};
+      vk::IndexType m_index_type{vk::IndexType::eUint32};
+
+      std::uint32_t m_elided_bind_count{0};
+      std::uint32_t m_draw_count{0};
+   };
+} // namespace gfx
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <gfx/data_types.hpp>
+
+#include <util/containers/dynamic_array.hpp>
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <span>
+
+namespace gfx
+{
+   struct bounding_sphere
+   {
+      glm::vec3 center{0.0F};
+      float radius{0.0F};
+   };
+
+   /**
+    * The six planes of a view frustum, stored as (normal, distance) with the normals pointing
+    * inward. Order: left, right, bottom, top, near, far
+    */
+   struct frustum
+   {
+      std::array<glm::vec4, 6> planes{};
+   };
+
+   /**
+    * Compute a sphere enclosing all vertices, centered on their axis aligned bounding box
+    */
+   auto compute_bounding_sphere(std::span<const vertex> vertices) noexcept -> bounding_sphere;
+
+   /**
+    * Transform a sphere by a model matrix. The radius is scaled by the largest axis scale so the
+    * result stays conservative under non-uniform scaling
+    */
+   auto transform_sphere(const bounding_sphere& sphere, const glm::mat4& model) noexcept
+      -> bounding_sphere;
+
+   /**
+    * Extract the normalized frustum planes of a view-projection matrix
+    */
+   auto extract_frustum(const glm::mat4& view_projection) noexcept -> frustum;
+
+   /**
+    * Test whether a single sphere intersects the frustum
+    */
+   auto intersects(const frustum& frustum, const bounding_sphere& sphere) noexcept -> bool;
+
+   /**
+    * Bounding spheres laid out as a structure of arrays so they may be culled several at a time
+    */
+   struct sphere_soa
+   {
+      util::dynamic_array<float> center_x;
+      util::dynamic_array<float> center_y;
+      util::dynamic_array<float> center_z;
+      util::dynamic_array<float> radius;
+
+      void push_back(const bounding_sphere& sphere);
+      void set(std::size_t index, const bounding_sphere& sphere) noexcept;
+      /**
+       * Remove the sphere at index by moving the last sphere into its place
+       */
+      void swap_and_pop(std::size_t index) noexcept;
+      void clear() noexcept;
+
+      [[nodiscard]] auto size() const noexcept -> std::size_t;
+   };
+
+   /**
+    * What spheres are projected to the screen with: the depth row of the view matrix and the
+    * projection_scale of the camera
+    */
+   struct sphere_projection
+   {
+      glm::vec4 depth_row{0.0F};
+      float scale{0.0F};
+   };
+
+   /**
+    * Get the number of pixels a unit long segment facing the camera covers at a view depth of
+    * one, for a perspective projection drawn to a viewport of the given height
+    */
+   auto projection_scale(const glm::mat4& perspective, float viewport_height) noexcept -> float;
+   auto make_sphere_projection(const glm::mat4& view, float projection_scale) noexcept
+      -> sphere_projection;
+
+   /**
+    * Append the index of every sphere intersecting the frustum to visible. Uses AVX or SSE when
+    * the module is compiled with support for them, a scalar loop otherwise
+    */
+   void cull_spheres(const frustum& frustum, const sphere_soa& spheres,
+                     util::dynamic_array<std::uint32_t>& visible);
+   /**
+    * Cull the spheres and append the radius in pixels of the visible ones to projected_radii
+    * in the same pass, in the order of visible. Spheres the camera is inside of are given an
+    * infinite radius
+    */
+   void cull_spheres(const frustum& frustum, const sphere_projection& projection,
+                     const sphere_soa& spheres, util::dynamic_array<std::uint32_t>& visible,
+                     util::dynamic_array<float>& projected_radii);
+
+   /**
+    * Compute the radius in pixels of spheres culled by other means, in the order of visible
+    */
+   void project_spheres(const sphere_projection& projection, const sphere_soa& spheres,
+                        std::span<const std::uint32_t> visible,
+                        util::dynamic_array<float>& projected_radii);
+
+   /**
+    * Pick the coarsest level of detail whose error, projected at the given number of pixels per
+    * object space unit, covers at most threshold pixels
+    */
+   auto select_lod(std::span<const mesh_lod> lods, float pixels_per_unit,
+                   float threshold = 1.0F) noexcept -> std::uint32_t;
+
+   namespace detail
+   {
+      auto project_sphere(const sphere_projection& projection, const sphere_soa& spheres,
+                          std::size_t index) noexcept -> float;
+
+      /**
+       * The spheres are only projected when p_projection is set, projected_radii is left
+       * untouched otherwise
+       */
+      void cull_spheres_scalar(const frustum& frustum, const sphere_projection* p_projection,
+                               const sphere_soa& spheres, std::size_t first,
+                               util::dynamic_array<std::uint32_t>& visible,
+                               util::dynamic_array<float>& projected_radii);
+#if defined(__SSE2__) || defined(_M_X64)
+      void cull_spheres_sse(const frustum& frustum, const sphere_projection* p_projection,
+                            const sphere_soa& spheres, util::dynamic_array<std::uint32_t>& visible,
+                            util::dynamic_array<float>& projected_radii);
+#endif
+#if defined(__AVX__)
+      void cull_spheres_avx(const frustum& frustum, const sphere_projection* p_projection,
+                            const sphere_soa& spheres, util::dynamic_array<std::uint32_t>& visible,
+                            util::dynamic_array<float>& projected_radii);
+#endif
+   } // namespace detail
+} // namespace gfx
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <util/containers/dynamic_array.hpp>
+#include <util/containers/slot_map.hpp>
 
 #include <glm/glm.hpp>
 
@@ -12,16 +13,69 @@ namespace gfx
       glm::vec3 colour;
    };
 
+   /**
+    * A level of detail: a range of the mesh's index buffer drawn over the shared vertices
+    */
+   struct mesh_lod
+   {
+      std::uint32_t first_index;
+      std::uint32_t index_count;
+      /**
+       * The object space error the level introduces compared to the full detail mesh
+       */
+      float error;
+   };
+
+   /**
+    * The data of a single drawn object as read by the shaders from the object buffer. Members
+    * must follow the std430 layout rules
+    */
+   struct object_data
+   {
+      glm::mat4 model;
+   };
+
    struct camera_matrices
    {
       glm::mat4 perspective;
       glm::mat4 view;
    };
 
+   /**
+    * Indices in the bindless table of the buffers read by the shaders, pushed as push constants
+    * once per frame
+    */
+   struct bindless_indices
+   {
+      std::uint32_t camera;
+      std::uint32_t objects;
+   };
+
+   /**
+    * Stable reference to a renderable subscribed to the render_manager
+    */
+   using renderable_handle = util::slot_key;
+
    struct renderable_data
    {
       util::dynamic_array<vertex> vertices;
       util::dynamic_array<std::uint32_t> indices;
       glm::mat4 model;
    };
+
+   struct instanced_renderable_data
+   {
+      util::dynamic_array<vertex> vertices;
+      util::dynamic_array<std::uint32_t> indices;
+      util::dynamic_array<glm::mat4> instances;
+   };
+
+   /**
+    * The handles of everything a scene was subscribed as
+    */
+   struct scene_handles
+   {
+      util::dynamic_array<renderable_handle> renderables{};
+      util::dynamic_array<renderable_handle> instanced_renderables{};
+   };
 } // namespace gfx
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <gfx/block_compression.hpp>
+#include <gfx/commons.hpp>
+
+#include <util/containers/dynamic_array.hpp>
+
+#include <span>
+
+namespace gfx
+{
+   enum struct dds_error
+   {
+      file_too_small,
+      invalid_magic,
+      unsupported_format,
+      unsupported_dimension,
+      truncated_data
+   };
+
+   auto to_string(dds_error err) -> std::string;
+   auto make_error(dds_error err) noexcept -> error_t;
+
+   /**
+    * Largest width or height accepted from a DDS file, the maxImageDimension2D of most desktop
+    * devices
+    */
+   static constexpr std::uint32_t max_dds_extent = 16384;
+
+   struct dds_mip
+   {
+      vk::Extent2D extent;
+      std::span<const std::byte> data;
+   };
+
+   /**
+    * A 2D texture stored in a DDS file. The mips point into the bytes the image was parsed from,
+    * which must outlive it
+    */
+   struct dds_image
+   {
+      texel_format format{texel_format::rgba8};
+      bool is_srgb{false};
+
+      // Ordered from the largest level down
+      util::small_dynamic_array<dds_mip, 16> mips{};
+   };
+
+   /**
+    * Parse the content of a DDS file holding a single 2D texture in BC1, BC3, BC5, BC7 or RGBA8,
+    * with either the legacy or the DX10 header. Images wider or taller than #max_dds_extent are
+    * rejected
+    */
+   auto parse_dds(std::span<const std::byte> bytes) -> gfx::result<dds_image>;
+   /**
+    * Serialise an image into the content of a DDS file. The DX10 header is always written so
+    * the colour space is kept
+    */
+   auto write_dds(const dds_image& image) -> util::dynamic_array<std::byte>;
+} // namespace gfx
+
+namespace std
+{
+   template <>
+   struct is_error_code_enum<gfx::dds_error> : true_type
+   {
+   };
+} // namespace std
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <util/containers/dynamic_array.hpp>
+
+#include <cstdint>
+#include <span>
+
+namespace gfx
+{
+   /**
+    * The state a draw depends on, used to build its sort key. Ids are truncated to the number
+    * of bits reserved for them in the key
+    */
+   struct draw_key_info
+   {
+      std::uint32_t pipeline{0};
+      std::uint32_t descriptor_set{0};
+      std::uint32_t material{0};
+      std::uint32_t mesh{0};
+      float depth{0.0F}; // normalized view depth in [0, 1]
+      bool is_translucent{false};
+   };
+
+   /**
+    * Pack the state of a draw in a 64 bit key. Opaque draws sort by pipeline, descriptor set,
+    * material then mesh with front to back depth last. Translucent draws sort after every
+    * opaque one, back to front first
+    *
+    * Opaque:      | 1 translucent | 10 pipeline | 10 set | 12 material | 15 mesh | 16 depth |
+    * Translucent: | 1 translucent | 16 inverse depth | state without its low 16 bits |
+    */
+   auto make_draw_key(const draw_key_info& info) noexcept -> std::uint64_t;
+
+   struct draw_packet
+   {
+      std::uint64_t key;
+      std::uint32_t renderable;
+      std::uint32_t lod;
+   };
+
+   /**
+    * Draws gathered for a frame. Sorting the queue by key groups draws sharing state together so
+    * the command recorder can skip the binds between them
+    */
+   class draw_queue
+   {
+   public:
+      void push(std::uint64_t key, std::uint32_t renderable, std::uint32_t lod = 0);
+      void sort();
+      void clear() noexcept;
+
+      [[nodiscard]] auto packets() const noexcept -> std::span<const draw_packet>;
+      [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+   private:
+      util::dynamic_array<draw_packet> m_packets;
+      util::dynamic_array<draw_packet> m_scratch;
+   };
+} // namespace gfx
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <gfx/commons.hpp>
+#include <gfx/culling.hpp>
+#include <gfx/data_types.hpp>
+#include <gfx/meshlet.hpp>
+
+#include <util/containers/dynamic_array.hpp>
+#include <util/logger.hpp>
+#include <util/thread_pool.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace gfx
+{
+   enum struct gltf_error
+   {
+      failed_to_map_file,
+      invalid_glb,
+      invalid_json,
+      unsupported_buffer,
+      invalid_buffer_view,
+      invalid_accessor,
+      invalid_mesh,
+      invalid_node
+   };
+
+   auto to_string(gltf_error err) -> std::string;
+   auto make_error(gltf_error err) noexcept -> error_t;
+
+   /**
+    * A mesh of a glTF file converted to the engine's vertex format. Its primitives are merged
+    * into one vertex & index list so the mesh is drawn with a single call, then run through
+    * optimize_mesh
+    */
+   struct gltf_mesh
+   {
+      std::string name;
+
+      util::dynamic_array<vertex> vertices{};
+      /**
+       * The indices of every level of detail, stored one after the other
+       */
+      util::dynamic_array<std::uint32_t> indices{};
+      util::dynamic_array<mesh_lod> lods{};
+      /**
+       * The meshlets of the full detail level, only built for dense meshes
+       */
+      util::dynamic_array<meshlet> meshlets{};
+
+      bounding_sphere local_bounds{};
+   };
+
+   /**
+    * A node of the scene referencing a mesh, with the transforms of its ancestors flattened
+    * into its own
+    */
+   struct gltf_instance
+   {
+      std::string name;
+
+      std::uint32_t mesh;
+      glm::mat4 transform;
+   };
+
+   struct gltf_import_stats
+   {
+      std::size_t json_bytes{0};
+      std::size_t buffer_bytes{0};
+      std::size_t vertex_count{0};
+      std::size_t index_count{0};
+
+      std::chrono::microseconds parse_time{0};
+      std::chrono::microseconds convert_time{0};
+   };
+
+   struct gltf_scene
+   {
+      util::dynamic_array<gltf_mesh> meshes{};
+      util::dynamic_array<gltf_instance> instances{};
+
+      gltf_import_stats stats;
+   };
+
+   /**
+    * Import the default scene of a glTF 2.0 file, either a .gltf with external buffers or a
+    * .glb. Buffers are memory mapped and read in place, the meshes are converted in parallel on
+    * the thread pool.
+    *
+    * Only triangle lists are imported. POSITION is required, COLOR_0 becomes the vertex colour
+    * and meshes without colours are shaded by their NORMAL instead. Meshes left without any
+    * triangle are dropped along with their instances. Sparse accessors & buffers embedded as
+    * data URIs aren't supported
+    */
+   auto import_gltf(const std::filesystem::path& path, util::thread_pool& thread_pool,
+                    const std::shared_ptr<util::logger>& p_logger) -> gfx::result<gltf_scene>;
+} // namespace gfx
+
+namespace std
+{
+   template <>
+   struct is_error_code_enum<gfx::gltf_error> : true_type
+   {
+   };
+} // namespace std
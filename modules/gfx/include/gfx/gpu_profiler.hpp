@@ -0,0 +1,187 @@
+#pragma once
+
+#include <gfx/commons.hpp>
+
+#include <util/containers/dynamic_array.hpp>
+#include <util/logger.hpp>
+
+#include <vkn/device.hpp>
+#include <vkn/query_pool.hpp>
+
+#include <array>
+#include <chrono>
+#include <limits>
+
+namespace gfx
+{
+   enum struct gpu_profiler_error
+   {
+      failed_to_create_query_pool,
+      timestamps_not_supported
+   };
+
+   auto to_string(gpu_profiler_error err) -> std::string;
+   auto make_error(gpu_profiler_error err) noexcept -> error_t;
+
+   /**
+    * Summary of the timings gathered for a scope over the last gpu_profiler::history_size
+    * samples. All values are in milliseconds
+    */
+   struct timing_stats
+   {
+      float average{0.0F};
+      float median{0.0F};
+      float p95{0.0F};
+      float p99{0.0F};
+      float max{0.0F};
+   };
+
+   struct scope_report
+   {
+      std::string_view name;
+
+      timing_stats gpu;
+      timing_stats cpu;
+
+      std::size_t gpu_sample_count{0};
+      std::size_t cpu_sample_count{0};
+   };
+
+   /**
+    * Measure the GPU time spent in named scopes of a command buffer using timestamp queries,
+    * along with the CPU time spent recording them. Each frame in flight owns its own range of
+    * queries, which are only read back once the frame's fence has been waited on, so resolving
+    * the results never stalls the CPU.
+    */
+   class gpu_profiler
+   {
+      using clock = std::chrono::steady_clock;
+
+   public:
+      static constexpr std::size_t history_size = 128;
+
+      struct create_info
+      {
+         const vkn::device* p_device;
+
+         util::count32_t frame_count{2};
+         util::count32_t max_scope_count{32};
+
+         std::shared_ptr<util::logger> p_logger;
+      };
+
+      /**
+       * Handle to an opened scope, must be given back to end_scope
+       */
+      struct scope_token
+      {
+         util::index_t scope{0};
+         std::uint32_t query{std::numeric_limits<std::uint32_t>::max()};
+         clock::time_point cpu_start{};
+      };
+
+      static auto make(create_info&& info) noexcept -> gfx::result<gpu_profiler>;
+
+      /**
+       * Register a new named scope. The returned index is used to open scopes of that name
+       */
+      auto register_scope(std::string name) -> util::index_t;
+
+      /**
+       * Read back the queries written the last time the frame slot was used and reset them.
+       * Must be called once the fence of the frame slot has been waited upon and before any
+       * scope is opened in the command buffer
+       */
+      void begin_frame(vk::CommandBuffer cmd, std::size_t frame_index);
+
+      auto begin_scope(vk::CommandBuffer cmd, util::index_t scope) -> scope_token;
+      void end_scope(vk::CommandBuffer cmd, const scope_token& token);
+
+      /**
+       * Record a CPU only timing for a scope
+       */
+      void add_cpu_sample(util::index_t scope, float milliseconds);
+
+      [[nodiscard]] auto report() const -> util::dynamic_array<scope_report>;
+      void log_report() const;
+
+      [[nodiscard]] auto is_enabled() const noexcept -> bool;
+
+   private:
+      void resolve(std::size_t frame_index);
+
+      struct timing_history
+      {
+         std::array<float, history_size> samples{};
+         std::size_t head{0};
+         std::size_t count{0};
+
+         void push(float sample) noexcept;
+         [[nodiscard]] auto compute() const noexcept -> timing_stats;
+      };
+
+      struct scope_data
+      {
+         std::string name;
+
+         timing_history gpu;
+         timing_history cpu;
+      };
+
+      struct pending_scope
+      {
+         util::index_t scope;
+         std::uint32_t query;
+      };
+
+      struct frame_data
+      {
+         util::dynamic_array<pending_scope> scopes;
+         std::uint32_t used_query_count{0};
+      };
+
+   private:
+      std::shared_ptr<util::logger> mp_logger;
+
+      vk::Device m_device;
+      vkn::query_pool m_query_pool;
+
+      float m_timestamp_period{1.0F};
+      std::uint64_t m_timestamp_mask{0};
+      std::uint32_t m_queries_per_frame{0};
+
+      std::size_t m_current_frame{0};
+
+      util::dynamic_array<frame_data> m_frames;
+      util::dynamic_array<scope_data> m_scopes;
+      util::dynamic_array<std::uint64_t> m_query_results;
+   };
+
+   /**
+    * RAII helper that opens a profiling scope on construction and closes it on destruction
+    */
+   class gpu_scope
+   {
+   public:
+      gpu_scope(gpu_profiler& profiler, vk::CommandBuffer cmd, util::index_t scope);
+      gpu_scope(const gpu_scope&) = delete;
+      gpu_scope(gpu_scope&&) = delete;
+      ~gpu_scope();
+
+      auto operator=(const gpu_scope&) -> gpu_scope& = delete;
+      auto operator=(gpu_scope&&) -> gpu_scope& = delete;
+
+   private:
+      gpu_profiler& m_profiler;
+      vk::CommandBuffer m_cmd;
+      gpu_profiler::scope_token m_token;
+   };
+} // namespace gfx
+
+namespace std
+{
+   template <>
+   struct is_error_code_enum<gfx::gpu_profiler_error> : true_type
+   {
+   };
+} // namespace std
@@ -9,6 +9,8 @@
 #include <vkn/buffer.hpp>
 #include <vkn/command_pool.hpp>
 
+#include <span>
+
 namespace gfx
 {
    enum struct index_buffer_error
@@ -27,7 +29,10 @@ namespace gfx
    public:
       struct create_info
       {
-         util::dynamic_array<uint32_t> indices;
+         /**
+          * Copied straight into the staging buffer, they may point into a mapped file
+          */
+         std::span<const std::uint32_t> indices;
 
          vkn::device* p_device;
          vkn::command_pool* p_command_pool;
@@ -48,6 +53,8 @@ namespace gfx
       auto index_count() const noexcept -> std::size_t; // NOLINT
 
    private:
+      friend class upload_batch;
+
       vkn::buffer m_buffer;
 
       std::size_t m_index_count;
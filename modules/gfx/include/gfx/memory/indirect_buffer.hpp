@@ -0,0 +1,78 @@
+#pragma once
+
+#include <gfx/commons.hpp>
+
+#include <util/logger.hpp>
+#include <util/strong_type.hpp>
+
+#include <vkn/buffer.hpp>
+
+#include <span>
+
+namespace gfx
+{
+   enum struct indirect_buffer_error
+   {
+      failed_to_create_indirect_buffer
+   };
+
+   auto to_string(indirect_buffer_error err) -> std::string;
+   auto make_error(indirect_buffer_error err) noexcept -> error_t;
+
+   /**
+    * A persistently mapped buffer holding the indexed draw commands written by the CPU for a
+    * frame, consumed by vkCmdDrawIndexedIndirect. The buffer is split in one region per frame in
+    * flight so the CPU may write the commands of a frame while the GPU reads those of the
+    * previous one
+    */
+   class indirect_buffer
+   {
+   public:
+      struct create_info
+      {
+         const vkn::device* p_device;
+
+         util::count32_t capacity{1U << 16U}; // NOLINT
+         util::count32_t frame_count{2};
+
+         std::shared_ptr<util::logger> p_logger;
+      };
+
+      static auto make(create_info&& info) noexcept -> gfx::result<indirect_buffer>;
+
+      /**
+       * Get the mapped region holding the commands of a frame
+       */
+      [[nodiscard]] auto frame_data(std::size_t frame_index) const noexcept
+         -> std::span<vk::DrawIndexedIndirectCommand>;
+      /**
+       * Get the byte offset of the region of a frame, to be added to the offset of the commands
+       * within it
+       */
+      [[nodiscard]] auto frame_offset(std::size_t frame_index) const noexcept -> vk::DeviceSize;
+
+      [[nodiscard]] auto capacity() const noexcept -> std::uint32_t;
+
+      auto operator->() noexcept -> vkn::buffer*;
+      auto operator->() const noexcept -> const vkn::buffer*;
+
+      auto operator*() noexcept -> vkn::buffer&;
+      auto operator*() const noexcept -> const vkn::buffer&;
+
+      auto value() noexcept -> vkn::buffer&;
+      [[nodiscard]] auto value() const noexcept -> const vkn::buffer&;
+
+   private:
+      vkn::buffer m_buffer;
+
+      std::uint32_t m_capacity{0};
+   };
+} // namespace gfx
+
+namespace std
+{
+   template <>
+   struct is_error_code_enum<gfx::indirect_buffer_error> : true_type
+   {
+   };
+} // namespace std
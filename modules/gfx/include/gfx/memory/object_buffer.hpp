@@ -0,0 +1,83 @@
+#pragma once
+
+#include <gfx/commons.hpp>
+#include <gfx/data_types.hpp>
+
+#include <util/logger.hpp>
+#include <util/strong_type.hpp>
+
+#include <vkn/buffer.hpp>
+
+#include <span>
+
+namespace gfx
+{
+   enum struct object_buffer_error
+   {
+      failed_to_create_object_buffer
+   };
+
+   auto to_string(object_buffer_error err) -> std::string;
+   auto make_error(object_buffer_error err) noexcept -> error_t;
+
+   /**
+    * A persistently mapped storage buffer holding the object_data of everything drawn in a
+    * frame, indexed in the shaders by gl_InstanceIndex. The buffer is split in one region per
+    * frame in flight, selected with a dynamic offset, so the CPU may write the objects of a frame
+    * while the GPU reads those of the previous one
+    */
+   class object_buffer
+   {
+   public:
+      struct create_info
+      {
+         const vkn::device* p_device;
+
+         util::count32_t capacity{1U << 16U}; // NOLINT
+         util::count32_t frame_count{2};
+
+         std::shared_ptr<util::logger> p_logger;
+      };
+
+      static auto make(create_info&& info) noexcept -> gfx::result<object_buffer>;
+
+      /**
+       * Get the mapped region holding the objects of a frame
+       */
+      [[nodiscard]] auto frame_data(std::size_t frame_index) const noexcept
+         -> std::span<object_data>;
+      /**
+       * Get the byte offset of the region of a frame, to be used as the dynamic offset
+       */
+      [[nodiscard]] auto frame_offset(std::size_t frame_index) const noexcept -> std::uint32_t;
+      /**
+       * Get the size in bytes of the region of a single frame, including alignment padding
+       */
+      [[nodiscard]] auto frame_size() const noexcept -> vk::DeviceSize;
+
+      [[nodiscard]] auto capacity() const noexcept -> std::uint32_t;
+
+      auto operator->() noexcept -> vkn::buffer*;
+      auto operator->() const noexcept -> const vkn::buffer*;
+
+      auto operator*() noexcept -> vkn::buffer&;
+      auto operator*() const noexcept -> const vkn::buffer&;
+
+      auto value() noexcept -> vkn::buffer&;
+      [[nodiscard]] auto value() const noexcept -> const vkn::buffer&;
+
+   private:
+      vkn::buffer m_buffer;
+
+      std::uint32_t m_capacity{0};
+      vk::DeviceSize m_frame_size{0};
+   };
+} // namespace gfx
+
+namespace std
+{
+   template <>
+   struct is_error_code_enum<gfx::object_buffer_error> : true_type
+   {
+   };
+} // namespace std
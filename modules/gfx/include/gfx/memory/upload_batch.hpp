@@ -0,0 +1,107 @@
+#pragma once
+
+#include <gfx/commons.hpp>
+#include <gfx/data_types.hpp>
+#include <gfx/memory/index_buffer.hpp>
+#include <gfx/memory/vertex_buffer.hpp>
+#include <gfx/vertex_layout.hpp>
+
+#include <util/containers/dynamic_array.hpp>
+#include <util/logger.hpp>
+
+#include <vkn/buffer.hpp>
+#include <vkn/command_pool.hpp>
+
+#include <span>
+
+namespace gfx
+{
+   enum struct upload_batch_error
+   {
+      failed_to_create_staging_buffer,
+      failed_to_create_buffer,
+      out_of_staging_memory
+   };
+
+   auto to_string(upload_batch_error err) -> std::string;
+   auto make_error(upload_batch_error err) noexcept -> error_t;
+
+   /**
+    * Uploads many vertex & index buffers through a single staging buffer and a single
+    * submission, instead of one staging buffer, submission and queue wait per buffer as
+    * vertex_buffer::make and index_buffer::make do
+    */
+   class upload_batch
+   {
+   public:
+      struct create_info
+      {
+         /**
+          * The size of the staging buffer: the total size of the data staged before a submit
+          */
+         vk::DeviceSize capacity{0};
+
+         vkn::device* p_device;
+         vkn::command_pool* p_command_pool;
+         std::shared_ptr<util::logger> p_logger;
+      };
+
+      static auto make(create_info&& info) noexcept -> gfx::result<upload_batch>;
+
+      /**
+       * Pack the vertices in the layout straight into the staging buffer and create the buffer
+       * they are uploaded to. The buffer may only be used once the batch is submitted
+       */
+      auto stage(std::span<const vertex> vertices,
+                 vertex_layout layout = vertex_layout::position_colour)
+         -> gfx::result<vertex_buffer>;
+      /**
+       * Copy the indices into the staging buffer and create the buffer they are uploaded to.
+       * The buffer may only be used once the batch is submitted
+       */
+      auto stage(std::span<const std::uint32_t> indices) -> gfx::result<index_buffer>;
+
+      /**
+       * Record the copies of every staged buffer in one command buffer and wait for their
+       * completion. The staging buffer may then be reused for another batch
+       */
+      auto submit() -> bool;
+
+      [[nodiscard]] auto staged_size() const noexcept -> vk::DeviceSize;
+
+   private:
+      struct copy
+      {
+         vk::Buffer destination;
+         vk::DeviceSize offset;
+         vk::DeviceSize size;
+      };
+
+      /**
+       * Reserve a range of the staging buffer & create the device local buffer it will be copied
+       * to. The range is the one of the last copy until the next allocation
+       */
+      auto allocate(vk::DeviceSize size, vk::BufferUsageFlags usage) -> gfx::result<vkn::buffer>;
+      auto last_staging_range() noexcept -> std::span<std::byte>;
+
+   private:
+      vkn::device* mp_device{nullptr};
+      vkn::command_pool* mp_command_pool{nullptr};
+
+      vkn::buffer m_staging_buffer;
+      vk::DeviceSize m_capacity{0};
+      vk::DeviceSize m_staged_size{0};
+
+      util::dynamic_array<copy> m_copies;
+
+      std::shared_ptr<util::logger> mp_logger;
+   };
+} // namespace gfx
+
+namespace std
+{
+   template <>
+   struct is_error_code_enum<gfx::upload_batch_error> : true_type
+   {
+   };
+} // namespace std
@@ -2,6 +2,7 @@
 
 #include <gfx/commons.hpp>
 #include <gfx/data_types.hpp>
+#include <gfx/vertex_layout.hpp>
 
 #include <util/containers/dynamic_array.hpp>
 #include <util/logger.hpp>
@@ -9,6 +10,8 @@
 #include <vkn/buffer.hpp>
 #include <vkn/command_pool.hpp>
 
+#include <span>
+
 namespace gfx
 {
    enum struct vertex_buffer_error
@@ -27,7 +30,16 @@ namespace gfx
    public:
       struct make_info
       {
-         util::dynamic_array<vertex> vertices;
+         /**
+          * Packed in the layout while copied into the staging buffer
+          */
+         std::span<const vertex> vertices{};
+         /**
+          * Vertices already packed in the layout, used as they are when no vertices are given.
+          * Copied straight into the staging buffer, they may point into a mapped file
+          */
+         std::span<const std::byte> packed_vertices{};
+         vertex_layout layout{vertex_layout::position_colour};
 
          vkn::device* p_device;
          vkn::command_pool* p_command_pool;
@@ -46,6 +58,8 @@ namespace gfx
       [[nodiscard]] auto value() const noexcept -> const vkn::buffer&;
 
    private:
+      friend class upload_batch;
+
       vkn::buffer m_buffer;
    };
 } // namespace gfx
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <gfx/bvh.hpp>
+#include <gfx/commons.hpp>
+#include <gfx/data_types.hpp>
+#include <gfx/vertex_layout.hpp>
+
+#include <util/mapped_file.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace gfx
+{
+   enum struct mesh_file_error
+   {
+      failed_to_map_file,
+      invalid_magic,
+      unsupported_version,
+      unsupported_vertex_layout,
+      truncated_data,
+      invalid_index
+   };
+
+   auto to_string(mesh_file_error err) -> std::string;
+   auto make_error(mesh_file_error err) noexcept -> error_t;
+
+   /**
+    * A mesh stored in the engine's binary format, memory mapped and never parsed: the vertices,
+    * indices & levels of detail are views into the mapping, meant to be copied straight into a
+    * staging buffer. The vertices are stored packed in any of the vertex layouts. Opening a file
+    * only validates it, every index must refer to one of its vertices.
+    *
+    * The file is a fixed size header holding the counts, the bounds, the vertex layout and the
+    * offsets of the payloads, followed by the LOD table, the vertices & the indices, each
+    * aligned to mesh_file::alignment
+    */
+   class mesh_file
+   {
+   public:
+      static constexpr std::size_t alignment = 16;
+      static constexpr std::uint32_t version = 1;
+
+      static auto open(const std::filesystem::path& path) -> gfx::result<mesh_file>;
+
+      [[nodiscard]] auto layout() const noexcept -> vertex_layout;
+      [[nodiscard]] auto bounds() const noexcept -> const aabb&;
+
+      [[nodiscard]] auto vertex_count() const noexcept -> std::size_t;
+      /**
+       * The vertices packed in the mesh's layout
+       */
+      [[nodiscard]] auto vertex_data() const noexcept -> std::span<const std::byte>;
+      /**
+       * The vertices as gfx::vertex, empty unless the layout is vertex_layout::position_colour
+       */
+      [[nodiscard]] auto vertices() const noexcept -> std::span<const vertex>;
+      [[nodiscard]] auto indices() const noexcept -> std::span<const std::uint32_t>;
+      /**
+       * The levels of detail, from the most detailed down. There is always at least one
+       */
+      [[nodiscard]] auto lods() const noexcept -> std::span<const mesh_lod>;
+
+   private:
+      util::mapped_file m_file;
+
+      vertex_layout m_layout{vertex_layout::position_colour};
+      aabb m_bounds;
+
+      std::size_t m_vertex_count{0};
+      std::span<const std::byte> m_vertex_data;
+      std::span<const vertex> m_vertices;
+      std::span<const std::uint32_t> m_indices;
+      std::span<const mesh_lod> m_lods;
+   };
+
+   /**
+    * Write a mesh in the format read by mesh_file, its vertices packed in the layout. Without
+    * LODs, a single level covering every index is written. Returns false if the file cannot be
+    * written
+    */
+   auto write_mesh_file(const std::filesystem::path& path, std::span<const vertex> vertices,
+                        std::span<const std::uint32_t> indices, std::span<const mesh_lod> lods = {},
+                        vertex_layout layout = vertex_layout::position_colour) -> bool;
+} // namespace gfx
+
+namespace std
+{
+   template <>
+   struct is_error_code_enum<gfx::mesh_file_error> : true_type
+   {
+   };
+} // namespace std
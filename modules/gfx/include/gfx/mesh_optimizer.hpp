@@ -0,0 +1,120 @@
+#pragma once
+
+#include <gfx/data_types.hpp>
+
+#include <util/containers/dynamic_array.hpp>
+
+#include <cstdint>
+#include <span>
+
+namespace gfx
+{
+   struct mesh_optimizer_options
+   {
+      /**
+       * The number of entries of the simulated post-transform vertex cache
+       */
+      std::uint32_t cache_size{16};
+
+      bool optimize_overdraw{true};
+      /**
+       * How much worse than the cache optimised order the overdraw optimised order may make the
+       * average cache miss ratio. Higher values allow more, smaller clusters to be sorted
+       */
+      float overdraw_threshold{1.05F};
+   };
+
+   struct mesh_lod_options
+   {
+      /**
+       * The most levels in a chain, the full detail one included
+       */
+      std::uint32_t max_lod_count{5};
+      /**
+       * The fraction of the previous level's triangles each level aims for
+       */
+      float reduction{0.5F};
+      /**
+       * The largest error a level may introduce, relative to the radius of the mesh
+       */
+      float max_error{0.05F};
+      /**
+       * Levels are not generated below this number of triangles
+       */
+      std::uint32_t min_triangle_count{32};
+
+      std::uint32_t cache_size{16};
+   };
+
+   struct simplified_mesh
+   {
+      util::dynamic_array<std::uint32_t> indices{};
+      /**
+       * The object space distance the simplified surface may be from the original one
+       */
+      float error{0.0F};
+   };
+
+   /**
+    * Merge the vertices whose bytes are identical, using a hash table, and remap the indices
+    * to the vertices left
+    */
+   void deduplicate_vertices(util::dynamic_array<vertex>& vertices,
+                             std::span<std::uint32_t> indices);
+
+   /**
+    * Reorder the triangles for the post-transform vertex cache with Tipsify (Sander, Nehab &
+    * Barczak, 2007): triangles are emitted in fans around vertices chosen to still be in the
+    * cache when their remaining triangles are reached
+    */
+   void optimize_vertex_cache(std::span<std::uint32_t> indices, std::size_t vertex_count,
+                              std::uint32_t cache_size = 16);
+
+   /**
+    * Reorder clusters of an index list already optimised for the vertex cache so triangles
+    * facing away from the centre of the mesh are drawn first, letting them occlude the rest.
+    * Clusters are cut where it raises the cache miss ratio by less than the threshold
+    */
+   void optimize_overdraw(std::span<std::uint32_t> indices, std::span<const vertex> vertices,
+                          std::uint32_t cache_size = 16, float threshold = 1.05F);
+
+   /**
+    * Reorder the vertices in the order the indices first reference them so the vertex fetches
+    * stream through memory. Vertices no index references are removed
+    */
+   void optimize_vertex_fetch(util::dynamic_array<vertex>& vertices,
+                              std::span<std::uint32_t> indices);
+
+   /**
+    * Get the average number of vertices transformed per triangle (ACMR) when drawing the
+    * indices through a FIFO cache of the given size. 3 is the worst, 0.5 the best on large
+    * regular meshes
+    */
+   auto analyze_vertex_cache(std::span<const std::uint32_t> indices, std::size_t vertex_count,
+                             std::uint32_t cache_size = 16) -> float;
+
+   /**
+    * Simplify a mesh down to the target number of indices with quadric edge collapses (Garland &
+    * Heckbert, 1997), stopping early once a collapse would exceed the target error. Vertices
+    * only collapse onto other vertices, so the result indexes the same vertex array. Vertices
+    * on borders and attribute seams are never moved
+    */
+   auto simplify_mesh(std::span<const std::uint32_t> indices, std::span<const vertex> vertices,
+                      std::size_t target_index_count, float target_error) -> simplified_mesh;
+
+   /**
+    * Append a chain of simplified levels of detail to the indices, each optimised for the
+    * vertex cache, and return the ranges of every level. The first level covers the indices
+    * given. The chain ends early when a level no longer removes enough triangles
+    */
+   auto build_lod_chain(util::dynamic_array<std::uint32_t>& indices,
+                        std::span<const vertex> vertices, const mesh_lod_options& options = {})
+      -> util::dynamic_array<mesh_lod>;
+
+   /**
+    * Run every pass in order: deduplication, vertex cache, overdraw and vertex fetch
+    */
+   void optimize_mesh(util::dynamic_array<vertex>& vertices,
+                      util::dynamic_array<std::uint32_t>& indices,
+                      const mesh_optimizer_options& options = {});
+} // namespace gfx
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <gfx/culling.hpp>
+#include <gfx/data_types.hpp>
+
+#include <util/containers/dynamic_array.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+
+namespace gfx
+{
+   static constexpr std::size_t max_meshlet_vertices = 64;
+   static constexpr std::size_t max_meshlet_triangles = 124;
+
+   /**
+    * A cluster of triangles drawn from a contiguous range of its mesh's index buffer
+    */
+   struct meshlet
+   {
+      std::uint32_t first_index{0};
+      std::uint32_t index_count{0};
+      std::uint32_t vertex_count{0};
+
+      bounding_sphere bounds{};
+      /**
+       * The cone holding the normals of every triangle of the meshlet. The meshlet faces away
+       * from any viewpoint v for which
+       *    dot(bounds.center - v, cone_axis) >= cone_cutoff * length(bounds.center - v) +
+       *    bounds.radius
+       * A cutoff of 1 or more means the meshlet is never backfacing
+       */
+      glm::vec3 cone_axis{0.0F};
+      float cone_cutoff{1.0F};
+   };
+
+   /**
+    * Split a triangle list in meshlets of at most max_vertices distinct vertices and
+    * max_triangles triangles. Triangles are scanned in order, so an index list already optimised
+    * for the vertex cache yields compact meshlets without being reordered
+    */
+   auto build_meshlets(std::span<const std::uint32_t> indices, std::span<const vertex> vertices,
+                       std::size_t max_vertices = max_meshlet_vertices,
+                       std::size_t max_triangles = max_meshlet_triangles)
+      -> util::dynamic_array<meshlet>;
+
+   /**
+    * The bounds & normal cones of meshlets laid out as a structure of arrays so they may be
+    * culled several at a time
+    */
+   struct meshlet_soa
+   {
+      sphere_soa spheres;
+      util::dynamic_array<float> axis_x;
+      util::dynamic_array<float> axis_y;
+      util::dynamic_array<float> axis_z;
+      util::dynamic_array<float> cutoff;
+
+      void push_back(const meshlet& m);
+      void clear() noexcept;
+
+      [[nodiscard]] auto size() const noexcept -> std::size_t;
+   };
+
+   /**
+    * Append the index of every meshlet intersecting the frustum and facing the camera to
+    * visible. The frustum & the camera position must be in the meshlets' object space. Uses SSE
+    * when the module is compiled with support for it, a scalar loop otherwise
+    */
+   void cull_meshlets(const frustum& frustum, const glm::vec3& camera_position,
+                      const meshlet_soa& meshlets, util::dynamic_array<std::uint32_t>& visible);
+
+   namespace detail
+   {
+      void cull_meshlets_scalar(const frustum& frustum, const glm::vec3& camera_position,
+                                const meshlet_soa& meshlets, std::size_t first,
+                                util::dynamic_array<std::uint32_t>& visible);
+#if defined(__SSE2__) || defined(_M_X64)
+      void cull_meshlets_sse(const frustum& frustum, const glm::vec3& camera_position,
+                             const meshlet_soa& meshlets,
+                             util::dynamic_array<std::uint32_t>& visible);
+#endif
+   } // namespace detail
+} // namespace gfx
@@ -1,17 +1,33 @@
 #pragma once
 
+#include <gfx/bindless_table.hpp>
+#include <gfx/bvh.hpp>
+#include <gfx/command_recorder.hpp>
 #include <gfx/context.hpp>
+#include <gfx/culling.hpp>
 #include <gfx/data_types.hpp>
+#include <gfx/draw_queue.hpp>
+#include <gfx/gltf.hpp>
+#include <gfx/gpu_profiler.hpp>
 #include <gfx/memory/camera_buffer.hpp>
 #include <gfx/memory/index_buffer.hpp>
+#include <gfx/memory/indirect_buffer.hpp>
+#include <gfx/memory/object_buffer.hpp>
+#include <gfx/memory/upload_batch.hpp>
 #include <gfx/memory/vertex_buffer.hpp>
+#include <gfx/mesh_file.hpp>
+#include <gfx/meshlet.hpp>
 #include <gfx/render_pass.hpp>
+#include <gfx/texture_cache.hpp>
+#include <gfx/vertex_layout.hpp>
 #include <gfx/window.hpp>
 
 #include <core/shader_codex.hpp>
 
+#include <util/thread_pool.hpp>
+
 #include <vkn/command_pool.hpp>
-#include <vkn/descriptor_pool.hpp>
+#include <vkn/descriptor_cache.hpp>
 #include <vkn/device.hpp>
 #include <vkn/framebuffer.hpp>
 #include <vkn/pipeline.hpp>
@@ -24,16 +40,96 @@ namespace gfx
 {
    class render_manager
    {
+   public:
       static constexpr std::size_t max_frames_in_flight = 2;
 
+   private:
+      /**
+       * Number of renderables from which culling goes through the BVH instead of a flat loop
+       */
+      static constexpr std::size_t bvh_culling_threshold = 1024;
+
+      /**
+       * Largest staging buffer used to upload a scene, larger scenes are uploaded in batches
+       */
+      static constexpr vk::DeviceSize max_scene_upload_size = 64 * 1024 * 1024;
+
+      /**
+       * Largest error in pixels a level of detail may show on screen to be drawn
+       */
+      static constexpr float lod_error_threshold = 1.0F;
+
+      static constexpr float camera_near_plane = 0.1F;
+      static constexpr float camera_far_plane = 10.0F;
+
       using framebuffer_array =
          util::small_dynamic_array<vkn::framebuffer, vkn::expected_image_count.value()>;
 
    public:
-      render_manager(const context& ctx, const window& wnd, std::shared_ptr<util::logger> p_logger);
+      /**
+       * The vertex layout is the one every vertex buffer is uploaded in and the pipeline reads
+       */
+      render_manager(const context& ctx, const window& wnd, std::shared_ptr<util::logger> p_logger,
+                     vertex_layout layout = vertex_layout::position_colour);
+
+      /**
+       * Upload a renderable's data and return the handle used to refer to it afterwards
+       */
+      auto subscribe_renderable(const std::string& name, const renderable_data& r)
+         -> std::optional<renderable_handle>;
+      /**
+       * Upload a mesh file with every one of its levels of detail, copying its mapped vertices
+       * and indices straight into the staging buffers. Its bounds are taken from the file's
+       * header. Vertices stored in another layout than the render manager's are repacked when
+       * possible
+       */
+      auto subscribe_mesh(const std::string& name, const mesh_file& mesh, const glm::mat4& model)
+         -> std::optional<renderable_handle>;
+      /**
+       * Remove a renderable. Its GPU buffers are kept alive until the frames using them are done
+       */
+      auto unsubscribe_renderable(renderable_handle handle) -> bool;
+      void update_model_matrix(renderable_handle handle, const glm::mat4& model);
+
+      /**
+       * Upload a mesh drawn at every one of its instance transforms with a single instanced draw
+       */
+      auto subscribe_instanced_renderable(const std::string& name,
+                                          const instanced_renderable_data& r)
+         -> std::optional<renderable_handle>;
+      auto unsubscribe_instanced_renderable(renderable_handle handle) -> bool;
+      /**
+       * Replace the instance transforms of an instanced renderable
+       */
+      void update_instances(renderable_handle handle, std::span<const glm::mat4> transforms);
+
+      /**
+       * Upload every mesh of an imported scene through one staging buffer and one submission.
+       * Meshes placed once become renderables, meshes placed several times become instanced
+       * renderables drawing all their placements
+       */
+      auto subscribe_scene(const gltf_scene& scene) -> std::optional<scene_handles>;
+      /**
+       * Import a glTF file on the render manager's thread pool and subscribe its scene
+       */
+      auto load_scene(const std::filesystem::path& path) -> std::optional<scene_handles>;
 
-      auto subscribe_renderable(const std::string& name, const renderable_data& r) -> bool;
-      void update_model_matrix(const std::string& name, const glm::mat4& model);
+      /**
+       * Find the closest renderable whose bounds are hit by the ray
+       */
+      [[nodiscard]] auto pick_renderable(const glm::vec3& origin, const glm::vec3& direction) const
+         -> std::optional<renderable_handle>;
+
+      /**
+       * Start loading a texture in the background. It may be sampled once it is resident
+       */
+      auto load_texture(const std::filesystem::path& path) -> texture_handle;
+      void release_texture(texture_handle handle);
+      /**
+       * Mount a pack of cooked textures, see texture_cache::mount
+       */
+      auto mount_texture_pack(const std::filesystem::path& path) -> bool;
+      [[nodiscard]] auto textures() const noexcept -> const texture_cache&;
 
       void bake();
 
@@ -44,9 +140,69 @@ namespace gfx
        */
       void wait();
 
+      /**
+       * Get the profiler holding the GPU & CPU timings of the previous frames. Besides the GPU
+       * scopes, render_frame samples the CPU time of each of its phases: fence_wait, acquire,
+       * prepare (culling & object streaming), record, submit and present, along with cpu_frame
+       * spanning all of them but the fence wait
+       */
+      [[nodiscard]] auto profiler() const noexcept -> const gpu_profiler&;
+      /**
+       * Get the logical device everything is rendered with
+       */
+      [[nodiscard]] auto device() const noexcept -> const vkn::device&;
+
    private:
+      /**
+       * Upload the vertices & indices of a renderable whose local bounds are already known
+       */
+      auto subscribe_renderable(const std::string& name, std::span<const vertex> vertices,
+                                std::span<const std::uint32_t> indices,
+                                const bounding_sphere& local_bounds, const glm::mat4& model,
+                                std::span<const mesh_lod> lods = {})
+         -> std::optional<renderable_handle>;
+      /**
+       * Store a renderable whose buffers are already uploaded. Without levels of detail, the
+       * whole index buffer is drawn. With meshlets, its full detail level is drawn by clusters
+       */
+      auto insert_renderable(const std::string& name, vertex_buffer&& vertices,
+                             index_buffer&& indices, const bounding_sphere& local_bounds,
+                             const glm::mat4& model, std::span<const mesh_lod> lods = {},
+                             std::span<const meshlet> meshlets = {}) -> renderable_handle;
+      auto insert_instanced_renderable(const std::string& name, vertex_buffer&& vertices,
+                                       index_buffer&& indices,
+                                       const bounding_sphere& local_bounds,
+                                       std::span<const glm::mat4> transforms,
+                                       std::span<const mesh_lod> lods = {})
+         -> renderable_handle;
+
       auto add_pass(const std::string& name, vkn::queue::type queue_type) -> render_pass&;
-      void update_camera(uint32_t image_index);
+      [[nodiscard]] auto compute_camera_matrices() const noexcept -> camera_matrices;
+      void update_camera(uint32_t image_index, const camera_matrices& matrices);
+      /**
+       * Cull the renderables and select the level of detail of the visible ones from their
+       * projected size
+       */
+      void cull_renderables(const camera_matrices& matrices);
+      void queue_draws(const camera_matrices& matrices);
+      /**
+       * Write the per object data of the queued draws & visible instances to the object buffer
+       */
+      void stream_objects(const camera_matrices& matrices);
+      /**
+       * Cull the meshlets of the queued draws drawn by clusters, writing the surviving ones to
+       * the indirect buffer
+       */
+      void cull_clusters(const camera_matrices& matrices);
+      void record_draws(command_recorder& recorder, std::uint32_t image_index);
+      /**
+       * Bind the pipeline and the descriptors shared by every draw of the frame
+       */
+      void bind_frame_resources(command_recorder& recorder, std::uint32_t image_index);
+      /**
+       * Keep buffers alive until the frames that may still be reading from them are done
+       */
+      void retire_buffers(vertex_buffer& vertices, index_buffer& indices);
 
       auto create_physical_device() const noexcept -> vkn::physical_device;
       auto create_logical_device() const noexcept -> vkn::device;
@@ -55,8 +211,18 @@ namespace gfx
       auto create_swapchain_framebuffers() const noexcept -> framebuffer_array;
       auto create_shader_codex() const noexcept -> core::shader_codex;
 
-      auto create_camera_descriptor_pool() const noexcept -> vkn::descriptor_pool;
+      auto create_bindless_table() const noexcept -> std::optional<bindless_table>;
+      auto create_descriptor_cache() const noexcept -> vkn::descriptor_cache;
+      auto create_texture_cache() noexcept -> texture_cache;
       auto create_camera_buffers() const noexcept -> util::dynamic_array<gfx::camera_buffer>;
+      auto create_object_buffer() const noexcept -> object_buffer;
+      auto create_indirect_buffer() const noexcept -> indirect_buffer;
+
+      /**
+       * Get the cached set of a pipeline layout holding the given descriptors
+       */
+      auto get_descriptor_set(const std::string& layout_name,
+                              std::span<const vkn::descriptor_write> writes) -> vk::DescriptorSet;
 
       auto create_command_pool() const noexcept
          -> std::array<vkn::command_pool, max_frames_in_flight>;
@@ -65,6 +231,7 @@ namespace gfx
       auto create_image_available_semaphores() const noexcept
          -> std::array<vkn::semaphore, max_frames_in_flight>;
       auto create_in_flight_fences() const noexcept -> std::array<vkn::fence, max_frames_in_flight>;
+      auto create_gpu_profiler() const noexcept -> gpu_profiler;
 
    private:
       struct renderable
@@ -72,6 +239,42 @@ namespace gfx
          std::string name;
          vertex_buffer vertex_buffer;
          index_buffer index_buffer;
+
+         bounding_sphere local_bounds;
+         std::uint32_t bvh_proxy;
+
+         util::dynamic_array<mesh_lod> lods;
+
+         util::dynamic_array<meshlet> meshlets;
+         meshlet_soa meshlet_bounds;
+      };
+
+      /**
+       * The range of the indirect buffer holding the commands of a draw drawn by clusters, or of
+       * m_direct_cluster_commands when they are recorded as direct draws
+       */
+      struct cluster_draw
+      {
+         bool is_clustered{false};
+         std::uint32_t first_command{0};
+         std::uint32_t command_count{0};
+      };
+
+      struct instanced_renderable
+      {
+         std::string name;
+         vertex_buffer vertex_buffer;
+         index_buffer index_buffer;
+
+         bounding_sphere local_bounds;
+         util::dynamic_array<glm::mat4> transforms;
+
+         util::dynamic_array<mesh_lod> lods;
+
+         // Range of the object buffer written for the current frame
+         std::uint32_t first_instance{0};
+         std::uint32_t visible_count{0};
+         std::uint32_t lod{0};
       };
 
       std::shared_ptr<util::logger> mp_logger;
@@ -79,6 +282,8 @@ namespace gfx
       const context& m_ctx;
       const window& m_wnd;
 
+      vertex_layout m_vertex_layout{vertex_layout::position_colour};
+
       vkn::device m_device;
       vkn::swapchain m_swapchain;
       vkn::render_pass m_swapchain_render_pass;
@@ -86,7 +291,18 @@ namespace gfx
 
       vkn::graphics_pipeline m_graphics_pipeline;
 
-      vkn::descriptor_pool m_camera_descriptor_pool; // Should be recreated with swapchain
+      // Sets written once and shared by every frame
+      vkn::descriptor_cache m_descriptor_cache;
+
+      util::small_dynamic_array<vk::DescriptorSet, vkn::expected_image_count.value()>
+         m_camera_descriptor_sets; // Should be recreated with swapchain
+      vk::DescriptorSet m_object_descriptor_set{};
+
+      // Used instead of the sets above when the device supports descriptor indexing
+      std::optional<bindless_table> m_bindless_table;
+      util::small_dynamic_array<std::uint32_t, vkn::expected_image_count.value()>
+         m_camera_indices;
+      std::array<std::uint32_t, max_frames_in_flight> m_object_indices{};
 
       util::small_dynamic_array<vkn::semaphore, vkn::expected_image_count.value()>
          m_render_finished_semaphores;
@@ -99,14 +315,59 @@ namespace gfx
 
       core::shader_codex m_shader_codex;
 
+      // Decodes textures, must outlive the texture cache
+      util::thread_pool m_thread_pool;
+      texture_cache m_texture_cache;
+
+      gpu_profiler m_gpu_profiler;
+
+      struct profiling_scopes
+      {
+         util::index_t main_pass;
+         util::index_t renderables;
+         util::index_t cpu_frame;
+         util::index_t fence_wait;
+
+         // CPU only timings of the phases of render_frame following the fence wait
+         util::index_t acquire;
+         util::index_t prepare;
+         util::index_t record;
+         util::index_t submit;
+         util::index_t present;
+      } m_profiling_scopes;
+
       util::dynamic_array<render_pass> m_render_passes;
       std::unordered_map<std::string, util::index_t> m_render_pass_to_index;
 
       std::size_t m_current_frame{0};
 
-      std::unordered_map<std::string, std::uint32_t> m_renderables_to_index;
-      util::dynamic_array<renderable> m_renderables;
+      // The model matrices & world bounds are kept parallel to the dense storage of the slot map
+      util::slot_map<renderable> m_renderables;
       util::dynamic_array<glm::mat4> m_renderable_model_matrices;
+      sphere_soa m_renderable_world_bounds;
+      bvh m_renderable_bvh;
+
+      util::slot_map<instanced_renderable> m_instanced_renderables;
+      object_buffer m_object_buffer;
+      std::uint32_t m_queued_object_count{0};
+
+      indirect_buffer m_indirect_buffer;
+      // Parallel to the queued draws
+      util::dynamic_array<cluster_draw> m_cluster_draws;
+      util::dynamic_array<std::uint32_t> m_visible_meshlets;
+      // The cluster commands when the device can't draw indirect commands with a first instance,
+      // recorded as direct draws instead
+      util::dynamic_array<vk::DrawIndexedIndirectCommand> m_direct_cluster_commands;
+      bool m_is_multi_draw_indirect{false};
+      bool m_is_indirect_first_instance{false};
+
+      std::array<util::dynamic_array<vkn::buffer>, max_frames_in_flight> m_retired_buffers;
+
+      util::dynamic_array<std::uint32_t> m_visible_renderables;
+      // Parallel to the visible renderables
+      util::dynamic_array<float> m_visible_projected_radii;
+      util::dynamic_array<std::uint32_t> m_visible_lods;
+      draw_queue m_draw_queue;
 
       util::dynamic_array<gfx::camera_buffer> m_camera_buffers;
    };
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <gfx/block_compression.hpp>
+#include <gfx/commons.hpp>
+
+#include <util/asset_pack.hpp>
+#include <util/containers/dynamic_array.hpp>
+#include <util/containers/slot_map.hpp>
+#include <util/logger.hpp>
+#include <util/mapped_file.hpp>
+#include <util/thread_pool.hpp>
+
+#include <vkn/buffer.hpp>
+#include <vkn/command_pool.hpp>
+#include <vkn/device.hpp>
+#include <vkn/image.hpp>
+#include <vkn/image_view.hpp>
+#include <vkn/sampler.hpp>
+#include <vkn/sync/fence.hpp>
+
+#include <array>
+#include <filesystem>
+#include <future>
+#include <optional>
+#include <unordered_map>
+
+namespace gfx
+{
+   using texture_handle = util::slot_key;
+
+   enum struct texture_cache_error
+   {
+      failed_to_find_a_suitable_queue,
+      failed_to_create_command_pool,
+      failed_to_create_sampler
+   };
+
+   auto to_string(texture_cache_error err) -> std::string;
+   auto make_error(texture_cache_error err) noexcept -> error_t;
+
+   enum struct texture_state
+   {
+      decoding,
+      uploading,
+      resident,
+      failed
+   };
+
+   /**
+    * Loads textures from disk without stalling the caller. Files are decoded on worker threads,
+    * then every decoded texture of an update is copied to the GPU through one staging buffer and
+    * one command buffer which also generates the mip chains. Textures are keyed by path and
+    * reference counted; released textures are destroyed once the frames using them are done.
+    *
+    * DDS files are memory mapped and their block compressed mips copied as they are. When the
+    * device cannot sample their format, they are decompressed to RGBA8 on the worker instead.
+    * Textures cooked into a mounted asset pack are read from the pack rather than the source file
+    */
+   class texture_cache
+   {
+   public:
+      struct create_info
+      {
+         const vkn::device* p_device;
+         util::thread_pool* p_thread_pool;
+
+         /**
+          * Number of updates a released texture is kept alive for
+          */
+         std::uint32_t frames_in_flight{2};
+
+         std::shared_ptr<util::logger> p_logger;
+      };
+
+      static auto make(create_info&& info) noexcept -> gfx::result<texture_cache>;
+
+      /**
+       * Get the texture stored at the path, queuing its decoding if it isn't cached yet. Every
+       * call must be matched by a call to release
+       */
+      auto load(const std::filesystem::path& path) -> texture_handle;
+      void release(texture_handle handle);
+
+      /**
+       * Add a pack of cooked DDS textures, keyed by the path of their source image. Packs
+       * mounted last take precedence. Returns false if the pack can't be opened
+       */
+      auto mount(const std::filesystem::path& pack_path) -> bool;
+
+      /**
+       * Advance the loading of the textures. Expected to be called once per frame, after the
+       * frame's fence wait
+       */
+      void update();
+
+      [[nodiscard]] auto state(texture_handle handle) const -> std::optional<texture_state>;
+      /**
+       * Get the view of a texture, or a null handle if the texture isn't resident yet
+       */
+      [[nodiscard]] auto view(texture_handle handle) const -> vk::ImageView;
+      [[nodiscard]] auto sampler() const noexcept -> vk::Sampler;
+
+      [[nodiscard]] auto size() const noexcept -> std::size_t;
+      /**
+       * Get the device memory used by the resident textures
+       */
+      [[nodiscard]] auto resident_bytes() const noexcept -> vk::DeviceSize;
+
+   private:
+      struct pixel_deleter
+      {
+         void operator()(std::byte* p_pixels) const noexcept;
+      };
+
+      struct mip_level
+      {
+         vk::Extent2D extent;
+         std::span<const std::byte> data;
+      };
+
+      struct decoded_image
+      {
+         vk::Format format{vk::Format::eUndefined};
+         /**
+          * The levels stored in the file, from the largest down. The rest of the chain is
+          * generated on the GPU if the format allows it
+          */
+         util::small_dynamic_array<mip_level, 16> mips{};
+
+         // Owners of the memory the mips point into, depending on where the image came from
+         std::unique_ptr<std::byte, pixel_deleter> p_pixels;
+         util::mapped_file file;
+         std::shared_ptr<const util::asset_pack> p_pack;
+         util::dynamic_array<std::byte> decompressed{};
+      };
+
+      using format_support = std::array<bool, texel_format_count>;
+
+      struct texture
+      {
+         std::string path;
+         std::uint32_t ref_count{1};
+
+         texture_state state{texture_state::decoding};
+         std::future<std::optional<decoded_image>> decoding;
+
+         vkn::image image;
+         vkn::image_view view;
+      };
+
+      struct upload
+      {
+         vkn::fence fence;
+         vk::UniqueCommandBuffer command_buffer;
+         vkn::buffer staging_buffer;
+
+         util::dynamic_array<texture_handle> textures;
+      };
+
+      struct retired_texture
+      {
+         vkn::image image;
+         vkn::image_view view;
+
+         std::uint32_t remaining_updates{0};
+      };
+
+      struct staged_texture
+      {
+         texture_handle handle;
+         util::small_dynamic_array<vk::DeviceSize, 16> mip_offsets{};
+      };
+
+      static auto decode_image(const std::string& path) -> std::optional<decoded_image>;
+      static auto load_dds(const std::string& path, const format_support& supported_formats)
+         -> std::optional<decoded_image>;
+      /**
+       * Parse the content of a DDS file, decompressing it if its format isn't in the supported
+       * formats. The mips may point into the bytes, whose owner must be set by the caller
+       */
+      static auto decode_dds(std::span<const std::byte> bytes,
+                             const format_support& supported_formats)
+         -> std::optional<decoded_image>;
+
+      /**
+       * Move the textures whose decoding is done to the uploading state and record their copy
+       */
+      void upload_decoded();
+      void record_upload(vk::CommandBuffer cmd, const vkn::buffer& staging_buffer,
+                         std::span<const staged_texture> textures) const;
+      void complete_uploads();
+      void destroy_retired();
+
+      /**
+       * Create the image of a decoded texture, with room for a full mip chain if the file
+       * doesn't provide one and the chain can be blitted
+       */
+      [[nodiscard]] auto create_image(const decoded_image& decoded) const
+         -> std::optional<std::pair<vkn::image, vkn::image_view>>;
+
+   private:
+      const vkn::device* mp_device{nullptr};
+      util::thread_pool* mp_thread_pool{nullptr};
+
+      vk::Queue m_queue;
+      vkn::command_pool m_command_pool;
+      vkn::sampler m_sampler;
+
+      // The texel formats the device can sample, in both colour spaces where they exist
+      format_support m_supported_formats{};
+      std::uint32_t m_frames_in_flight{2};
+
+      util::dynamic_array<std::shared_ptr<const util::asset_pack>> m_packs;
+
+      util::slot_map<texture> m_textures;
+      std::unordered_map<std::string, texture_handle> m_path_to_handle;
+
+      util::dynamic_array<upload> m_uploads;
+      util::dynamic_array<retired_texture> m_retired;
+
+      vk::DeviceSize m_resident_bytes{0};
+
+      std::shared_ptr<util::logger> mp_logger;
+   };
+} // namespace gfx
+
+namespace std
+{
+   template <>
+   struct is_error_code_enum<gfx::texture_cache_error> : true_type
+   {
+   };
+} // namespace std
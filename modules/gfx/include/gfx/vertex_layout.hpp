@@ -0,0 +1,74 @@
+#pragma once
+
+#include <gfx/data_types.hpp>
+
+#include <util/containers/dynamic_array.hpp>
+
+#include <vkn/core.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace gfx
+{
+   /**
+    * The layouts vertices may be stored in on the GPU. The vertex shaders read every attribute
+    * as floats, so a mesh may use any layout without its shaders changing
+    */
+   enum struct vertex_layout : std::uint32_t
+   {
+      position_colour, // gfx::vertex as it is, 24 bytes
+      compact          // Half float position and unorm8 colour, 12 bytes
+   };
+
+   static constexpr std::size_t vertex_layout_count = 2;
+
+   /**
+    * What an attribute holds. The value of a semantic is the shader location it is bound to
+    */
+   enum struct vertex_semantic : std::uint32_t
+   {
+      position = 0,
+      colour = 1
+   };
+
+   struct vertex_attribute
+   {
+      vertex_semantic semantic;
+      vk::Format format;
+      std::uint32_t offset;
+   };
+
+   auto to_string(vertex_layout layout) -> std::string;
+
+   [[nodiscard]] auto vertex_stride(vertex_layout layout) noexcept -> std::uint32_t;
+   [[nodiscard]] auto vertex_attributes(vertex_layout layout) noexcept
+      -> std::span<const vertex_attribute>;
+
+   /**
+    * Get the description of a vertex buffer holding vertices in the layout, for the pipeline's
+    * vertex input state
+    */
+   auto vertex_input_binding(vertex_layout layout, std::uint32_t binding = 0)
+      -> vk::VertexInputBindingDescription;
+   auto vertex_input_attributes(vertex_layout layout, std::uint32_t binding = 0)
+      -> util::small_dynamic_array<vk::VertexInputAttributeDescription, 4>;
+
+   /**
+    * Write the vertices in the layout. The output must hold vertex_stride(layout) bytes per
+    * vertex
+    */
+   void pack_vertices(vertex_layout layout, std::span<const vertex> vertices,
+                      std::span<std::byte> output) noexcept;
+   auto pack_vertices(vertex_layout layout, std::span<const vertex> vertices)
+      -> util::dynamic_array<std::byte>;
+
+   /**
+    * Convert a float to the nearest half float, rounding ties to even. Values too large for a
+    * half become infinities
+    */
+   auto to_half(float value) noexcept -> std::uint16_t;
+   auto from_half(std::uint16_t value) noexcept -> float;
+} // namespace gfx
@@ -22,6 +22,10 @@ namespace gfx
       void poll_events();
 
       auto is_open() -> bool;
+      /**
+       * Check whether a key, given as a GLFW key code, is currently held down
+       */
+      [[nodiscard]] auto is_key_pressed(int key) const -> bool;
 
       [[nodiscard]] auto get_surface(vk::Instance instance) const -> vkn::result<vk::SurfaceKHR>;
 
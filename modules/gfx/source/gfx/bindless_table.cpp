@@ -0,0 +1,224 @@
+#include <gfx/bindless_table.hpp>
+
+namespace gfx
+{
+   struct bindless_table_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override
+      {
+         return "gfx_bindless_table";
+      }
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return to_string(static_cast<bindless_table_error>(err));
+      }
+   };
+   inline static const bindless_table_error_category m_bindless_table_category{};
+
+   auto to_string(bindless_table_error err) -> std::string
+   {
+      switch (err)
+      {
+         case bindless_table_error::descriptor_indexing_not_supported:
+            return "descriptor_indexing_not_supported";
+         case bindless_table_error::failed_to_create_set_layout:
+            return "failed_to_create_set_layout";
+         case bindless_table_error::failed_to_allocate_set:
+            return "failed_to_allocate_set";
+         default:
+            return "UNKNOWN";
+      }
+   }
+
+   auto make_error(bindless_table_error err) noexcept -> error_t
+   {
+      return {{static_cast<int>(err), m_bindless_table_category}};
+   }
+
+   auto bindless_table::make(create_info&& info) noexcept -> gfx::result<bindless_table>
+   {
+      const vkn::device& device = *info.p_device;
+
+      if (!is_supported(device.vulkan12_features()))
+      {
+         return monad::make_error(
+            make_error(bindless_table_error::descriptor_indexing_not_supported));
+      }
+
+      auto layout_res = vkn::descriptor_set_layout::builder{device, info.p_logger}
+                           .set_bindings(layout_bindings())
+                           .set_binding_flags(layout_binding_flags())
+                           .set_flags(layout_flags())
+                           .build();
+      if (!layout_res)
+      {
+         util::log_error(info.p_logger, "[gfx] bindless table error: {}",
+                         layout_res.error().value().type.message());
+
+         return monad::make_error(make_error(bindless_table_error::failed_to_create_set_layout));
+      }
+
+      // The table is a single set, so its pool only ever needs room for one
+      auto allocator_res =
+         vkn::descriptor_allocator::builder{device, info.p_logger}
+            .set_initial_set_count(util::count32_t{1})
+            .add_pool_ratio(vk::DescriptorType::eStorageBuffer,
+                           static_cast<float>(max_storage_buffers))
+            .add_pool_ratio(vk::DescriptorType::eCombinedImageSampler,
+                           static_cast<float>(max_sampled_images))
+            .set_pool_flags(vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind)
+            .build();
+      if (!allocator_res)
+      {
+         util::log_error(info.p_logger, "[gfx] bindless table error: {}",
+                         allocator_res.error().value().type.message());
+
+         return monad::make_error(make_error(bindless_table_error::failed_to_allocate_set));
+      }
+
+      bindless_table table;
+      table.m_device = device.value();
+      table.m_layout = std::move(layout_res).value().value();
+      table.m_allocator = std::move(allocator_res).value().value();
+      table.mp_logger = std::move(info.p_logger);
+
+      auto set_res = table.m_allocator.allocate(table.m_layout.value());
+      if (!set_res)
+      {
+         util::log_error(table.mp_logger, "[gfx] bindless table error: {}",
+                         set_res.error().value().type.message());
+
+         return monad::make_error(make_error(bindless_table_error::failed_to_allocate_set));
+      }
+
+      table.m_set = set_res.value().value();
+
+      util::log_info(table.mp_logger, "[gfx] bindless table of {} buffers & {} images created",
+                     max_storage_buffers, max_sampled_images);
+
+      return table;
+   }
+
+   auto bindless_table::required_features() noexcept -> vk::PhysicalDeviceVulkan12Features
+   {
+      return {.shaderSampledImageArrayNonUniformIndexing = true,
+              .shaderStorageBufferArrayNonUniformIndexing = true,
+              .descriptorBindingSampledImageUpdateAfterBind = true,
+              .descriptorBindingStorageBufferUpdateAfterBind = true,
+              .descriptorBindingPartiallyBound = true,
+              .runtimeDescriptorArray = true};
+   }
+   auto bindless_table::is_supported(const vk::PhysicalDeviceVulkan12Features& features) noexcept
+      -> bool
+   {
+      return features.shaderSampledImageArrayNonUniformIndexing &&
+         features.shaderStorageBufferArrayNonUniformIndexing &&
+         features.descriptorBindingSampledImageUpdateAfterBind &&
+         features.descriptorBindingStorageBufferUpdateAfterBind &&
+         features.descriptorBindingPartiallyBound && features.runtimeDescriptorArray;
+   }
+
+   auto bindless_table::layout_bindings() -> util::dynamic_array<vk::DescriptorSetLayoutBinding>
+   {
+      const auto stages = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment;
+
+      return {{.binding = storage_buffer_binding,
+               .descriptorType = vk::DescriptorType::eStorageBuffer,
+               .descriptorCount = max_storage_buffers,
+               .stageFlags = stages},
+              {.binding = sampled_image_binding,
+               .descriptorType = vk::DescriptorType::eCombinedImageSampler,
+               .descriptorCount = max_sampled_images,
+               .stageFlags = stages}};
+   }
+   auto bindless_table::layout_binding_flags() -> util::dynamic_array<vk::DescriptorBindingFlags>
+   {
+      const vk::DescriptorBindingFlags flags =
+         vk::DescriptorBindingFlagBits::eUpdateAfterBind |
+         vk::DescriptorBindingFlagBits::ePartiallyBound;
+
+      return {flags, flags};
+   }
+   auto bindless_table::layout_flags() noexcept -> vk::DescriptorSetLayoutCreateFlags
+   {
+      return vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool;
+   }
+
+   auto bindless_table::add_storage_buffer(vk::Buffer buffer, vk::DeviceSize offset,
+                                           vk::DeviceSize range) -> std::uint32_t
+   {
+      const std::uint32_t index = m_storage_buffers.acquire();
+      if (index == invalid_index)
+      {
+         util::log_warn(mp_logger, "[gfx] bindless table out of storage buffer slots");
+
+         return invalid_index;
+      }
+
+      const vk::DescriptorBufferInfo buffer_info{
+         .buffer = buffer, .offset = offset, .range = range};
+      write({.dstSet = m_set,
+             .dstBinding = storage_buffer_binding,
+             .dstArrayElement = index,
+             .descriptorCount = 1,
+             .descriptorType = vk::DescriptorType::eStorageBuffer,
+             .pBufferInfo = &buffer_info});
+
+      return index;
+   }
+   auto bindless_table::add_sampled_image(vk::ImageView view, vk::Sampler sampler,
+                                          vk::ImageLayout layout) -> std::uint32_t
+   {
+      const std::uint32_t index = m_sampled_images.acquire();
+      if (index == invalid_index)
+      {
+         util::log_warn(mp_logger, "[gfx] bindless table out of sampled image slots");
+
+         return invalid_index;
+      }
+
+      const vk::DescriptorImageInfo image_info{
+         .sampler = sampler, .imageView = view, .imageLayout = layout};
+      write({.dstSet = m_set,
+             .dstBinding = sampled_image_binding,
+             .dstArrayElement = index,
+             .descriptorCount = 1,
+             .descriptorType = vk::DescriptorType::eCombinedImageSampler,
+             .pImageInfo = &image_info});
+
+      return index;
+   }
+
+   void bindless_table::remove_storage_buffer(std::uint32_t index)
+   {
+      m_storage_buffers.free_indices.emplace_back(index);
+   }
+   void bindless_table::remove_sampled_image(std::uint32_t index)
+   {
+      m_sampled_images.free_indices.emplace_back(index);
+   }
+
+   auto bindless_table::set() const noexcept -> vk::DescriptorSet { return m_set; }
+   auto bindless_table::layout() const noexcept -> vk::DescriptorSetLayout
+   {
+      return m_layout.value();
+   }
+
+   auto bindless_table::slot_range::acquire() -> std::uint32_t
+   {
+      if (!std::empty(free_indices))
+      {
+         const std::uint32_t index = free_indices.back();
+         free_indices.pop_back();
+
+         return index;
+      }
+
+      return count < capacity ? count++ : invalid_index;
+   }
+
+   void bindless_table::write(const vk::WriteDescriptorSet& write) const
+   {
+      m_device.updateDescriptorSets(1, &write, 0, nullptr);
+   }
+} // namespace gfx
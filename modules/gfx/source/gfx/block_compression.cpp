@@ -0,0 +1,938 @@
+#include <gfx/block_compression.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace gfx
+{
+   namespace
+   {
+      using rgba = std::array<std::uint8_t, 4>;
+      using block_texels = std::array<rgba, 16>;
+
+      /**
+       * Get the number of 4x4 blocks covering a dimension, computed in std::size_t so extents
+       * near the 32 bit limit don't wrap around
+       */
+      auto block_count(std::uint32_t texel_count) noexcept -> std::size_t
+      {
+         return std::max<std::size_t>((std::size_t{texel_count} + 3) / 4, 1);
+      }
+
+      auto load_u16(const std::byte* p_data) noexcept -> std::uint32_t
+      {
+         return std::to_integer<std::uint32_t>(p_data[0]) |
+            (std::to_integer<std::uint32_t>(p_data[1]) << 8U);
+      }
+      auto load_u32(const std::byte* p_data) noexcept -> std::uint32_t
+      {
+         return load_u16(p_data) | (load_u16(p_data + 2) << 16U);
+      }
+      auto load_u64(const std::byte* p_data) noexcept -> std::uint64_t
+      {
+         std::uint64_t value = 0;
+         for (std::size_t i = 0; i < sizeof(value); ++i)
+         {
+            value |= std::to_integer<std::uint64_t>(p_data[i]) << (8U * i);
+         }
+
+         return value;
+      }
+
+      void store_u16(std::byte* p_data, std::uint32_t value) noexcept
+      {
+         p_data[0] = static_cast<std::byte>(value & 0xFFU);
+         p_data[1] = static_cast<std::byte>((value >> 8U) & 0xFFU);
+      }
+      void store_u32(std::byte* p_data, std::uint32_t value) noexcept
+      {
+         store_u16(p_data, value & 0xFFFFU);
+         store_u16(p_data + 2, value >> 16U);
+      }
+      void store_u64(std::byte* p_data, std::uint64_t value) noexcept
+      {
+         for (std::size_t i = 0; i < sizeof(value); ++i)
+         {
+            p_data[i] = static_cast<std::byte>((value >> (8U * i)) & 0xFFU);
+         }
+      }
+
+      auto expand_565(std::uint32_t colour) noexcept -> rgba
+      {
+         const std::uint32_t r = (colour >> 11U) & 0x1FU;
+         const std::uint32_t g = (colour >> 5U) & 0x3FU;
+         const std::uint32_t b = colour & 0x1FU;
+
+         return {static_cast<std::uint8_t>((r << 3U) | (r >> 2U)),
+                 static_cast<std::uint8_t>((g << 2U) | (g >> 4U)),
+                 static_cast<std::uint8_t>((b << 3U) | (b >> 2U)), 255};
+      }
+
+      /**
+       * Decode the colour part of a BC1/BC3 block. BC3 always uses the four colour mode
+       */
+      void decode_colour_block(const std::byte* p_block, bool is_bc1, block_texels& texels)
+      {
+         const std::uint32_t c0 = load_u16(p_block);
+         const std::uint32_t c1 = load_u16(p_block + 2);
+
+         std::array<rgba, 4> palette{expand_565(c0), expand_565(c1)};
+         for (std::size_t i = 0; i < 3; ++i)
+         {
+            const std::uint32_t e0 = palette[0][i];
+            const std::uint32_t e1 = palette[1][i];
+
+            if (c0 > c1 || !is_bc1)
+            {
+               palette[2][i] = static_cast<std::uint8_t>((2 * e0 + e1) / 3);
+               palette[3][i] = static_cast<std::uint8_t>((e0 + 2 * e1) / 3);
+            }
+            else
+            {
+               palette[2][i] = static_cast<std::uint8_t>((e0 + e1) / 2);
+               palette[3][i] = 0;
+            }
+         }
+
+         palette[2][3] = 255;
+         palette[3][3] = (c0 > c1 || !is_bc1) ? 255 : 0;
+
+         const std::uint32_t indices = load_u32(p_block + 4);
+         for (std::size_t i = 0; i < 16; ++i)
+         {
+            const auto& colour = palette[(indices >> (2 * i)) & 0x3U];
+
+            texels[i][0] = colour[0];
+            texels[i][1] = colour[1];
+            texels[i][2] = colour[2];
+            texels[i][3] = is_bc1 ? colour[3] : texels[i][3];
+         }
+      }
+
+      /**
+       * Decode a BC4 block, as used by BC3's alpha and BC5's two channels, into one channel
+       */
+      void decode_single_channel_block(const std::byte* p_block, std::size_t channel,
+                                       block_texels& texels)
+      {
+         const std::uint64_t bits = load_u64(p_block);
+         const std::uint32_t e0 = bits & 0xFFU;
+         const std::uint32_t e1 = (bits >> 8U) & 0xFFU;
+
+         std::array<std::uint32_t, 8> palette{e0, e1};
+         if (e0 > e1)
+         {
+            for (std::uint32_t i = 1; i < 7; ++i)
+            {
+               palette[i + 1] = ((7 - i) * e0 + i * e1) / 7;
+            }
+         }
+         else
+         {
+            for (std::uint32_t i = 1; i < 5; ++i)
+            {
+               palette[i + 1] = ((5 - i) * e0 + i * e1) / 5;
+            }
+
+            palette[6] = 0;
+            palette[7] = 255;
+         }
+
+         for (std::size_t i = 0; i < 16; ++i)
+         {
+            texels[i][channel] = static_cast<std::uint8_t>(palette[(bits >> (16 + 3 * i)) & 0x7U]);
+         }
+      }
+
+      /**
+       * Get the two extremes of the first channels of the texels along their principal axis,
+       * found by power iteration on their covariance
+       */
+      template <std::size_t channel_count_>
+      auto principal_endpoints(const block_texels& texels) noexcept
+         -> std::array<std::array<float, channel_count_>, 2>
+      {
+         using vector = std::array<float, channel_count_>;
+
+         vector mean{};
+         for (const auto& texel : texels)
+         {
+            for (std::size_t c = 0; c < channel_count_; ++c)
+            {
+               mean[c] += static_cast<float>(texel[c]) / 16.0F;
+            }
+         }
+
+         std::array<vector, channel_count_> covariance{};
+         for (const auto& texel : texels)
+         {
+            for (std::size_t i = 0; i < channel_count_; ++i)
+            {
+               for (std::size_t j = 0; j < channel_count_; ++j)
+               {
+                  covariance[i][j] += (static_cast<float>(texel[i]) - mean[i]) *
+                     (static_cast<float>(texel[j]) - mean[j]);
+               }
+            }
+         }
+
+         vector axis;
+         axis.fill(1.0F);
+         for (std::size_t iteration = 0; iteration < 8; ++iteration)
+         {
+            vector next{};
+            float largest = 0.0F;
+            for (std::size_t i = 0; i < channel_count_; ++i)
+            {
+               for (std::size_t j = 0; j < channel_count_; ++j)
+               {
+                  next[i] += covariance[i][j] * axis[j];
+               }
+               largest = std::max(largest, std::abs(next[i]));
+            }
+
+            // Uniform blocks have no principal axis, any axis gives the same endpoints
+            if (largest == 0.0F)
+            {
+               break;
+            }
+
+            for (std::size_t i = 0; i < channel_count_; ++i)
+            {
+               axis[i] = next[i] / largest;
+            }
+         }
+
+         float min_t = std::numeric_limits<float>::max();
+         float max_t = std::numeric_limits<float>::lowest();
+         for (const auto& texel : texels)
+         {
+            float t = 0.0F;
+            for (std::size_t c = 0; c < channel_count_; ++c)
+            {
+               t += (static_cast<float>(texel[c]) - mean[c]) * axis[c];
+            }
+
+            min_t = std::min(min_t, t);
+            max_t = std::max(max_t, t);
+         }
+
+         float length_squared = 0.0F;
+         for (float value : axis)
+         {
+            length_squared += value * value;
+         }
+
+         std::array<vector, 2> endpoints{};
+         for (std::size_t c = 0; c < channel_count_; ++c)
+         {
+            const float direction = length_squared > 0.0F ? axis[c] / length_squared : 0.0F;
+
+            endpoints[0][c] = std::clamp(mean[c] + direction * max_t, 0.0F, 255.0F);
+            endpoints[1][c] = std::clamp(mean[c] + direction * min_t, 0.0F, 255.0F);
+         }
+
+         return endpoints;
+      }
+
+      template <std::size_t channel_count_>
+      auto distance(const rgba& lhs, const rgba& rhs) noexcept -> std::uint32_t
+      {
+         std::uint32_t sum = 0;
+         for (std::size_t c = 0; c < channel_count_; ++c)
+         {
+            const int difference = int{lhs[c]} - int{rhs[c]};
+            sum += static_cast<std::uint32_t>(difference * difference);
+         }
+
+         return sum;
+      }
+
+      template <std::size_t palette_size_, std::size_t channel_count_>
+      auto closest_index(const std::array<rgba, palette_size_>& palette, const rgba& texel) noexcept
+         -> std::uint32_t
+      {
+         std::uint32_t best_index = 0;
+         std::uint32_t best_distance = std::numeric_limits<std::uint32_t>::max();
+         for (std::uint32_t i = 0; i < palette_size_; ++i)
+         {
+            if (const auto d = distance<channel_count_>(palette[i], texel); d < best_distance)
+            {
+               best_index = i;
+               best_distance = d;
+            }
+         }
+
+         return best_index;
+      }
+
+      auto pack_565(const std::array<float, 3>& colour) noexcept -> std::uint32_t
+      {
+         const auto r = static_cast<std::uint32_t>(colour[0] * 31.0F / 255.0F + 0.5F);
+         const auto g = static_cast<std::uint32_t>(colour[1] * 63.0F / 255.0F + 0.5F);
+         const auto b = static_cast<std::uint32_t>(colour[2] * 31.0F / 255.0F + 0.5F);
+
+         return (r << 11U) | (g << 5U) | b;
+      }
+
+      /**
+       * Encode the colour part of a BC1/BC3 block in the four colour mode, alpha is ignored
+       */
+      void encode_colour_block(const block_texels& texels, std::byte* p_block)
+      {
+         const auto endpoints = principal_endpoints<3>(texels);
+
+         std::uint32_t c0 = pack_565(endpoints[0]);
+         std::uint32_t c1 = pack_565(endpoints[1]);
+         if (c0 < c1)
+         {
+            std::swap(c0, c1);
+         }
+
+         store_u16(p_block, c0);
+         store_u16(p_block + 2, c1);
+
+         // Equal endpoints select the three colour mode, where index 0 is still the colour
+         std::uint32_t indices = 0;
+         if (c0 != c1)
+         {
+            std::array<rgba, 4> palette{expand_565(c0), expand_565(c1)};
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+               const std::uint32_t e0 = palette[0][i];
+               const std::uint32_t e1 = palette[1][i];
+
+               palette[2][i] = static_cast<std::uint8_t>((2 * e0 + e1) / 3);
+               palette[3][i] = static_cast<std::uint8_t>((e0 + 2 * e1) / 3);
+            }
+
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+               indices |= closest_index<4, 3>(palette, texels[i]) << (2 * i);
+            }
+         }
+
+         store_u32(p_block + 4, indices);
+      }
+
+      /**
+       * Encode one channel of the texels as a BC4 block, in the eight value mode
+       */
+      void encode_single_channel_block(const block_texels& texels, std::size_t channel,
+                                       std::byte* p_block)
+      {
+         std::uint32_t e0 = 0;
+         std::uint32_t e1 = 255;
+         for (const auto& texel : texels)
+         {
+            e0 = std::max<std::uint32_t>(e0, texel[channel]);
+            e1 = std::min<std::uint32_t>(e1, texel[channel]);
+         }
+
+         std::uint64_t bits = e0 | (e1 << 8U);
+         if (e0 > e1)
+         {
+            std::array<std::uint32_t, 8> palette{e0, e1};
+            for (std::uint32_t i = 1; i < 7; ++i)
+            {
+               palette[i + 1] = ((7 - i) * e0 + i * e1) / 7;
+            }
+
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+               const std::uint32_t value = texels[i][channel];
+
+               std::uint64_t best_index = 0;
+               std::uint32_t best_distance = 256;
+               for (std::uint32_t j = 0; j < 8; ++j)
+               {
+                  const std::uint32_t d =
+                     value > palette[j] ? value - palette[j] : palette[j] - value;
+                  if (d < best_distance)
+                  {
+                     best_index = j;
+                     best_distance = d;
+                  }
+               }
+
+               bits |= best_index << (16 + 3 * i);
+            }
+         }
+
+         store_u64(p_block, bits);
+      }
+
+      namespace bc7
+      {
+         struct mode_info
+         {
+            std::uint32_t subset_count;
+            std::uint32_t partition_bits;
+            std::uint32_t rotation_bits;
+            std::uint32_t index_selection_bits;
+            std::uint32_t colour_bits;
+            std::uint32_t alpha_bits;
+            std::uint32_t endpoint_pbits;
+            std::uint32_t shared_pbits;
+            std::uint32_t index_bits;
+            std::uint32_t secondary_index_bits;
+         };
+
+         constexpr std::array<mode_info, 8> modes{{{3, 4, 0, 0, 4, 0, 1, 0, 3, 0},
+                                                   {2, 6, 0, 0, 6, 0, 0, 1, 3, 0},
+                                                   {3, 6, 0, 0, 5, 0, 0, 0, 2, 0},
+                                                   {2, 6, 0, 0, 7, 0, 1, 0, 2, 0},
+                                                   {1, 0, 2, 1, 5, 6, 0, 0, 2, 3},
+                                                   {1, 0, 2, 0, 7, 8, 0, 0, 2, 2},
+                                                   {1, 0, 0, 0, 7, 7, 1, 0, 4, 0},
+                                                   {2, 6, 0, 0, 5, 5, 1, 0, 2, 0}}};
+
+         // One bit per texel, set for the texels of the second subset
+         constexpr std::array<std::uint16_t, 64> two_subset_partitions{
+            0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80, 0xC800, 0xFFEC,
+            0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000, 0xF710, 0x008E, 0x7100, 0x08CE,
+            0x008C, 0x7310, 0x3100, 0x8CCE, 0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0,
+            0x718E, 0x399C, 0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+            0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660, 0x0272, 0x04E4,
+            0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C, 0x9336, 0x9CC6, 0x817E, 0xE718,
+            0xCCF0, 0x0FCC, 0x7744, 0xEE22};
+
+         // Two bits per texel holding the subset of the texel
+         constexpr std::array<std::uint32_t, 64> three_subset_partitions{
+            0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050,
+            0x5555A0A0, 0x5A5A5050, 0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090,
+            0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250, 0xA5945040, 0x0A425054,
+            0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+            0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414,
+            0x50A4A450, 0x6A5A0200, 0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424,
+            0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50, 0x500AA550, 0xAAAA4444,
+            0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+            0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580,
+            0xAA141414, 0x96960000, 0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000,
+            0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254};
+
+         // Texels whose index drops its top bit, besides the first texel of the block
+         constexpr std::array<std::uint8_t, 64> two_subset_anchors{
+            15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 2,  8,  2,  2,  8,
+            8,  15, 2,  8,  2,  2,  8,  8,  2,  2,  15, 15, 6,  8,  2,  8,  15, 15, 2,  8,  2,  2,
+            2,  15, 15, 6,  6,  2,  6,  8,  15, 15, 2,  2,  15, 15, 15, 15, 15, 2,  2,  15};
+         constexpr std::array<std::uint8_t, 64> three_subset_second_anchors{
+            3,  3,  15, 15, 8,  3,  15, 15, 8,  8,  6,  6,  6,  5,  3,  3,  3,  3,  8,  15, 3,  3,
+            6,  10, 5,  8,  8,  6,  8,  5,  15, 15, 8,  15, 3,  5,  6,  10, 8,  15, 15, 3,  15, 5,
+            15, 15, 15, 15, 3,  15, 5,  5,  5,  8,  5,  10, 5,  10, 8,  13, 15, 12, 3,  3};
+         constexpr std::array<std::uint8_t, 64> three_subset_third_anchors{
+            15, 8,  8,  3,  15, 15, 3,  8,  15, 15, 15, 15, 15, 15, 15, 8,  15, 8,  15, 3,  15, 8,
+            15, 8,  3,  15, 6,  10, 15, 15, 10, 8,  15, 3,  15, 10, 10, 8,  9,  10, 6,  15, 8,  15,
+            3,  6,  6,  8,  15, 3,  15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3,  15, 15, 8};
+
+         constexpr std::array<std::uint32_t, 4> weights_2{0, 21, 43, 64};
+         constexpr std::array<std::uint32_t, 8> weights_3{0, 9, 18, 27, 37, 46, 55, 64};
+         constexpr std::array<std::uint32_t, 16> weights_4{0,  4,  9,  13, 17, 21, 26, 30,
+                                                           34, 38, 43, 47, 51, 55, 60, 64};
+
+         class bit_reader
+         {
+         public:
+            explicit bit_reader(const std::byte* p_block) noexcept :
+               m_low{load_u64(p_block)}, m_high{load_u64(p_block + 8)}
+            {}
+
+            auto read(std::uint32_t count) noexcept -> std::uint32_t
+            {
+               std::uint32_t value = 0;
+               for (std::uint32_t i = 0; i < count; ++i)
+               {
+                  const std::uint64_t word = m_position < 64 ? m_low : m_high;
+                  value |= static_cast<std::uint32_t>((word >> (m_position % 64)) & 1U) << i;
+
+                  ++m_position;
+               }
+
+               return value;
+            }
+
+         private:
+            std::uint64_t m_low;
+            std::uint64_t m_high;
+            std::uint32_t m_position{0};
+         };
+
+         auto interpolate(std::uint32_t e0, std::uint32_t e1, std::uint32_t index,
+                          std::uint32_t index_bits) noexcept -> std::uint8_t
+         {
+            const std::uint32_t weight = index_bits == 2 ? weights_2[index]
+               : index_bits == 3                         ? weights_3[index]
+                                                         : weights_4[index];
+
+            return static_cast<std::uint8_t>(((64 - weight) * e0 + weight * e1 + 32) >> 6U);
+         }
+
+         auto subset_of(const mode_info& mode, std::uint32_t partition, std::size_t texel) noexcept
+            -> std::uint32_t
+         {
+            if (mode.subset_count == 2)
+            {
+               return (two_subset_partitions[partition] >> texel) & 1U;
+            }
+            if (mode.subset_count == 3)
+            {
+               return (three_subset_partitions[partition] >> (2 * texel)) & 3U;
+            }
+
+            return 0;
+         }
+
+         auto is_anchor(const mode_info& mode, std::uint32_t partition, std::size_t texel) noexcept
+            -> bool
+         {
+            if (texel == 0)
+            {
+               return true;
+            }
+            if (mode.subset_count == 2)
+            {
+               return texel == two_subset_anchors[partition];
+            }
+            if (mode.subset_count == 3)
+            {
+               return texel == three_subset_second_anchors[partition] ||
+                  texel == three_subset_third_anchors[partition];
+            }
+
+            return false;
+         }
+
+         void decode_block(const std::byte* p_block, block_texels& texels)
+         {
+            bit_reader reader{p_block};
+
+            std::uint32_t mode_index = 0;
+            while (mode_index < 8 && reader.read(1) == 0)
+            {
+               ++mode_index;
+            }
+
+            // Reserved mode, decoded as transparent black
+            if (mode_index == 8)
+            {
+               texels.fill({0, 0, 0, 0});
+               return;
+            }
+
+            const mode_info& mode = modes[mode_index];
+
+            const std::uint32_t partition = reader.read(mode.partition_bits);
+            const std::uint32_t rotation = reader.read(mode.rotation_bits);
+            const std::uint32_t index_selection = reader.read(mode.index_selection_bits);
+
+            const std::uint32_t endpoint_count = mode.subset_count * 2;
+
+            // Endpoints are stored channel by channel
+            std::array<std::array<std::uint32_t, 4>, 6> endpoints{};
+            for (std::size_t channel = 0; channel < 3; ++channel)
+            {
+               for (std::size_t i = 0; i < endpoint_count; ++i)
+               {
+                  endpoints[i][channel] = reader.read(mode.colour_bits);
+               }
+            }
+            for (std::size_t i = 0; i < endpoint_count; ++i)
+            {
+               endpoints[i][3] = mode.alpha_bits > 0 ? reader.read(mode.alpha_bits) : 255;
+            }
+
+            std::array<std::uint32_t, 6> pbits{};
+            if (mode.endpoint_pbits > 0)
+            {
+               for (std::size_t i = 0; i < endpoint_count; ++i)
+               {
+                  pbits[i] = reader.read(1);
+               }
+            }
+            if (mode.shared_pbits > 0)
+            {
+               for (std::size_t i = 0; i < mode.subset_count; ++i)
+               {
+                  pbits[2 * i] = pbits[2 * i + 1] = reader.read(1);
+               }
+            }
+
+            const bool has_pbits = mode.endpoint_pbits > 0 || mode.shared_pbits > 0;
+            const auto expand = [&](std::uint32_t value, std::uint32_t bits, std::uint32_t pbit) {
+               if (has_pbits)
+               {
+                  value = (value << 1U) | pbit;
+                  ++bits;
+               }
+
+               value <<= (8 - bits);
+               return value | (value >> bits);
+            };
+
+            for (std::size_t i = 0; i < endpoint_count; ++i)
+            {
+               for (std::size_t channel = 0; channel < 3; ++channel)
+               {
+                  endpoints[i][channel] = expand(endpoints[i][channel], mode.colour_bits, pbits[i]);
+               }
+               if (mode.alpha_bits > 0)
+               {
+                  endpoints[i][3] = expand(endpoints[i][3], mode.alpha_bits, pbits[i]);
+               }
+            }
+
+            std::array<std::uint32_t, 16> indices{};
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+               const bool anchor = is_anchor(mode, partition, i);
+               indices[i] = reader.read(anchor ? mode.index_bits - 1 : mode.index_bits);
+            }
+
+            std::array<std::uint32_t, 16> secondary_indices{};
+            if (mode.secondary_index_bits > 0)
+            {
+               for (std::size_t i = 0; i < 16; ++i)
+               {
+                  const std::uint32_t bits = mode.secondary_index_bits;
+                  secondary_indices[i] = reader.read(i == 0 ? bits - 1 : bits);
+               }
+            }
+
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+               const std::uint32_t subset = subset_of(mode, partition, i);
+               const auto& e0 = endpoints[2 * subset];
+               const auto& e1 = endpoints[2 * subset + 1];
+
+               rgba& texel = texels[i];
+               if (mode.secondary_index_bits == 0)
+               {
+                  for (std::size_t channel = 0; channel < 4; ++channel)
+                  {
+                     texel[channel] =
+                        interpolate(e0[channel], e1[channel], indices[i], mode.index_bits);
+                  }
+               }
+               else
+               {
+                  // The index selection bit swaps which index set the colour & alpha use
+                  const bool swap = index_selection == 1;
+                  const std::uint32_t colour_index = swap ? secondary_indices[i] : indices[i];
+                  const std::uint32_t colour_bits =
+                     swap ? mode.secondary_index_bits : mode.index_bits;
+                  const std::uint32_t alpha_index = swap ? indices[i] : secondary_indices[i];
+                  const std::uint32_t alpha_bits =
+                     swap ? mode.index_bits : mode.secondary_index_bits;
+
+                  for (std::size_t channel = 0; channel < 3; ++channel)
+                  {
+                     texel[channel] =
+                        interpolate(e0[channel], e1[channel], colour_index, colour_bits);
+                  }
+                  texel[3] = interpolate(e0[3], e1[3], alpha_index, alpha_bits);
+               }
+
+               if (rotation > 0)
+               {
+                  std::swap(texel[3], texel[rotation - 1]);
+               }
+            }
+         }
+
+         class bit_writer
+         {
+         public:
+            void write(std::uint32_t value, std::uint32_t count) noexcept
+            {
+               for (std::uint32_t i = 0; i < count; ++i)
+               {
+                  const std::uint64_t bit = (value >> i) & 1U;
+                  if (m_position < 64)
+                  {
+                     m_low |= bit << m_position;
+                  }
+                  else
+                  {
+                     m_high |= bit << (m_position - 64);
+                  }
+
+                  ++m_position;
+               }
+            }
+
+            void store(std::byte* p_block) const noexcept
+            {
+               store_u64(p_block, m_low);
+               store_u64(p_block + 8, m_high);
+            }
+
+         private:
+            std::uint64_t m_low{0};
+            std::uint64_t m_high{0};
+            std::uint32_t m_position{0};
+         };
+
+         /**
+          * Encode a block in mode 6: a single subset of 7 bit RGBA endpoints with their own
+          * p-bit, and 4 bit indices. It handles alpha and smooth gradients well, which covers
+          * most textures
+          */
+         void encode_block(const block_texels& texels, std::byte* p_block)
+         {
+            const auto endpoints = principal_endpoints<4>(texels);
+
+            std::array<std::array<std::uint32_t, 4>, 2> quantized{};
+            std::array<std::uint32_t, 2> pbits{};
+            std::array<rgba, 2> expanded{};
+            for (std::size_t e = 0; e < 2; ++e)
+            {
+               // Keep the p-bit giving the endpoint closest to the unquantized one
+               float best_error = std::numeric_limits<float>::max();
+               for (std::uint32_t pbit = 0; pbit < 2; ++pbit)
+               {
+                  std::array<std::uint32_t, 4> values{};
+                  float error = 0.0F;
+                  for (std::size_t c = 0; c < 4; ++c)
+                  {
+                     const float target = (endpoints[e][c] - static_cast<float>(pbit)) / 2.0F;
+                     values[c] =
+                        static_cast<std::uint32_t>(std::clamp(target + 0.5F, 0.0F, 127.0F));
+
+                     const float difference =
+                        static_cast<float>((values[c] << 1U) | pbit) - endpoints[e][c];
+                     error += difference * difference;
+                  }
+
+                  if (error < best_error)
+                  {
+                     best_error = error;
+                     quantized[e] = values;
+                     pbits[e] = pbit;
+                  }
+               }
+
+               for (std::size_t c = 0; c < 4; ++c)
+               {
+                  expanded[e][c] = static_cast<std::uint8_t>((quantized[e][c] << 1U) | pbits[e]);
+               }
+            }
+
+            std::array<rgba, 16> palette{};
+            for (std::uint32_t i = 0; i < 16; ++i)
+            {
+               for (std::size_t c = 0; c < 4; ++c)
+               {
+                  palette[i][c] = interpolate(expanded[0][c], expanded[1][c], i, 4);
+               }
+            }
+
+            std::array<std::uint32_t, 16> indices{};
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+               indices[i] = closest_index<16, 4>(palette, texels[i]);
+            }
+
+            // The anchor index is stored without its top bit, which must then be 0
+            if (indices[0] >= 8)
+            {
+               std::swap(quantized[0], quantized[1]);
+               std::swap(pbits[0], pbits[1]);
+               for (auto& index : indices)
+               {
+                  index = 15 - index;
+               }
+            }
+
+            bit_writer writer;
+            writer.write(1U << 6U, 7);
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+               writer.write(quantized[0][c], 7);
+               writer.write(quantized[1][c], 7);
+            }
+            writer.write(pbits[0], 1);
+            writer.write(pbits[1], 1);
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+               writer.write(indices[i], i == 0 ? 3 : 4);
+            }
+
+            writer.store(p_block);
+         }
+      } // namespace bc7
+
+      void decode_block(texel_format format, const std::byte* p_block, block_texels& texels)
+      {
+         switch (format)
+         {
+            case texel_format::bc1:
+               decode_colour_block(p_block, true, texels);
+               break;
+            case texel_format::bc3:
+               decode_single_channel_block(p_block, 3, texels);
+               decode_colour_block(p_block + 8, false, texels);
+               break;
+            case texel_format::bc5:
+               for (auto& texel : texels)
+               {
+                  texel = {0, 0, 0, 255};
+               }
+               decode_single_channel_block(p_block, 0, texels);
+               decode_single_channel_block(p_block + 8, 1, texels);
+               break;
+            case texel_format::bc7:
+               bc7::decode_block(p_block, texels);
+               break;
+            default:
+               break;
+         }
+      }
+      void encode_block(texel_format format, const block_texels& texels, std::byte* p_block)
+      {
+         switch (format)
+         {
+            case texel_format::bc1:
+               encode_colour_block(texels, p_block);
+               break;
+            case texel_format::bc3:
+               encode_single_channel_block(texels, 3, p_block);
+               encode_colour_block(texels, p_block + 8);
+               break;
+            case texel_format::bc5:
+               encode_single_channel_block(texels, 0, p_block);
+               encode_single_channel_block(texels, 1, p_block + 8);
+               break;
+            case texel_format::bc7:
+               bc7::encode_block(texels, p_block);
+               break;
+            default:
+               break;
+         }
+      }
+   } // namespace
+
+   auto is_block_compressed(texel_format format) noexcept -> bool
+   {
+      return format != texel_format::rgba8;
+   }
+   auto block_size(texel_format format) noexcept -> std::uint32_t
+   {
+      switch (format)
+      {
+         case texel_format::rgba8:
+            return 4;
+         case texel_format::bc1:
+            return 8;
+         default:
+            return 16;
+      }
+   }
+   auto image_size(texel_format format, const vk::Extent2D& extent) noexcept -> std::size_t
+   {
+      if (!is_block_compressed(format))
+      {
+         return std::size_t{extent.width} * extent.height * block_size(format);
+      }
+
+      return block_count(extent.width) * block_count(extent.height) * block_size(format);
+   }
+   auto to_vk_format(texel_format format, bool is_srgb) noexcept -> vk::Format
+   {
+      switch (format)
+      {
+         case texel_format::rgba8:
+            return is_srgb ? vk::Format::eR8G8B8A8Srgb : vk::Format::eR8G8B8A8Unorm;
+         case texel_format::bc1:
+            return is_srgb ? vk::Format::eBc1RgbaSrgbBlock : vk::Format::eBc1RgbaUnormBlock;
+         case texel_format::bc3:
+            return is_srgb ? vk::Format::eBc3SrgbBlock : vk::Format::eBc3UnormBlock;
+         case texel_format::bc5:
+            return vk::Format::eBc5UnormBlock;
+         case texel_format::bc7:
+            return is_srgb ? vk::Format::eBc7SrgbBlock : vk::Format::eBc7UnormBlock;
+         default:
+            return vk::Format::eUndefined;
+      }
+   }
+
+   auto decompress_to_rgba8(texel_format format, const vk::Extent2D& extent,
+                            std::span<const std::byte> data) -> util::dynamic_array<std::byte>
+   {
+      if (!is_block_compressed(format) || std::size(data) < image_size(format, extent))
+      {
+         return util::dynamic_array<std::byte>{};
+      }
+
+      util::dynamic_array<std::byte> texels(std::size_t{extent.width} * extent.height * 4);
+
+      const std::size_t blocks_x = block_count(extent.width);
+      const std::size_t blocks_y = block_count(extent.height);
+      const std::byte* p_block = std::data(data);
+
+      block_texels block{};
+      for (std::size_t by = 0; by < blocks_y; ++by)
+      {
+         for (std::size_t bx = 0; bx < blocks_x; ++bx)
+         {
+            decode_block(format, p_block, block);
+            p_block += block_size(format);
+
+            // Blocks on the right & bottom edges may hang over the image
+            for (std::size_t y = 0; y < 4 && by * 4 + y < extent.height; ++y)
+            {
+               for (std::size_t x = 0; x < 4 && bx * 4 + x < extent.width; ++x)
+               {
+                  const std::size_t texel = (by * 4 + y) * extent.width + bx * 4 + x;
+                  std::memcpy(&texels[texel * 4], block[y * 4 + x].data(), 4);
+               }
+            }
+         }
+      }
+
+      return texels;
+   }
+
+   auto compress_from_rgba8(texel_format format, const vk::Extent2D& extent,
+                            std::span<const std::byte> texels) -> util::dynamic_array<std::byte>
+   {
+      if (!is_block_compressed(format) ||
+          std::size(texels) < image_size(texel_format::rgba8, extent))
+      {
+         return util::dynamic_array<std::byte>{};
+      }
+
+      util::dynamic_array<std::byte> data(image_size(format, extent));
+
+      const std::size_t blocks_x = block_count(extent.width);
+      const std::size_t blocks_y = block_count(extent.height);
+      std::byte* p_block = std::data(data);
+
+      block_texels block{};
+      for (std::size_t by = 0; by < blocks_y; ++by)
+      {
+         for (std::size_t bx = 0; bx < blocks_x; ++bx)
+         {
+            // Blocks hanging over the edges repeat the last row & column of the image
+            for (std::size_t y = 0; y < 4; ++y)
+            {
+               for (std::size_t x = 0; x < 4; ++x)
+               {
+                  const std::size_t texel_x = std::min<std::size_t>(bx * 4 + x, extent.width - 1);
+                  const std::size_t texel_y = std::min<std::size_t>(by * 4 + y, extent.height - 1);
+                  const std::size_t texel = texel_y * extent.width + texel_x;
+
+                  std::memcpy(block[y * 4 + x].data(), &texels[texel * 4], 4);
+               }
+            }
+
+            encode_block(format, block, p_block);
+            p_block += block_size(format);
+         }
+      }
+
+      return data;
+   }
+} // namespace gfx
@@ -0,0 +1,569 @@
+#include <gfx/bvh.hpp>
+
+#include <algorithm>
+
+namespace gfx
+{
+   using traversal_stack = util::small_dynamic_array<std::uint32_t, 64>;
+
+   auto aabb::contains(const aabb& other) const noexcept -> bool
+   {
+      return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+         other.max.x <= max.x && other.max.y <= max.y && other.max.z <= max.z;
+   }
+   auto aabb::overlaps(const aabb& other) const noexcept -> bool
+   {
+      return min.x <= other.max.x && other.min.x <= max.x && min.y <= other.max.y &&
+         other.min.y <= max.y && min.z <= other.max.z && other.min.z <= max.z;
+   }
+   auto aabb::surface_area() const noexcept -> float
+   {
+      const glm::vec3 d = max - min;
+      return 2.0F * (d.x * d.y + d.y * d.z + d.z * d.x);
+   }
+
+   auto merge(const aabb& lhs, const aabb& rhs) noexcept -> aabb
+   {
+      return {.min = glm::min(lhs.min, rhs.min), .max = glm::max(lhs.max, rhs.max)};
+   }
+   auto to_aabb(const bounding_sphere& sphere) noexcept -> aabb
+   {
+      return {.min = sphere.center - glm::vec3{sphere.radius},
+              .max = sphere.center + glm::vec3{sphere.radius}};
+   }
+
+   namespace
+   {
+      enum struct containment
+      {
+         outside,
+         intersecting,
+         inside
+      };
+
+      auto classify(const aabb& box, const frustum& frustum) noexcept -> containment
+      {
+         auto result = containment::inside;
+
+         for (const auto& plane : frustum.planes)
+         {
+            const glm::vec3 positive{plane.x >= 0.0F ? box.max.x : box.min.x,
+                                     plane.y >= 0.0F ? box.max.y : box.min.y,
+                                     plane.z >= 0.0F ? box.max.z : box.min.z};
+            const glm::vec3 negative{plane.x >= 0.0F ? box.min.x : box.max.x,
+                                     plane.y >= 0.0F ? box.min.y : box.max.y,
+                                     plane.z >= 0.0F ? box.min.z : box.max.z};
+
+            if (glm::dot(glm::vec3{plane}, positive) + plane.w < 0.0F)
+            {
+               return containment::outside;
+            }
+
+            if (glm::dot(glm::vec3{plane}, negative) + plane.w < 0.0F)
+            {
+               result = containment::intersecting;
+            }
+         }
+
+         return result;
+      }
+
+      /**
+       * Slab test, returns the entry distance along the ray if the box is hit within max_distance
+       */
+      auto intersect_ray(const aabb& box, const glm::vec3& origin, const glm::vec3& inv_direction,
+                         float max_distance) noexcept -> std::optional<float>
+      {
+         float t_min = 0.0F;
+         float t_max = max_distance;
+
+         for (int axis = 0; axis < 3; ++axis)
+         {
+            float t_0 = (box.min[axis] - origin[axis]) * inv_direction[axis];
+            float t_1 = (box.max[axis] - origin[axis]) * inv_direction[axis];
+            if (t_0 > t_1)
+            {
+               std::swap(t_0, t_1);
+            }
+
+            t_min = std::max(t_min, t_0);
+            t_max = std::min(t_max, t_1);
+
+            if (t_min > t_max)
+            {
+               return std::nullopt;
+            }
+         }
+
+         return t_min;
+      }
+   } // namespace
+
+   bvh::bvh(float margin) noexcept : m_margin{margin} {}
+
+   auto bvh::insert(const aabb& bounds, std::uint32_t user_data) -> std::uint32_t
+   {
+      const std::uint32_t proxy = allocate_node();
+
+      auto& leaf = m_nodes[proxy];
+      leaf.tight = bounds;
+      leaf.fat = {.min = bounds.min - glm::vec3{m_margin}, .max = bounds.max + glm::vec3{m_margin}};
+      leaf.user_data = user_data;
+      leaf.height = 0;
+
+      insert_leaf(proxy);
+      ++m_leaf_count;
+
+      return proxy;
+   }
+
+   void bvh::remove(std::uint32_t proxy)
+   {
+      remove_leaf(proxy);
+      free_node(proxy);
+      --m_leaf_count;
+   }
+
+   auto bvh::move(std::uint32_t proxy, const aabb& bounds) -> bool
+   {
+      m_nodes[proxy].tight = bounds;
+
+      if (m_nodes[proxy].fat.contains(bounds))
+      {
+         return false;
+      }
+
+      remove_leaf(proxy);
+
+      m_nodes[proxy].fat = {.min = bounds.min - glm::vec3{m_margin},
+                            .max = bounds.max + glm::vec3{m_margin}};
+
+      insert_leaf(proxy);
+
+      return true;
+   }
+
+   void bvh::set_user_data(std::uint32_t proxy, std::uint32_t user_data) noexcept
+   {
+      m_nodes[proxy].user_data = user_data;
+   }
+   auto bvh::user_data(std::uint32_t proxy) const noexcept -> std::uint32_t
+   {
+      return m_nodes[proxy].user_data;
+   }
+   auto bvh::fat_bounds(std::uint32_t proxy) const noexcept -> const aabb&
+   {
+      return m_nodes[proxy].fat;
+   }
+
+   void bvh::query_frustum(const frustum& frustum, util::dynamic_array<std::uint32_t>& out) const
+   {
+      if (m_root == null_node)
+      {
+         return;
+      }
+
+      traversal_stack stack{};
+      stack.push_back(m_root);
+
+      while (!stack.empty())
+      {
+         const std::uint32_t index = stack.back();
+         stack.pop_back();
+
+         const auto& n = m_nodes[index];
+         if (n.is_leaf())
+         {
+            if (classify(n.tight, frustum) != containment::outside)
+            {
+               out.push_back(n.user_data);
+            }
+
+            continue;
+         }
+
+         const auto result = classify(n.fat, frustum);
+         if (result == containment::inside)
+         {
+            collect_leaves(index, out);
+         }
+         else if (result == containment::intersecting)
+         {
+            stack.push_back(n.child_a);
+            stack.push_back(n.child_b);
+         }
+      }
+   }
+
+   void bvh::query_aabb(const aabb& bounds, util::dynamic_array<std::uint32_t>& out) const
+   {
+      if (m_root == null_node)
+      {
+         return;
+      }
+
+      traversal_stack stack{};
+      stack.push_back(m_root);
+
+      while (!stack.empty())
+      {
+         const std::uint32_t index = stack.back();
+         stack.pop_back();
+
+         const auto& n = m_nodes[index];
+         if (n.is_leaf())
+         {
+            if (n.tight.overlaps(bounds))
+            {
+               out.push_back(n.user_data);
+            }
+         }
+         else if (n.fat.overlaps(bounds))
+         {
+            stack.push_back(n.child_a);
+            stack.push_back(n.child_b);
+         }
+      }
+   }
+
+   auto bvh::raycast(const glm::vec3& origin, const glm::vec3& direction,
+                     float max_distance) const -> std::optional<ray_hit>
+   {
+      if (m_root == null_node)
+      {
+         return std::nullopt;
+      }
+
+      const glm::vec3 inv_direction{1.0F / direction.x, 1.0F / direction.y, 1.0F / direction.z};
+
+      std::optional<ray_hit> closest{};
+      float closest_distance = max_distance;
+
+      traversal_stack stack{};
+      stack.push_back(m_root);
+
+      while (!stack.empty())
+      {
+         const std::uint32_t index = stack.back();
+         stack.pop_back();
+
+         const auto& n = m_nodes[index];
+         if (n.is_leaf())
+         {
+            if (auto t = intersect_ray(n.tight, origin, inv_direction, closest_distance))
+            {
+               closest_distance = *t;
+               closest = ray_hit{.user_data = n.user_data, .distance = *t};
+            }
+         }
+         else if (intersect_ray(n.fat, origin, inv_direction, closest_distance))
+         {
+            stack.push_back(n.child_a);
+            stack.push_back(n.child_b);
+         }
+      }
+
+      return closest;
+   }
+
+   auto bvh::height() const noexcept -> std::int32_t
+   {
+      return m_root == null_node ? 0 : m_nodes[m_root].height;
+   }
+   auto bvh::size() const noexcept -> std::size_t { return m_leaf_count; }
+
+   void bvh::clear() noexcept
+   {
+      m_nodes.clear();
+      m_root = null_node;
+      m_free_list = null_node;
+      m_leaf_count = 0;
+   }
+
+   auto bvh::allocate_node() -> std::uint32_t
+   {
+      if (m_free_list == null_node)
+      {
+         m_nodes.emplace_back();
+         return static_cast<std::uint32_t>(std::size(m_nodes) - 1);
+      }
+
+      // Free nodes are chained through their parent index
+      const std::uint32_t index = m_free_list;
+      m_free_list = m_nodes[index].parent;
+      m_nodes[index] = node{};
+
+      return index;
+   }
+
+   void bvh::free_node(std::uint32_t index) noexcept
+   {
+      m_nodes[index].parent = m_free_list;
+      m_nodes[index].height = -1;
+      m_free_list = index;
+   }
+
+   void bvh::insert_leaf(std::uint32_t leaf)
+   {
+      if (m_root == null_node)
+      {
+         m_root = leaf;
+         m_nodes[leaf].parent = null_node;
+         return;
+      }
+
+      // Find the best sibling using the surface area heuristic
+      const aabb leaf_box = m_nodes[leaf].fat;
+
+      std::uint32_t index = m_root;
+      while (!m_nodes[index].is_leaf())
+      {
+         const auto& current = m_nodes[index];
+
+         const float area = current.fat.surface_area();
+         const float combined_area = merge(current.fat, leaf_box).surface_area();
+
+         const float cost = 2.0F * combined_area;
+         const float inheritance_cost = 2.0F * (combined_area - area);
+
+         const auto child_cost = [&](std::uint32_t child) noexcept {
+            const auto& c = m_nodes[child];
+            const float merged_area = merge(leaf_box, c.fat).surface_area();
+
+            return c.is_leaf() ? merged_area + inheritance_cost
+                               : merged_area - c.fat.surface_area() + inheritance_cost;
+         };
+
+         const float cost_a = child_cost(current.child_a);
+         const float cost_b = child_cost(current.child_b);
+
+         if (cost < cost_a && cost < cost_b)
+         {
+            break;
+         }
+
+         index = cost_a < cost_b ? current.child_a : current.child_b;
+      }
+
+      const std::uint32_t sibling = index;
+      const std::uint32_t old_parent = m_nodes[sibling].parent;
+      const std::uint32_t new_parent = allocate_node();
+
+      m_nodes[new_parent].parent = old_parent;
+      m_nodes[new_parent].fat = merge(leaf_box, m_nodes[sibling].fat);
+      m_nodes[new_parent].height = m_nodes[sibling].height + 1;
+      m_nodes[new_parent].child_a = sibling;
+      m_nodes[new_parent].child_b = leaf;
+
+      if (old_parent != null_node)
+      {
+         if (m_nodes[old_parent].child_a == sibling)
+         {
+            m_nodes[old_parent].child_a = new_parent;
+         }
+         else
+         {
+            m_nodes[old_parent].child_b = new_parent;
+         }
+      }
+      else
+      {
+         m_root = new_parent;
+      }
+
+      m_nodes[sibling].parent = new_parent;
+      m_nodes[leaf].parent = new_parent;
+
+      refit_ancestors(m_nodes[leaf].parent);
+   }
+
+   void bvh::remove_leaf(std::uint32_t leaf)
+   {
+      if (leaf == m_root)
+      {
+         m_root = null_node;
+         return;
+      }
+
+      const std::uint32_t parent = m_nodes[leaf].parent;
+      const std::uint32_t grand_parent = m_nodes[parent].parent;
+      const std::uint32_t sibling =
+         m_nodes[parent].child_a == leaf ? m_nodes[parent].child_b : m_nodes[parent].child_a;
+
+      if (grand_parent != null_node)
+      {
+         if (m_nodes[grand_parent].child_a == parent)
+         {
+            m_nodes[grand_parent].child_a = sibling;
+         }
+         else
+         {
+            m_nodes[grand_parent].child_b = sibling;
+         }
+
+         m_nodes[sibling].parent = grand_parent;
+         free_node(parent);
+
+         refit_ancestors(grand_parent);
+      }
+      else
+      {
+         m_root = sibling;
+         m_nodes[sibling].parent = null_node;
+         free_node(parent);
+      }
+   }
+
+   void bvh::refit_ancestors(std::uint32_t index)
+   {
+      while (index != null_node)
+      {
+         index = balance(index);
+
+         auto& n = m_nodes[index];
+         const auto& a = m_nodes[n.child_a];
+         const auto& b = m_nodes[n.child_b];
+
+         n.height = 1 + std::max(a.height, b.height);
+         n.fat = merge(a.fat, b.fat);
+
+         index = n.parent;
+      }
+   }
+
+   auto bvh::balance(std::uint32_t i_a) -> std::uint32_t
+   {
+      auto& a = m_nodes[i_a];
+      if (a.is_leaf() || a.height < 2)
+      {
+         return i_a;
+      }
+
+      const std::uint32_t i_b = a.child_a;
+      const std::uint32_t i_c = a.child_b;
+      auto& b = m_nodes[i_b];
+      auto& c = m_nodes[i_c];
+
+      const auto replace_in_parent = [&](std::uint32_t old_child, std::uint32_t new_child) {
+         const std::uint32_t parent = m_nodes[new_child].parent;
+         if (parent == null_node)
+         {
+            m_root = new_child;
+         }
+         else if (m_nodes[parent].child_a == old_child)
+         {
+            m_nodes[parent].child_a = new_child;
+         }
+         else
+         {
+            m_nodes[parent].child_b = new_child;
+         }
+      };
+
+      const std::int32_t balance = c.height - b.height;
+
+      // Rotate C up
+      if (balance > 1)
+      {
+         const std::uint32_t i_f = c.child_a;
+         const std::uint32_t i_g = c.child_b;
+         auto& f = m_nodes[i_f];
+         auto& g = m_nodes[i_g];
+
+         c.child_a = i_a;
+         c.parent = a.parent;
+         a.parent = i_c;
+
+         replace_in_parent(i_a, i_c);
+
+         if (f.height > g.height)
+         {
+            c.child_b = i_f;
+            a.child_b = i_g;
+            g.parent = i_a;
+            a.fat = merge(b.fat, g.fat);
+            c.fat = merge(a.fat, f.fat);
+
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+         }
+         else
+         {
+            c.child_b = i_g;
+            a.child_b = i_f;
+            f.parent = i_a;
+            a.fat = merge(b.fat, f.fat);
+            c.fat = merge(a.fat, g.fat);
+
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+         }
+
+         return i_c;
+      }
+
+      // Rotate B up
+      if (balance < -1)
+      {
+         const std::uint32_t i_d = b.child_a;
+         const std::uint32_t i_e = b.child_b;
+         auto& d = m_nodes[i_d];
+         auto& e = m_nodes[i_e];
+
+         b.child_a = i_a;
+         b.parent = a.parent;
+         a.parent = i_b;
+
+         replace_in_parent(i_a, i_b);
+
+         if (d.height > e.height)
+         {
+            b.child_b = i_d;
+            a.child_a = i_e;
+            e.parent = i_a;
+            a.fat = merge(c.fat, e.fat);
+            b.fat = merge(a.fat, d.fat);
+
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+         }
+         else
+         {
+            b.child_b = i_e;
+            a.child_a = i_d;
+            d.parent = i_a;
+            a.fat = merge(c.fat, d.fat);
+            b.fat = merge(a.fat, e.fat);
+
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+         }
+
+         return i_b;
+      }
+
+      return i_a;
+   }
+
+   void bvh::collect_leaves(std::uint32_t index, util::dynamic_array<std::uint32_t>& out) const
+   {
+      traversal_stack stack{};
+      stack.push_back(index);
+
+      while (!stack.empty())
+      {
+         const auto& n = m_nodes[stack.back()];
+         stack.pop_back();
+
+         if (n.is_leaf())
+         {
+            out.push_back(n.user_data);
+         }
+         else
+         {
+            stack.push_back(n.child_a);
+            stack.push_back(n.child_b);
+         }
+      }
+   }
+} // namespace gfx
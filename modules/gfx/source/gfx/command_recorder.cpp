@@ -0,0 +1,149 @@
+#include <gfx/command_recorder.hpp>
+
+#include <util/stats.hpp>
+
+#include <algorithm>
+
+namespace gfx
+{
+   command_recorder::command_recorder(vk::CommandBuffer buffer) noexcept : m_buffer{buffer} {}
+
+   void command_recorder::bind_pipeline(vk::Pipeline pipeline, vk::PipelineLayout layout)
+   {
+      if (pipeline == m_pipeline)
+      {
+         ++m_elided_bind_count;
+         util::stats::increment(util::stats::counter::elided_binds);
+
+         return;
+      }
+
+      m_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+      util::stats::increment(util::stats::counter::pipeline_binds);
+
+      m_pipeline = pipeline;
+      if (layout != m_layout)
+      {
+         // Sets bound with an incompatible layout may be disturbed, assume they all are
+         m_layout = layout;
+         m_descriptor_sets.fill(vk::DescriptorSet{});
+      }
+   }
+
+   void command_recorder::bind_descriptor_sets(std::uint32_t first_set,
+                                               std::span<const vk::DescriptorSet> sets,
+                                               std::span<const std::uint32_t> dynamic_offsets)
+   {
+      const bool is_tracked = first_set + std::size(sets) <= max_descriptor_sets &&
+         (std::empty(dynamic_offsets) || std::size(dynamic_offsets) == std::size(sets));
+      const auto first_offset =
+         std::begin(m_dynamic_offsets) + std::min<std::size_t>(first_set, max_descriptor_sets);
+
+      if (is_tracked &&
+          std::equal(std::begin(sets), std::end(sets), std::begin(m_descriptor_sets) + first_set) &&
+          (std::empty(dynamic_offsets) ||
+           std::equal(std::begin(dynamic_offsets), std::end(dynamic_offsets), first_offset)))
+      {
+         ++m_elided_bind_count;
+         util::stats::increment(util::stats::counter::elided_binds);
+
+         return;
+      }
+
+      m_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_layout, first_set,
+                                  static_cast<std::uint32_t>(std::size(sets)), std::data(sets),
+                                  static_cast<std::uint32_t>(std::size(dynamic_offsets)),
+                                  std::data(dynamic_offsets));
+      util::stats::increment(util::stats::counter::descriptor_binds);
+
+      if (is_tracked)
+      {
+         std::copy(std::begin(sets), std::end(sets), std::begin(m_descriptor_sets) + first_set);
+         std::copy(std::begin(dynamic_offsets), std::end(dynamic_offsets), first_offset);
+      }
+   }
+
+   void command_recorder::bind_vertex_buffer(std::uint32_t binding, vk::Buffer buffer,
+                                             vk::DeviceSize offset)
+   {
+      const bool is_tracked = binding < max_vertex_bindings;
+      if (is_tracked && m_vertex_buffers[binding] == buffer && m_vertex_offsets[binding] == offset)
+      {
+         ++m_elided_bind_count;
+         util::stats::increment(util::stats::counter::elided_binds);
+
+         return;
+      }
+
+      m_buffer.bindVertexBuffers(binding, {buffer}, {offset});
+
+      if (is_tracked)
+      {
+         m_vertex_buffers[binding] = buffer;
+         m_vertex_offsets[binding] = offset;
+      }
+   }
+
+   void command_recorder::bind_index_buffer(vk::Buffer buffer, vk::IndexType type,
+                                            vk::DeviceSize offset)
+   {
+      if (m_index_buffer == buffer && m_index_offset == offset && m_index_type == type)
+      {
+         ++m_elided_bind_count;
+         util::stats::increment(util::stats::counter::elided_binds);
+
+         return;
+      }
+
+      m_buffer.bindIndexBuffer(buffer, offset, type);
+
+      m_index_buffer = buffer;
+      m_index_offset = offset;
+      m_index_type = type;
+   }
+
+   void command_recorder::push_constants(vk::ShaderStageFlags stages, std::uint32_t offset,
+                                         std::uint32_t size, const void* p_values)
+   {
+      m_buffer.pushConstants(m_layout, stages, offset, size, p_values);
+   }
+
+   void command_recorder::draw_indexed(std::uint32_t index_count, std::uint32_t instance_count,
+                                       std::uint32_t first_index, std::int32_t vertex_offset,
+                                       std::uint32_t first_instance)
+   {
+      m_buffer.drawIndexed(index_count, instance_count, first_index, vertex_offset,
+                           first_instance);
+
+      ++m_draw_count;
+      util::stats::increment(util::stats::counter::draw_calls);
+   }
+   void command_recorder::draw_indexed_indirect(vk::Buffer buffer, vk::DeviceSize offset,
+                                                std::uint32_t draw_count, std::uint32_t stride)
+   {
+      m_buffer.drawIndexedIndirect(buffer, offset, draw_count, stride);
+
+      m_draw_count += draw_count;
+      util::stats::increment(util::stats::counter::draw_calls, draw_count);
+   }
+
+   void command_recorder::reset() noexcept
+   {
+      m_pipeline = vk::Pipeline{};
+      m_layout = vk::PipelineLayout{};
+      m_descriptor_sets.fill(vk::DescriptorSet{});
+      m_dynamic_offsets.fill(0);
+      m_vertex_buffers.fill(vk::Buffer{});
+      m_vertex_offsets.fill(0);
+      m_index_buffer = vk::Buffer{};
+      m_index_offset = 0;
+      m_index_type = vk::IndexType::eUint32;
+   }
+
+   auto command_recorder::buffer() const noexcept -> vk::CommandBuffer { return m_buffer; }
+   auto command_recorder::elided_bind_count() const noexcept -> std::uint32_t
+   {
+      return m_elided_bind_count;
+   }
+   auto command_recorder::draw_count() const noexcept -> std::uint32_t { return m_draw_count; }
+} // namespace gfx
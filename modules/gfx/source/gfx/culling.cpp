@@ -0,0 +1,381 @@
+#include <gfx/culling.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(__AVX__)
+#   include <immintrin.h>
+#endif
+
+namespace gfx
+{
+   auto compute_bounding_sphere(std::span<const vertex> vertices) noexcept -> bounding_sphere
+   {
+      if (std::empty(vertices))
+      {
+         return {};
+      }
+
+      glm::vec3 min{std::numeric_limits<float>::max()};
+      glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+      for (const auto& v : vertices)
+      {
+         min = glm::min(min, v.position);
+         max = glm::max(max, v.position);
+      }
+
+      const glm::vec3 center = (min + max) * 0.5F;
+
+      float radius_sq = 0.0F;
+      for (const auto& v : vertices)
+      {
+         const glm::vec3 diff = v.position - center;
+         radius_sq = std::max(radius_sq, glm::dot(diff, diff));
+      }
+
+      return {.center = center, .radius = std::sqrt(radius_sq)};
+   }
+
+   auto transform_sphere(const bounding_sphere& sphere, const glm::mat4& model) noexcept
+      -> bounding_sphere
+   {
+      const float scale_x = glm::dot(glm::vec3{model[0]}, glm::vec3{model[0]});
+      const float scale_y = glm::dot(glm::vec3{model[1]}, glm::vec3{model[1]});
+      const float scale_z = glm::dot(glm::vec3{model[2]}, glm::vec3{model[2]});
+
+      return {.center = glm::vec3{model * glm::vec4{sphere.center, 1.0F}},
+              .radius = sphere.radius * std::sqrt(std::max({scale_x, scale_y, scale_z}))};
+   }
+
+   auto extract_frustum(const glm::mat4& view_projection) noexcept -> frustum
+   {
+      const auto row = [&](int i) noexcept {
+         return glm::vec4{view_projection[0][i], view_projection[1][i], view_projection[2][i],
+                          view_projection[3][i]};
+      };
+
+      frustum result{.planes = {row(3) + row(0), row(3) - row(0), row(3) + row(1),
+                                row(3) - row(1), row(3) + row(2), row(3) - row(2)}};
+
+      for (auto& plane : result.planes)
+      {
+         plane /= glm::length(glm::vec3{plane});
+      }
+
+      return result;
+   }
+
+   auto intersects(const frustum& frustum, const bounding_sphere& sphere) noexcept -> bool
+   {
+      return std::ranges::all_of(frustum.planes, [&](const glm::vec4& plane) {
+         return glm::dot(glm::vec3{plane}, sphere.center) + plane.w >= -sphere.radius;
+      });
+   }
+
+   void sphere_soa::push_back(const bounding_sphere& sphere)
+   {
+      center_x.push_back(sphere.center.x);
+      center_y.push_back(sphere.center.y);
+      center_z.push_back(sphere.center.z);
+      radius.push_back(sphere.radius);
+   }
+   void sphere_soa::set(std::size_t index, const bounding_sphere& sphere) noexcept
+   {
+      center_x[index] = sphere.center.x;
+      center_y[index] = sphere.center.y;
+      center_z[index] = sphere.center.z;
+      radius[index] = sphere.radius;
+   }
+   void sphere_soa::swap_and_pop(std::size_t index) noexcept
+   {
+      const std::size_t last = size() - 1;
+
+      center_x[index] = center_x[last];
+      center_y[index] = center_y[last];
+      center_z[index] = center_z[last];
+      radius[index] = radius[last];
+
+      center_x.pop_back();
+      center_y.pop_back();
+      center_z.pop_back();
+      radius.pop_back();
+   }
+   void sphere_soa::clear() noexcept
+   {
+      center_x.clear();
+      center_y.clear();
+      center_z.clear();
+      radius.clear();
+   }
+   auto sphere_soa::size() const noexcept -> std::size_t { return std::size(radius); }
+
+   auto projection_scale(const glm::mat4& perspective, float viewport_height) noexcept -> float
+   {
+      // The y scale of the projection is cot(fov / 2), negated when the y axis is flipped
+      return std::abs(perspective[1][1]) * viewport_height * 0.5F;
+   }
+   auto make_sphere_projection(const glm::mat4& view, float projection_scale) noexcept
+      -> sphere_projection
+   {
+      // Only the depth row of the view matrix is needed
+      return {.depth_row = {view[0][2], view[1][2], view[2][2], view[3][2]},
+              .scale = projection_scale};
+   }
+
+   void cull_spheres(const frustum& frustum, const sphere_soa& spheres,
+                     util::dynamic_array<std::uint32_t>& visible)
+   {
+      util::dynamic_array<float> unused;
+
+#if defined(__AVX__)
+      detail::cull_spheres_avx(frustum, nullptr, spheres, visible, unused);
+#elif defined(__SSE2__) || defined(_M_X64)
+      detail::cull_spheres_sse(frustum, nullptr, spheres, visible, unused);
+#else
+      detail::cull_spheres_scalar(frustum, nullptr, spheres, 0, visible, unused);
+#endif
+   }
+   void cull_spheres(const frustum& frustum, const sphere_projection& projection,
+                     const sphere_soa& spheres, util::dynamic_array<std::uint32_t>& visible,
+                     util::dynamic_array<float>& projected_radii)
+   {
+#if defined(__AVX__)
+      detail::cull_spheres_avx(frustum, &projection, spheres, visible, projected_radii);
+#elif defined(__SSE2__) || defined(_M_X64)
+      detail::cull_spheres_sse(frustum, &projection, spheres, visible, projected_radii);
+#else
+      detail::cull_spheres_scalar(frustum, &projection, spheres, 0, visible, projected_radii);
+#endif
+   }
+
+   void project_spheres(const sphere_projection& projection, const sphere_soa& spheres,
+                        std::span<const std::uint32_t> visible,
+                        util::dynamic_array<float>& projected_radii)
+   {
+      projected_radii.clear();
+      projected_radii.reserve(std::size(visible));
+
+      for (const std::uint32_t i : visible)
+      {
+         projected_radii.push_back(detail::project_sphere(projection, spheres, i));
+      }
+   }
+
+   auto select_lod(std::span<const mesh_lod> lods, float pixels_per_unit, float threshold) noexcept
+      -> std::uint32_t
+   {
+      for (auto i = static_cast<std::uint32_t>(std::size(lods)); i > 1; --i)
+      {
+         if (lods[i - 1].error * pixels_per_unit <= threshold)
+         {
+            return i - 1;
+         }
+      }
+
+      return 0;
+   }
+
+   namespace detail
+   {
+      auto project_sphere(const sphere_projection& projection, const sphere_soa& spheres,
+                          std::size_t index) noexcept -> float
+      {
+         const auto& row = projection.depth_row;
+         const float depth = -(row.x * spheres.center_x[index] + row.y * spheres.center_y[index] +
+                               row.z * spheres.center_z[index] + row.w);
+         const float radius = spheres.radius[index];
+
+         return depth > radius ? radius * projection.scale / depth
+                               : std::numeric_limits<float>::infinity();
+      }
+
+      void cull_spheres_scalar(const frustum& frustum, const sphere_projection* p_projection,
+                               const sphere_soa& spheres, std::size_t first,
+                               util::dynamic_array<std::uint32_t>& visible,
+                               util::dynamic_array<float>& projected_radii)
+      {
+         for (std::size_t i = first; i < spheres.size(); ++i)
+         {
+            bool is_visible = true;
+            for (const auto& plane : frustum.planes)
+            {
+               const float distance = plane.x * spheres.center_x[i] +
+                  plane.y * spheres.center_y[i] + plane.z * spheres.center_z[i] + plane.w;
+
+               if (distance < -spheres.radius[i])
+               {
+                  is_visible = false;
+                  break;
+               }
+            }
+
+            if (is_visible)
+            {
+               visible.push_back(static_cast<std::uint32_t>(i));
+               if (p_projection)
+               {
+                  projected_radii.push_back(project_sphere(*p_projection, spheres, i));
+               }
+            }
+         }
+      }
+
+#if defined(__SSE2__) || defined(_M_X64)
+      void cull_spheres_sse(const frustum& frustum, const sphere_projection* p_projection,
+                            const sphere_soa& spheres, util::dynamic_array<std::uint32_t>& visible,
+                            util::dynamic_array<float>& projected_radii)
+      {
+         constexpr std::size_t lane_count = 4;
+
+         const std::size_t count = spheres.size();
+         const std::size_t simd_count = count - count % lane_count;
+
+         const __m128 sign_mask = _mm_set1_ps(-0.0F);
+         const __m128 infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+
+         for (std::size_t i = 0; i < simd_count; i += lane_count)
+         {
+            const __m128 x = _mm_loadu_ps(&spheres.center_x[i]);
+            const __m128 y = _mm_loadu_ps(&spheres.center_y[i]);
+            const __m128 z = _mm_loadu_ps(&spheres.center_z[i]);
+            const __m128 neg_radius = _mm_xor_ps(_mm_loadu_ps(&spheres.radius[i]), sign_mask);
+
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (const auto& plane : frustum.planes)
+            {
+               __m128 distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)),
+                                            _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+               distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+               distance = _mm_add_ps(distance, _mm_set1_ps(plane.w));
+
+               inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, neg_radius));
+            }
+
+            auto mask = static_cast<std::uint32_t>(_mm_movemask_ps(inside));
+            if (mask == 0)
+            {
+               continue;
+            }
+
+            // The lanes are projected with the registers already loaded, the spheres inside of
+            // the camera get an infinite radius
+            std::array<float, lane_count> radii{};
+            if (p_projection)
+            {
+               const auto& row = p_projection->depth_row;
+               __m128 depth = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(row.x)),
+                                         _mm_mul_ps(y, _mm_set1_ps(row.y)));
+               depth = _mm_add_ps(depth, _mm_mul_ps(z, _mm_set1_ps(row.z)));
+               depth = _mm_xor_ps(_mm_add_ps(depth, _mm_set1_ps(row.w)), sign_mask);
+
+               const __m128 radius = _mm_xor_ps(neg_radius, sign_mask);
+               const __m128 projected =
+                  _mm_div_ps(_mm_mul_ps(radius, _mm_set1_ps(p_projection->scale)), depth);
+               const __m128 is_outside = _mm_cmpgt_ps(depth, radius);
+
+               _mm_storeu_ps(std::data(radii), _mm_or_ps(_mm_and_ps(is_outside, projected),
+                                                         _mm_andnot_ps(is_outside, infinity)));
+            }
+
+            while (mask != 0)
+            {
+               const auto lane = static_cast<std::uint32_t>(std::countr_zero(mask));
+
+               visible.push_back(static_cast<std::uint32_t>(i) + lane);
+               if (p_projection)
+               {
+                  projected_radii.push_back(radii[lane]);
+               }
+
+               mask &= mask - 1;
+            }
+         }
+
+         cull_spheres_scalar(frustum, p_projection, spheres, simd_count, visible,
+                             projected_radii);
+      }
+#endif
+
+#if defined(__AVX__)
+      void cull_spheres_avx(const frustum& frustum, const sphere_projection* p_projection,
+                            const sphere_soa& spheres, util::dynamic_array<std::uint32_t>& visible,
+                            util::dynamic_array<float>& projected_radii)
+      {
+         constexpr std::size_t lane_count = 8;
+
+         const std::size_t count = spheres.size();
+         const std::size_t simd_count = count - count % lane_count;
+
+         const __m256 sign_mask = _mm256_set1_ps(-0.0F);
+         const __m256 infinity = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+
+         for (std::size_t i = 0; i < simd_count; i += lane_count)
+         {
+            const __m256 x = _mm256_loadu_ps(&spheres.center_x[i]);
+            const __m256 y = _mm256_loadu_ps(&spheres.center_y[i]);
+            const __m256 z = _mm256_loadu_ps(&spheres.center_z[i]);
+            const __m256 neg_radius =
+               _mm256_xor_ps(_mm256_loadu_ps(&spheres.radius[i]), sign_mask);
+
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (const auto& plane : frustum.planes)
+            {
+               __m256 distance = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(plane.x)),
+                                               _mm256_mul_ps(y, _mm256_set1_ps(plane.y)));
+               distance = _mm256_add_ps(distance, _mm256_mul_ps(z, _mm256_set1_ps(plane.z)));
+               distance = _mm256_add_ps(distance, _mm256_set1_ps(plane.w));
+
+               inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, neg_radius, _CMP_GE_OQ));
+            }
+
+            auto mask = static_cast<std::uint32_t>(_mm256_movemask_ps(inside));
+            if (mask == 0)
+            {
+               continue;
+            }
+
+            // The lanes are projected with the registers already loaded, the spheres inside of
+            // the camera get an infinite radius
+            std::array<float, lane_count> radii{};
+            if (p_projection)
+            {
+               const auto& row = p_projection->depth_row;
+               __m256 depth = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(row.x)),
+                                            _mm256_mul_ps(y, _mm256_set1_ps(row.y)));
+               depth = _mm256_add_ps(depth, _mm256_mul_ps(z, _mm256_set1_ps(row.z)));
+               depth = _mm256_xor_ps(_mm256_add_ps(depth, _mm256_set1_ps(row.w)), sign_mask);
+
+               const __m256 radius = _mm256_xor_ps(neg_radius, sign_mask);
+               const __m256 projected =
+                  _mm256_div_ps(_mm256_mul_ps(radius, _mm256_set1_ps(p_projection->scale)), depth);
+               const __m256 is_outside = _mm256_cmp_ps(depth, radius, _CMP_GT_OQ);
+
+               _mm256_storeu_ps(std::data(radii),
+                                _mm256_or_ps(_mm256_and_ps(is_outside, projected),
+                                             _mm256_andnot_ps(is_outside, infinity)));
+            }
+
+            while (mask != 0)
+            {
+               const auto lane = static_cast<std::uint32_t>(std::countr_zero(mask));
+
+               visible.push_back(static_cast<std::uint32_t>(i) + lane);
+               if (p_projection)
+               {
+                  projected_radii.push_back(radii[lane]);
+               }
+
+               mask &= mask - 1;
+            }
+         }
+
+         cull_spheres_scalar(frustum, p_projection, spheres, simd_count, visible,
+                             projected_radii);
+      }
+#endif
+   } // namespace detail
+} // namespace gfx
@@ -0,0 +1,336 @@
+#include <gfx/dds.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+
+namespace gfx
+{
+   struct dds_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override { return "gfx_dds"; }
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return to_string(static_cast<dds_error>(err));
+      }
+   };
+   inline static const dds_error_category m_dds_category{};
+
+   auto to_string(dds_error err) -> std::string
+   {
+      switch (err)
+      {
+         case dds_error::file_too_small:
+            return "file_too_small";
+         case dds_error::invalid_magic:
+            return "invalid_magic";
+         case dds_error::unsupported_format:
+            return "unsupported_format";
+         case dds_error::unsupported_dimension:
+            return "unsupported_dimension";
+         case dds_error::truncated_data:
+            return "truncated_data";
+         default:
+            return "UNKNOWN";
+      }
+   }
+
+   auto make_error(dds_error err) noexcept -> error_t
+   {
+      return {{static_cast<int>(err), m_dds_category}};
+   }
+
+   namespace
+   {
+      constexpr auto four_cc(const char (&code)[5]) noexcept -> std::uint32_t // NOLINT
+      {
+         return static_cast<std::uint32_t>(code[0]) | (static_cast<std::uint32_t>(code[1]) << 8U) |
+            (static_cast<std::uint32_t>(code[2]) << 16U) |
+            (static_cast<std::uint32_t>(code[3]) << 24U);
+      }
+
+      // Byte offsets of the fields read from the file, the magic included
+      constexpr std::size_t header_size = 128;
+      constexpr std::size_t dx10_header_size = 20;
+
+      constexpr std::size_t size_offset = 4;
+      constexpr std::size_t flags_offset = 8;
+      constexpr std::size_t height_offset = 12;
+      constexpr std::size_t width_offset = 16;
+      constexpr std::size_t linear_size_offset = 20;
+      constexpr std::size_t mip_count_offset = 28;
+      constexpr std::size_t pixel_format_size_offset = 76;
+      constexpr std::size_t pixel_flags_offset = 80;
+      constexpr std::size_t four_cc_offset = 84;
+      constexpr std::size_t rgb_bit_count_offset = 88;
+      constexpr std::size_t red_mask_offset = 92;
+      constexpr std::size_t alpha_mask_offset = 104;
+      constexpr std::size_t caps_offset = 108;
+      constexpr std::size_t caps2_offset = 112;
+
+      constexpr std::size_t dxgi_format_offset = 128;
+      constexpr std::size_t dimension_offset = 132;
+      constexpr std::size_t misc_flags_offset = 136;
+      constexpr std::size_t array_size_offset = 140;
+
+      constexpr std::uint32_t header_flags = 0x1 | 0x2 | 0x4 | 0x1000; // NOLINT
+      constexpr std::uint32_t header_flag_pitch = 0x8;
+      constexpr std::uint32_t header_flag_mip_count = 0x20000;
+      constexpr std::uint32_t header_flag_linear_size = 0x80000;
+      constexpr std::uint32_t caps_texture = 0x1000;
+      constexpr std::uint32_t caps_mipmap = 0x400000 | 0x8; // NOLINT
+
+      constexpr std::uint32_t pixel_flag_four_cc = 0x4;
+      constexpr std::uint32_t pixel_flag_rgb = 0x40;
+      constexpr std::uint32_t caps2_cubemap = 0x200;
+      constexpr std::uint32_t caps2_volume = 0x200000;
+      constexpr std::uint32_t misc_flag_cubemap = 0x4;
+      constexpr std::uint32_t dimension_texture_2d = 3;
+
+      // The DXGI_FORMAT values of the supported formats
+      enum struct dxgi_format : std::uint32_t
+      {
+         r8g8b8a8_unorm = 28,
+         r8g8b8a8_unorm_srgb = 29,
+         bc1_unorm = 71,
+         bc1_unorm_srgb = 72,
+         bc3_unorm = 77,
+         bc3_unorm_srgb = 78,
+         bc5_unorm = 83,
+         bc7_unorm = 98,
+         bc7_unorm_srgb = 99
+      };
+
+      auto read_u32(std::span<const std::byte> bytes, std::size_t offset) noexcept
+         -> std::uint32_t
+      {
+         return std::to_integer<std::uint32_t>(bytes[offset]) |
+            (std::to_integer<std::uint32_t>(bytes[offset + 1]) << 8U) |
+            (std::to_integer<std::uint32_t>(bytes[offset + 2]) << 16U) |
+            (std::to_integer<std::uint32_t>(bytes[offset + 3]) << 24U);
+      }
+
+      void write_u32(std::span<std::byte> bytes, std::size_t offset, std::uint32_t value) noexcept
+      {
+         for (std::size_t i = 0; i < 4; ++i)
+         {
+            bytes[offset + i] = static_cast<std::byte>((value >> (8U * i)) & 0xFFU);
+         }
+      }
+
+      struct format_info
+      {
+         texel_format format;
+         bool is_srgb;
+      };
+
+      auto from_dxgi(std::uint32_t format) noexcept -> std::optional<format_info>
+      {
+         switch (static_cast<dxgi_format>(format))
+         {
+            case dxgi_format::r8g8b8a8_unorm:
+               return format_info{texel_format::rgba8, false};
+            case dxgi_format::r8g8b8a8_unorm_srgb:
+               return format_info{texel_format::rgba8, true};
+            case dxgi_format::bc1_unorm:
+               return format_info{texel_format::bc1, false};
+            case dxgi_format::bc1_unorm_srgb:
+               return format_info{texel_format::bc1, true};
+            case dxgi_format::bc3_unorm:
+               return format_info{texel_format::bc3, false};
+            case dxgi_format::bc3_unorm_srgb:
+               return format_info{texel_format::bc3, true};
+            case dxgi_format::bc5_unorm:
+               return format_info{texel_format::bc5, false};
+            case dxgi_format::bc7_unorm:
+               return format_info{texel_format::bc7, false};
+            case dxgi_format::bc7_unorm_srgb:
+               return format_info{texel_format::bc7, true};
+            default:
+               return std::nullopt;
+         }
+      }
+
+      auto to_dxgi(texel_format format, bool is_srgb) noexcept -> dxgi_format
+      {
+         switch (format)
+         {
+            case texel_format::bc1:
+               return is_srgb ? dxgi_format::bc1_unorm_srgb : dxgi_format::bc1_unorm;
+            case texel_format::bc3:
+               return is_srgb ? dxgi_format::bc3_unorm_srgb : dxgi_format::bc3_unorm;
+            case texel_format::bc5:
+               return dxgi_format::bc5_unorm;
+            case texel_format::bc7:
+               return is_srgb ? dxgi_format::bc7_unorm_srgb : dxgi_format::bc7_unorm;
+            default:
+               return is_srgb ? dxgi_format::r8g8b8a8_unorm_srgb : dxgi_format::r8g8b8a8_unorm;
+         }
+      }
+
+      /**
+       * Get the format described by a legacy pixel format header. Legacy files carry no colour
+       * space, they are assumed to be linear
+       */
+      auto from_legacy(std::span<const std::byte> bytes) noexcept -> std::optional<format_info>
+      {
+         const std::uint32_t flags = read_u32(bytes, pixel_flags_offset);
+
+         if (flags & pixel_flag_four_cc)
+         {
+            const std::uint32_t code = read_u32(bytes, four_cc_offset);
+            if (code == four_cc("DXT1"))
+            {
+               return format_info{texel_format::bc1, false};
+            }
+            if (code == four_cc("DXT5"))
+            {
+               return format_info{texel_format::bc3, false};
+            }
+            if (code == four_cc("ATI2") || code == four_cc("BC5U"))
+            {
+               return format_info{texel_format::bc5, false};
+            }
+
+            return std::nullopt;
+         }
+
+         if ((flags & pixel_flag_rgb) && read_u32(bytes, rgb_bit_count_offset) == 32 &&
+             read_u32(bytes, red_mask_offset) == 0x000000FF &&
+             read_u32(bytes, alpha_mask_offset) == 0xFF000000)
+         {
+            return format_info{texel_format::rgba8, false};
+         }
+
+         return std::nullopt;
+      }
+   } // namespace
+
+   auto parse_dds(std::span<const std::byte> bytes) -> gfx::result<dds_image>
+   {
+      if (std::size(bytes) < header_size)
+      {
+         return monad::make_error(make_error(dds_error::file_too_small));
+      }
+      if (read_u32(bytes, 0) != four_cc("DDS "))
+      {
+         return monad::make_error(make_error(dds_error::invalid_magic));
+      }
+      if (read_u32(bytes, caps2_offset) & (caps2_cubemap | caps2_volume))
+      {
+         return monad::make_error(make_error(dds_error::unsupported_dimension));
+      }
+
+      std::size_t data_offset = header_size;
+      std::optional<format_info> format;
+
+      const bool has_dx10_header = (read_u32(bytes, pixel_flags_offset) & pixel_flag_four_cc) &&
+         read_u32(bytes, four_cc_offset) == four_cc("DX10");
+      if (has_dx10_header)
+      {
+         if (std::size(bytes) < header_size + dx10_header_size)
+         {
+            return monad::make_error(make_error(dds_error::file_too_small));
+         }
+         if (read_u32(bytes, dimension_offset) != dimension_texture_2d ||
+             (read_u32(bytes, misc_flags_offset) & misc_flag_cubemap) ||
+             read_u32(bytes, array_size_offset) > 1)
+         {
+            return monad::make_error(make_error(dds_error::unsupported_dimension));
+         }
+
+         data_offset += dx10_header_size;
+         format = from_dxgi(read_u32(bytes, dxgi_format_offset));
+      }
+      else
+      {
+         format = from_legacy(bytes);
+      }
+
+      if (!format)
+      {
+         return monad::make_error(make_error(dds_error::unsupported_format));
+      }
+
+      vk::Extent2D extent{read_u32(bytes, width_offset), read_u32(bytes, height_offset)};
+      if (extent.width == 0 || extent.height == 0 || extent.width > max_dds_extent ||
+          extent.height > max_dds_extent)
+      {
+         return monad::make_error(make_error(dds_error::unsupported_dimension));
+      }
+
+      // Files without mips may leave the count at 0
+      const auto full_chain_length =
+         static_cast<std::uint32_t>(std::bit_width(std::max(extent.width, extent.height)));
+      const std::uint32_t mip_count =
+         std::clamp(read_u32(bytes, mip_count_offset), 1U, full_chain_length);
+
+      dds_image image{.format = format->format, .is_srgb = format->is_srgb};
+      for (std::uint32_t i = 0; i < mip_count; ++i)
+      {
+         const std::size_t size = image_size(image.format, extent);
+         if (std::size(bytes) - data_offset < size)
+         {
+            return monad::make_error(make_error(dds_error::truncated_data));
+         }
+
+         image.mips.push_back({.extent = extent, .data = bytes.subspan(data_offset, size)});
+
+         data_offset += size;
+         extent = {std::max(extent.width / 2, 1U), std::max(extent.height / 2, 1U)};
+      }
+
+      return image;
+   }
+
+   auto write_dds(const dds_image& image) -> util::dynamic_array<std::byte>
+   {
+      if (std::empty(image.mips))
+      {
+         return util::dynamic_array<std::byte>{};
+      }
+
+      std::size_t size = header_size + dx10_header_size;
+      for (const auto& mip : image.mips)
+      {
+         size += std::size(mip.data);
+      }
+
+      util::dynamic_array<std::byte> bytes(size);
+
+      const auto& extent = image.mips[0].extent;
+      const bool is_compressed = is_block_compressed(image.format);
+      const auto mip_count = static_cast<std::uint32_t>(std::size(image.mips));
+
+      const std::span<std::byte> header{std::data(bytes), header_size + dx10_header_size};
+      write_u32(header, 0, four_cc("DDS "));
+      write_u32(header, size_offset, header_size - 4);
+      write_u32(header, flags_offset,
+                header_flags | header_flag_mip_count |
+                   (is_compressed ? header_flag_linear_size : header_flag_pitch));
+      write_u32(header, height_offset, extent.height);
+      write_u32(header, width_offset, extent.width);
+      write_u32(header, linear_size_offset,
+                is_compressed ? static_cast<std::uint32_t>(image_size(image.format, extent))
+                              : extent.width * block_size(image.format));
+      write_u32(header, mip_count_offset, mip_count);
+      write_u32(header, pixel_format_size_offset, 32);
+      write_u32(header, pixel_flags_offset, pixel_flag_four_cc);
+      write_u32(header, four_cc_offset, four_cc("DX10"));
+      write_u32(header, caps_offset, caps_texture | (mip_count > 1 ? caps_mipmap : 0U));
+
+      write_u32(header, dxgi_format_offset,
+                static_cast<std::uint32_t>(to_dxgi(image.format, image.is_srgb)));
+      write_u32(header, dimension_offset, dimension_texture_2d);
+      write_u32(header, array_size_offset, 1);
+
+      std::size_t offset = std::size(header);
+      for (const auto& mip : image.mips)
+      {
+         std::copy(std::begin(mip.data), std::end(mip.data), std::data(bytes) + offset);
+         offset += std::size(mip.data);
+      }
+
+      return bytes;
+   }
+} // namespace gfx
@@ -0,0 +1,75 @@
+#include <gfx/draw_queue.hpp>
+
+#include <util/radix_sort.hpp>
+
+#include <algorithm>
+
+namespace gfx
+{
+   namespace
+   {
+      constexpr std::uint64_t pipeline_bits = 10;
+      constexpr std::uint64_t descriptor_set_bits = 10;
+      constexpr std::uint64_t material_bits = 12;
+      constexpr std::uint64_t mesh_bits = 15;
+      constexpr std::uint64_t depth_bits = 16;
+
+      constexpr auto mask(std::uint64_t bits) noexcept -> std::uint64_t
+      {
+         return (std::uint64_t{1} << bits) - 1;
+      }
+
+      auto quantize_depth(float depth) noexcept -> std::uint64_t
+      {
+         const float clamped = std::clamp(depth, 0.0F, 1.0F);
+         return static_cast<std::uint64_t>(clamped * static_cast<float>(mask(depth_bits)));
+      }
+
+      auto pack_state(const draw_key_info& info) noexcept -> std::uint64_t
+      {
+         std::uint64_t state = info.pipeline & mask(pipeline_bits);
+         state = (state << descriptor_set_bits) | (info.descriptor_set & mask(descriptor_set_bits));
+         state = (state << material_bits) | (info.material & mask(material_bits));
+         state = (state << mesh_bits) | (info.mesh & mask(mesh_bits));
+
+         return state;
+      }
+   } // namespace
+
+   auto make_draw_key(const draw_key_info& info) noexcept -> std::uint64_t
+   {
+      constexpr std::uint64_t translucent_bit = std::uint64_t{1} << 63U;
+
+      const std::uint64_t depth = quantize_depth(info.depth);
+
+      if (info.is_translucent)
+      {
+         const std::uint64_t inverse_depth = mask(depth_bits) - depth;
+         return translucent_bit | (inverse_depth << (63U - depth_bits)) |
+            (pack_state(info) >> depth_bits);
+      }
+
+      return (pack_state(info) << depth_bits) | depth;
+   }
+
+   void draw_queue::push(std::uint64_t key, std::uint32_t renderable, std::uint32_t lod)
+   {
+      m_packets.push_back({.key = key, .renderable = renderable, .lod = lod});
+   }
+   void draw_queue::sort()
+   {
+      m_scratch.resize(m_packets.size());
+      util::radix_sort(std::span{m_packets.data(), m_packets.size()},
+                       std::span{m_scratch.data(), m_scratch.size()},
+                       [](const draw_packet& packet) noexcept {
+                          return packet.key;
+                       });
+   }
+   void draw_queue::clear() noexcept { m_packets.clear(); }
+
+   auto draw_queue::packets() const noexcept -> std::span<const draw_packet>
+   {
+      return {m_packets.data(), m_packets.size()};
+   }
+   auto draw_queue::size() const noexcept -> std::size_t { return m_packets.size(); }
+} // namespace gfx
@@ -0,0 +1,1103 @@
+#include <gfx/gltf.hpp>
+
+#include <gfx/mesh_optimizer.hpp>
+
+#include <util/mapped_file.hpp>
+#include <util/trace.hpp>
+
+#include <monads/try.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <new>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+namespace gfx
+{
+   struct gltf_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override { return "gfx_gltf"; }
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return to_string(static_cast<gltf_error>(err));
+      }
+   };
+   inline static const gltf_error_category m_gltf_category{};
+
+   auto to_string(gltf_error err) -> std::string
+   {
+      switch (err)
+      {
+         case gltf_error::failed_to_map_file:
+            return "failed_to_map_file";
+         case gltf_error::invalid_glb:
+            return "invalid_glb";
+         case gltf_error::invalid_json:
+            return "invalid_json";
+         case gltf_error::unsupported_buffer:
+            return "unsupported_buffer";
+         case gltf_error::invalid_buffer_view:
+            return "invalid_buffer_view";
+         case gltf_error::invalid_accessor:
+            return "invalid_accessor";
+         case gltf_error::invalid_mesh:
+            return "invalid_mesh";
+         case gltf_error::invalid_node:
+            return "invalid_node";
+         default:
+            return "UNKNOWN";
+      }
+   }
+
+   auto make_error(gltf_error err) noexcept -> error_t
+   {
+      return {{static_cast<int>(err), m_gltf_category}};
+   }
+
+   namespace
+   {
+      using json = nlohmann::json;
+
+      constexpr std::uint32_t glb_magic = 0x4654'6C67;      // "glTF"
+      constexpr std::uint32_t glb_json_chunk = 0x4E4F'534A; // "JSON"
+      constexpr std::uint32_t glb_bin_chunk = 0x004E'4942;  // "BIN\0"
+      constexpr std::size_t glb_header_size = 12;
+      constexpr std::size_t glb_chunk_header_size = 8;
+
+      constexpr std::uint64_t triangles_mode = 4;
+
+      // Meshes with fewer triangles are cheaper to draw whole than to cull by cluster
+      constexpr std::size_t min_meshlet_mesh_triangle_count = 4096;
+
+      enum struct component_type : std::uint32_t
+      {
+         i8 = 5120,
+         u8 = 5121,
+         i16 = 5122,
+         u16 = 5123,
+         u32 = 5125,
+         f32 = 5126
+      };
+
+      /**
+       * The elements of an accessor, resolved down to the bytes of its buffer
+       */
+      struct accessor_view
+      {
+         // From the first byte of the first element to the last byte of the last one
+         std::span<const std::byte> data{};
+         std::size_t count{0};
+         std::size_t stride{0};
+
+         component_type type{component_type::f32};
+         std::size_t component_count{0};
+         bool is_normalized{false};
+      };
+
+      struct primitive_view
+      {
+         accessor_view positions;
+         std::optional<accessor_view> colours{};
+         std::optional<accessor_view> normals{};
+         std::optional<accessor_view> indices{};
+      };
+
+      /**
+       * A mesh whose accessors are all resolved & validated, ready to be converted on any thread
+       */
+      struct mesh_view
+      {
+         std::string name;
+         util::dynamic_array<primitive_view> primitives{};
+
+         std::size_t vertex_count{0};
+         std::size_t index_count{0};
+      };
+
+      struct document
+      {
+         json root;
+
+         // The mapped files the buffers point into
+         util::mapped_file file;
+         util::dynamic_array<util::mapped_file> buffer_files{};
+         util::dynamic_array<std::span<const std::byte>> buffers{};
+      };
+
+      auto read_glb_u32(std::span<const std::byte> bytes, std::size_t offset) noexcept
+         -> std::uint32_t
+      {
+         std::uint32_t value = 0;
+         std::memcpy(&value, std::data(bytes) + offset, sizeof(value));
+
+         return value;
+      }
+
+      /**
+       * The lookups below never throw, so malformed files are reported the same way whether
+       * exceptions are enabled or not
+       */
+      auto find_index(const json& object, const char* key) -> std::optional<std::size_t>
+      {
+         const auto it = object.find(key);
+         if (it == std::end(object) || !it->is_number_unsigned())
+         {
+            return std::nullopt;
+         }
+
+         return it->get<std::size_t>();
+      }
+      auto find_string(const json& object, const char* key) -> std::string
+      {
+         const auto it = object.find(key);
+         if (it == std::end(object) || !it->is_string())
+         {
+            return {};
+         }
+
+         return it->get<std::string>();
+      }
+      auto find_array(const json& object, const char* key) -> const json*
+      {
+         const auto it = object.find(key);
+         if (it == std::end(object) || !it->is_array())
+         {
+            return nullptr;
+         }
+
+         return &(*it);
+      }
+      auto find_element(const json& object, const char* key, std::size_t index) -> const json*
+      {
+         const json* p_array = find_array(object, key);
+         if (!p_array || index >= std::size(*p_array) || !(*p_array)[index].is_object())
+         {
+            return nullptr;
+         }
+
+         return &(*p_array)[index];
+      }
+      template <std::size_t count_>
+      auto find_floats(const json& object, const char* key)
+         -> std::optional<std::array<float, count_>>
+      {
+         const json* p_array = find_array(object, key);
+         if (!p_array || std::size(*p_array) != count_)
+         {
+            return std::nullopt;
+         }
+
+         std::array<float, count_> values{};
+         for (std::size_t i = 0; i < count_; ++i)
+         {
+            if (!(*p_array)[i].is_number())
+            {
+               return std::nullopt;
+            }
+
+            values[i] = (*p_array)[i].get<float>();
+         }
+
+         return values;
+      }
+
+      auto component_size(std::size_t type) noexcept -> std::size_t
+      {
+         switch (static_cast<component_type>(type))
+         {
+            case component_type::i8:
+            case component_type::u8:
+               return 1;
+            case component_type::i16:
+            case component_type::u16:
+               return 2;
+            case component_type::u32:
+            case component_type::f32:
+               return 4;
+            default:
+               return 0;
+         }
+      }
+      auto component_count(const std::string& type) noexcept -> std::size_t
+      {
+         if (type == "SCALAR")
+         {
+            return 1;
+         }
+         if (type == "VEC2")
+         {
+            return 2;
+         }
+         if (type == "VEC3")
+         {
+            return 3;
+         }
+         if (type == "VEC4")
+         {
+            return 4;
+         }
+
+         return 0;
+      }
+
+      /**
+       * Split a binary glTF into its JSON & binary chunks
+       */
+      auto parse_glb(std::span<const std::byte> bytes)
+         -> std::optional<std::pair<std::span<const std::byte>, std::span<const std::byte>>>
+      {
+         if (std::size(bytes) < glb_header_size + glb_chunk_header_size ||
+             read_glb_u32(bytes, 8) > std::size(bytes))
+         {
+            return std::nullopt;
+         }
+
+         bytes = bytes.first(read_glb_u32(bytes, 8));
+
+         std::span<const std::byte> json_chunk;
+         std::span<const std::byte> bin_chunk;
+
+         std::size_t offset = glb_header_size;
+         while (offset + glb_chunk_header_size <= std::size(bytes))
+         {
+            const std::size_t length = read_glb_u32(bytes, offset);
+            const std::uint32_t type = read_glb_u32(bytes, offset + 4);
+            offset += glb_chunk_header_size;
+
+            if (length > std::size(bytes) - offset)
+            {
+               return std::nullopt;
+            }
+
+            if (type == glb_json_chunk && std::empty(json_chunk))
+            {
+               json_chunk = bytes.subspan(offset, length);
+            }
+            else if (type == glb_bin_chunk && std::empty(bin_chunk))
+            {
+               bin_chunk = bytes.subspan(offset, length);
+            }
+
+            // Chunks are padded to 4 bytes
+            offset += (length + 3) & ~std::size_t{3};
+         }
+
+         if (std::empty(json_chunk))
+         {
+            return std::nullopt;
+         }
+
+         return std::pair{json_chunk, bin_chunk};
+      }
+
+      /**
+       * Map the buffers of the document. The buffer without URI of a GLB is its binary chunk,
+       * the others are files relative to the glTF
+       */
+      auto map_buffers(document& doc, const std::filesystem::path& directory,
+                       std::span<const std::byte> bin_chunk) -> std::optional<gltf_error>
+      {
+         const json* p_buffers = find_array(doc.root, "buffers");
+         if (!p_buffers)
+         {
+            return std::nullopt;
+         }
+
+         for (const auto& buffer : *p_buffers)
+         {
+            const auto byte_length = find_index(buffer, "byteLength");
+            const auto uri = find_string(buffer, "uri");
+            if (!byte_length || uri.starts_with("data:"))
+            {
+               return gltf_error::unsupported_buffer;
+            }
+
+            std::span<const std::byte> bytes = bin_chunk;
+            if (!std::empty(uri))
+            {
+               auto file = util::mapped_file::open(directory / uri);
+               if (!file)
+               {
+                  return gltf_error::failed_to_map_file;
+               }
+
+               bytes = file->bytes();
+               doc.buffer_files.push_back(std::move(file).value());
+            }
+
+            if (std::size(bytes) < byte_length.value())
+            {
+               return gltf_error::unsupported_buffer;
+            }
+
+            doc.buffers.push_back(bytes.first(byte_length.value()));
+         }
+
+         return std::nullopt;
+      }
+
+      auto resolve_accessor(const document& doc, std::size_t index)
+         -> gfx::result<accessor_view>
+      {
+         const json* p_accessor = find_element(doc.root, "accessors", index);
+         if (!p_accessor || p_accessor->contains("sparse"))
+         {
+            return monad::make_error(make_error(gltf_error::invalid_accessor));
+         }
+
+         const auto view_index = find_index(*p_accessor, "bufferView");
+         const auto count = find_index(*p_accessor, "count");
+         const auto type = find_index(*p_accessor, "componentType");
+         if (!(view_index && count && type))
+         {
+            return monad::make_error(make_error(gltf_error::invalid_accessor));
+         }
+
+         const json* p_view = find_element(doc.root, "bufferViews", view_index.value());
+         if (!p_view)
+         {
+            return monad::make_error(make_error(gltf_error::invalid_buffer_view));
+         }
+
+         // Every offset, length & count comes from the file, the checks are written so none of
+         // them can overflow
+         const auto buffer_index = find_index(*p_view, "buffer");
+         const auto byte_length = find_index(*p_view, "byteLength");
+         const std::size_t view_offset = find_index(*p_view, "byteOffset").value_or(0);
+         if (!(buffer_index && byte_length) || buffer_index.value() >= std::size(doc.buffers))
+         {
+            return monad::make_error(make_error(gltf_error::invalid_buffer_view));
+         }
+
+         const std::size_t buffer_size = std::size(doc.buffers[buffer_index.value()]);
+         if (byte_length.value() > buffer_size || view_offset > buffer_size - byte_length.value())
+         {
+            return monad::make_error(make_error(gltf_error::invalid_buffer_view));
+         }
+
+         const auto normalized_it = p_accessor->find("normalized");
+         accessor_view accessor{
+            .count = count.value(),
+            .type = static_cast<component_type>(type.value()),
+            .component_count = component_count(find_string(*p_accessor, "type")),
+            .is_normalized = normalized_it != std::end(*p_accessor) &&
+               normalized_it->is_boolean() && normalized_it->get<bool>()};
+
+         const std::size_t element_size = component_size(type.value()) * accessor.component_count;
+         if (element_size == 0)
+         {
+            return monad::make_error(make_error(gltf_error::invalid_accessor));
+         }
+
+         accessor.stride = find_index(*p_view, "byteStride").value_or(element_size);
+         if (accessor.stride < element_size)
+         {
+            return monad::make_error(make_error(gltf_error::invalid_buffer_view));
+         }
+
+         // The elements must fit in the buffer view, which also caps the count by the view size
+         const std::size_t offset = find_index(*p_accessor, "byteOffset").value_or(0);
+         if (offset > byte_length.value())
+         {
+            return monad::make_error(make_error(gltf_error::invalid_accessor));
+         }
+
+         const std::size_t available = byte_length.value() - offset;
+         std::size_t size = 0;
+         if (accessor.count != 0)
+         {
+            if (element_size > available ||
+                accessor.count - 1 > (available - element_size) / accessor.stride)
+            {
+               return monad::make_error(make_error(gltf_error::invalid_accessor));
+            }
+
+            size = (accessor.count - 1) * accessor.stride + element_size;
+         }
+
+         accessor.data =
+            doc.buffers[buffer_index.value()].subspan(view_offset + offset, size);
+
+         return accessor;
+      }
+
+      /**
+       * Resolve an optional vertex attribute, checking its element type before anything reads
+       * it: read_vec3 reads three components of every element
+       */
+      auto resolve_attribute(const document& doc, const json& attributes, const char* name,
+                             std::size_t vertex_count, std::size_t min_component_count,
+                             std::size_t max_component_count)
+         -> std::optional<gfx::result<accessor_view>>
+      {
+         const auto index = find_index(attributes, name);
+         if (!index)
+         {
+            return std::nullopt;
+         }
+
+         auto accessor = resolve_accessor(doc, index.value());
+         if (accessor && (accessor.value()->count != vertex_count ||
+                          accessor.value()->component_count < min_component_count ||
+                          accessor.value()->component_count > max_component_count))
+         {
+            return monad::make_error(make_error(gltf_error::invalid_accessor));
+         }
+
+         return accessor;
+      }
+
+      /**
+       * Resolve the accessors of every triangle list of a mesh. Primitives drawn with other
+       * modes are skipped
+       */
+      auto resolve_mesh(const document& doc, const json& mesh,
+                        const std::shared_ptr<util::logger>& p_logger) -> gfx::result<mesh_view>
+      {
+         mesh_view view{.name = find_string(mesh, "name")};
+
+         const json* p_primitives = find_array(mesh, "primitives");
+         if (!p_primitives)
+         {
+            return monad::make_error(make_error(gltf_error::invalid_mesh));
+         }
+
+         for (const auto& primitive : *p_primitives)
+         {
+            if (find_index(primitive, "mode").value_or(triangles_mode) != triangles_mode)
+            {
+               util::log_warn(p_logger, R"([gfx] skipped a primitive of "{}", not a triangle list)",
+                              view.name);
+
+               continue;
+            }
+
+            const auto attributes_it = primitive.find("attributes");
+            if (attributes_it == std::end(primitive))
+            {
+               return monad::make_error(make_error(gltf_error::invalid_mesh));
+            }
+
+            const json& attributes = *attributes_it;
+            const auto position_index = find_index(attributes, "POSITION");
+            if (!position_index)
+            {
+               return monad::make_error(make_error(gltf_error::invalid_mesh));
+            }
+
+            auto positions = resolve_accessor(doc, position_index.value());
+            if (!positions)
+            {
+               return monad::make_error(positions.error().value());
+            }
+
+            primitive_view result{.positions = positions.value().value()};
+            if (result.positions.component_count != 3 ||
+                result.positions.type != component_type::f32)
+            {
+               return monad::make_error(make_error(gltf_error::invalid_accessor));
+            }
+
+            const std::size_t vertex_count = result.positions.count;
+
+            if (auto colours = resolve_attribute(doc, attributes, "COLOR_0", vertex_count, 3, 4))
+            {
+               if (!colours.value())
+               {
+                  return monad::make_error(colours.value().error().value());
+               }
+
+               result.colours = colours.value().value().value();
+            }
+            if (auto normals = resolve_attribute(doc, attributes, "NORMAL", vertex_count, 3, 3))
+            {
+               if (!normals.value())
+               {
+                  return monad::make_error(normals.value().error().value());
+               }
+
+               result.normals = normals.value().value().value();
+            }
+
+            std::size_t index_count = vertex_count;
+            if (const auto indices_index = find_index(primitive, "indices"))
+            {
+               auto indices = resolve_accessor(doc, indices_index.value());
+               if (!indices)
+               {
+                  return monad::make_error(indices.error().value());
+               }
+
+               result.indices = indices.value().value();
+               if (result.indices->component_count != 1 ||
+                   result.indices->type == component_type::f32 ||
+                   result.indices->type == component_type::i8 ||
+                   result.indices->type == component_type::i16)
+               {
+                  return monad::make_error(make_error(gltf_error::invalid_accessor));
+               }
+
+               index_count = result.indices->count;
+            }
+
+            if (index_count % 3 != 0)
+            {
+               return monad::make_error(make_error(gltf_error::invalid_mesh));
+            }
+
+            view.vertex_count += vertex_count;
+            view.index_count += index_count;
+            view.primitives.push_back(result);
+         }
+
+         // The primitives are merged, their indices must still fit
+         if (view.vertex_count > std::numeric_limits<std::uint32_t>::max())
+         {
+            return monad::make_error(make_error(gltf_error::invalid_mesh));
+         }
+
+         return view;
+      }
+
+      template <typename component_>
+      auto read_component(const std::byte* p_data, float scale) noexcept -> float
+      {
+         component_ value{};
+         std::memcpy(&value, p_data, sizeof(value));
+
+         return static_cast<float>(value) * scale;
+      }
+
+      /**
+       * Read the first three components of every element of an accessor into a member of the
+       * vertices. Components are read through memcpy since glTF only aligns them to their size
+       */
+      template <typename component_>
+      void read_vec3(const accessor_view& accessor, glm::vec3 vertex::*p_member,
+                     std::span<vertex> vertices) noexcept
+      {
+         const float scale = std::is_integral_v<component_> && accessor.is_normalized
+                                ? 1.0F / static_cast<float>(std::numeric_limits<component_>::max())
+                                : 1.0F;
+
+         const std::byte* p_element = std::data(accessor.data);
+         for (auto& v : vertices)
+         {
+            auto& member = v.*p_member;
+            member.x = read_component<component_>(p_element, scale);
+            member.y = read_component<component_>(p_element + sizeof(component_), scale);
+            member.z = read_component<component_>(p_element + 2 * sizeof(component_), scale);
+
+            p_element += accessor.stride;
+         }
+      }
+      /**
+       * Dispatch on the component type once for the whole accessor
+       */
+      void read_vec3(const accessor_view& accessor, glm::vec3 vertex::*p_member,
+                     std::span<vertex> vertices) noexcept
+      {
+         switch (accessor.type)
+         {
+            case component_type::i8:
+               read_vec3<std::int8_t>(accessor, p_member, vertices);
+               break;
+            case component_type::u8:
+               read_vec3<std::uint8_t>(accessor, p_member, vertices);
+               break;
+            case component_type::i16:
+               read_vec3<std::int16_t>(accessor, p_member, vertices);
+               break;
+            case component_type::u16:
+               read_vec3<std::uint16_t>(accessor, p_member, vertices);
+               break;
+            case component_type::u32:
+               read_vec3<std::uint32_t>(accessor, p_member, vertices);
+               break;
+            case component_type::f32:
+               read_vec3<float>(accessor, p_member, vertices);
+               break;
+         }
+      }
+
+      template <typename index_>
+      void read_indices(const accessor_view& accessor, std::uint32_t base_vertex,
+                        std::span<std::uint32_t> indices) noexcept
+      {
+         const std::byte* p_element = std::data(accessor.data);
+         for (auto& index : indices)
+         {
+            index_ value{};
+            std::memcpy(&value, p_element, sizeof(value));
+
+            index = base_vertex + value;
+            p_element += accessor.stride;
+         }
+      }
+
+      /**
+       * Convert a resolved mesh to the engine's vertex format, merging its primitives
+       */
+      auto convert_mesh(const mesh_view& view) -> gfx::result<gltf_mesh>
+      {
+         UTIL_TRACE_ZONE_CAT("gltf::convert_mesh", "import");
+
+         gltf_mesh mesh{.name = view.name};
+
+         // The counts are bounded by the buffers, but primitives may share accessors. A failed
+         // allocation is reported like any other error instead of escaping the task
+         if (!monad::try_wrap<std::bad_alloc>([&] {
+                mesh.vertices.resize(view.vertex_count);
+                mesh.indices.resize(view.index_count);
+                return 0;
+             }))
+         {
+            return monad::make_error(make_error(gltf_error::invalid_mesh));
+         }
+
+         std::size_t first_vertex = 0;
+         std::size_t first_index = 0;
+         for (const auto& primitive : view.primitives)
+         {
+            const std::size_t vertex_count = primitive.positions.count;
+            const auto vertices = std::span{mesh.vertices}.subspan(first_vertex, vertex_count);
+
+            read_vec3(primitive.positions, &vertex::position, vertices);
+            if (primitive.colours)
+            {
+               read_vec3(primitive.colours.value(), &vertex::colour, vertices);
+            }
+            else if (primitive.normals)
+            {
+               // The pipeline is unlit, the normals keep the shape of the mesh readable
+               read_vec3(primitive.normals.value(), &vertex::colour, vertices);
+               for (auto& v : vertices)
+               {
+                  v.colour = v.colour * 0.5F + 0.5F;
+               }
+            }
+            else
+            {
+               for (auto& v : vertices)
+               {
+                  v.colour = glm::vec3{1.0F};
+               }
+            }
+
+            const auto base_vertex = static_cast<std::uint32_t>(first_vertex);
+            if (primitive.indices)
+            {
+               const auto& accessor = primitive.indices.value();
+               const auto indices = std::span{mesh.indices}.subspan(first_index, accessor.count);
+
+               switch (accessor.type)
+               {
+                  case component_type::u8:
+                     read_indices<std::uint8_t>(accessor, base_vertex, indices);
+                     break;
+                  case component_type::u16:
+                     read_indices<std::uint16_t>(accessor, base_vertex, indices);
+                     break;
+                  default:
+                     read_indices<std::uint32_t>(accessor, base_vertex, indices);
+                     break;
+               }
+
+               // Indices are the only data read from the file that could make the GPU read out
+               // of bounds
+               for (const std::uint32_t index : indices)
+               {
+                  if (index - base_vertex >= vertex_count)
+                  {
+                     return monad::make_error(make_error(gltf_error::invalid_accessor));
+                  }
+               }
+
+               first_index += accessor.count;
+            }
+            else
+            {
+               for (std::size_t i = 0; i < vertex_count; ++i)
+               {
+                  mesh.indices[first_index++] = base_vertex + static_cast<std::uint32_t>(i);
+               }
+            }
+
+            first_vertex += vertex_count;
+         }
+
+         // Exported meshes are rarely ordered for the GPU and often hold duplicated vertices
+         optimize_mesh(mesh.vertices, mesh.indices);
+         if (std::size(mesh.indices) / 3 >= min_meshlet_mesh_triangle_count)
+         {
+            mesh.meshlets = build_meshlets(mesh.indices, mesh.vertices);
+         }
+         mesh.lods = build_lod_chain(mesh.indices, mesh.vertices);
+
+         mesh.local_bounds = compute_bounding_sphere(mesh.vertices);
+
+         return mesh;
+      }
+
+      auto local_transform(const json& node) -> glm::mat4
+      {
+         if (const auto matrix = find_floats<16>(node, "matrix"))
+         {
+            // Both glTF and glm store matrices column major
+            glm::mat4 result{1.0F};
+            for (glm::length_t column = 0; column < 4; ++column)
+            {
+               for (glm::length_t row = 0; row < 4; ++row)
+               {
+                  result[column][row] = matrix.value()[static_cast<std::size_t>(column * 4 + row)];
+               }
+            }
+
+            return result;
+         }
+
+         const auto t = find_floats<3>(node, "translation").value_or(std::array{0.0F, 0.0F, 0.0F});
+         const auto s = find_floats<3>(node, "scale").value_or(std::array{1.0F, 1.0F, 1.0F});
+         const auto r =
+            find_floats<4>(node, "rotation").value_or(std::array{0.0F, 0.0F, 0.0F, 1.0F});
+
+         return glm::translate(glm::mat4{1.0F}, glm::vec3{t[0], t[1], t[2]}) *
+            glm::mat4_cast(glm::quat{r[3], r[0], r[1], r[2]}) *
+            glm::scale(glm::mat4{1.0F}, glm::vec3{s[0], s[1], s[2]});
+      }
+
+      /**
+       * Get the root nodes of the default scene. Files without scenes are treated as one scene
+       * made of every node that isn't a child
+       */
+      auto find_root_nodes(const json& root) -> util::dynamic_array<std::size_t>
+      {
+         util::dynamic_array<std::size_t> roots;
+
+         const json* p_scene = find_element(root, "scenes", find_index(root, "scene").value_or(0));
+         if (p_scene)
+         {
+            if (const json* p_nodes = find_array(*p_scene, "nodes"))
+            {
+               for (const auto& node : *p_nodes)
+               {
+                  if (node.is_number_unsigned())
+                  {
+                     roots.push_back(node.get<std::size_t>());
+                  }
+               }
+            }
+
+            return roots;
+         }
+
+         const json* p_nodes = find_array(root, "nodes");
+         if (!p_nodes)
+         {
+            return roots;
+         }
+
+         util::dynamic_array<bool> is_child(std::size(*p_nodes));
+         for (const auto& node : *p_nodes)
+         {
+            if (const json* p_children = find_array(node, "children"))
+            {
+               for (const auto& child : *p_children)
+               {
+                  if (child.is_number_unsigned() && child.get<std::size_t>() < std::size(is_child))
+                  {
+                     is_child[child.get<std::size_t>()] = true;
+                  }
+               }
+            }
+         }
+
+         for (std::size_t i = 0; i < std::size(is_child); ++i)
+         {
+            if (!is_child[i])
+            {
+               roots.push_back(i);
+            }
+         }
+
+         return roots;
+      }
+
+      /**
+       * Walk the node hierarchy of the default scene and emit an instance for every node with a
+       * mesh, its transform multiplied by those of its ancestors
+       */
+      auto flatten_nodes(const json& root, std::span<const gltf_mesh> meshes)
+         -> gfx::result<util::dynamic_array<gltf_instance>>
+      {
+         struct pending_node
+         {
+            std::size_t index;
+            glm::mat4 parent_transform;
+         };
+
+         const json* p_nodes = find_array(root, "nodes");
+         const std::size_t node_count = p_nodes ? std::size(*p_nodes) : 0;
+
+         util::dynamic_array<gltf_instance> instances;
+         util::dynamic_array<bool> is_visited(node_count);
+         util::dynamic_array<pending_node> pending;
+
+         for (const std::size_t index : find_root_nodes(root))
+         {
+            pending.push_back({.index = index, .parent_transform = glm::mat4{1.0F}});
+         }
+
+         while (!std::empty(pending))
+         {
+            const auto [index, parent_transform] = pending.back();
+            pending.pop_back();
+
+            // A node may only have one parent, which also rules out cycles
+            if (index >= node_count || is_visited[index] || !(*p_nodes)[index].is_object())
+            {
+               return monad::make_error(make_error(gltf_error::invalid_node));
+            }
+
+            is_visited[index] = true;
+
+            const json& node = (*p_nodes)[index];
+            const glm::mat4 transform = parent_transform * local_transform(node);
+
+            if (const auto mesh = find_index(node, "mesh"))
+            {
+               if (mesh.value() >= std::size(meshes))
+               {
+                  return monad::make_error(make_error(gltf_error::invalid_node));
+               }
+
+               auto name = find_string(node, "name");
+               instances.push_back(
+                  {.name = std::empty(name) ? meshes[mesh.value()].name : std::move(name),
+                   .mesh = static_cast<std::uint32_t>(mesh.value()),
+                   .transform = transform});
+            }
+
+            if (const json* p_children = find_array(node, "children"))
+            {
+               for (const auto& child : *p_children)
+               {
+                  if (!child.is_number_unsigned())
+                  {
+                     return monad::make_error(make_error(gltf_error::invalid_node));
+                  }
+
+                  pending.push_back(
+                     {.index = child.get<std::size_t>(), .parent_transform = transform});
+               }
+            }
+         }
+
+         return instances;
+      }
+
+      /**
+       * Remove the meshes left without any triangle, such as meshes made only of points or
+       * lines, along with the instances placing them. Return the number of meshes removed
+       */
+      auto drop_empty_meshes(gltf_scene& scene) -> std::size_t
+      {
+         constexpr auto dropped = std::numeric_limits<std::uint32_t>::max();
+
+         util::dynamic_array<std::uint32_t> new_mesh_indices(std::size(scene.meshes));
+         util::dynamic_array<gltf_mesh> meshes;
+         for (std::size_t i = 0; i < std::size(scene.meshes); ++i)
+         {
+            if (std::empty(scene.meshes[i].indices))
+            {
+               new_mesh_indices[i] = dropped;
+
+               continue;
+            }
+
+            new_mesh_indices[i] = static_cast<std::uint32_t>(std::size(meshes));
+            meshes.push_back(std::move(scene.meshes[i]));
+         }
+
+         const std::size_t dropped_count = std::size(scene.meshes) - std::size(meshes);
+
+         util::dynamic_array<gltf_instance> instances;
+         for (auto& instance : scene.instances)
+         {
+            if (new_mesh_indices[instance.mesh] != dropped)
+            {
+               instance.mesh = new_mesh_indices[instance.mesh];
+               instances.push_back(std::move(instance));
+            }
+         }
+
+         scene.meshes = std::move(meshes);
+         scene.instances = std::move(instances);
+
+         return dropped_count;
+      }
+
+      auto to_ms(std::chrono::microseconds time) noexcept -> double
+      {
+         return static_cast<double>(time.count()) / 1000.0;
+      }
+      /**
+       * Get a throughput in millions of units per second
+       */
+      auto to_throughput(std::size_t count, std::chrono::microseconds time) noexcept -> double
+      {
+         return time.count() > 0 ? static_cast<double>(count) / static_cast<double>(time.count())
+                                 : 0.0;
+      }
+   } // namespace
+
+   auto import_gltf(const std::filesystem::path& path, util::thread_pool& thread_pool,
+                    const std::shared_ptr<util::logger>& p_logger) -> gfx::result<gltf_scene>
+   {
+      UTIL_TRACE_ZONE_CAT("import_gltf", "import");
+
+      using clock = std::chrono::steady_clock;
+      using std::chrono::duration_cast;
+      using std::chrono::microseconds;
+
+      const auto fail = [&](error_t err) {
+         util::log_error(p_logger, R"([gfx] failed to import "{}": {})", path.generic_string(),
+                         err.value().message());
+
+         return monad::make_error(err);
+      };
+
+      const auto parse_start = clock::now();
+
+      document doc;
+      if (auto file = util::mapped_file::open(path))
+      {
+         doc.file = std::move(file).value();
+      }
+      else
+      {
+         return fail(make_error(gltf_error::failed_to_map_file));
+      }
+
+      std::span<const std::byte> json_text = doc.file.bytes();
+      std::span<const std::byte> bin_chunk;
+      if (std::size(json_text) >= 4 && read_glb_u32(json_text, 0) == glb_magic)
+      {
+         const auto chunks = parse_glb(json_text);
+         if (!chunks)
+         {
+            return fail(make_error(gltf_error::invalid_glb));
+         }
+
+         std::tie(json_text, bin_chunk) = chunks.value();
+      }
+
+      const auto* p_text = reinterpret_cast<const char*>(std::data(json_text)); // NOLINT
+      doc.root = json::parse(p_text, p_text + std::size(json_text), nullptr, false);
+      if (doc.root.is_discarded() || !doc.root.is_object())
+      {
+         return fail(make_error(gltf_error::invalid_json));
+      }
+
+      if (const auto err = map_buffers(doc, path.parent_path(), bin_chunk))
+      {
+         return fail(make_error(err.value()));
+      }
+
+      util::dynamic_array<mesh_view> mesh_views;
+      if (const auto* p_meshes = find_array(doc.root, "meshes"))
+      {
+         for (const auto& mesh : *p_meshes)
+         {
+            auto view = resolve_mesh(doc, mesh, p_logger);
+            if (!view)
+            {
+               return fail(view.error().value());
+            }
+
+            mesh_views.push_back(std::move(view).value().value());
+         }
+      }
+
+      gltf_scene scene;
+      scene.stats.json_bytes = std::size(json_text);
+      for (const auto& buffer : doc.buffers)
+      {
+         scene.stats.buffer_bytes += std::size(buffer);
+      }
+      scene.stats.parse_time = duration_cast<microseconds>(clock::now() - parse_start);
+
+      const auto convert_start = clock::now();
+
+      // The views only point into the mapped buffers, every mesh is converted on its own task
+      util::dynamic_array<std::future<gfx::result<gltf_mesh>>> conversions;
+      conversions.reserve(std::size(mesh_views));
+      for (const auto& view : mesh_views)
+      {
+         conversions.push_back(thread_pool.submit([&view] {
+            return convert_mesh(view);
+         }));
+      }
+
+      std::optional<error_t> conversion_error;
+      for (auto& conversion : conversions)
+      {
+         auto mesh = conversion.get();
+         if (!mesh)
+         {
+            conversion_error = mesh.error();
+
+            continue;
+         }
+
+         scene.stats.vertex_count += std::size(mesh.value()->vertices);
+         scene.stats.index_count += std::size(mesh.value()->indices);
+         scene.meshes.push_back(std::move(mesh).value().value());
+      }
+
+      if (conversion_error)
+      {
+         return fail(conversion_error.value());
+      }
+
+      auto instances = flatten_nodes(doc.root, scene.meshes);
+      if (!instances)
+      {
+         return fail(instances.error().value());
+      }
+
+      scene.instances = std::move(instances).value().value();
+
+      // Nothing could be uploaded for them, an empty Vulkan buffer isn't valid
+      if (const std::size_t dropped_count = drop_empty_meshes(scene); dropped_count != 0)
+      {
+         util::log_warn(p_logger, R"([gfx] dropped {} meshes without triangles from "{}")",
+                        dropped_count, path.generic_string());
+      }
+
+      scene.stats.convert_time = duration_cast<microseconds>(clock::now() - convert_start);
+
+      const auto& stats = scene.stats;
+      util::log_info(p_logger,
+                     R"([gfx] parsed "{}" in {:.2f} ms: {} bytes of JSON, {} bytes of buffers)",
+                     path.generic_string(), to_ms(stats.parse_time), stats.json_bytes,
+                     stats.buffer_bytes);
+      util::log_info(p_logger,
+                     "[gfx] converted {} meshes & {} instances in {:.2f} ms: {} vertices, {} "
+                     "indices, {:.2f} M vertices/s",
+                     std::size(scene.meshes), std::size(scene.instances),
+                     to_ms(stats.convert_time), stats.vertex_count, stats.index_count,
+                     to_throughput(stats.vertex_count, stats.convert_time));
+
+      return scene;
+   }
+} // namespace gfx
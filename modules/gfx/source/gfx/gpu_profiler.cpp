@@ -0,0 +1,264 @@
+#include <gfx/gpu_profiler.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace gfx
+{
+   struct gpu_profiler_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override
+      {
+         return "gfx_gpu_profiler";
+      }
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return to_string(static_cast<gpu_profiler_error>(err));
+      }
+   };
+   inline static const gpu_profiler_error_category m_gpu_profiler_category{};
+
+   auto to_string(gpu_profiler_error err) -> std::string
+   {
+      switch (err)
+      {
+         case gpu_profiler_error::failed_to_create_query_pool:
+            return "failed_to_create_query_pool";
+         case gpu_profiler_error::timestamps_not_supported:
+            return "timestamps_not_supported";
+         default:
+            return "UNKNOWN";
+      }
+   }
+
+   auto make_error(gpu_profiler_error err) noexcept -> error_t
+   {
+      return {{static_cast<int>(err), m_gpu_profiler_category}};
+   }
+
+   auto gpu_profiler::make(create_info&& info) noexcept -> gfx::result<gpu_profiler>
+   {
+      const vkn::device& device = *info.p_device;
+
+      const auto queue_index = device.get_queue_index(vkn::queue::type::graphics);
+      if (!queue_index)
+      {
+         return monad::make_error(make_error(gpu_profiler_error::timestamps_not_supported));
+      }
+
+      const auto valid_bits = device.physical().queue_families()[*queue_index.value()]
+                                 .timestampValidBits;
+      if (valid_bits == 0)
+      {
+         util::log_warn(info.p_logger, "[gfx] graphics queue does not support timestamps");
+
+         return monad::make_error(make_error(gpu_profiler_error::timestamps_not_supported));
+      }
+
+      const std::uint32_t queries_per_frame = info.max_scope_count.value() * 2;
+
+      return vkn::query_pool::builder{device, info.p_logger}
+         .set_query_type(vk::QueryType::eTimestamp)
+         .set_query_count(util::count32_t{queries_per_frame * info.frame_count.value()})
+         .build()
+         .map_error([&](vkn::error&& err) {
+            util::log_error(info.p_logger, "[gfx] query pool error: {}-{}",
+                            err.type.category().name(), err.type.message());
+
+            return make_error(gpu_profiler_error::failed_to_create_query_pool);
+         })
+         .map([&](vkn::query_pool&& pool) {
+            gpu_profiler profiler{};
+            profiler.mp_logger = info.p_logger;
+            profiler.m_device = device.value();
+            profiler.m_query_pool = std::move(pool);
+            profiler.m_timestamp_period = device.physical().properties().limits.timestampPeriod;
+            profiler.m_timestamp_mask = valid_bits >= 64
+               ? std::numeric_limits<std::uint64_t>::max()
+               : (std::uint64_t{1} << valid_bits) - 1;
+            profiler.m_queries_per_frame = queries_per_frame;
+            profiler.m_frames.resize(info.frame_count.value());
+            profiler.m_query_results.resize(queries_per_frame);
+
+            util::log_info(info.p_logger, "[gfx] gpu profiler created ({} ns per tick)",
+                           profiler.m_timestamp_period);
+
+            return profiler;
+         });
+   }
+
+   auto gpu_profiler::register_scope(std::string name) -> util::index_t
+   {
+      m_scopes.emplace_back(scope_data{.name = std::move(name)});
+
+      return util::index_t{std::size(m_scopes) - 1};
+   }
+
+   void gpu_profiler::begin_frame(vk::CommandBuffer cmd, std::size_t frame_index)
+   {
+      if (!is_enabled())
+      {
+         return;
+      }
+
+      m_current_frame = frame_index;
+
+      resolve(frame_index);
+
+      cmd.resetQueryPool(m_query_pool.value(),
+                         static_cast<std::uint32_t>(frame_index) * m_queries_per_frame,
+                         m_queries_per_frame);
+   }
+
+   auto gpu_profiler::begin_scope(vk::CommandBuffer cmd, util::index_t scope) -> scope_token
+   {
+      scope_token token{.scope = scope, .cpu_start = clock::now()};
+
+      if (!is_enabled())
+      {
+         return token;
+      }
+
+      auto& frame = m_frames[m_current_frame];
+      if (frame.used_query_count + 2 > m_queries_per_frame)
+      {
+         util::log_warn(mp_logger, "[gfx] gpu profiler out of queries, scope \"{}\" dropped",
+                        m_scopes[scope.value()].name);
+
+         return token;
+      }
+
+      token.query = frame.used_query_count;
+      frame.used_query_count += 2;
+
+      cmd.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, m_query_pool.value(),
+                         static_cast<std::uint32_t>(m_current_frame) * m_queries_per_frame +
+                            token.query);
+
+      return token;
+   }
+
+   void gpu_profiler::end_scope(vk::CommandBuffer cmd, const scope_token& token)
+   {
+      const auto cpu_time =
+         std::chrono::duration<float, std::milli>(clock::now() - token.cpu_start);
+      m_scopes[token.scope.value()].cpu.push(cpu_time.count());
+
+      if (!is_enabled() || token.query == std::numeric_limits<std::uint32_t>::max())
+      {
+         return;
+      }
+
+      cmd.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, m_query_pool.value(),
+                         static_cast<std::uint32_t>(m_current_frame) * m_queries_per_frame +
+                            token.query + 1);
+
+      m_frames[m_current_frame].scopes.emplace_back(
+         pending_scope{.scope = token.scope, .query = token.query});
+   }
+
+   void gpu_profiler::add_cpu_sample(util::index_t scope, float milliseconds)
+   {
+      m_scopes[scope.value()].cpu.push(milliseconds);
+   }
+
+   auto gpu_profiler::report() const -> util::dynamic_array<scope_report>
+   {
+      util::dynamic_array<scope_report> reports;
+      reports.reserve(std::size(m_scopes));
+
+      for (const auto& scope : m_scopes)
+      {
+         reports.emplace_back(scope_report{.name = scope.name,
+                                           .gpu = scope.gpu.compute(),
+                                           .cpu = scope.cpu.compute(),
+                                           .gpu_sample_count = scope.gpu.count,
+                                           .cpu_sample_count = scope.cpu.count});
+      }
+
+      return reports;
+   }
+
+   void gpu_profiler::log_report() const
+   {
+      for (const auto& r : report())
+      {
+         util::log_info(mp_logger,
+                        "[gfx] profile \"{}\": gpu avg {:.3f}ms p50 {:.3f}ms p95 {:.3f}ms p99 "
+                        "{:.3f}ms | cpu avg {:.3f}ms p50 {:.3f}ms p95 {:.3f}ms p99 {:.3f}ms",
+                        r.name, r.gpu.average, r.gpu.median, r.gpu.p95, r.gpu.p99, r.cpu.average,
+                        r.cpu.median, r.cpu.p95, r.cpu.p99);
+      }
+   }
+
+   auto gpu_profiler::is_enabled() const noexcept -> bool { return m_queries_per_frame != 0; }
+
+   void gpu_profiler::resolve(std::size_t frame_index)
+   {
+      auto& frame = m_frames[frame_index];
+      if (frame.used_query_count == 0)
+      {
+         return;
+      }
+
+      // The fence of the frame slot has already been waited upon, no need to ask the driver to
+      // wait for the results. If they are somehow not available, the samples are dropped.
+      const auto result = m_device.getQueryPoolResults<std::uint64_t>(
+         m_query_pool.value(), static_cast<std::uint32_t>(frame_index) * m_queries_per_frame,
+         frame.used_query_count,
+         vk::ArrayProxy<std::uint64_t>{frame.used_query_count, std::data(m_query_results)},
+         sizeof(std::uint64_t), vk::QueryResultFlagBits::e64);
+
+      if (result == vk::Result::eSuccess)
+      {
+         const float ns_to_ms = m_timestamp_period / 1'000'000.0F;
+
+         for (const auto& pending : frame.scopes)
+         {
+            const std::uint64_t begin = m_query_results[pending.query] & m_timestamp_mask;
+            const std::uint64_t end = m_query_results[pending.query + 1] & m_timestamp_mask;
+            const std::uint64_t ticks = (end - begin) & m_timestamp_mask;
+
+            m_scopes[pending.scope.value()].gpu.push(static_cast<float>(ticks) * ns_to_ms);
+         }
+      }
+
+      frame.scopes.clear();
+      frame.used_query_count = 0;
+   }
+
+   void gpu_profiler::timing_history::push(float sample) noexcept
+   {
+      samples[head] = sample;
+      head = (head + 1) % history_size;
+      count = std::min(count + 1, history_size);
+   }
+
+   auto gpu_profiler::timing_history::compute() const noexcept -> timing_stats
+   {
+      if (count == 0)
+      {
+         return {};
+      }
+
+      std::array<float, history_size> sorted{};
+      std::copy_n(std::begin(samples), count, std::begin(sorted));
+      std::sort(std::begin(sorted), std::begin(sorted) + count);
+
+      const auto percentile = [&](float p) noexcept {
+         return sorted[static_cast<std::size_t>(p * static_cast<float>(count - 1) + 0.5F)];
+      };
+
+      return {.average = std::accumulate(std::begin(sorted), std::begin(sorted) + count, 0.0F) /
+                 static_cast<float>(count),
+              .median = percentile(0.50F),
+              .p95 = percentile(0.95F),
+              .p99 = percentile(0.99F),
+              .max = sorted[count - 1]};
+   }
+
+   gpu_scope::gpu_scope(gpu_profiler& profiler, vk::CommandBuffer cmd, util::index_t scope) :
+      m_profiler{profiler}, m_cmd{cmd}, m_token{profiler.begin_scope(cmd, scope)}
+   {}
+   gpu_scope::~gpu_scope() { m_profiler.end_scope(m_cmd, m_token); }
+} // namespace gfx
@@ -44,7 +44,8 @@ namespace gfx
 
       return vkn::buffer::builder{device, info.p_logger}
          .set_size(sizeof(gfx::camera_matrices))
-         .set_usage(vk::BufferUsageFlagBits::eUniformBuffer)
+         .set_usage(vk::BufferUsageFlagBits::eUniformBuffer |
+                    vk::BufferUsageFlagBits::eStorageBuffer)
          .set_desired_memory_type(vk::MemoryPropertyFlagBits::eHostVisible |
                                   vk::MemoryPropertyFlagBits::eHostCoherent)
          .build()
@@ -1,5 +1,8 @@
 #include <gfx/memory/index_buffer.hpp>
 
+#include <util/stats.hpp>
+#include <util/trace.hpp>
+
 namespace gfx
 {
    auto to_string(index_buffer_error err) -> std::string
@@ -39,6 +42,8 @@ namespace gfx
 
    auto index_buffer::make(create_info&& info) noexcept -> gfx::result<index_buffer>
    {
+      UTIL_TRACE_ZONE_CAT("index_buffer::make", "upload");
+
       const vkn::device& device = *info.p_device;
       const vkn::command_pool& command_pool = *info.p_command_pool;
 
@@ -104,6 +109,8 @@ namespace gfx
                queue.submit({{.commandBufferCount = 1, .pCommandBuffers = &buffer.get()}}, nullptr);
                queue.waitIdle();
 
+               util::stats::increment(util::stats::counter::bytes_uploaded, size);
+
                util::log_info(info.p_logger, "[core] index buffer created");
 
                class index_buffer buf = {};
@@ -0,0 +1,98 @@
+#include <gfx/memory/indirect_buffer.hpp>
+
+namespace gfx
+{
+   struct indirect_buffer_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override
+      {
+         return "gfx_indirect_buffer";
+      }
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return to_string(static_cast<indirect_buffer_error>(err));
+      }
+   };
+   inline static const indirect_buffer_error_category m_indirect_buffer_category{};
+
+   auto to_string(indirect_buffer_error err) -> std::string
+   {
+      switch (err)
+      {
+         case indirect_buffer_error::failed_to_create_indirect_buffer:
+            return "failed_to_create_indirect_buffer";
+         default:
+            return "UNKNOWN";
+      }
+   }
+
+   auto make_error(indirect_buffer_error err) noexcept -> error_t
+   {
+      return {{static_cast<int>(err), m_indirect_buffer_category}};
+   }
+
+   auto indirect_buffer::make(create_info&& info) noexcept -> gfx::result<indirect_buffer>
+   {
+      const vkn::device& device = *info.p_device;
+
+      const auto buffer_error = [&](vkn::error&& err) noexcept {
+         util::log_error(info.p_logger, "[gfx] indirect buffer error: {}-{}",
+                         err.type.category().name(), err.type.message());
+
+         return make_error(indirect_buffer_error::failed_to_create_indirect_buffer);
+      };
+
+      const vk::DeviceSize frame_size =
+         sizeof(vk::DrawIndexedIndirectCommand) * info.capacity.value();
+
+      return vkn::buffer::builder{device, info.p_logger}
+         .set_size(frame_size * info.frame_count.value())
+         .set_usage(vk::BufferUsageFlagBits::eIndirectBuffer)
+         .set_desired_memory_type(vk::MemoryPropertyFlagBits::eDeviceLocal |
+                                  vk::MemoryPropertyFlagBits::eHostVisible |
+                                  vk::MemoryPropertyFlagBits::eHostCoherent)
+         .add_fallback_memory_type(vk::MemoryPropertyFlagBits::eHostVisible |
+                                   vk::MemoryPropertyFlagBits::eHostCoherent)
+         .set_persistently_mapped()
+         .build()
+         .map_error(buffer_error)
+         .map([&](vkn::buffer&& handle) {
+            util::log_info(info.p_logger, "[gfx] indirect buffer of {} commands created",
+                           info.capacity.value());
+
+            indirect_buffer buf;
+            buf.m_buffer = std::move(handle);
+            buf.m_capacity = info.capacity.value();
+
+            return buf;
+         });
+   }
+
+   auto indirect_buffer::frame_data(std::size_t frame_index) const noexcept
+      -> std::span<vk::DrawIndexedIndirectCommand>
+   {
+      auto* p_bytes = static_cast<std::byte*>(m_buffer.mapped_data());
+      if (!p_bytes)
+      {
+         return {};
+      }
+
+      return {reinterpret_cast<vk::DrawIndexedIndirectCommand*>( // NOLINT
+                 p_bytes + frame_offset(frame_index)),
+              m_capacity};
+   }
+   auto indirect_buffer::frame_offset(std::size_t frame_index) const noexcept -> vk::DeviceSize
+   {
+      return sizeof(vk::DrawIndexedIndirectCommand) * m_capacity * frame_index;
+   }
+   auto indirect_buffer::capacity() const noexcept -> std::uint32_t { return m_capacity; }
+
+   auto indirect_buffer::operator->() noexcept -> vkn::buffer* { return &m_buffer; }
+   auto indirect_buffer::operator->() const noexcept -> const vkn::buffer* { return &m_buffer; }
+
+   auto indirect_buffer::operator*() noexcept -> vkn::buffer& { return value(); }
+   auto indirect_buffer::operator*() const noexcept -> const vkn::buffer& { return value(); }
+
+   auto indirect_buffer::value() noexcept -> vkn::buffer& { return m_buffer; }
+   auto indirect_buffer::value() const noexcept -> const vkn::buffer& { return m_buffer; }
+} // namespace gfx
@@ -0,0 +1,102 @@
+#include <gfx/memory/object_buffer.hpp>
+
+namespace gfx
+{
+   struct object_buffer_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override
+      {
+         return "gfx_object_buffer";
+      }
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return to_string(static_cast<object_buffer_error>(err));
+      }
+   };
+   inline static const object_buffer_error_category m_object_buffer_category{};
+
+   auto to_string(object_buffer_error err) -> std::string
+   {
+      switch (err)
+      {
+         case object_buffer_error::failed_to_create_object_buffer:
+            return "failed_to_create_object_buffer";
+         default:
+            return "UNKNOWN";
+      }
+   }
+
+   auto make_error(object_buffer_error err) noexcept -> error_t
+   {
+      return {{static_cast<int>(err), m_object_buffer_category}};
+   }
+
+   auto object_buffer::make(create_info&& info) noexcept -> gfx::result<object_buffer>
+   {
+      const vkn::device& device = *info.p_device;
+
+      const auto buffer_error = [&](vkn::error&& err) noexcept {
+         util::log_error(info.p_logger, "[gfx] object buffer error: {}-{}",
+                         err.type.category().name(), err.type.message());
+
+         return make_error(object_buffer_error::failed_to_create_object_buffer);
+      };
+
+      // Dynamic offsets have to respect the alignment required by the device
+      const vk::DeviceSize alignment =
+         device.physical().properties().limits.minStorageBufferOffsetAlignment;
+      const vk::DeviceSize frame_size =
+         (sizeof(object_data) * info.capacity.value() + alignment - 1) / alignment * alignment;
+
+      return vkn::buffer::builder{device, info.p_logger}
+         .set_size(frame_size * info.frame_count.value())
+         .set_usage(vk::BufferUsageFlagBits::eStorageBuffer)
+         .set_desired_memory_type(vk::MemoryPropertyFlagBits::eDeviceLocal |
+                                  vk::MemoryPropertyFlagBits::eHostVisible |
+                                  vk::MemoryPropertyFlagBits::eHostCoherent)
+         .add_fallback_memory_type(vk::MemoryPropertyFlagBits::eHostVisible |
+                                   vk::MemoryPropertyFlagBits::eHostCoherent)
+         .set_persistently_mapped()
+         .build()
+         .map_error(buffer_error)
+         .map([&](vkn::buffer&& handle) {
+            util::log_info(info.p_logger, "[gfx] object buffer of {} objects created",
+                           info.capacity.value());
+
+            object_buffer buf;
+            buf.m_buffer = std::move(handle);
+            buf.m_capacity = info.capacity.value();
+            buf.m_frame_size = frame_size;
+
+            return buf;
+         });
+   }
+
+   auto object_buffer::frame_data(std::size_t frame_index) const noexcept
+      -> std::span<object_data>
+   {
+      auto* p_bytes = static_cast<std::byte*>(m_buffer.mapped_data());
+      if (!p_bytes)
+      {
+         return {};
+      }
+
+      return {reinterpret_cast<object_data*>(p_bytes + frame_offset(frame_index)), // NOLINT
+              m_capacity};
+   }
+   auto object_buffer::frame_offset(std::size_t frame_index) const noexcept -> std::uint32_t
+   {
+      return static_cast<std::uint32_t>(m_frame_size * frame_index);
+   }
+   auto object_buffer::frame_size() const noexcept -> vk::DeviceSize { return m_frame_size; }
+   auto object_buffer::capacity() const noexcept -> std::uint32_t { return m_capacity; }
+
+   auto object_buffer::operator->() noexcept -> vkn::buffer* { return &m_buffer; }
+   auto object_buffer::operator->() const noexcept -> const vkn::buffer* { return &m_buffer; }
+
+   auto object_buffer::operator*() noexcept -> vkn::buffer& { return value(); }
+   auto object_buffer::operator*() const noexcept -> const vkn::buffer& { return value(); }
+
+   auto object_buffer::value() noexcept -> vkn::buffer& { return m_buffer; }
+   auto object_buffer::value() const noexcept -> const vkn::buffer& { return m_buffer; }
+} // namespace gfx
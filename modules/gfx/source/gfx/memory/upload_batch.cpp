@@ -0,0 +1,191 @@
+#include <gfx/memory/upload_batch.hpp>
+
+#include <util/stats.hpp>
+#include <util/trace.hpp>
+
+#include <cstring>
+
+namespace gfx
+{
+   struct upload_batch_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override
+      {
+         return "gfx_upload_batch";
+      }
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return to_string(static_cast<upload_batch_error>(err));
+      }
+   };
+   inline static const upload_batch_error_category m_upload_batch_category{};
+
+   auto to_string(upload_batch_error err) -> std::string
+   {
+      switch (err)
+      {
+         case upload_batch_error::failed_to_create_staging_buffer:
+            return "failed_to_create_staging_buffer";
+         case upload_batch_error::failed_to_create_buffer:
+            return "failed_to_create_buffer";
+         case upload_batch_error::out_of_staging_memory:
+            return "out_of_staging_memory";
+         default:
+            return "UNKNOWN";
+      }
+   }
+
+   auto make_error(upload_batch_error err) noexcept -> error_t
+   {
+      return {{static_cast<int>(err), m_upload_batch_category}};
+   }
+
+   auto upload_batch::make(create_info&& info) noexcept -> gfx::result<upload_batch>
+   {
+      return vkn::buffer::builder{*info.p_device, info.p_logger}
+         .set_size(info.capacity)
+         .set_usage(vk::BufferUsageFlagBits::eTransferSrc)
+         .set_desired_memory_type(vk::MemoryPropertyFlagBits::eHostVisible |
+                                  vk::MemoryPropertyFlagBits::eHostCoherent)
+         .set_persistently_mapped()
+         .build()
+         .map_error([&](vkn::error&& err) noexcept {
+            util::log_error(info.p_logger, "[gfx] upload staging buffer error: {}-{}",
+                            err.type.category().name(), err.type.message());
+
+            return make_error(upload_batch_error::failed_to_create_staging_buffer);
+         })
+         .map([&](vkn::buffer&& staging_buffer) {
+            upload_batch batch;
+            batch.mp_device = info.p_device;
+            batch.mp_command_pool = info.p_command_pool;
+            batch.m_staging_buffer = std::move(staging_buffer);
+            batch.m_capacity = info.capacity;
+            batch.mp_logger = std::move(info.p_logger);
+
+            return batch;
+         });
+   }
+
+   auto upload_batch::stage(std::span<const vertex> vertices, vertex_layout layout)
+      -> gfx::result<vertex_buffer>
+   {
+      const vk::DeviceSize size = std::size(vertices) * vertex_stride(layout);
+      return allocate(size, vk::BufferUsageFlagBits::eVertexBuffer)
+         .map([&](vkn::buffer&& buffer) {
+            pack_vertices(layout, vertices, last_staging_range());
+
+            vertex_buffer result{};
+            result.m_buffer = std::move(buffer);
+
+            return result;
+         });
+   }
+   auto upload_batch::stage(std::span<const std::uint32_t> indices) -> gfx::result<index_buffer>
+   {
+      return allocate(indices.size_bytes(), vk::BufferUsageFlagBits::eIndexBuffer)
+         .map([&](vkn::buffer&& buffer) {
+            std::memcpy(std::data(last_staging_range()), std::data(indices), indices.size_bytes());
+
+            index_buffer result{};
+            result.m_buffer = std::move(buffer);
+            result.m_index_count = std::size(indices);
+
+            return result;
+         });
+   }
+
+   auto upload_batch::submit() -> bool
+   {
+      UTIL_TRACE_ZONE_CAT("upload_batch::submit", "upload");
+
+      if (std::empty(m_copies))
+      {
+         return true;
+      }
+
+      const vkn::device& device = *mp_device;
+
+      auto command_buffer_res = mp_command_pool->create_primary_buffer();
+      if (!command_buffer_res)
+      {
+         util::log_error(mp_logger, "[gfx] upload command buffer error: {}",
+                         command_buffer_res.error().value().type.message());
+
+         return false;
+      }
+
+      auto queue_res = device.get_queue(vkn::queue::type::graphics);
+      if (!queue_res)
+      {
+         util::log_error(mp_logger, "[gfx] no queue found for the upload batch");
+
+         return false;
+      }
+
+      const auto command_buffer = std::move(command_buffer_res).value().value();
+      const vk::Queue queue = queue_res.value().value();
+
+      command_buffer->begin({.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+      for (const auto& c : m_copies)
+      {
+         command_buffer->copyBuffer(vkn::value(m_staging_buffer), c.destination,
+                                    {{.srcOffset = c.offset, .size = c.size}});
+      }
+      command_buffer->end();
+
+      queue.submit({{.commandBufferCount = 1, .pCommandBuffers = &command_buffer.get()}}, nullptr);
+      queue.waitIdle();
+
+      util::stats::increment(util::stats::counter::bytes_uploaded, m_staged_size);
+
+      util::log_info(mp_logger, "[gfx] uploaded {} buffers holding {} bytes in one submission",
+                     std::size(m_copies), m_staged_size);
+
+      m_copies.clear();
+      m_staged_size = 0;
+
+      return true;
+   }
+
+   auto upload_batch::staged_size() const noexcept -> vk::DeviceSize { return m_staged_size; }
+
+   auto upload_batch::allocate(vk::DeviceSize size, vk::BufferUsageFlags usage)
+      -> gfx::result<vkn::buffer>
+   {
+      if (m_capacity - m_staged_size < size)
+      {
+         util::log_error(mp_logger, "[gfx] {} bytes don't fit in the upload batch", size);
+
+         return monad::make_error(make_error(upload_batch_error::out_of_staging_memory));
+      }
+
+      auto buffer_res = vkn::buffer::builder{*mp_device, mp_logger}
+                           .set_size(size)
+                           .set_usage(vk::BufferUsageFlagBits::eTransferDst | usage)
+                           .set_desired_memory_type(vk::MemoryPropertyFlagBits::eDeviceLocal)
+                           .build();
+      if (!buffer_res)
+      {
+         util::log_error(mp_logger, "[gfx] upload batch buffer error: {}",
+                         buffer_res.error().value().type.message());
+
+         return monad::make_error(make_error(upload_batch_error::failed_to_create_buffer));
+      }
+
+      auto buffer = std::move(buffer_res).value().value();
+
+      m_copies.push_back(
+         {.destination = vkn::value(buffer), .offset = m_staged_size, .size = size});
+      m_staged_size += size;
+
+      return buffer;
+   }
+   auto upload_batch::last_staging_range() noexcept -> std::span<std::byte>
+   {
+      const auto& last = m_copies.back();
+      auto* p_staging = static_cast<std::byte*>(m_staging_buffer.mapped_data());
+
+      return {p_staging + last.offset, static_cast<std::size_t>(last.size)};
+   }
+} // namespace gfx
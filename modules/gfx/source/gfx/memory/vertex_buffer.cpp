@@ -1,5 +1,8 @@
 #include <gfx/memory/vertex_buffer.hpp>
 
+#include <util/stats.hpp>
+#include <util/trace.hpp>
+
 namespace gfx
 {
    auto to_string(vertex_buffer_error err) -> std::string
@@ -40,15 +43,27 @@ namespace gfx
 
    auto vertex_buffer::make(make_info&& info) noexcept -> gfx::result<vertex_buffer>
    {
+      UTIL_TRACE_ZONE_CAT("vertex_buffer::make", "upload");
+
       const vkn::device& device = *info.p_device;
       const vkn::command_pool& command_pool = *info.p_command_pool;
 
-      const std::size_t size = sizeof(vertex) * std::size(info.vertices);
+      const bool is_packed = std::empty(info.vertices);
+      const std::size_t size = is_packed
+         ? std::size(info.packed_vertices)
+         : std::size(info.vertices) * std::size_t{vertex_stride(info.layout)};
       const auto map_memory = [&](vkn::buffer&& buffer) noexcept {
          util::log_debug(info.p_logger, "[gfx] mapping vertex data into staging buffer");
 
          void* p_data = device->mapMemory(buffer.memory(), 0, size, {});
-         memcpy(p_data, info.vertices.data(), size);
+         if (is_packed)
+         {
+            memcpy(p_data, info.packed_vertices.data(), size);
+         }
+         else
+         {
+            pack_vertices(info.layout, info.vertices, {static_cast<std::byte*>(p_data), size});
+         }
          device->unmapMemory(buffer.memory());
 
          return std::move(buffer);
@@ -119,6 +134,8 @@ namespace gfx
                queue.submit({{.commandBufferCount = 1, .pCommandBuffers = &buffer.get()}}, nullptr);
                queue.waitIdle();
 
+               util::stats::increment(util::stats::counter::bytes_uploaded, size);
+
                util::log_info(info.p_logger, "[gfx] vertex buffer created");
 
                class vertex_buffer buf = {};
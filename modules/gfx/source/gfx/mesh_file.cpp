@@ -0,0 +1,259 @@
+#include <gfx/mesh_file.hpp>
+
+#include <util/trace.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+
+namespace gfx
+{
+   struct mesh_file_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override { return "gfx_mesh_file"; }
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return to_string(static_cast<mesh_file_error>(err));
+      }
+   };
+   inline static const mesh_file_error_category m_mesh_file_category{};
+
+   auto to_string(mesh_file_error err) -> std::string
+   {
+      switch (err)
+      {
+         case mesh_file_error::failed_to_map_file:
+            return "failed_to_map_file";
+         case mesh_file_error::invalid_magic:
+            return "invalid_magic";
+         case mesh_file_error::unsupported_version:
+            return "unsupported_version";
+         case mesh_file_error::unsupported_vertex_layout:
+            return "unsupported_vertex_layout";
+         case mesh_file_error::truncated_data:
+            return "truncated_data";
+         case mesh_file_error::invalid_index:
+            return "invalid_index";
+         default:
+            return "UNKNOWN";
+      }
+   }
+
+   auto make_error(mesh_file_error err) noexcept -> error_t
+   {
+      return {{static_cast<int>(err), m_mesh_file_category}};
+   }
+
+   namespace
+   {
+      constexpr std::uint32_t mesh_magic = 0x4853'4D56; // "VMSH"
+
+      /**
+       * The header at the start of every mesh file. Like the payloads it is stored in the byte
+       * order of the host, little endian on every platform the engine runs on
+       */
+      struct mesh_header
+      {
+         std::uint32_t magic;
+         std::uint32_t version;
+         vertex_layout layout;
+         std::uint32_t vertex_stride;
+         std::uint32_t vertex_count;
+         std::uint32_t index_count;
+         std::uint32_t lod_count;
+         std::uint32_t padding;
+         std::array<float, 3> bounds_min;
+         std::array<float, 3> bounds_max;
+         std::uint64_t lod_offset;
+         std::uint64_t vertex_offset;
+         std::uint64_t index_offset;
+      };
+
+      // The payloads are read in place, their layout is part of the format
+      static_assert(sizeof(mesh_header) == 80 && std::is_trivially_copyable_v<mesh_header>);
+      static_assert(sizeof(mesh_lod) == 12 && std::is_trivially_copyable_v<mesh_lod>);
+      static_assert(sizeof(vertex) == 24 && std::is_trivially_copyable_v<vertex>);
+
+      auto align_up(std::uint64_t offset) noexcept -> std::uint64_t
+      {
+         return (offset + mesh_file::alignment - 1) / mesh_file::alignment * mesh_file::alignment;
+      }
+
+      /**
+       * Check that an array of count elements at the offset is aligned and fits in the file
+       */
+      auto is_in_file(std::uint64_t offset, std::uint64_t count, std::uint64_t element_size,
+                      std::size_t file_size) noexcept -> bool
+      {
+         return offset % mesh_file::alignment == 0 && offset <= file_size &&
+            count * element_size <= file_size - offset;
+      }
+
+      template <class any_>
+      auto view(std::span<const std::byte> bytes, std::uint64_t offset, std::uint32_t count)
+         -> std::span<const any_>
+      {
+         return {reinterpret_cast<const any_*>(std::data(bytes) + offset), count}; // NOLINT
+      }
+   } // namespace
+
+   auto mesh_file::open(const std::filesystem::path& path) -> gfx::result<mesh_file>
+   {
+      UTIL_TRACE_ZONE_CAT("mesh_file::open", "upload");
+
+      auto file = util::mapped_file::open(path);
+      if (!file)
+      {
+         return monad::make_error(make_error(mesh_file_error::failed_to_map_file));
+      }
+
+      const auto bytes = file->bytes();
+      if (std::size(bytes) < sizeof(mesh_header))
+      {
+         return monad::make_error(make_error(mesh_file_error::truncated_data));
+      }
+
+      mesh_header header{};
+      std::memcpy(&header, std::data(bytes), sizeof(header));
+
+      if (header.magic != mesh_magic)
+      {
+         return monad::make_error(make_error(mesh_file_error::invalid_magic));
+      }
+      if (header.version != version)
+      {
+         return monad::make_error(make_error(mesh_file_error::unsupported_version));
+      }
+      if (static_cast<std::size_t>(header.layout) >= vertex_layout_count ||
+          header.vertex_stride != vertex_stride(header.layout))
+      {
+         return monad::make_error(make_error(mesh_file_error::unsupported_vertex_layout));
+      }
+
+      const std::size_t size = std::size(bytes);
+      if (header.lod_count == 0 ||
+          !is_in_file(header.lod_offset, header.lod_count, sizeof(mesh_lod), size) ||
+          !is_in_file(header.vertex_offset, header.vertex_count, header.vertex_stride, size) ||
+          !is_in_file(header.index_offset, header.index_count, sizeof(std::uint32_t), size))
+      {
+         return monad::make_error(make_error(mesh_file_error::truncated_data));
+      }
+
+      mesh_file mesh;
+      mesh.m_layout = header.layout;
+      mesh.m_bounds = {.min = {header.bounds_min[0], header.bounds_min[1], header.bounds_min[2]},
+                       .max = {header.bounds_max[0], header.bounds_max[1], header.bounds_max[2]}};
+      mesh.m_vertex_count = header.vertex_count;
+      mesh.m_vertex_data = bytes.subspan(header.vertex_offset,
+                                         std::size_t{header.vertex_count} * header.vertex_stride);
+      if (header.layout == vertex_layout::position_colour)
+      {
+         mesh.m_vertices = view<vertex>(bytes, header.vertex_offset, header.vertex_count);
+      }
+      mesh.m_indices = view<std::uint32_t>(bytes, header.index_offset, header.index_count);
+      mesh.m_lods = view<mesh_lod>(bytes, header.lod_offset, header.lod_count);
+
+      for (const auto& lod : mesh.m_lods)
+      {
+         if (lod.first_index > header.index_count ||
+             lod.index_count > header.index_count - lod.first_index)
+         {
+            return monad::make_error(make_error(mesh_file_error::truncated_data));
+         }
+      }
+
+      // Checked once here so the indices can be drawn without reading past the vertex buffer
+      if (std::any_of(std::begin(mesh.m_indices), std::end(mesh.m_indices),
+                      [&](std::uint32_t index) {
+                         return index >= header.vertex_count;
+                      }))
+      {
+         return monad::make_error(make_error(mesh_file_error::invalid_index));
+      }
+
+      // The views point into the mapping, which stays in place when moved
+      mesh.m_file = std::move(file).value();
+
+      return mesh;
+   }
+
+   auto mesh_file::layout() const noexcept -> vertex_layout { return m_layout; }
+   auto mesh_file::bounds() const noexcept -> const aabb& { return m_bounds; }
+
+   auto mesh_file::vertex_count() const noexcept -> std::size_t { return m_vertex_count; }
+   auto mesh_file::vertex_data() const noexcept -> std::span<const std::byte>
+   {
+      return m_vertex_data;
+   }
+   auto mesh_file::vertices() const noexcept -> std::span<const vertex> { return m_vertices; }
+   auto mesh_file::indices() const noexcept -> std::span<const std::uint32_t>
+   {
+      return m_indices;
+   }
+   auto mesh_file::lods() const noexcept -> std::span<const mesh_lod> { return m_lods; }
+
+   auto write_mesh_file(const std::filesystem::path& path, std::span<const vertex> vertices,
+                        std::span<const std::uint32_t> indices, std::span<const mesh_lod> lods,
+                        vertex_layout layout) -> bool
+   {
+      const std::array<mesh_lod, 1> full_lod{
+         {{.first_index = 0, .index_count = static_cast<std::uint32_t>(std::size(indices)),
+           .error = 0.0F}}};
+      if (std::empty(lods))
+      {
+         lods = full_lod;
+      }
+
+      glm::vec3 min{std::empty(vertices) ? 0.0F : std::numeric_limits<float>::max()};
+      glm::vec3 max{std::empty(vertices) ? 0.0F : std::numeric_limits<float>::lowest()};
+      for (const auto& v : vertices)
+      {
+         min = glm::min(min, v.position);
+         max = glm::max(max, v.position);
+      }
+
+      mesh_header header{.magic = mesh_magic,
+                         .version = mesh_file::version,
+                         .layout = layout,
+                         .vertex_stride = vertex_stride(layout),
+                         .vertex_count = static_cast<std::uint32_t>(std::size(vertices)),
+                         .index_count = static_cast<std::uint32_t>(std::size(indices)),
+                         .lod_count = static_cast<std::uint32_t>(std::size(lods)),
+                         .padding = 0,
+                         .bounds_min = {min.x, min.y, min.z},
+                         .bounds_max = {max.x, max.y, max.z},
+                         .lod_offset = align_up(sizeof(mesh_header)),
+                         .vertex_offset = 0,
+                         .index_offset = 0};
+      header.vertex_offset =
+         align_up(header.lod_offset + std::size_t{header.lod_count} * sizeof(mesh_lod));
+      header.index_offset =
+         align_up(header.vertex_offset + std::size_t{header.vertex_count} * header.vertex_stride);
+
+      std::ofstream stream{path, std::ios::binary | std::ios::trunc};
+      if (!stream)
+      {
+         return false;
+      }
+
+      std::uint64_t position = 0;
+      const auto write = [&](std::uint64_t offset, std::span<const std::byte> data) {
+         const std::array<char, mesh_file::alignment> padding{};
+         stream.write(std::data(padding), static_cast<std::streamsize>(offset - position));
+         stream.write(reinterpret_cast<const char*>(std::data(data)), // NOLINT
+                      static_cast<std::streamsize>(std::size(data)));
+
+         position = offset + std::size(data);
+      };
+
+      write(0, std::as_bytes(std::span{&header, 1}));
+      write(header.lod_offset, std::as_bytes(lods));
+      write(header.vertex_offset, pack_vertices(layout, vertices));
+      write(header.index_offset, std::as_bytes(indices));
+
+      return static_cast<bool>(stream);
+   }
+} // namespace gfx
@@ -0,0 +1,827 @@
+#include <gfx/mesh_optimizer.hpp>
+
+#include <gfx/culling.hpp>
+
+#include <util/trace.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace gfx
+{
+   namespace detail
+   {
+      static constexpr std::uint32_t invalid_index = std::numeric_limits<std::uint32_t>::max();
+
+      auto hash_vertex(const vertex& v) noexcept -> std::uint64_t
+      {
+         static_assert(sizeof(vertex) % sizeof(std::uint32_t) == 0);
+
+         std::array<std::uint32_t, sizeof(vertex) / sizeof(std::uint32_t)> words{};
+         std::memcpy(words.data(), &v, sizeof(vertex));
+
+         // FNV-1a over 32 bit words, the vertices are made of floats
+         std::uint64_t hash = 0xCBF2'9CE4'8422'2325;
+         for (const std::uint32_t word : words)
+         {
+            hash = (hash ^ word) * 0x100'0000'01B3;
+         }
+
+         return hash;
+      }
+
+      /**
+       * The triangles using every vertex, stored contiguously per vertex
+       */
+      struct vertex_adjacency
+      {
+         util::dynamic_array<std::uint32_t> offsets{};
+         util::dynamic_array<std::uint32_t> triangles{};
+
+         [[nodiscard]] auto of(std::uint32_t v) const -> std::span<const std::uint32_t>
+         {
+            return std::span{triangles}.subspan(offsets[v], offsets[v + 1] - offsets[v]);
+         }
+      };
+
+      auto build_adjacency(std::span<const std::uint32_t> indices, std::size_t vertex_count)
+         -> vertex_adjacency
+      {
+         vertex_adjacency adjacency{.offsets = util::dynamic_array<std::uint32_t>(vertex_count + 1),
+                                    .triangles = util::dynamic_array<std::uint32_t>(
+                                       std::size(indices))};
+
+         for (const std::uint32_t index : indices)
+         {
+            ++adjacency.offsets[index + 1];
+         }
+         std::partial_sum(std::begin(adjacency.offsets), std::end(adjacency.offsets),
+                          std::begin(adjacency.offsets));
+
+         util::dynamic_array<std::uint32_t> cursors(std::begin(adjacency.offsets),
+                                                    std::end(adjacency.offsets) - 1);
+         for (std::size_t i = 0; i < std::size(indices); ++i)
+         {
+            adjacency.triangles[cursors[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+         }
+
+         return adjacency;
+      }
+
+      /**
+       * A FIFO cache simulated with timestamps: a vertex is cached if it was one of the last
+       * cache_size vertices inserted
+       */
+      class fifo_cache
+      {
+      public:
+         fifo_cache(std::size_t vertex_count, std::uint32_t cache_size) :
+            m_timestamps(vertex_count), m_cache_size{cache_size}, m_time{cache_size + 1}
+         {}
+
+         /**
+          * Access the vertex, returning true on a cache miss
+          */
+         auto access(std::uint32_t v) -> bool
+         {
+            if (m_time - m_timestamps[v] > m_cache_size)
+            {
+               m_timestamps[v] = m_time++;
+
+               return true;
+            }
+
+            return false;
+         }
+
+         void clear()
+         {
+            // Pushing the time forward evicts every vertex at once
+            m_time += m_cache_size + 1;
+         }
+
+      private:
+         util::dynamic_array<std::uint32_t> m_timestamps;
+         std::uint32_t m_cache_size;
+         std::uint32_t m_time;
+      };
+
+      auto cross(const glm::vec3& a, const glm::vec3& b) noexcept -> glm::vec3
+      {
+         return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+      }
+
+      /**
+       * The sum of the squared distances to a set of planes, weighted by the area of the
+       * triangles they come from. Only the upper half of the symmetric 4x4 matrix is stored
+       */
+      struct quadric
+      {
+         double xx{0.0}, xy{0.0}, xz{0.0}, xw{0.0};
+         double yy{0.0}, yz{0.0}, yw{0.0};
+         double zz{0.0}, zw{0.0};
+         double ww{0.0};
+         double weight{0.0};
+
+         static auto from_plane(const glm::vec3& normal, float distance, float weight) noexcept
+            -> quadric
+         {
+            const double a = normal.x;
+            const double b = normal.y;
+            const double c = normal.z;
+            const double d = distance;
+            const double w = weight;
+
+            return {.xx = a * a * w, .xy = a * b * w, .xz = a * c * w, .xw = a * d * w,
+                    .yy = b * b * w, .yz = b * c * w, .yw = b * d * w,
+                    .zz = c * c * w, .zw = c * d * w,
+                    .ww = d * d * w,
+                    .weight = w};
+         }
+
+         auto operator+=(const quadric& rhs) noexcept -> quadric&
+         {
+            xx += rhs.xx;
+            xy += rhs.xy;
+            xz += rhs.xz;
+            xw += rhs.xw;
+            yy += rhs.yy;
+            yz += rhs.yz;
+            yw += rhs.yw;
+            zz += rhs.zz;
+            zw += rhs.zw;
+            ww += rhs.ww;
+            weight += rhs.weight;
+
+            return *this;
+         }
+
+         /**
+          * The mean squared distance of the point to the planes
+          */
+         [[nodiscard]] auto error(const glm::vec3& p) const noexcept -> float
+         {
+            const double x = p.x;
+            const double y = p.y;
+            const double z = p.z;
+
+            const double sum = x * x * xx + y * y * yy + z * z * zz + ww +
+               2.0 * (x * y * xy + x * z * xz + y * z * yz + x * xw + y * yw + z * zw);
+
+            return weight > 0.0 ? static_cast<float>(std::abs(sum) / weight) : 0.0F;
+         }
+      };
+
+      auto operator+(quadric lhs, const quadric& rhs) noexcept -> quadric { return lhs += rhs; }
+
+      struct collapse
+      {
+         std::uint32_t from;
+         std::uint32_t to;
+         float error;
+      };
+
+      /**
+       * Find the vertices at the end of an edge used by a single triangle, the edges of both
+       * borders and attribute seams, which collapses would tear open
+       */
+      auto find_border_vertices(std::span<const std::uint32_t> indices, std::size_t vertex_count)
+         -> util::dynamic_array<bool>
+      {
+         util::dynamic_array<std::uint64_t> edges;
+         edges.reserve(std::size(indices));
+         for (std::size_t i = 0; i < std::size(indices); i += 3)
+         {
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+               const std::uint64_t a = indices[i + c];
+               const std::uint64_t b = indices[i + (c + 1) % 3];
+
+               edges.push_back(std::min(a, b) << 32U | std::max(a, b));
+            }
+         }
+         std::sort(std::begin(edges), std::end(edges));
+
+         util::dynamic_array<bool> is_border(vertex_count);
+         for (std::size_t i = 0; i < std::size(edges);)
+         {
+            std::size_t end = i + 1;
+            while (end < std::size(edges) && edges[end] == edges[i])
+            {
+               ++end;
+            }
+
+            if (end - i == 1)
+            {
+               is_border[edges[i] >> 32U] = true;
+               is_border[edges[i] & 0xFFFF'FFFFU] = true;
+            }
+
+            i = end;
+         }
+
+         return is_border;
+      }
+
+      /**
+       * Remove the triangles a collapse made degenerate
+       */
+      void remove_degenerate_triangles(util::dynamic_array<std::uint32_t>& indices)
+      {
+         std::size_t write = 0;
+         for (std::size_t i = 0; i < std::size(indices); i += 3)
+         {
+            const std::uint32_t a = indices[i];
+            const std::uint32_t b = indices[i + 1];
+            const std::uint32_t c = indices[i + 2];
+
+            if (a != b && b != c && a != c)
+            {
+               indices[write++] = a;
+               indices[write++] = b;
+               indices[write++] = c;
+            }
+         }
+
+         indices.resize(write);
+      }
+   } // namespace detail
+
+   void deduplicate_vertices(util::dynamic_array<vertex>& vertices,
+                             std::span<std::uint32_t> indices)
+   {
+      UTIL_TRACE_ZONE_CAT("deduplicate_vertices", "mesh");
+
+      const std::size_t vertex_count = std::size(vertices);
+      if (vertex_count == 0)
+      {
+         return;
+      }
+
+      // Open addressing with linear probing, kept at most half full
+      const std::size_t table_size = std::bit_ceil(vertex_count * 2);
+      util::dynamic_array<std::uint32_t> table(table_size);
+      std::fill(std::begin(table), std::end(table), detail::invalid_index);
+
+      util::dynamic_array<std::uint32_t> remap(vertex_count);
+      std::uint32_t unique_count = 0;
+
+      for (std::uint32_t v = 0; v < vertex_count; ++v)
+      {
+         std::size_t slot = detail::hash_vertex(vertices[v]) & (table_size - 1);
+         while (table[slot] != detail::invalid_index &&
+                std::memcmp(&vertices[table[slot]], &vertices[v], sizeof(vertex)) != 0)
+         {
+            slot = (slot + 1) & (table_size - 1);
+         }
+
+         if (table[slot] == detail::invalid_index)
+         {
+            // Unique vertices are compacted in place, a vertex never moves past its position
+            vertices[unique_count] = vertices[v];
+            table[slot] = unique_count;
+            ++unique_count;
+         }
+
+         remap[v] = table[slot];
+      }
+
+      for (auto& index : indices)
+      {
+         index = remap[index];
+      }
+
+      vertices.resize(unique_count);
+   }
+
+   void optimize_vertex_cache(std::span<std::uint32_t> indices, std::size_t vertex_count,
+                              std::uint32_t cache_size)
+   {
+      UTIL_TRACE_ZONE_CAT("optimize_vertex_cache", "mesh");
+
+      const std::size_t triangle_count = std::size(indices) / 3;
+      if (triangle_count == 0)
+      {
+         return;
+      }
+
+      const auto adjacency = detail::build_adjacency(indices, vertex_count);
+
+      util::dynamic_array<std::uint32_t> live_triangles(vertex_count);
+      for (std::uint32_t v = 0; v < vertex_count; ++v)
+      {
+         live_triangles[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+      }
+
+      util::dynamic_array<std::uint32_t> cache_times(vertex_count);
+      util::dynamic_array<bool> is_emitted(triangle_count);
+      util::dynamic_array<std::uint32_t> dead_end_stack;
+      util::dynamic_array<std::uint32_t> candidates;
+
+      util::dynamic_array<std::uint32_t> result;
+      result.reserve(std::size(indices));
+
+      std::uint32_t time = cache_size + 1;
+      std::uint32_t cursor = 0;
+
+      // Skip to a vertex that still has triangles, from the most recently used ones first
+      const auto skip_dead_end = [&]() -> std::uint32_t {
+         while (!std::empty(dead_end_stack))
+         {
+            const std::uint32_t v = dead_end_stack.back();
+            dead_end_stack.pop_back();
+
+            if (live_triangles[v] > 0)
+            {
+               return v;
+            }
+         }
+
+         for (; cursor < vertex_count; ++cursor)
+         {
+            if (live_triangles[cursor] > 0)
+            {
+               return cursor;
+            }
+         }
+
+         return detail::invalid_index;
+      };
+
+      std::uint32_t fanning = skip_dead_end();
+      while (fanning != detail::invalid_index)
+      {
+         candidates.clear();
+
+         for (const std::uint32_t triangle : adjacency.of(fanning))
+         {
+            if (is_emitted[triangle])
+            {
+               continue;
+            }
+
+            for (std::size_t corner = 0; corner < 3; ++corner)
+            {
+               const std::uint32_t v = indices[std::size_t{triangle} * 3 + corner];
+
+               result.push_back(v);
+               dead_end_stack.push_back(v);
+               candidates.push_back(v);
+
+               --live_triangles[v];
+               if (time - cache_times[v] > cache_size)
+               {
+                  cache_times[v] = time++;
+               }
+            }
+
+            is_emitted[triangle] = true;
+         }
+
+         // Prefer the oldest candidate whose remaining triangles can be emitted before it leaves
+         // the cache
+         std::uint32_t next = detail::invalid_index;
+         std::uint32_t best_priority = 0;
+         for (const std::uint32_t v : candidates)
+         {
+            if (live_triangles[v] == 0)
+            {
+               continue;
+            }
+
+            std::uint32_t priority = 0;
+            if (time - cache_times[v] + 2 * live_triangles[v] <= cache_size)
+            {
+               priority = time - cache_times[v];
+            }
+
+            if (next == detail::invalid_index || priority > best_priority)
+            {
+               next = v;
+               best_priority = priority;
+            }
+         }
+
+         fanning = next != detail::invalid_index ? next : skip_dead_end();
+      }
+
+      std::copy(std::begin(result), std::end(result), std::begin(indices));
+   }
+
+   void optimize_overdraw(std::span<std::uint32_t> indices, std::span<const vertex> vertices,
+                          std::uint32_t cache_size, float threshold)
+   {
+      UTIL_TRACE_ZONE_CAT("optimize_overdraw", "mesh");
+
+      const std::size_t triangle_count = std::size(indices) / 3;
+      if (triangle_count == 0)
+      {
+         return;
+      }
+
+      const auto corner = [&](std::size_t triangle, std::size_t c) {
+         return indices[triangle * 3 + c];
+      };
+
+      // Hard boundaries are the triangles that miss the cache on every corner, where the cache
+      // optimised order started over
+      util::dynamic_array<std::uint32_t> clusters;
+      {
+         detail::fifo_cache cache{std::size(vertices), cache_size};
+         for (std::size_t t = 0; t < triangle_count; ++t)
+         {
+            const bool a = cache.access(corner(t, 0));
+            const bool b = cache.access(corner(t, 1));
+            const bool c = cache.access(corner(t, 2));
+
+            if (a && b && c)
+            {
+               clusters.push_back(static_cast<std::uint32_t>(t));
+            }
+         }
+      }
+      clusters.push_back(static_cast<std::uint32_t>(triangle_count));
+
+      // Soft boundaries split the hard clusters wherever the miss ratio of the part before the
+      // cut stays within the threshold of the whole cluster's
+      util::dynamic_array<std::uint32_t> boundaries;
+      {
+         detail::fifo_cache cache{std::size(vertices), cache_size};
+         for (std::size_t i = 0; i + 1 < std::size(clusters); ++i)
+         {
+            const std::size_t begin = clusters[i];
+            const std::size_t end = clusters[i + 1];
+
+            cache.clear();
+            std::size_t misses = 0;
+            for (std::size_t t = begin; t < end; ++t)
+            {
+               for (std::size_t c = 0; c < 3; ++c)
+               {
+                  misses += cache.access(corner(t, c)) ? 1 : 0;
+               }
+            }
+
+            const float cluster_acmr =
+               static_cast<float>(misses) / static_cast<float>(end - begin);
+
+            boundaries.push_back(static_cast<std::uint32_t>(begin));
+
+            cache.clear();
+            misses = 0;
+            std::size_t start = begin;
+            for (std::size_t t = begin; t < end; ++t)
+            {
+               for (std::size_t c = 0; c < 3; ++c)
+               {
+                  misses += cache.access(corner(t, c)) ? 1 : 0;
+               }
+
+               const float acmr = static_cast<float>(misses) / static_cast<float>(t + 1 - start);
+               if (t + 1 < end && acmr <= cluster_acmr * threshold)
+               {
+                  boundaries.push_back(static_cast<std::uint32_t>(t + 1));
+
+                  cache.clear();
+                  misses = 0;
+                  start = t + 1;
+               }
+            }
+         }
+      }
+      boundaries.push_back(static_cast<std::uint32_t>(triangle_count));
+
+      // The sort key of a cluster is how much its area weighted normal points away from the
+      // centre of the mesh, measured at the cluster's centroid
+      const std::size_t cluster_count = std::size(boundaries) - 1;
+      util::dynamic_array<glm::vec3> centroids(cluster_count);
+      util::dynamic_array<glm::vec3> normals(cluster_count);
+      glm::vec3 mesh_centroid{0.0F};
+      float mesh_area = 0.0F;
+
+      for (std::size_t i = 0; i < cluster_count; ++i)
+      {
+         glm::vec3 centroid{0.0F};
+         glm::vec3 normal{0.0F};
+         float area = 0.0F;
+
+         for (std::size_t t = boundaries[i]; t < boundaries[i + 1]; ++t)
+         {
+            const glm::vec3& p0 = vertices[corner(t, 0)].position;
+            const glm::vec3& p1 = vertices[corner(t, 1)].position;
+            const glm::vec3& p2 = vertices[corner(t, 2)].position;
+
+            const glm::vec3 n = detail::cross(p1 - p0, p2 - p0);
+            const float triangle_area = glm::length(n);
+
+            centroid = centroid + (p0 + p1 + p2) * (triangle_area / 3.0F);
+            normal = normal + n;
+            area += triangle_area;
+         }
+
+         mesh_centroid = mesh_centroid + centroid;
+         mesh_area += area;
+
+         centroids[i] = area > 0.0F ? centroid * (1.0F / area) : centroid;
+         const float normal_length = glm::length(normal);
+         normals[i] = normal_length > 0.0F ? normal * (1.0F / normal_length) : normal;
+      }
+
+      if (mesh_area > 0.0F)
+      {
+         mesh_centroid = mesh_centroid * (1.0F / mesh_area);
+      }
+
+      util::dynamic_array<float> sort_keys(cluster_count);
+      util::dynamic_array<std::uint32_t> order(cluster_count);
+      for (std::size_t i = 0; i < cluster_count; ++i)
+      {
+         sort_keys[i] = glm::dot(centroids[i] - mesh_centroid, normals[i]);
+         order[i] = static_cast<std::uint32_t>(i);
+      }
+
+      std::stable_sort(std::begin(order), std::end(order), [&](std::uint32_t a, std::uint32_t b) {
+         return sort_keys[a] > sort_keys[b];
+      });
+
+      util::dynamic_array<std::uint32_t> result;
+      result.reserve(std::size(indices));
+      for (const std::uint32_t cluster : order)
+      {
+         result.insert(std::cend(result), std::begin(indices) + boundaries[cluster] * 3,
+                       std::begin(indices) + boundaries[cluster + 1] * 3);
+      }
+
+      std::copy(std::begin(result), std::end(result), std::begin(indices));
+   }
+
+   void optimize_vertex_fetch(util::dynamic_array<vertex>& vertices,
+                              std::span<std::uint32_t> indices)
+   {
+      UTIL_TRACE_ZONE_CAT("optimize_vertex_fetch", "mesh");
+
+      util::dynamic_array<std::uint32_t> remap(std::size(vertices));
+      std::fill(std::begin(remap), std::end(remap), detail::invalid_index);
+
+      util::dynamic_array<vertex> result;
+      result.reserve(std::size(vertices));
+
+      for (auto& index : indices)
+      {
+         if (remap[index] == detail::invalid_index)
+         {
+            remap[index] = static_cast<std::uint32_t>(std::size(result));
+            result.push_back(vertices[index]);
+         }
+
+         index = remap[index];
+      }
+
+      vertices = std::move(result);
+   }
+
+   auto analyze_vertex_cache(std::span<const std::uint32_t> indices, std::size_t vertex_count,
+                             std::uint32_t cache_size) -> float
+   {
+      const std::size_t triangle_count = std::size(indices) / 3;
+      if (triangle_count == 0)
+      {
+         return 0.0F;
+      }
+
+      detail::fifo_cache cache{vertex_count, cache_size};
+
+      std::size_t misses = 0;
+      for (const std::uint32_t index : indices)
+      {
+         misses += cache.access(index) ? 1 : 0;
+      }
+
+      return static_cast<float>(misses) / static_cast<float>(triangle_count);
+   }
+
+   auto simplify_mesh(std::span<const std::uint32_t> indices, std::span<const vertex> vertices,
+                      std::size_t target_index_count, float target_error) -> simplified_mesh
+   {
+      UTIL_TRACE_ZONE_CAT("simplify_mesh", "mesh");
+
+      simplified_mesh result{
+         .indices = util::dynamic_array<std::uint32_t>(std::begin(indices), std::end(indices))};
+
+      const std::size_t vertex_count = std::size(vertices);
+      if (std::size(indices) <= target_index_count || vertex_count == 0)
+      {
+         return result;
+      }
+
+      util::dynamic_array<detail::quadric> quadrics(vertex_count);
+      for (std::size_t i = 0; i < std::size(indices); i += 3)
+      {
+         const glm::vec3 p0 = vertices[indices[i]].position;
+         const glm::vec3 p1 = vertices[indices[i + 1]].position;
+         const glm::vec3 p2 = vertices[indices[i + 2]].position;
+
+         const glm::vec3 normal = detail::cross(p1 - p0, p2 - p0);
+         const float double_area = glm::length(normal);
+         if (double_area == 0.0F)
+         {
+            continue;
+         }
+
+         const glm::vec3 unit_normal = normal / double_area;
+         const auto plane = detail::quadric::from_plane(unit_normal, -glm::dot(unit_normal, p0),
+                                                        double_area * 0.5F);
+         for (std::size_t c = 0; c < 3; ++c)
+         {
+            quadrics[indices[i + c]] += plane;
+         }
+      }
+
+      const auto is_locked = detail::find_border_vertices(indices, vertex_count);
+      const float max_error_sq = target_error * target_error;
+
+      util::dynamic_array<std::uint32_t> remap(vertex_count);
+      util::dynamic_array<bool> is_touched(vertex_count);
+      util::dynamic_array<detail::collapse> collapses;
+
+      // Every pass collapses the cheapest edges whose vertices no other collapse of the pass
+      // touched, then rewrites the indices
+      while (std::size(result.indices) > target_index_count)
+      {
+         const auto& current = result.indices;
+         const auto adjacency = detail::build_adjacency(current, vertex_count);
+
+         collapses.clear();
+         for (std::size_t i = 0; i < std::size(current); i += 3)
+         {
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+               const std::uint32_t a = current[i + c];
+               const std::uint32_t b = current[i + (c + 1) % 3];
+
+               // Interior edges are shared by two triangles, only one of which sees a < b
+               if (a > b)
+               {
+                  continue;
+               }
+
+               const auto q = quadrics[a] + quadrics[b];
+               if (!is_locked[a])
+               {
+                  collapses.push_back({.from = a, .to = b, .error = q.error(vertices[b].position)});
+               }
+               if (!is_locked[b])
+               {
+                  collapses.push_back({.from = b, .to = a, .error = q.error(vertices[a].position)});
+               }
+            }
+         }
+
+         std::sort(std::begin(collapses), std::end(collapses),
+                   [](const auto& lhs, const auto& rhs) { return lhs.error < rhs.error; });
+
+         std::iota(std::begin(remap), std::end(remap), 0U);
+         std::fill(std::begin(is_touched), std::end(is_touched), false);
+
+         // A collapse removes two triangles of a closed surface
+         const std::size_t triangles_to_remove = (std::size(current) - target_index_count) / 3;
+         const std::size_t max_collapse_count = std::max<std::size_t>(triangles_to_remove / 2, 1);
+
+         const auto flips = [&](const detail::collapse& c) {
+            for (const std::uint32_t triangle : adjacency.of(c.from))
+            {
+               std::array<std::uint32_t, 3> corners{};
+               for (std::size_t k = 0; k < 3; ++k)
+               {
+                  corners[k] = remap[current[triangle * 3 + k]];
+               }
+
+               // The triangles around the collapsed edge disappear
+               if (std::ranges::find(corners, c.to) != std::end(corners))
+               {
+                  continue;
+               }
+
+               const auto normal = [&] {
+                  return detail::cross(
+                     vertices[corners[1]].position - vertices[corners[0]].position,
+                     vertices[corners[2]].position - vertices[corners[0]].position);
+               };
+
+               const glm::vec3 before = normal();
+               std::ranges::replace(corners, c.from, c.to);
+               const glm::vec3 after = normal();
+
+               if (glm::dot(before, after) <= 0.0F)
+               {
+                  return true;
+               }
+            }
+
+            return false;
+         };
+
+         std::size_t collapse_count = 0;
+         for (const auto& c : collapses)
+         {
+            if (c.error > max_error_sq || collapse_count == max_collapse_count)
+            {
+               break;
+            }
+
+            if (is_touched[c.from] || is_touched[c.to] || flips(c))
+            {
+               continue;
+            }
+
+            remap[c.from] = c.to;
+            quadrics[c.to] += quadrics[c.from];
+            is_touched[c.from] = true;
+            is_touched[c.to] = true;
+
+            result.error = std::max(result.error, std::sqrt(c.error));
+            ++collapse_count;
+         }
+
+         if (collapse_count == 0)
+         {
+            break;
+         }
+
+         for (auto& index : result.indices)
+         {
+            index = remap[index];
+         }
+         detail::remove_degenerate_triangles(result.indices);
+      }
+
+      return result;
+   }
+
+   auto build_lod_chain(util::dynamic_array<std::uint32_t>& indices,
+                        std::span<const vertex> vertices, const mesh_lod_options& options)
+      -> util::dynamic_array<mesh_lod>
+   {
+      UTIL_TRACE_ZONE_CAT("build_lod_chain", "mesh");
+
+      util::dynamic_array<mesh_lod> lods;
+      lods.push_back({.first_index = 0,
+                      .index_count = static_cast<std::uint32_t>(std::size(indices)),
+                      .error = 0.0F});
+
+      const std::size_t full_index_count = std::size(indices);
+      const float max_error = options.max_error * compute_bounding_sphere(vertices).radius;
+
+      // Every level is simplified from the full detail one so errors don't accumulate
+      std::size_t previous_count = full_index_count;
+      while (std::size(lods) < options.max_lod_count)
+      {
+         const auto target_triangle_count = static_cast<std::size_t>(
+            static_cast<float>(previous_count / 3) * options.reduction);
+         if (target_triangle_count < options.min_triangle_count)
+         {
+            break;
+         }
+
+         auto lod = simplify_mesh(std::span{indices}.first(full_index_count), vertices,
+                                  target_triangle_count * 3, max_error);
+
+         // Levels barely smaller than the previous one cost memory without saving vertices
+         if (std::size(lod.indices) * 10 > previous_count * 9)
+         {
+            break;
+         }
+
+         optimize_vertex_cache(lod.indices, std::size(vertices), options.cache_size);
+
+         lods.push_back({.first_index = static_cast<std::uint32_t>(std::size(indices)),
+                         .index_count = static_cast<std::uint32_t>(std::size(lod.indices)),
+                         .error = lod.error});
+         indices.insert(std::cend(indices), std::cbegin(lod.indices), std::cend(lod.indices));
+
+         previous_count = std::size(lod.indices);
+      }
+
+      return lods;
+   }
+
+   void optimize_mesh(util::dynamic_array<vertex>& vertices,
+                      util::dynamic_array<std::uint32_t>& indices,
+                      const mesh_optimizer_options& options)
+   {
+      UTIL_TRACE_ZONE_CAT("optimize_mesh", "mesh");
+
+      deduplicate_vertices(vertices, indices);
+      optimize_vertex_cache(indices, std::size(vertices), options.cache_size);
+      if (options.optimize_overdraw)
+      {
+         optimize_overdraw(indices, vertices, options.cache_size, options.overdraw_threshold);
+      }
+      optimize_vertex_fetch(vertices, indices);
+   }
+} // namespace gfx
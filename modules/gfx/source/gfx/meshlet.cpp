@@ -0,0 +1,275 @@
+#include <gfx/meshlet.hpp>
+
+#include <util/trace.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#   include <immintrin.h>
+#endif
+
+namespace gfx
+{
+   namespace detail
+   {
+      /**
+       * Compute the bounds & normal cone of a meshlet from the vertices and triangles it holds
+       */
+      void compute_meshlet_bounds(meshlet& m, std::span<const std::uint32_t> indices,
+                                  std::span<const vertex> meshlet_vertices,
+                                  std::span<const vertex> vertices)
+      {
+         m.bounds = compute_bounding_sphere(meshlet_vertices);
+
+         // The normals are computed twice rather than stored, meshlets may be built with more
+         // triangles than max_meshlet_triangles
+         const auto triangle_normal = [&](std::size_t i) {
+            const glm::vec3 p0 = vertices[indices[i]].position;
+            const glm::vec3 e1 = vertices[indices[i + 1]].position - p0;
+            const glm::vec3 e2 = vertices[indices[i + 2]].position - p0;
+
+            return glm::vec3{e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z,
+                             e1.x * e2.y - e1.y * e2.x};
+         };
+
+         glm::vec3 axis{0.0F};
+         for (std::size_t i = 0; i < std::size(indices); i += 3)
+         {
+            const glm::vec3 normal = triangle_normal(i);
+            const float length = glm::length(normal);
+            if (length != 0.0F)
+            {
+               axis = axis + normal / length;
+            }
+         }
+
+         const float axis_length = glm::length(axis);
+         if (axis_length == 0.0F)
+         {
+            return;
+         }
+
+         axis = axis / axis_length;
+
+         float min_dot = 1.0F;
+         for (std::size_t i = 0; i < std::size(indices); i += 3)
+         {
+            const glm::vec3 normal = triangle_normal(i);
+            const float length = glm::length(normal);
+            if (length != 0.0F)
+            {
+               min_dot = std::min(min_dot, glm::dot(normal / length, axis));
+            }
+         }
+
+         // Cones wider than a half sphere, or close to it, can't reject anything worthwhile
+         static constexpr float min_cone_dot = 0.1F;
+         if (min_dot <= min_cone_dot)
+         {
+            return;
+         }
+
+         m.cone_axis = axis;
+         m.cone_cutoff = std::sqrt(1.0F - min_dot * min_dot);
+      }
+   } // namespace detail
+
+   auto build_meshlets(std::span<const std::uint32_t> indices, std::span<const vertex> vertices,
+                       std::size_t max_vertices, std::size_t max_triangles)
+      -> util::dynamic_array<meshlet>
+   {
+      UTIL_TRACE_ZONE_CAT("build_meshlets", "mesh");
+
+      util::dynamic_array<meshlet> meshlets;
+
+      const std::size_t index_count = std::size(indices) - std::size(indices) % 3;
+      if (index_count == 0)
+      {
+         return meshlets;
+      }
+
+      // The meshlet a vertex was last added to, so membership is tested in constant time
+      util::dynamic_array<std::uint32_t> owners(std::size(vertices));
+      std::fill(std::begin(owners), std::end(owners), std::numeric_limits<std::uint32_t>::max());
+
+      util::dynamic_array<vertex> meshlet_vertices;
+      meshlet_vertices.reserve(max_vertices);
+
+      meshlet current{};
+      const auto flush = [&](std::size_t end) {
+         current.index_count = static_cast<std::uint32_t>(end) - current.first_index;
+         current.vertex_count = static_cast<std::uint32_t>(std::size(meshlet_vertices));
+         detail::compute_meshlet_bounds(
+            current, indices.subspan(current.first_index, current.index_count), meshlet_vertices,
+            vertices);
+
+         meshlets.push_back(current);
+
+         current = {.first_index = static_cast<std::uint32_t>(end)};
+         meshlet_vertices.clear();
+      };
+
+      for (std::size_t i = 0; i < index_count; i += 3)
+      {
+         const auto id = static_cast<std::uint32_t>(std::size(meshlets));
+
+         std::size_t new_vertex_count = 0;
+         for (std::size_t c = 0; c < 3; ++c)
+         {
+            const std::uint32_t v = indices[i + c];
+            const bool is_repeated = (c > 0 && indices[i] == v) || (c > 1 && indices[i + 1] == v);
+            new_vertex_count += owners[v] != id && !is_repeated ? 1 : 0;
+         }
+
+         const std::size_t triangle_count = (i - current.first_index) / 3;
+         if (std::size(meshlet_vertices) + new_vertex_count > max_vertices ||
+             triangle_count + 1 > max_triangles)
+         {
+            flush(i);
+         }
+
+         const auto owner = static_cast<std::uint32_t>(std::size(meshlets));
+         for (std::size_t c = 0; c < 3; ++c)
+         {
+            const std::uint32_t v = indices[i + c];
+            if (owners[v] != owner)
+            {
+               owners[v] = owner;
+               meshlet_vertices.push_back(vertices[v]);
+            }
+         }
+      }
+
+      flush(index_count);
+
+      return meshlets;
+   }
+
+   void meshlet_soa::push_back(const meshlet& m)
+   {
+      spheres.push_back(m.bounds);
+      axis_x.push_back(m.cone_axis.x);
+      axis_y.push_back(m.cone_axis.y);
+      axis_z.push_back(m.cone_axis.z);
+      cutoff.push_back(m.cone_cutoff);
+   }
+   void meshlet_soa::clear() noexcept
+   {
+      spheres.clear();
+      axis_x.clear();
+      axis_y.clear();
+      axis_z.clear();
+      cutoff.clear();
+   }
+   auto meshlet_soa::size() const noexcept -> std::size_t { return spheres.size(); }
+
+   void cull_meshlets(const frustum& frustum, const glm::vec3& camera_position,
+                      const meshlet_soa& meshlets, util::dynamic_array<std::uint32_t>& visible)
+   {
+#if defined(__SSE2__) || defined(_M_X64)
+      detail::cull_meshlets_sse(frustum, camera_position, meshlets, visible);
+#else
+      detail::cull_meshlets_scalar(frustum, camera_position, meshlets, 0, visible);
+#endif
+   }
+
+   namespace detail
+   {
+      void cull_meshlets_scalar(const frustum& frustum, const glm::vec3& camera_position,
+                                const meshlet_soa& meshlets, std::size_t first,
+                                util::dynamic_array<std::uint32_t>& visible)
+      {
+         const auto& spheres = meshlets.spheres;
+         for (std::size_t i = first; i < meshlets.size(); ++i)
+         {
+            const glm::vec3 offset{spheres.center_x[i] - camera_position.x,
+                                   spheres.center_y[i] - camera_position.y,
+                                   spheres.center_z[i] - camera_position.z};
+            const glm::vec3 axis{meshlets.axis_x[i], meshlets.axis_y[i], meshlets.axis_z[i]};
+
+            if (glm::dot(offset, axis) >=
+                meshlets.cutoff[i] * glm::length(offset) + spheres.radius[i])
+            {
+               continue;
+            }
+
+            const bool is_inside = std::ranges::all_of(frustum.planes, [&](const auto& plane) {
+               return plane.x * spheres.center_x[i] + plane.y * spheres.center_y[i] +
+                  plane.z * spheres.center_z[i] + plane.w >=
+                  -spheres.radius[i];
+            });
+
+            if (is_inside)
+            {
+               visible.push_back(static_cast<std::uint32_t>(i));
+            }
+         }
+      }
+
+#if defined(__SSE2__) || defined(_M_X64)
+      void cull_meshlets_sse(const frustum& frustum, const glm::vec3& camera_position,
+                             const meshlet_soa& meshlets,
+                             util::dynamic_array<std::uint32_t>& visible)
+      {
+         constexpr std::size_t lane_count = 4;
+
+         const auto& spheres = meshlets.spheres;
+         const std::size_t count = meshlets.size();
+         const std::size_t simd_count = count - count % lane_count;
+
+         const __m128 sign_mask = _mm_set1_ps(-0.0F);
+         const __m128 camera_x = _mm_set1_ps(camera_position.x);
+         const __m128 camera_y = _mm_set1_ps(camera_position.y);
+         const __m128 camera_z = _mm_set1_ps(camera_position.z);
+
+         for (std::size_t i = 0; i < simd_count; i += lane_count)
+         {
+            const __m128 x = _mm_loadu_ps(&spheres.center_x[i]);
+            const __m128 y = _mm_loadu_ps(&spheres.center_y[i]);
+            const __m128 z = _mm_loadu_ps(&spheres.center_z[i]);
+            const __m128 radius = _mm_loadu_ps(&spheres.radius[i]);
+            const __m128 neg_radius = _mm_xor_ps(radius, sign_mask);
+
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (const auto& plane : frustum.planes)
+            {
+               __m128 distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)),
+                                            _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+               distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+               distance = _mm_add_ps(distance, _mm_set1_ps(plane.w));
+
+               inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, neg_radius));
+            }
+
+            // Backfacing when dot(offset, axis) >= cutoff * length(offset) + radius
+            const __m128 dx = _mm_sub_ps(x, camera_x);
+            const __m128 dy = _mm_sub_ps(y, camera_y);
+            const __m128 dz = _mm_sub_ps(z, camera_z);
+
+            const __m128 length = _mm_sqrt_ps(_mm_add_ps(
+               _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+            __m128 dot = _mm_add_ps(_mm_mul_ps(dx, _mm_loadu_ps(&meshlets.axis_x[i])),
+                                    _mm_mul_ps(dy, _mm_loadu_ps(&meshlets.axis_y[i])));
+            dot = _mm_add_ps(dot, _mm_mul_ps(dz, _mm_loadu_ps(&meshlets.axis_z[i])));
+
+            const __m128 bound =
+               _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&meshlets.cutoff[i]), length), radius);
+            inside = _mm_andnot_ps(_mm_cmpge_ps(dot, bound), inside);
+
+            auto mask = static_cast<std::uint32_t>(_mm_movemask_ps(inside));
+            while (mask != 0)
+            {
+               visible.push_back(static_cast<std::uint32_t>(i) +
+                                 static_cast<std::uint32_t>(std::countr_zero(mask)));
+               mask &= mask - 1;
+            }
+         }
+
+         cull_meshlets_scalar(frustum, camera_position, meshlets, simd_count, visible);
+      }
+#endif
+   } // namespace detail
+} // namespace gfx
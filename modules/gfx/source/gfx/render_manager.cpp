@@ -3,16 +3,63 @@
 
 #include <gfx/data_types.hpp>
 
+#include <util/stats.hpp>
+#include <util/trace.hpp>
+
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <chrono>
+#include <limits>
 
 namespace gfx
 {
+   namespace detail
+   {
+      /**
+       * Copy the levels of detail of a mesh, or make a single level drawing every index
+       */
+      auto make_lods(std::span<const mesh_lod> lods, std::size_t index_count)
+         -> util::dynamic_array<mesh_lod>
+      {
+         if (std::empty(lods))
+         {
+            return util::dynamic_array<mesh_lod>(
+               1, {.first_index = 0,
+                   .index_count = static_cast<std::uint32_t>(index_count),
+                   .error = 0.0F});
+         }
+
+         return util::dynamic_array<mesh_lod>(std::begin(lods), std::end(lods));
+      }
+
+      /**
+       * Meshlet cones are tested in object space, which only matches world space backfacing
+       * when the model neither mirrors nor scales unevenly
+       */
+      auto is_cluster_cullable(const glm::mat4& model) noexcept -> bool
+      {
+         const glm::vec3 x{model[0]};
+         const glm::vec3 y{model[1]};
+         const glm::vec3 z{model[2]};
+
+         const float scale_x = glm::length(x);
+         const float scale_y = glm::length(y);
+         const float scale_z = glm::length(z);
+
+         static constexpr float tolerance = 0.01F;
+         const float max_scale = std::max({scale_x, scale_y, scale_z});
+         const float min_scale = std::min({scale_x, scale_y, scale_z});
+
+         return glm::dot(glm::cross(x, y), z) > 0.0F &&
+            max_scale - min_scale <= max_scale * tolerance;
+      }
+   } // namespace detail
+
    render_manager::render_manager(const context& ctx, const window& wnd,
-                                  std::shared_ptr<util::logger> p_logger) :
+                                  std::shared_ptr<util::logger> p_logger,
+                                  vertex_layout layout) :
       mp_logger{std::move(p_logger)},
-      m_ctx{ctx}, m_wnd{wnd}
+      m_ctx{ctx}, m_wnd{wnd}, m_vertex_layout{layout}
    {
       m_device = create_logical_device();
       m_swapchain = create_swapchain();
@@ -28,13 +75,203 @@ namespace gfx
 
       m_gfx_command_pools = create_command_pool();
 
+      m_gpu_profiler = create_gpu_profiler();
+      m_profiling_scopes = {.main_pass = m_gpu_profiler.register_scope("main_pass"),
+                            .renderables = m_gpu_profiler.register_scope("renderables"),
+                            .cpu_frame = m_gpu_profiler.register_scope("cpu_frame"),
+                            .fence_wait = m_gpu_profiler.register_scope("fence_wait"),
+                            .acquire = m_gpu_profiler.register_scope("acquire"),
+                            .prepare = m_gpu_profiler.register_scope("prepare"),
+                            .record = m_gpu_profiler.register_scope("record"),
+                            .submit = m_gpu_profiler.register_scope("submit"),
+                            .present = m_gpu_profiler.register_scope("present")};
+
+      m_bindless_table = create_bindless_table();
+      m_descriptor_cache = create_descriptor_cache();
+      m_texture_cache = create_texture_cache();
+      m_object_buffer = create_object_buffer();
+      m_indirect_buffer = create_indirect_buffer();
+
+      // The device is created with every feature the GPU supports. The cluster commands pick
+      // their object through firstInstance, which indirect draws only honour with
+      // drawIndirectFirstInstance
+      const auto& features = m_device.physical().features();
+      m_is_multi_draw_indirect = features.multiDrawIndirect == VK_TRUE;
+      m_is_indirect_first_instance = features.drawIndirectFirstInstance == VK_TRUE;
+      if (!m_is_indirect_first_instance)
+      {
+         util::log_info(mp_logger, "[gfx] no drawIndirectFirstInstance, clusters are drawn "
+                                   "with direct draws");
+      }
+
       m_images_in_flight.resize(std::size(m_swapchain.image_views()), {nullptr});
    }
 
    auto render_manager::subscribe_renderable(const std::string& name, const renderable_data& r)
-      -> bool
+      -> std::optional<renderable_handle>
+   {
+      const auto local_bounds =
+         compute_bounding_sphere({std::data(r.vertices), std::size(r.vertices)});
+
+      return subscribe_renderable(name, r.vertices, r.indices, local_bounds, r.model);
+   }
+
+   auto render_manager::subscribe_mesh(const std::string& name, const mesh_file& mesh,
+                                       const glm::mat4& model) -> std::optional<renderable_handle>
+   {
+      const auto& bounds = mesh.bounds();
+      const bounding_sphere local_bounds{.center = (bounds.min + bounds.max) * 0.5F,
+                                         .radius = glm::length(bounds.max - bounds.min) * 0.5F};
+
+      const auto indices = mesh.indices();
+
+      // Meshes cooked in the pipeline's layout are copied as they are, the others are repacked
+      if (mesh.layout() != m_vertex_layout)
+      {
+         if (std::empty(mesh.vertices()))
+         {
+            util::log_error(mp_logger, R"([gfx] mesh "{}" can't be repacked from layout {})",
+                            name, to_string(mesh.layout()));
+
+            return std::nullopt;
+         }
+
+         return subscribe_renderable(name, mesh.vertices(), indices, local_bounds, model,
+                                     mesh.lods());
+      }
+
+      auto vertex = vertex_buffer::make({.packed_vertices = mesh.vertex_data(),
+                                         .layout = m_vertex_layout,
+                                         .p_device = &m_device,
+                                         .p_command_pool = &m_gfx_command_pools[0],
+                                         .p_logger = mp_logger});
+
+      auto index = index_buffer::make({.indices = indices,
+                                       .p_device = &m_device,
+                                       .p_command_pool = &m_gfx_command_pools[0],
+                                       .p_logger = mp_logger});
+
+      if (!(vertex && index))
+      {
+         return std::nullopt;
+      }
+
+      return insert_renderable(name, std::move(vertex).value().value(),
+                               std::move(index).value().value(), local_bounds, model,
+                               mesh.lods());
+   }
+
+   auto render_manager::subscribe_renderable(const std::string& name,
+                                             std::span<const vertex> vertices,
+                                             std::span<const std::uint32_t> indices,
+                                             const bounding_sphere& local_bounds,
+                                             const glm::mat4& model,
+                                             std::span<const mesh_lod> lods)
+      -> std::optional<renderable_handle>
+   {
+      auto vertex = vertex_buffer::make({.vertices = vertices,
+                                         .layout = m_vertex_layout,
+                                         .p_device = &m_device,
+                                         .p_command_pool = &m_gfx_command_pools[0],
+                                         .p_logger = mp_logger});
+
+      auto index = index_buffer::make({.indices = indices,
+                                       .p_device = &m_device,
+                                       .p_command_pool = &m_gfx_command_pools[0],
+                                       .p_logger = mp_logger});
+
+      if (!(vertex && index))
+      {
+         return std::nullopt;
+      }
+
+      return insert_renderable(name, std::move(vertex).value().value(),
+                               std::move(index).value().value(), local_bounds, model, lods);
+   }
+
+   auto render_manager::insert_renderable(const std::string& name, vertex_buffer&& vertices,
+                                          index_buffer&& indices,
+                                          const bounding_sphere& local_bounds,
+                                          const glm::mat4& model, std::span<const mesh_lod> lods,
+                                          std::span<const meshlet> meshlets) -> renderable_handle
+   {
+      auto renderable_lods = detail::make_lods(lods, indices.index_count());
+
+      meshlet_soa meshlet_bounds;
+      for (const auto& m : meshlets)
+      {
+         meshlet_bounds.push_back(m);
+      }
+
+      const auto world_bounds = transform_sphere(local_bounds, model);
+
+      m_renderable_model_matrices.emplace_back(model);
+      m_renderable_world_bounds.push_back(world_bounds);
+
+      return m_renderables.insert(renderable{
+         .name = name,
+         .vertex_buffer = std::move(vertices),
+         .index_buffer = std::move(indices),
+         .local_bounds = local_bounds,
+         .bvh_proxy = m_renderable_bvh.insert(
+            to_aabb(world_bounds), static_cast<std::uint32_t>(std::size(m_renderables))),
+         .lods = std::move(renderable_lods),
+         .meshlets = util::dynamic_array<meshlet>(std::begin(meshlets), std::end(meshlets)),
+         .meshlet_bounds = std::move(meshlet_bounds)});
+   }
+
+   auto render_manager::unsubscribe_renderable(renderable_handle handle) -> bool
+   {
+      const auto index = m_renderables.index_of(handle);
+      if (!index)
+      {
+         util::log_warn(mp_logger, "[gfx] failed to unsubscribe renderable, stale handle");
+
+         return false;
+      }
+
+      const std::size_t last = std::size(m_renderables) - 1;
+
+      auto& removed = m_renderables[handle];
+      m_renderable_bvh.remove(removed.bvh_proxy);
+      if (*index != last)
+      {
+         m_renderable_bvh.set_user_data(m_renderables.values()[last].bvh_proxy,
+                                        static_cast<std::uint32_t>(*index));
+      }
+
+      retire_buffers(removed.vertex_buffer, removed.index_buffer);
+
+      m_renderable_model_matrices[*index] = m_renderable_model_matrices[last];
+      m_renderable_model_matrices.pop_back();
+      m_renderable_world_bounds.swap_and_pop(*index);
+
+      return m_renderables.erase(handle);
+   }
+
+   void render_manager::update_model_matrix(renderable_handle handle, const glm::mat4& model)
+   {
+      if (const auto index = m_renderables.index_of(handle))
+      {
+         const auto& r = m_renderables.values()[*index];
+         const auto world_bounds = transform_sphere(r.local_bounds, model);
+
+         m_renderable_model_matrices[*index] = model;
+         m_renderable_world_bounds.set(*index, world_bounds);
+         m_renderable_bvh.move(r.bvh_proxy, to_aabb(world_bounds));
+      }
+      else
+      {
+         util::log_warn(mp_logger, "[gfx] failed to update model matrix, stale renderable handle");
+      }
+   }
+
+   auto render_manager::subscribe_instanced_renderable(const std::string& name,
+                                                       const instanced_renderable_data& r)
+      -> std::optional<renderable_handle>
    {
       auto vertex = vertex_buffer::make({.vertices = r.vertices,
+                                         .layout = m_vertex_layout,
                                          .p_device = &m_device,
                                          .p_command_pool = &m_gfx_command_pools[0],
                                          .p_logger = mp_logger});
@@ -46,56 +283,240 @@ namespace gfx
 
       if (!(vertex && index))
       {
+         return std::nullopt;
+      }
+
+      return insert_instanced_renderable(
+         name, std::move(vertex).value().value(), std::move(index).value().value(),
+         compute_bounding_sphere({std::data(r.vertices), std::size(r.vertices)}), r.instances);
+   }
+
+   auto render_manager::insert_instanced_renderable(const std::string& name,
+                                                    vertex_buffer&& vertices,
+                                                    index_buffer&& indices,
+                                                    const bounding_sphere& local_bounds,
+                                                    std::span<const glm::mat4> transforms,
+                                                    std::span<const mesh_lod> lods)
+      -> renderable_handle
+   {
+      auto renderable_lods = detail::make_lods(lods, indices.index_count());
+
+      return m_instanced_renderables.insert(instanced_renderable{
+         .name = name,
+         .vertex_buffer = std::move(vertices),
+         .index_buffer = std::move(indices),
+         .local_bounds = local_bounds,
+         .transforms = util::dynamic_array<glm::mat4>(std::begin(transforms),
+                                                      std::end(transforms)),
+         .lods = std::move(renderable_lods)});
+   }
+
+   auto render_manager::subscribe_scene(const gltf_scene& scene) -> std::optional<scene_handles>
+   {
+      UTIL_TRACE_ZONE_CAT("render_manager::subscribe_scene", "upload");
+
+      util::dynamic_array<util::dynamic_array<glm::mat4>> mesh_transforms(
+         std::size(scene.meshes));
+      for (const auto& instance : scene.instances)
+      {
+         // Vulkan buffers can't be empty, meshes without triangles are never staged
+         const auto& mesh = scene.meshes[instance.mesh];
+         if (!std::empty(mesh.vertices) && !std::empty(mesh.indices))
+         {
+            mesh_transforms[instance.mesh].push_back(instance.transform);
+         }
+      }
+
+      // Staged in batches of at most max_scene_upload_size, or a single mesh if it's larger
+      vk::DeviceSize largest_mesh_size = 0;
+      vk::DeviceSize total_size = 0;
+      for (std::size_t i = 0; i < std::size(scene.meshes); ++i)
+      {
+         if (!std::empty(mesh_transforms[i]))
+         {
+            const auto& mesh = scene.meshes[i];
+            const vk::DeviceSize size = std::size(mesh.vertices) * vertex_stride(m_vertex_layout) +
+               std::size(mesh.indices) * sizeof(std::uint32_t);
+
+            largest_mesh_size = std::max(largest_mesh_size, size);
+            total_size += size;
+         }
+      }
+
+      const vk::DeviceSize capacity =
+         std::max(largest_mesh_size, std::min(total_size, max_scene_upload_size));
+      if (capacity == 0)
+      {
+         return scene_handles{};
+      }
+
+      auto batch_res = upload_batch::make({.capacity = capacity,
+                                           .p_device = &m_device,
+                                           .p_command_pool = &m_gfx_command_pools[0],
+                                           .p_logger = mp_logger});
+      if (!batch_res)
+      {
+         return std::nullopt;
+      }
+
+      auto batch = std::move(batch_res).value().value();
+
+      struct staged_mesh
+      {
+         std::size_t index;
+         vertex_buffer vertices;
+         index_buffer indices;
+      };
+
+      util::dynamic_array<staged_mesh> staged;
+      for (std::size_t i = 0; i < std::size(scene.meshes); ++i)
+      {
+         if (std::empty(mesh_transforms[i]))
+         {
+            continue;
+         }
+
+         const auto& mesh = scene.meshes[i];
+         const vk::DeviceSize size = std::size(mesh.vertices) * vertex_stride(m_vertex_layout) +
+            std::size(mesh.indices) * sizeof(std::uint32_t);
+         if (batch.staged_size() + size > capacity && !batch.submit())
+         {
+            return std::nullopt;
+         }
+
+         auto vertices = batch.stage(std::span<const vertex>{mesh.vertices}, m_vertex_layout);
+         auto indices = batch.stage(std::span<const std::uint32_t>{mesh.indices});
+         if (!(vertices && indices))
+         {
+            return std::nullopt;
+         }
+
+         staged.push_back({.index = i,
+                           .vertices = std::move(vertices).value().value(),
+                           .indices = std::move(indices).value().value()});
+      }
+
+      if (!batch.submit())
+      {
+         return std::nullopt;
+      }
+
+      // Meshes placed once are culled on their own, the others are drawn instanced
+      scene_handles handles;
+      for (auto& [index, vertices, indices] : staged)
+      {
+         const auto& mesh = scene.meshes[index];
+         const auto& transforms = mesh_transforms[index];
+
+         if (std::size(transforms) == 1)
+         {
+            handles.renderables.push_back(insert_renderable(mesh.name, std::move(vertices),
+                                                            std::move(indices), mesh.local_bounds,
+                                                            transforms[0], mesh.lods,
+                                                            mesh.meshlets));
+         }
+         else
+         {
+            handles.instanced_renderables.push_back(
+               insert_instanced_renderable(mesh.name, std::move(vertices), std::move(indices),
+                                           mesh.local_bounds, transforms, mesh.lods));
+         }
+      }
+
+      util::log_info(mp_logger, "[gfx] subscribed a scene of {} renderables & {} instanced",
+                     std::size(handles.renderables), std::size(handles.instanced_renderables));
+
+      return handles;
+   }
+
+   auto render_manager::load_scene(const std::filesystem::path& path)
+      -> std::optional<scene_handles>
+   {
+      auto scene = import_gltf(path, m_thread_pool, mp_logger);
+      if (!scene)
+      {
+         return std::nullopt;
+      }
+
+      return subscribe_scene(scene.value().value());
+   }
+
+   auto render_manager::unsubscribe_instanced_renderable(renderable_handle handle) -> bool
+   {
+      auto* p_removed = m_instanced_renderables.find(handle);
+      if (!p_removed)
+      {
+         util::log_warn(mp_logger,
+                        "[gfx] failed to unsubscribe instanced renderable, stale handle");
+
          return false;
       }
 
-      m_renderables_to_index.insert_or_assign(name, std::size(m_renderables));
-      m_renderable_model_matrices.emplace_back(r.model);
-      m_renderables.emplace_back(renderable{.name = name,
-                                            .vertex_buffer = std::move(vertex).value().value(),
-                                            .index_buffer = std::move(index).value().value()});
+      retire_buffers(p_removed->vertex_buffer, p_removed->index_buffer);
 
-      return true;
+      return m_instanced_renderables.erase(handle);
    }
 
-   void render_manager::update_model_matrix(const std::string& name, const glm::mat4& model)
+   void render_manager::update_instances(renderable_handle handle,
+                                         std::span<const glm::mat4> transforms)
    {
-      auto it = m_renderables_to_index.find(name);
-      if (it != m_renderables_to_index.end())
+      if (auto* p_renderable = m_instanced_renderables.find(handle))
       {
-         m_renderable_model_matrices[it->second] = model;
+         p_renderable->transforms.assign(std::begin(transforms), std::end(transforms));
       }
       else
       {
-         util::log_warn(mp_logger, "[gfx] failed to update model matrix for renderable \"{}\"",
-                        name);
+         util::log_warn(mp_logger, "[gfx] failed to update instances, stale renderable handle");
       }
    }
 
+   void render_manager::retire_buffers(vertex_buffer& vertices, index_buffer& indices)
+   {
+      // The last submitted frame is the latest one that may still be reading from them
+      auto& retired =
+         m_retired_buffers[(m_current_frame + max_frames_in_flight - 1) % max_frames_in_flight];
+
+      retired.push_back(std::move(vertices.value()));
+      retired.push_back(std::move(indices.value()));
+   }
+
    void render_manager::bake()
    {
-      m_graphics_pipeline =
-         vkn::graphics_pipeline::builder{m_device, m_swapchain_render_pass, mp_logger}
-            .add_shader(m_shader_codex.get_shader("test_shader.vert"))
-            .add_shader(m_shader_codex.get_shader("test_shader.frag"))
-            .add_vertex_binding({.binding = 0,
-                                 .stride = sizeof(gfx::vertex),
-                                 .inputRate = vk::VertexInputRate::eVertex})
-            .add_vertex_attribute({.location = 0,
-                                   .binding = 0,
-                                   .format = vk::Format::eR32G32B32Sfloat,
-                                   .offset = offsetof(gfx::vertex, position)})
-            .add_vertex_attribute({.location = 1,
-                                   .binding = 0,
-                                   .format = vk::Format::eR32G32B32Sfloat,
-                                   .offset = offsetof(gfx::vertex, colour)})
+      vkn::graphics_pipeline::builder pipeline_builder{m_device, m_swapchain_render_pass,
+                                                       mp_logger};
+      if (m_bindless_table)
+      {
+         // Every buffer is reached through the table by the indices given as push constants
+         pipeline_builder.add_shader(m_shader_codex.get_shader("test_shader_bindless.vert"))
+            .add_set_layout("bindless_layout", bindless_table::layout_bindings(),
+                            bindless_table::layout_binding_flags(), bindless_table::layout_flags())
+            .add_push_constant("bindless_indices", vkn::shader_type::vertex, util::size_t{0},
+                               util::size_t{sizeof(bindless_indices)});
+      }
+      else
+      {
+         pipeline_builder.add_shader(m_shader_codex.get_shader("test_shader.vert"))
             .add_set_layout("camera_layout",
                             {{.binding = 0,
                               .descriptorType = vk::DescriptorType::eUniformBuffer,
                               .descriptorCount = 1,
                               .stageFlags = vk::ShaderStageFlagBits::eVertex}})
-            .add_push_constant("mesh_data", vkn::shader_type::vertex, util::size_t{0},
-                               util::size_t{sizeof(glm::mat4)})
+            .add_set_layout("object_layout",
+                            {{.binding = 0,
+                              .descriptorType = vk::DescriptorType::eStorageBufferDynamic,
+                              .descriptorCount = 1,
+                              .stageFlags = vk::ShaderStageFlagBits::eVertex}});
+      }
+
+      pipeline_builder.add_shader(m_shader_codex.get_shader("test_shader.frag"))
+         .add_vertex_binding(vertex_input_binding(m_vertex_layout));
+      for (auto attribute : vertex_input_attributes(m_vertex_layout))
+      {
+         pipeline_builder.add_vertex_attribute(std::move(attribute));
+      }
+
+      m_graphics_pipeline =
+         pipeline_builder
             .add_viewport({.x = 0.0F,
                            .y = 0.0F,
                            .width = static_cast<float>(m_swapchain.extent().width),
@@ -114,39 +535,112 @@ namespace gfx
             })
             .join();
 
-      m_camera_descriptor_pool = create_camera_descriptor_pool();
       m_camera_buffers = create_camera_buffers();
 
-      for (std::size_t i = 0; auto set : m_camera_descriptor_pool.sets())
+      if (m_bindless_table)
       {
-         std::array buf_info{vk::DescriptorBufferInfo{.buffer = vkn::value(*m_camera_buffers[i++]),
-                                                      .offset = 0,
-                                                      .range = sizeof(gfx::camera_matrices)}};
-         vk::WriteDescriptorSet write{.dstSet = set,
-                                      .dstBinding = 0,
-                                      .dstArrayElement = 0,
-                                      .descriptorCount = std::size(buf_info),
-                                      .descriptorType = vk::DescriptorType::eUniformBuffer,
-                                      .pBufferInfo = std::data(buf_info)};
+         m_camera_indices.clear();
+         for (const auto& buffer : m_camera_buffers)
+         {
+            m_camera_indices.emplace_back(m_bindless_table->add_storage_buffer(
+               vkn::value(*buffer), 0, sizeof(gfx::camera_matrices)));
+         }
+
+         // Storage buffers can't take dynamic offsets here, each frame region gets its own index
+         for (std::size_t i = 0; i < max_frames_in_flight; ++i)
+         {
+            m_object_indices[i] = m_bindless_table->add_storage_buffer(
+               vkn::value(*m_object_buffer), m_object_buffer.frame_offset(i),
+               m_object_buffer.frame_size());
+         }
 
-         m_device->updateDescriptorSets({write}, {});
+         return;
       }
+
+      m_camera_descriptor_sets.clear();
+      for (const auto& buffer : m_camera_buffers)
+      {
+         const std::array writes{
+            vkn::descriptor_write{.binding = 0,
+                                  .type = vk::DescriptorType::eUniformBuffer,
+                                  .buffer_info = {.buffer = vkn::value(*buffer),
+                                                  .offset = 0,
+                                                  .range = sizeof(gfx::camera_matrices)}}};
+
+         m_camera_descriptor_sets.emplace_back(get_descriptor_set("camera_layout", writes));
+      }
+
+      // A single set covers every frame, the region of a frame is selected by a dynamic offset
+      const std::array object_writes{
+         vkn::descriptor_write{.binding = 0,
+                               .type = vk::DescriptorType::eStorageBufferDynamic,
+                               .buffer_info = {.buffer = vkn::value(*m_object_buffer),
+                                               .offset = 0,
+                                               .range = m_object_buffer.frame_size()}}};
+
+      m_object_descriptor_set = get_descriptor_set("object_layout", object_writes);
    }
 
    void render_manager::render_frame()
    {
-      m_device->waitForFences({vkn::value(m_in_flight_fences.at(m_current_frame))}, true,
-                              std::numeric_limits<std::uint64_t>::max());
+      using clock = std::chrono::steady_clock;
+      using milliseconds = std::chrono::duration<float, std::milli>;
+      using std::chrono::duration_cast;
+      using std::chrono::microseconds;
+
+      UTIL_TRACE_ZONE_CAT("render_frame", "gfx");
 
-      auto [image_res, image_index] = m_device->acquireNextImageKHR(
-         vkn::value(m_swapchain), std::numeric_limits<std::uint64_t>::max(),
-         vkn::value(m_image_available_semaphores.at(m_current_frame)), nullptr);
+      const auto wait_start = clock::now();
+
+      {
+         UTIL_TRACE_ZONE_CAT("fence_wait", "gfx");
+
+         m_device->waitForFences({vkn::value(m_in_flight_fences.at(m_current_frame))}, true,
+                                 std::numeric_limits<std::uint64_t>::max());
+      }
+
+      m_retired_buffers[m_current_frame].clear();
+      m_texture_cache.update();
+
+      const auto frame_start = clock::now();
+      m_gpu_profiler.add_cpu_sample(m_profiling_scopes.fence_wait,
+                                    milliseconds(frame_start - wait_start).count());
+      util::stats::set(util::stats::gauge::fence_wait_us,
+                       duration_cast<microseconds>(frame_start - wait_start).count());
+
+      // Close the CPU timing of the current phase of the frame, the next one starts right away
+      auto phase_start = frame_start;
+      const auto end_phase = [&](util::index_t scope) {
+         const auto now = clock::now();
+         m_gpu_profiler.add_cpu_sample(scope, milliseconds(now - phase_start).count());
+         phase_start = now;
+      };
+
+      auto [image_res, image_index] = [&] {
+         UTIL_TRACE_ZONE_CAT("acquire", "gfx");
+
+         return m_device->acquireNextImageKHR(
+            vkn::value(m_swapchain), std::numeric_limits<std::uint64_t>::max(),
+            vkn::value(m_image_available_semaphores.at(m_current_frame)), nullptr);
+      }();
+      util::stats::set(util::stats::gauge::acquire_latency_us,
+                       duration_cast<microseconds>(clock::now() - frame_start).count());
       if (image_res != vk::Result::eSuccess)
       {
          abort();
       }
 
       util::log_debug(mp_logger, R"([gfx] swapchain image "{}" acquired)", image_index);
+      end_phase(m_profiling_scopes.acquire);
+
+      const auto camera = compute_camera_matrices();
+
+      cull_renderables(camera);
+      queue_draws(camera);
+      stream_objects(camera);
+      cull_clusters(camera);
+      end_phase(m_profiling_scopes.prepare);
+
       util::log_debug(mp_logger, R"([gfx] graphics command pool "{}" resetting)", m_current_frame);
 
       m_device->resetCommandPool(m_gfx_command_pools[m_current_frame].value(), {}); // NOLINT
@@ -154,45 +648,46 @@ namespace gfx
       util::log_debug(mp_logger, R"([gfx] graphics command pool "{}" buffer recording)",
                       m_current_frame);
 
-      for (const auto& buffer :
-           m_gfx_command_pools[m_current_frame].primary_cmd_buffers()) // NOLINT
       {
-         buffer.begin({.pNext = nullptr, .flags = {}, .pInheritanceInfo = nullptr});
+         UTIL_TRACE_ZONE_CAT("record", "gfx");
 
-         const auto clear_colour = vk::ClearValue{std::array<float, 4>{0.0F, 0.0F, 0.0F, 0.0F}};
-         buffer.beginRenderPass({.pNext = nullptr,
-                                 .renderPass = m_swapchain_render_pass.value(),
-                                 .framebuffer = m_swapchain_framebuffers[image_index].value(),
-                                 .renderArea = {{0, 0}, m_swapchain.extent()},
-                                 .clearValueCount = 1,
-                                 .pClearValues = &clear_colour},
-                                vk::SubpassContents::eInline);
+         for (const auto& buffer :
+              m_gfx_command_pools[m_current_frame].primary_cmd_buffers()) // NOLINT
+         {
+            buffer.begin({.pNext = nullptr, .flags = {}, .pInheritanceInfo = nullptr});
 
-         buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, m_graphics_pipeline.value());
-         buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_graphics_pipeline.layout(),
-                                   0, {m_camera_descriptor_pool.sets()[image_index]}, {});
+            m_gpu_profiler.begin_frame(buffer, m_current_frame);
+            const auto main_pass_scope =
+               m_gpu_profiler.begin_scope(buffer, m_profiling_scopes.main_pass);
 
-         for (const auto& [name, index] : m_renderables_to_index)
-         {
-            util::log_debug(mp_logger, R"([gfx] buffer calls for renderable "{}" at index "{}")",
-                            name, index);
-
-            buffer.pushConstants(
-               m_graphics_pipeline.layout(),
-               m_graphics_pipeline.get_push_constant_ranges("mesh_data").stageFlags, 0,
-               sizeof(glm::mat4) * 1, &m_renderable_model_matrices[index]);
-            buffer.bindVertexBuffers(0, {m_renderables[index].vertex_buffer->value()},
-                                     {vk::DeviceSize{0}});
-            buffer.bindIndexBuffer(m_renderables[index].index_buffer->value(), 0,
-                                   vk::IndexType::eUint32);
-            buffer.drawIndexed(m_renderables[index].index_buffer.index_count(), 1, 0, 0, 0);
-         }
+            const auto clear_colour =
+               vk::ClearValue{std::array<float, 4>{0.0F, 0.0F, 0.0F, 0.0F}};
+            buffer.beginRenderPass({.pNext = nullptr,
+                                    .renderPass = m_swapchain_render_pass.value(),
+                                    .framebuffer = m_swapchain_framebuffers[image_index].value(),
+                                    .renderArea = {{0, 0}, m_swapchain.extent()},
+                                    .clearValueCount = 1,
+                                    .pClearValues = &clear_colour},
+                                   vk::SubpassContents::eInline);
 
-         buffer.endRenderPass();
-         buffer.end();
+            const auto renderables_scope =
+               m_gpu_profiler.begin_scope(buffer, m_profiling_scopes.renderables);
+
+            command_recorder recorder{buffer};
+            record_draws(recorder, image_index);
+
+            m_gpu_profiler.end_scope(buffer, renderables_scope);
+
+            buffer.endRenderPass();
+
+            m_gpu_profiler.end_scope(buffer, main_pass_scope);
+
+            buffer.end();
+         }
       }
+      end_phase(m_profiling_scopes.record);
 
-      update_camera(image_index);
+      update_camera(image_index, camera);
 
       if (m_images_in_flight[image_index])
       {
@@ -222,6 +717,8 @@ namespace gfx
 
       try
       {
+         UTIL_TRACE_ZONE_CAT("submit", "gfx");
+
          const auto gfx_queue = *m_device.get_queue(vkn::queue::type::graphics).value();
          gfx_queue.submit(submit_infos, vkn::value(m_in_flight_fences.at(m_current_frame)));
       }
@@ -230,39 +727,442 @@ namespace gfx
          util::log_error(mp_logger, "[core] failed to submit graphics queue");
          abort();
       }
+      end_phase(m_profiling_scopes.submit);
 
       const std::array swapchains{vkn::value(m_swapchain)};
 
-      const auto present_queue = *m_device.get_queue(vkn::queue::type::present).value();
-      if (present_queue.presentKHR({.waitSemaphoreCount = std::size(signal_semaphores),
-                                    .pWaitSemaphores = std::data(signal_semaphores),
-                                    .swapchainCount = std::size(swapchains),
-                                    .pSwapchains = std::data(swapchains),
-                                    .pImageIndices = &image_index}) != vk::Result::eSuccess)
       {
-         util::log_error(mp_logger, "[core] failed to present present queue");
-         abort();
+         UTIL_TRACE_ZONE_CAT("present", "gfx");
+
+         const auto present_queue = *m_device.get_queue(vkn::queue::type::present).value();
+         if (present_queue.presentKHR({.waitSemaphoreCount = std::size(signal_semaphores),
+                                       .pWaitSemaphores = std::data(signal_semaphores),
+                                       .swapchainCount = std::size(swapchains),
+                                       .pSwapchains = std::data(swapchains),
+                                       .pImageIndices = &image_index}) != vk::Result::eSuccess)
+         {
+            util::log_error(mp_logger, "[core] failed to present present queue");
+            abort();
+         }
       }
+      end_phase(m_profiling_scopes.present);
+
+      m_gpu_profiler.add_cpu_sample(m_profiling_scopes.cpu_frame,
+                                    milliseconds(clock::now() - frame_start).count());
+
+      util::stats::end_frame();
 
       m_current_frame = (m_current_frame + 1) % max_frames_in_flight;
    }
 
+   auto render_manager::load_texture(const std::filesystem::path& path) -> texture_handle
+   {
+      return m_texture_cache.load(path);
+   }
+   void render_manager::release_texture(texture_handle handle) { m_texture_cache.release(handle); }
+   auto render_manager::mount_texture_pack(const std::filesystem::path& path) -> bool
+   {
+      return m_texture_cache.mount(path);
+   }
+   auto render_manager::textures() const noexcept -> const texture_cache&
+   {
+      return m_texture_cache;
+   }
+
    void render_manager::wait() { m_device->waitIdle(); }
 
-   void render_manager::update_camera(uint32_t image_index)
+   auto render_manager::profiler() const noexcept -> const gpu_profiler& { return m_gpu_profiler; }
+   auto render_manager::device() const noexcept -> const vkn::device& { return m_device; }
+
+   auto render_manager::compute_camera_matrices() const noexcept -> camera_matrices
    {
       gfx::camera_matrices matrices{};
       matrices.perspective = glm::perspective(
-         glm::radians(45.0F), m_swapchain.extent().width / (float)m_swapchain.extent().height, 0.1F,
-         10.0F);
+         glm::radians(45.0F), m_swapchain.extent().width / (float)m_swapchain.extent().height,
+         camera_near_plane, camera_far_plane);
       matrices.view = glm::lookAt(glm::vec3(2.0F, 2.0F, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f),
                                   glm::vec3(0.0F, 0.0F, 1.0F));
       matrices.perspective[1][1] *= -1;
 
+      return matrices;
+   }
+
+   void render_manager::update_camera(uint32_t image_index, const camera_matrices& matrices)
+   {
       void* p_data =
          m_device->mapMemory(m_camera_buffers[image_index]->memory(), 0, sizeof(matrices), {});
       memcpy(p_data, &matrices, sizeof(matrices));
       m_device->unmapMemory(m_camera_buffers[image_index]->memory());
+
+      util::stats::increment(util::stats::counter::bytes_uploaded, sizeof(matrices));
+   }
+
+   void render_manager::cull_renderables(const camera_matrices& matrices)
+   {
+      UTIL_TRACE_ZONE_CAT("cull_renderables", "gfx");
+
+      m_visible_renderables.clear();
+      m_visible_projected_radii.clear();
+
+      const auto view_frustum = extract_frustum(matrices.perspective * matrices.view);
+      const auto projection = make_sphere_projection(
+         matrices.view,
+         projection_scale(matrices.perspective, static_cast<float>(m_swapchain.extent().height)));
+      if (m_renderable_world_bounds.size() >= bvh_culling_threshold)
+      {
+         m_renderable_bvh.query_frustum(view_frustum, m_visible_renderables);
+         project_spheres(projection, m_renderable_world_bounds, m_visible_renderables,
+                         m_visible_projected_radii);
+      }
+      else
+      {
+         // The spheres are projected in the culling loop, while they are still in registers
+         cull_spheres(view_frustum, projection, m_renderable_world_bounds, m_visible_renderables,
+                      m_visible_projected_radii);
+      }
+
+      // The coarsest level whose error stays under a pixel is drawn. Errors are in object
+      // space, scaled to the world like the bounds are
+      const auto renderables = m_renderables.values();
+
+      m_visible_lods.clear();
+      for (std::size_t i = 0; i < std::size(m_visible_renderables); ++i)
+      {
+         const auto& r = renderables[m_visible_renderables[i]];
+         const float pixels_per_unit = r.local_bounds.radius > 0.0F
+            ? m_visible_projected_radii[i] / r.local_bounds.radius
+            : std::numeric_limits<float>::infinity();
+
+         m_visible_lods.push_back(select_lod(r.lods, pixels_per_unit, lod_error_threshold));
+      }
+
+      util::log_debug(mp_logger, "[gfx] {} of {} renderables visible",
+                      std::size(m_visible_renderables), m_renderable_world_bounds.size());
+   }
+
+   void render_manager::queue_draws(const camera_matrices& matrices)
+   {
+      UTIL_TRACE_ZONE_CAT("queue_draws", "gfx");
+
+      m_draw_queue.clear();
+
+      for (std::size_t i = 0; i < std::size(m_visible_renderables); ++i)
+      {
+         const std::uint32_t index = m_visible_renderables[i];
+         const glm::vec4 center{m_renderable_world_bounds.center_x[index],
+                                m_renderable_world_bounds.center_y[index],
+                                m_renderable_world_bounds.center_z[index], 1.0F};
+         const float view_depth = -(matrices.view * center).z;
+
+         // Every renderable currently shares the same pipeline, camera set & material
+         m_draw_queue.push(make_draw_key({.mesh = index,
+                                          .depth = (view_depth - camera_near_plane) /
+                                             (camera_far_plane - camera_near_plane)}),
+                           index, m_visible_lods[i]);
+      }
+
+      m_draw_queue.sort();
+   }
+
+   void render_manager::stream_objects(const camera_matrices& matrices)
+   {
+      UTIL_TRACE_ZONE_CAT("stream_objects", "gfx");
+
+      const auto objects = m_object_buffer.frame_data(m_current_frame);
+
+      // The objects of the queued draws come first, in the order they are drawn in, so the
+      // object of the i-th draw is found at index i
+      m_queued_object_count = 0;
+      for (const auto& packet : m_draw_queue.packets())
+      {
+         if (m_queued_object_count == std::size(objects))
+         {
+            break;
+         }
+
+         objects[m_queued_object_count++] = {
+            .model = m_renderable_model_matrices[packet.renderable]};
+      }
+
+      const auto view_frustum = extract_frustum(matrices.perspective * matrices.view);
+      const float scale = projection_scale(matrices.perspective,
+                                           static_cast<float>(m_swapchain.extent().height));
+
+      std::uint32_t object_count = m_queued_object_count;
+      std::size_t dropped_count = std::size(m_draw_queue) - m_queued_object_count;
+      for (auto& r : m_instanced_renderables)
+      {
+         r.first_instance = object_count;
+
+         // Every instance is drawn with the level its closest instance needs
+         float pixels_per_unit = 0.0F;
+         for (const auto& transform : r.transforms)
+         {
+            const auto world_bounds = transform_sphere(r.local_bounds, transform);
+            if (!intersects(view_frustum, world_bounds))
+            {
+               continue;
+            }
+
+            const float depth = -(matrices.view * glm::vec4{world_bounds.center, 1.0F}).z;
+            pixels_per_unit = depth > world_bounds.radius && r.local_bounds.radius > 0.0F
+               ? std::max(pixels_per_unit,
+                          world_bounds.radius * scale / (depth * r.local_bounds.radius))
+               : std::numeric_limits<float>::infinity();
+
+            if (object_count < std::size(objects))
+            {
+               objects[object_count++] = {.model = transform};
+            }
+            else
+            {
+               ++dropped_count;
+            }
+         }
+
+         r.visible_count = object_count - r.first_instance;
+         r.lod = select_lod(r.lods, pixels_per_unit, lod_error_threshold);
+      }
+
+      if (dropped_count != 0)
+      {
+         util::log_debug(mp_logger, "[gfx] object buffer full, {} objects dropped",
+                         dropped_count);
+      }
+
+      util::stats::increment(util::stats::counter::bytes_uploaded,
+                             object_count * sizeof(object_data));
+   }
+
+   void render_manager::cull_clusters(const camera_matrices& matrices)
+   {
+      UTIL_TRACE_ZONE_CAT("cull_clusters", "gfx");
+
+      const auto renderables = m_renderables.values();
+      const auto packets = m_draw_queue.packets().first(m_queued_object_count);
+
+      // Without drawIndirectFirstInstance the commands are kept on the CPU and recorded as direct
+      // draws, which always honour their first instance
+      std::span<vk::DrawIndexedIndirectCommand> commands =
+         m_indirect_buffer.frame_data(m_current_frame);
+      if (!m_is_indirect_first_instance)
+      {
+         m_direct_cluster_commands.resize(std::size(commands));
+         commands = m_direct_cluster_commands;
+      }
+
+      const glm::mat4 view_projection = matrices.perspective * matrices.view;
+      const glm::vec4 camera_position = glm::inverse(matrices.view)[3];
+
+      m_cluster_draws.clear();
+
+      std::uint32_t command_count = 0;
+      std::size_t meshlet_count = 0;
+      std::size_t culled_count = 0;
+      for (std::uint32_t i = 0; const auto& packet : packets)
+      {
+         const auto& r = renderables[packet.renderable];
+         const auto& model = m_renderable_model_matrices[packet.renderable];
+
+         // Meshlets only cover the full detail level
+         if (std::empty(r.meshlets) || packet.lod != 0 || !detail::is_cluster_cullable(model))
+         {
+            m_cluster_draws.push_back({});
+            ++i;
+
+            continue;
+         }
+
+         m_visible_meshlets.clear();
+         cull_meshlets(extract_frustum(view_projection * model),
+                       glm::vec3{glm::inverse(model) * camera_position}, r.meshlet_bounds,
+                       m_visible_meshlets);
+
+         // Meshlets following each other in the index buffer are merged in one command. The
+         // commands are built on the side as the indirect buffer may be write combined
+         const std::uint32_t first_command = command_count;
+         bool is_complete = true;
+
+         vk::DrawIndexedIndirectCommand pending{.indexCount = 0, .firstInstance = i};
+         const auto emit = [&] {
+            if (pending.indexCount == 0)
+            {
+               return true;
+            }
+            if (command_count == std::size(commands))
+            {
+               return false;
+            }
+
+            commands[command_count++] = pending;
+
+            return true;
+         };
+
+         for (const std::uint32_t index : m_visible_meshlets)
+         {
+            const auto& m = r.meshlets[index];
+            if (pending.indexCount != 0 && pending.firstIndex + pending.indexCount == m.first_index)
+            {
+               pending.indexCount += m.index_count;
+
+               continue;
+            }
+
+            if (!emit())
+            {
+               is_complete = false;
+               break;
+            }
+
+            pending = {.indexCount = m.index_count,
+                       .instanceCount = 1,
+                       .firstIndex = m.first_index,
+                       .vertexOffset = 0,
+                       .firstInstance = i};
+         }
+         is_complete = is_complete && emit();
+
+         if (is_complete)
+         {
+            m_cluster_draws.push_back({.is_clustered = true,
+                                       .first_command = first_command,
+                                       .command_count = command_count - first_command});
+
+            meshlet_count += std::size(r.meshlets);
+            culled_count += std::size(r.meshlets) - std::size(m_visible_meshlets);
+         }
+         else
+         {
+            // Out of commands, the draw falls back to the whole level
+            command_count = first_command;
+            m_cluster_draws.push_back({});
+         }
+
+         ++i;
+      }
+
+      if (m_is_indirect_first_instance)
+      {
+         util::stats::increment(util::stats::counter::bytes_uploaded,
+                                command_count * sizeof(vk::DrawIndexedIndirectCommand));
+      }
+
+      util::log_debug(mp_logger, "[gfx] {} of {} meshlets culled, {} cluster commands",
+                      culled_count, meshlet_count, command_count);
+   }
+
+   void render_manager::record_draws(command_recorder& recorder, std::uint32_t image_index)
+   {
+      const auto renderables = m_renderables.values();
+      const auto packets = m_draw_queue.packets().first(m_queued_object_count);
+
+      bind_frame_resources(recorder, image_index);
+
+      for (std::uint32_t i = 0; const auto& packet : packets)
+      {
+         const auto& r = renderables[packet.renderable];
+
+         util::log_debug(mp_logger, R"([gfx] buffer calls for renderable "{}" at index "{}")",
+                         r.name, packet.renderable);
+
+         recorder.bind_pipeline(m_graphics_pipeline.value(), m_graphics_pipeline.layout());
+         recorder.bind_vertex_buffer(0, r.vertex_buffer->value());
+         recorder.bind_index_buffer(r.index_buffer->value(), vk::IndexType::eUint32);
+
+         const auto& clusters = m_cluster_draws[i];
+         if (clusters.is_clustered && !m_is_indirect_first_instance)
+         {
+            for (const auto& command : std::span{m_direct_cluster_commands}.subspan(
+                    clusters.first_command, clusters.command_count))
+            {
+               recorder.draw_indexed(command.indexCount, command.instanceCount,
+                                     command.firstIndex, command.vertexOffset,
+                                     command.firstInstance);
+            }
+         }
+         else if (clusters.is_clustered)
+         {
+            const vk::DeviceSize offset = m_indirect_buffer.frame_offset(m_current_frame) +
+               clusters.first_command * sizeof(vk::DrawIndexedIndirectCommand);
+
+            if (m_is_multi_draw_indirect)
+            {
+               recorder.draw_indexed_indirect(m_indirect_buffer->value(), offset,
+                                              clusters.command_count);
+            }
+            else
+            {
+               for (std::uint32_t c = 0; c < clusters.command_count; ++c)
+               {
+                  recorder.draw_indexed_indirect(
+                     m_indirect_buffer->value(),
+                     offset + c * sizeof(vk::DrawIndexedIndirectCommand), 1);
+               }
+            }
+         }
+         else
+         {
+            const auto& lod = r.lods[packet.lod];
+            recorder.draw_indexed(lod.index_count, 1, lod.first_index, 0, i);
+         }
+
+         ++i;
+      }
+
+      for (const auto& r : m_instanced_renderables)
+      {
+         if (r.visible_count == 0)
+         {
+            continue;
+         }
+
+         recorder.bind_pipeline(m_graphics_pipeline.value(), m_graphics_pipeline.layout());
+         recorder.bind_vertex_buffer(0, r.vertex_buffer->value());
+         recorder.bind_index_buffer(r.index_buffer->value(), vk::IndexType::eUint32);
+
+         const auto& lod = r.lods[r.lod];
+         recorder.draw_indexed(lod.index_count, r.visible_count, lod.first_index, 0,
+                               r.first_instance);
+      }
+
+      util::log_debug(mp_logger, "[gfx] {} draws recorded, {} redundant binds skipped",
+                      recorder.draw_count(), recorder.elided_bind_count());
+   }
+
+   void render_manager::bind_frame_resources(command_recorder& recorder, std::uint32_t image_index)
+   {
+      // Every pipeline shares the same set layouts, so the sets bound here stay valid for all of
+      // the frame's draws
+      recorder.bind_pipeline(m_graphics_pipeline.value(), m_graphics_pipeline.layout());
+
+      if (m_bindless_table)
+      {
+         const std::array sets{m_bindless_table->set()};
+         const bindless_indices indices{.camera = m_camera_indices[image_index],
+                                        .objects = m_object_indices[m_current_frame]};
+
+         recorder.bind_descriptor_sets(0, sets);
+         recorder.push_constants(vk::ShaderStageFlagBits::eVertex, 0, sizeof(indices), &indices);
+      }
+      else
+      {
+         const std::array sets{m_camera_descriptor_sets[image_index], m_object_descriptor_set};
+         const std::array dynamic_offsets{m_object_buffer.frame_offset(m_current_frame)};
+
+         recorder.bind_descriptor_sets(0, sets, dynamic_offsets);
+      }
+   }
+
+   auto render_manager::pick_renderable(const glm::vec3& origin, const glm::vec3& direction) const
+      -> std::optional<renderable_handle>
+   {
+      if (const auto hit = m_renderable_bvh.raycast(origin, direction))
+      {
+         return m_renderables.key_at(hit->user_data);
+      }
+
+      return std::nullopt;
    }
 
    auto render_manager::add_pass(const std::string& name,
@@ -309,8 +1209,15 @@ namespace gfx
    }
    auto render_manager::create_logical_device() const noexcept -> vkn::device
    {
-      return vkn::device::builder{m_ctx.vulkan_loader(), create_physical_device(),
+      auto physical_device = create_physical_device();
+
+      // Descriptor indexing is only enabled when every feature the bindless table needs is there
+      const bool is_bindless = bindless_table::is_supported(physical_device.vulkan12_features());
+
+      return vkn::device::builder{m_ctx.vulkan_loader(), std::move(physical_device),
                                   m_ctx.vulkan_instance().version(), mp_logger}
+         .set_vulkan12_features(is_bindless ? bindless_table::required_features()
+                                            : vk::PhysicalDeviceVulkan12Features{})
          .build()
          .map_error([&](auto&& err) {
             log_error(mp_logger, "[core] Failed to create device: {0}", err.type.message());
@@ -377,21 +1284,54 @@ namespace gfx
 
       return framebuffers;
    }
-   auto render_manager::create_camera_descriptor_pool() const noexcept -> vkn::descriptor_pool
+   auto render_manager::create_bindless_table() const noexcept -> std::optional<bindless_table>
    {
-      return vkn::descriptor_pool::builder{m_device, mp_logger}
-         .add_pool_size(vk::DescriptorType::eUniformBuffer,
-                        util::count32_t{std::size(m_swapchain.image_views())})
-         .set_descriptor_set_layout(
-            vkn::value(m_graphics_pipeline.get_descriptor_set_layout("camera_layout")))
-         .set_max_sets(util::count32_t{std::size(m_swapchain.image_views())})
+      auto table = bindless_table::make({.p_device = &m_device, .p_logger = mp_logger});
+      if (!table)
+      {
+         // Not an error, the renderer falls back to binding regular descriptor sets
+         log_warn(mp_logger, "[gfx] bindless descriptors disabled: \"{0}\"",
+                  table.error().value().value().message());
+
+         return std::nullopt;
+      }
+
+      return std::move(table).value().value();
+   }
+   auto render_manager::create_descriptor_cache() const noexcept -> vkn::descriptor_cache
+   {
+      return vkn::descriptor_allocator::builder{m_device, mp_logger}
+         .add_pool_ratio(vk::DescriptorType::eUniformBuffer, 1.0F)
+         .add_pool_ratio(vk::DescriptorType::eStorageBuffer, 1.0F)
+         .add_pool_ratio(vk::DescriptorType::eStorageBufferDynamic, 0.5F) // NOLINT
+         .add_pool_ratio(vk::DescriptorType::eCombinedImageSampler, 4.0F) // NOLINT
          .build()
+         .map([](vkn::descriptor_allocator&& allocator) {
+            return vkn::descriptor_cache{std::move(allocator)};
+         })
          .map_error([&](vkn::error&& err) {
-            log_error(mp_logger, "[core] Failed to camera descriptor pool: \"{0}\"",
+            log_error(mp_logger, "[gfx] Failed to create descriptor cache: \"{0}\"",
                       err.type.message());
             std::terminate();
 
-            return vkn::descriptor_pool{};
+            return vkn::descriptor_cache{};
+         })
+         .join();
+   }
+   auto render_manager::create_texture_cache() noexcept -> texture_cache
+   {
+      constexpr auto frames_in_flight = static_cast<std::uint32_t>(max_frames_in_flight);
+
+      return texture_cache::make({.p_device = &m_device,
+                                  .p_thread_pool = &m_thread_pool,
+                                  .frames_in_flight = frames_in_flight,
+                                  .p_logger = mp_logger})
+         .map_error([&](auto&& err) {
+            log_error(mp_logger, "[gfx] Failed to create texture cache: \"{0}\"",
+                      err.value().message());
+            std::terminate();
+
+            return texture_cache{};
          })
          .join();
    }
@@ -425,6 +1365,7 @@ namespace gfx
    {
       return core::shader_codex::builder{m_device, mp_logger}
          .add_shader_filepath("resources/shaders/test_shader.vert")
+         .add_shader_filepath("resources/shaders/test_shader_bindless.vert")
          .add_shader_filepath("resources/shaders/test_shader.frag")
          .allow_caching(false)
          .build()
@@ -536,4 +1477,63 @@ namespace gfx
 
       return fences;
    }
+   auto render_manager::create_object_buffer() const noexcept -> object_buffer
+   {
+      return object_buffer::make({.p_device = &m_device,
+                                  .frame_count = util::count32_t{max_frames_in_flight},
+                                  .p_logger = mp_logger})
+         .map_error([&](auto&& err) {
+            log_error(mp_logger, "[gfx] Failed to create object buffer: \"{0}\"",
+                      err.value().message());
+            std::terminate();
+
+            return object_buffer{};
+         })
+         .join();
+   }
+
+   auto render_manager::create_indirect_buffer() const noexcept -> indirect_buffer
+   {
+      return indirect_buffer::make({.p_device = &m_device,
+                                    .frame_count = util::count32_t{max_frames_in_flight},
+                                    .p_logger = mp_logger})
+         .map_error([&](auto&& err) {
+            log_error(mp_logger, "[gfx] Failed to create indirect buffer: \"{0}\"",
+                      err.value().message());
+            std::terminate();
+
+            return indirect_buffer{};
+         })
+         .join();
+   }
+
+   auto render_manager::get_descriptor_set(const std::string& layout_name,
+                                           std::span<const vkn::descriptor_write> writes)
+      -> vk::DescriptorSet
+   {
+      return m_descriptor_cache
+         .get(vkn::value(m_graphics_pipeline.get_descriptor_set_layout(layout_name)), writes)
+         .map_error([&](vkn::error&& err) {
+            log_error(mp_logger, R"([gfx] Failed to get descriptor set of layout "{}": "{}")",
+                      layout_name, err.type.message());
+            std::terminate();
+
+            return vk::DescriptorSet{};
+         })
+         .join();
+   }
+
+   auto render_manager::create_gpu_profiler() const noexcept -> gpu_profiler
+   {
+      return gpu_profiler::make({.p_device = &m_device,
+                                 .frame_count = util::count32_t{max_frames_in_flight},
+                                 .p_logger = mp_logger})
+         .map_error([&](auto&& err) {
+            // Profiling is not critical, the renderer keeps going with CPU timings only
+            log_warn(mp_logger, "[gfx] GPU profiling disabled: \"{0}\"", err.value().message());
+
+            return gpu_profiler{};
+         })
+         .join();
+   }
 } // namespace gfx
@@ -0,0 +1,2 @@
+#define STB_IMAGE_IMPLEMENTATION
+#include <gfx/stb_image.h>
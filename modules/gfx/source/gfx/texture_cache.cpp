@@ -0,0 +1,676 @@
+#include <gfx/texture_cache.hpp>
+
+#include <gfx/dds.hpp>
+#include <gfx/stb_image.h>
+
+#include <util/stats.hpp>
+#include <util/trace.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <functional>
+
+namespace gfx
+{
+   struct texture_cache_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override
+      {
+         return "gfx_texture_cache";
+      }
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return to_string(static_cast<texture_cache_error>(err));
+      }
+   };
+   inline static const texture_cache_error_category m_texture_cache_category{};
+
+   auto to_string(texture_cache_error err) -> std::string
+   {
+      switch (err)
+      {
+         case texture_cache_error::failed_to_find_a_suitable_queue:
+            return "failed_to_find_a_suitable_queue";
+         case texture_cache_error::failed_to_create_command_pool:
+            return "failed_to_create_command_pool";
+         case texture_cache_error::failed_to_create_sampler:
+            return "failed_to_create_sampler";
+         default:
+            return "UNKNOWN";
+      }
+   }
+
+   auto make_error(texture_cache_error err) noexcept -> error_t
+   {
+      return {{static_cast<int>(err), m_texture_cache_category}};
+   }
+
+   static constexpr float max_anisotropy = 16.0F;
+
+   // Offsets into the staging buffer must be multiples of the block size of compressed formats
+   static constexpr vk::DeviceSize staging_alignment = 16;
+
+   void texture_cache::pixel_deleter::operator()(std::byte* p_pixels) const noexcept
+   {
+      stbi_image_free(p_pixels);
+   }
+
+   auto texture_cache::make(create_info&& info) noexcept -> gfx::result<texture_cache>
+   {
+      const vkn::device& device = *info.p_device;
+
+      auto queue_res = device.get_queue(vkn::queue::type::graphics);
+      auto queue_index_res = device.get_queue_index(vkn::queue::type::graphics);
+      if (!queue_res || !queue_index_res)
+      {
+         util::log_error(info.p_logger, "[gfx] no queue found for texture uploads");
+
+         return monad::make_error(
+            make_error(texture_cache_error::failed_to_find_a_suitable_queue));
+      }
+
+      auto pool_res = vkn::command_pool::builder{device, info.p_logger}
+                         .set_queue_family_index(queue_index_res.value().value())
+                         .build();
+      if (!pool_res)
+      {
+         util::log_error(info.p_logger, "[gfx] texture command pool error: {}",
+                         pool_res.error().value().type.message());
+
+         return monad::make_error(make_error(texture_cache_error::failed_to_create_command_pool));
+      }
+
+      auto sampler_res =
+         vkn::sampler::builder{device, info.p_logger}.set_max_anisotropy(max_anisotropy).build();
+      if (!sampler_res)
+      {
+         util::log_error(info.p_logger, "[gfx] texture sampler error: {}",
+                         sampler_res.error().value().type.message());
+
+         return monad::make_error(make_error(texture_cache_error::failed_to_create_sampler));
+      }
+
+      const auto is_sampled = [&](vk::Format format) {
+         const auto properties = device.physical().value().getFormatProperties(format);
+         return static_cast<bool>(properties.optimalTilingFeatures &
+                                  vk::FormatFeatureFlagBits::eSampledImage);
+      };
+
+      texture_cache cache;
+      cache.mp_device = info.p_device;
+      cache.mp_thread_pool = info.p_thread_pool;
+      cache.m_queue = queue_res.value().value();
+      cache.m_command_pool = std::move(pool_res).value().value();
+      cache.m_sampler = std::move(sampler_res).value().value();
+      cache.m_frames_in_flight = info.frames_in_flight;
+      cache.mp_logger = std::move(info.p_logger);
+
+      for (std::size_t i = 0; i < texel_format_count; ++i)
+      {
+         const auto format = static_cast<texel_format>(i);
+
+         cache.m_supported_formats[i] =
+            is_sampled(to_vk_format(format, false)) && is_sampled(to_vk_format(format, true));
+         if (!cache.m_supported_formats[i])
+         {
+            util::log_warn(cache.mp_logger, "[gfx] {} can't be sampled, it will be decompressed",
+                           vk::to_string(to_vk_format(format, true)));
+         }
+      }
+
+      return cache;
+   }
+
+   auto texture_cache::load(const std::filesystem::path& path) -> texture_handle
+   {
+      const std::string key = path.generic_string();
+
+      if (const auto it = m_path_to_handle.find(key); it != std::end(m_path_to_handle))
+      {
+         ++m_textures[it->second].ref_count;
+
+         return it->second;
+      }
+
+      std::string extension = path.extension().string();
+      std::transform(std::begin(extension), std::end(extension), std::begin(extension),
+                     [](unsigned char c) {
+                        return static_cast<char>(std::tolower(c));
+                     });
+
+      const auto pack_it =
+         std::find_if(std::rbegin(m_packs), std::rend(m_packs), [&](const auto& p_pack) {
+            return p_pack->contains(key);
+         });
+
+      std::future<std::optional<decoded_image>> decoding;
+      if (pack_it != std::rend(m_packs))
+      {
+         decoding =
+            mp_thread_pool->submit([key, p_pack = *pack_it, supported = m_supported_formats] {
+               auto image = decode_dds(p_pack->find(key).value(), supported);
+               if (image)
+               {
+                  image->p_pack = p_pack;
+               }
+
+               return image;
+            });
+      }
+      else if (extension == ".dds")
+      {
+         decoding = mp_thread_pool->submit([key, supported = m_supported_formats] {
+            return load_dds(key, supported);
+         });
+      }
+      else
+      {
+         decoding = mp_thread_pool->submit([key] {
+            return decode_image(key);
+         });
+      }
+
+      const auto handle = m_textures.insert({.path = key, .decoding = std::move(decoding)});
+      m_path_to_handle.emplace(key, handle);
+
+      util::log_debug(mp_logger, R"([gfx] texture "{}" queued for decoding)", key);
+
+      return handle;
+   }
+
+   auto texture_cache::mount(const std::filesystem::path& pack_path) -> bool
+   {
+      auto pack = util::asset_pack::open(pack_path);
+      if (!pack)
+      {
+         util::log_error(mp_logger, R"([gfx] failed to mount texture pack "{}")",
+                         pack_path.generic_string());
+
+         return false;
+      }
+
+      util::log_info(mp_logger, R"([gfx] mounted texture pack "{}" holding {} textures)",
+                     pack_path.generic_string(), pack->size());
+
+      m_packs.push_back(std::make_shared<const util::asset_pack>(std::move(pack).value()));
+
+      return true;
+   }
+
+   void texture_cache::release(texture_handle handle)
+   {
+      if (auto* p_texture = m_textures.find(handle); p_texture && p_texture->ref_count > 0)
+      {
+         --p_texture->ref_count;
+      }
+   }
+
+   void texture_cache::update()
+   {
+      UTIL_TRACE_ZONE_CAT("texture_cache::update", "upload");
+
+      destroy_retired();
+      complete_uploads();
+      upload_decoded();
+
+      // Textures still decoding or uploading are retired once they are done
+      for (std::size_t i = std::size(m_textures); i-- > 0;)
+      {
+         const auto key = m_textures.key_at(i);
+         auto& texture = m_textures[key];
+
+         if (texture.ref_count > 0 || texture.state == texture_state::decoding ||
+             texture.state == texture_state::uploading)
+         {
+            continue;
+         }
+
+         if (texture.state == texture_state::resident)
+         {
+            m_resident_bytes -= texture.image.memory_size();
+         }
+
+         m_retired.push_back({.image = std::move(texture.image),
+                              .view = std::move(texture.view),
+                              .remaining_updates = m_frames_in_flight});
+
+         m_path_to_handle.erase(texture.path);
+         m_textures.erase(key);
+      }
+
+      util::stats::set(util::stats::gauge::resident_texture_bytes,
+                       static_cast<std::int64_t>(m_resident_bytes));
+   }
+
+   auto texture_cache::state(texture_handle handle) const -> std::optional<texture_state>
+   {
+      if (const auto* p_texture = m_textures.find(handle))
+      {
+         return p_texture->state;
+      }
+
+      return std::nullopt;
+   }
+   auto texture_cache::view(texture_handle handle) const -> vk::ImageView
+   {
+      if (const auto* p_texture = m_textures.find(handle);
+          p_texture && p_texture->state == texture_state::resident)
+      {
+         return p_texture->view.value();
+      }
+
+      return nullptr;
+   }
+   auto texture_cache::sampler() const noexcept -> vk::Sampler { return m_sampler.value(); }
+
+   auto texture_cache::size() const noexcept -> std::size_t { return std::size(m_textures); }
+   auto texture_cache::resident_bytes() const noexcept -> vk::DeviceSize
+   {
+      return m_resident_bytes;
+   }
+
+   auto texture_cache::decode_image(const std::string& path) -> std::optional<decoded_image>
+   {
+      UTIL_TRACE_ZONE_CAT("texture_decode", "upload");
+
+      int width = 0;
+      int height = 0;
+      int channels = 0;
+      stbi_uc* p_pixels = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+      if (!p_pixels)
+      {
+         return std::nullopt;
+      }
+
+      const vk::Extent2D extent{static_cast<std::uint32_t>(width),
+                                static_cast<std::uint32_t>(height)};
+
+      decoded_image image{.format = to_vk_format(texel_format::rgba8, true),
+                          .p_pixels = std::unique_ptr<std::byte, pixel_deleter>{
+                             reinterpret_cast<std::byte*>(p_pixels)}}; // NOLINT
+      image.mips.push_back(
+         {.extent = extent,
+          .data = {image.p_pixels.get(), image_size(texel_format::rgba8, extent)}});
+
+      return image;
+   }
+
+   auto texture_cache::load_dds(const std::string& path, const format_support& supported_formats)
+      -> std::optional<decoded_image>
+   {
+      auto file = util::mapped_file::open(path);
+      if (!file)
+      {
+         return std::nullopt;
+      }
+
+      auto image = decode_dds(file->bytes(), supported_formats);
+      if (image)
+      {
+         image->file = std::move(file).value();
+      }
+
+      return image;
+   }
+
+   auto texture_cache::decode_dds(std::span<const std::byte> bytes,
+                                  const format_support& supported_formats)
+      -> std::optional<decoded_image>
+   {
+      UTIL_TRACE_ZONE_CAT("texture_decode", "upload");
+
+      auto dds_res = parse_dds(bytes);
+      if (!dds_res)
+      {
+         return std::nullopt;
+      }
+
+      const auto dds = std::move(dds_res).value().value();
+
+      decoded_image image{.format = to_vk_format(dds.format, dds.is_srgb)};
+      if (supported_formats[static_cast<std::size_t>(dds.format)] ||
+          !is_block_compressed(dds.format))
+      {
+         // The mips are uploaded straight from the bytes
+         for (const auto& mip : dds.mips)
+         {
+            image.mips.push_back({.extent = mip.extent, .data = mip.data});
+         }
+
+         return image;
+      }
+
+      std::size_t total_size = 0;
+      for (const auto& mip : dds.mips)
+      {
+         total_size += image_size(texel_format::rgba8, mip.extent);
+      }
+
+      image.format = to_vk_format(texel_format::rgba8, dds.is_srgb);
+      image.decompressed.resize(total_size);
+
+      std::size_t offset = 0;
+      for (const auto& mip : dds.mips)
+      {
+         const auto texels = decompress_to_rgba8(dds.format, mip.extent, mip.data);
+         std::memcpy(std::data(image.decompressed) + offset, std::data(texels), std::size(texels));
+
+         image.mips.push_back(
+            {.extent = mip.extent,
+             .data = {std::data(image.decompressed) + offset, std::size(texels)}});
+
+         offset += std::size(texels);
+      }
+
+      return image;
+   }
+
+   void texture_cache::upload_decoded()
+   {
+      util::dynamic_array<staged_texture> staged;
+      util::dynamic_array<decoded_image> images;
+      vk::DeviceSize staging_size = 0;
+
+      for (std::size_t i = 0; i < std::size(m_textures); ++i)
+      {
+         auto& texture = m_textures.values()[i];
+         if (texture.state != texture_state::decoding ||
+             texture.decoding.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+         {
+            continue;
+         }
+
+         auto decoded = texture.decoding.get();
+         if (!decoded)
+         {
+            util::log_error(mp_logger, R"([gfx] failed to decode texture "{}")", texture.path);
+
+            texture.state = texture_state::failed;
+            continue;
+         }
+
+         // Nobody is waiting on it anymore, let the update retire it
+         if (texture.ref_count == 0)
+         {
+            texture.state = texture_state::failed;
+            continue;
+         }
+
+         auto image = create_image(decoded.value());
+         if (!image)
+         {
+            texture.state = texture_state::failed;
+            continue;
+         }
+
+         std::tie(texture.image, texture.view) = std::move(image).value();
+         texture.state = texture_state::uploading;
+
+         staged_texture staging{.handle = m_textures.key_at(i)};
+         for (const auto& mip : decoded->mips)
+         {
+            staging_size = (staging_size + staging_alignment - 1) & ~(staging_alignment - 1);
+            staging.mip_offsets.push_back(staging_size);
+            staging_size += std::size(mip.data);
+         }
+
+         staged.push_back(std::move(staging));
+         images.push_back(std::move(decoded).value());
+      }
+
+      if (std::empty(staged))
+      {
+         return;
+      }
+
+      const auto fail_batch = [&] {
+         for (const auto& texture : staged)
+         {
+            m_textures[texture.handle].state = texture_state::failed;
+         }
+      };
+
+      auto staging_res = vkn::buffer::builder{*mp_device, mp_logger}
+                            .set_size(staging_size)
+                            .set_usage(vk::BufferUsageFlagBits::eTransferSrc)
+                            .set_desired_memory_type(vk::MemoryPropertyFlagBits::eHostVisible |
+                                                     vk::MemoryPropertyFlagBits::eHostCoherent)
+                            .set_persistently_mapped()
+                            .build();
+      auto fence_res = vkn::fence::builder{*mp_device, mp_logger}.build();
+      auto cmd_res = m_command_pool.create_primary_buffer();
+      if (!staging_res || !fence_res || !cmd_res)
+      {
+         util::log_error(mp_logger, "[gfx] failed to prepare the upload of {} textures",
+                         std::size(staged));
+
+         fail_batch();
+         return;
+      }
+
+      auto staging_buffer = std::move(staging_res).value().value();
+      auto* p_staging_data = static_cast<std::byte*>(staging_buffer.mapped_data());
+      for (std::size_t i = 0; i < std::size(images); ++i)
+      {
+         for (std::size_t level = 0; level < std::size(images[i].mips); ++level)
+         {
+            const auto data = images[i].mips[level].data;
+            std::memcpy(p_staging_data + staged[i].mip_offsets[level], std::data(data),
+                        std::size(data));
+         }
+      }
+
+      auto command_buffer = std::move(cmd_res).value().value();
+      auto fence = std::move(fence_res).value().value();
+
+      command_buffer->begin({.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+      record_upload(command_buffer.get(), staging_buffer, staged);
+      command_buffer->end();
+
+      m_queue.submit({{.commandBufferCount = 1, .pCommandBuffers = &command_buffer.get()}},
+                     fence.value());
+
+      util::stats::increment(util::stats::counter::bytes_uploaded, staging_size);
+
+      util::log_debug(mp_logger, "[gfx] {} textures ({} bytes) submitted for upload",
+                      std::size(staged), staging_size);
+
+      util::dynamic_array<texture_handle> handles;
+      handles.reserve(std::size(staged));
+      for (const auto& texture : staged)
+      {
+         handles.push_back(texture.handle);
+      }
+
+      m_uploads.push_back({.fence = std::move(fence),
+                           .command_buffer = std::move(command_buffer),
+                           .staging_buffer = std::move(staging_buffer),
+                           .textures = std::move(handles)});
+   }
+
+   void texture_cache::record_upload(vk::CommandBuffer cmd, const vkn::buffer& staging_buffer,
+                                     std::span<const staged_texture> textures) const
+   {
+      const auto barrier = [&](vk::Image image, std::uint32_t base_mip, std::uint32_t mip_count,
+                               vk::ImageLayout old_layout, vk::ImageLayout new_layout,
+                               vk::AccessFlags src_access, vk::AccessFlags dst_access,
+                               vk::PipelineStageFlags src_stage, vk::PipelineStageFlags dst_stage) {
+         cmd.pipelineBarrier(src_stage, dst_stage, {}, {}, {},
+                             {{.srcAccessMask = src_access,
+                               .dstAccessMask = dst_access,
+                               .oldLayout = old_layout,
+                               .newLayout = new_layout,
+                               .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                               .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                               .image = image,
+                               .subresourceRange = {.aspectMask = vk::ImageAspectFlagBits::eColor,
+                                                    .baseMipLevel = base_mip,
+                                                    .levelCount = mip_count,
+                                                    .baseArrayLayer = 0,
+                                                    .layerCount = 1}}});
+      };
+
+      using layout = vk::ImageLayout;
+      using access = vk::AccessFlagBits;
+      using stage = vk::PipelineStageFlagBits;
+
+      for (const auto& staged : textures)
+      {
+         const auto& image = m_textures[staged.handle].image;
+         const auto extent = image.extent();
+         const auto mip_levels = image.mip_levels();
+         const auto provided_levels = static_cast<std::uint32_t>(std::size(staged.mip_offsets));
+
+         barrier(image.value(), 0, mip_levels, layout::eUndefined, layout::eTransferDstOptimal,
+                 {}, access::eTransferWrite, stage::eTopOfPipe, stage::eTransfer);
+
+         for (std::uint32_t mip = 0; mip < provided_levels; ++mip)
+         {
+            cmd.copyBufferToImage(
+               staging_buffer.value(), image.value(), layout::eTransferDstOptimal,
+               {{.bufferOffset = staged.mip_offsets[mip],
+                 .imageSubresource = {.aspectMask = vk::ImageAspectFlagBits::eColor,
+                                      .mipLevel = mip,
+                                      .baseArrayLayer = 0,
+                                      .layerCount = 1},
+                 .imageExtent = {std::max(extent.width >> mip, 1U),
+                                 std::max(extent.height >> mip, 1U), 1}}});
+         }
+
+         // Each missing level is blitted from the previous one, which is then done being written
+         const std::uint32_t last_provided = provided_levels - 1;
+         auto width = static_cast<std::int32_t>(std::max(extent.width >> last_provided, 1U));
+         auto height = static_cast<std::int32_t>(std::max(extent.height >> last_provided, 1U));
+         for (std::uint32_t mip = provided_levels; mip < mip_levels; ++mip)
+         {
+            barrier(image.value(), mip - 1, 1, layout::eTransferDstOptimal,
+                    layout::eTransferSrcOptimal, access::eTransferWrite, access::eTransferRead,
+                    stage::eTransfer, stage::eTransfer);
+
+            const std::int32_t next_width = std::max(width / 2, 1);
+            const std::int32_t next_height = std::max(height / 2, 1);
+
+            cmd.blitImage(image.value(), layout::eTransferSrcOptimal, image.value(),
+                          layout::eTransferDstOptimal,
+                          {{.srcSubresource = {.aspectMask = vk::ImageAspectFlagBits::eColor,
+                                               .mipLevel = mip - 1,
+                                               .baseArrayLayer = 0,
+                                               .layerCount = 1},
+                            .srcOffsets = std::array{vk::Offset3D{0, 0, 0},
+                                                     vk::Offset3D{width, height, 1}},
+                            .dstSubresource = {.aspectMask = vk::ImageAspectFlagBits::eColor,
+                                               .mipLevel = mip,
+                                               .baseArrayLayer = 0,
+                                               .layerCount = 1},
+                            .dstOffsets = std::array{vk::Offset3D{0, 0, 0},
+                                                     vk::Offset3D{next_width, next_height, 1}}}},
+                          vk::Filter::eLinear);
+
+            barrier(image.value(), mip - 1, 1, layout::eTransferSrcOptimal,
+                    layout::eShaderReadOnlyOptimal, access::eTransferRead, access::eShaderRead,
+                    stage::eTransfer, stage::eFragmentShader);
+
+            width = next_width;
+            height = next_height;
+         }
+
+         // The levels copied from the file were never blit sources, they are still written to
+         if (provided_levels > 1)
+         {
+            barrier(image.value(), 0, provided_levels - 1, layout::eTransferDstOptimal,
+                    layout::eShaderReadOnlyOptimal, access::eTransferWrite, access::eShaderRead,
+                    stage::eTransfer, stage::eFragmentShader);
+         }
+         barrier(image.value(), mip_levels - 1, 1, layout::eTransferDstOptimal,
+                 layout::eShaderReadOnlyOptimal, access::eTransferWrite, access::eShaderRead,
+                 stage::eTransfer, stage::eFragmentShader);
+      }
+   }
+
+   void texture_cache::complete_uploads()
+   {
+      const auto is_done = [&](const upload& upload) {
+         return mp_device->value().getFenceStatus(upload.fence.value()) == vk::Result::eSuccess;
+      };
+
+      const auto first_done = std::stable_partition(std::begin(m_uploads), std::end(m_uploads),
+                                                    std::not_fn(is_done));
+      for (auto it = first_done; it != std::end(m_uploads); ++it)
+      {
+         for (const auto handle : it->textures)
+         {
+            // Uploading textures are never erased, the handle is still valid
+            auto& texture = m_textures[handle];
+            texture.state = texture_state::resident;
+
+            m_resident_bytes += texture.image.memory_size();
+
+            util::log_debug(mp_logger, R"([gfx] texture "{}" resident)", texture.path);
+         }
+      }
+
+      m_uploads.erase(first_done, std::end(m_uploads));
+   }
+
+   void texture_cache::destroy_retired()
+   {
+      for (auto& texture : m_retired)
+      {
+         --texture.remaining_updates;
+      }
+
+      const auto first_expired =
+         std::remove_if(std::begin(m_retired), std::end(m_retired), [](const auto& texture) {
+            return texture.remaining_updates == 0;
+         });
+      m_retired.erase(first_expired, std::end(m_retired));
+   }
+
+   auto texture_cache::create_image(const decoded_image& decoded) const
+      -> std::optional<std::pair<vkn::image, vkn::image_view>>
+   {
+      const vk::Extent2D extent = decoded.mips[0].extent;
+
+      // Mips are generated with linear blits, which not every format supports
+      const auto blit_features = vk::FormatFeatureFlagBits::eBlitSrc |
+         vk::FormatFeatureFlagBits::eBlitDst | vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+      const auto properties = mp_device->physical().value().getFormatProperties(decoded.format);
+      const bool can_blit = (properties.optimalTilingFeatures & blit_features) == blit_features;
+
+      const auto provided_levels = static_cast<std::uint32_t>(std::size(decoded.mips));
+      const std::uint32_t mip_levels = provided_levels == 1 && can_blit
+         ? vkn::full_mip_chain_length(extent)
+         : provided_levels;
+
+      auto image_res = vkn::image::builder{*mp_device, mp_logger}
+                          .set_format(decoded.format)
+                          .set_extent(extent)
+                          .set_mip_levels(util::count32_t{mip_levels})
+                          .set_usage(vk::ImageUsageFlagBits::eTransferSrc |
+                                     vk::ImageUsageFlagBits::eTransferDst |
+                                     vk::ImageUsageFlagBits::eSampled)
+                          .build();
+      if (!image_res)
+      {
+         util::log_error(mp_logger, "[gfx] texture image error: {}",
+                         image_res.error().value().type.message());
+
+         return std::nullopt;
+      }
+
+      auto image = std::move(image_res).value().value();
+
+      auto view_res = vkn::image_view::builder{*mp_device, mp_logger}.set_image(image).build();
+      if (!view_res)
+      {
+         util::log_error(mp_logger, "[gfx] texture image view error: {}",
+                         view_res.error().value().type.message());
+
+         return std::nullopt;
+      }
+
+      return std::pair{std::move(image), std::move(view_res).value().value()};
+   }
+} // namespace gfx
@@ -0,0 +1,204 @@
+#include <gfx/vertex_layout.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+
+namespace gfx
+{
+   namespace detail
+   {
+      static constexpr std::array position_colour_attributes{
+         vertex_attribute{.semantic = vertex_semantic::position,
+                          .format = vk::Format::eR32G32B32Sfloat,
+                          .offset = offsetof(vertex, position)},
+         vertex_attribute{.semantic = vertex_semantic::colour,
+                          .format = vk::Format::eR32G32B32Sfloat,
+                          .offset = offsetof(vertex, colour)}};
+
+      /**
+       * Three component 16 bit formats are rarely supported for vertex input, the position is
+       * padded to four components, the last one holding 1
+       */
+      struct compact_vertex
+      {
+         std::array<std::uint16_t, 4> position;
+         std::array<std::uint8_t, 4> colour;
+      };
+
+      static_assert(sizeof(compact_vertex) == 12);
+
+      static constexpr std::array compact_attributes{
+         vertex_attribute{.semantic = vertex_semantic::position,
+                          .format = vk::Format::eR16G16B16A16Sfloat,
+                          .offset = offsetof(compact_vertex, position)},
+         vertex_attribute{.semantic = vertex_semantic::colour,
+                          .format = vk::Format::eR8G8B8A8Unorm,
+                          .offset = offsetof(compact_vertex, colour)}};
+
+      auto to_unorm8(float value) noexcept -> std::uint8_t
+      {
+         return static_cast<std::uint8_t>(std::clamp(value, 0.0F, 1.0F) * 255.0F + 0.5F);
+      }
+
+      void pack_compact(std::span<const vertex> vertices, std::span<std::byte> output) noexcept
+      {
+         static constexpr std::uint16_t half_one = 0x3C00;
+
+         std::byte* p_output = std::data(output);
+         for (const auto& v : vertices)
+         {
+            const compact_vertex packed{
+               .position = {to_half(v.position.x), to_half(v.position.y), to_half(v.position.z),
+                            half_one},
+               .colour = {to_unorm8(v.colour.x), to_unorm8(v.colour.y), to_unorm8(v.colour.z),
+                          255}};
+
+            std::memcpy(p_output, &packed, sizeof(packed));
+            p_output += sizeof(packed);
+         }
+      }
+   } // namespace detail
+
+   auto to_string(vertex_layout layout) -> std::string
+   {
+      switch (layout)
+      {
+         case vertex_layout::position_colour:
+            return "position_colour";
+         case vertex_layout::compact:
+            return "compact";
+         default:
+            return "UNKNOWN";
+      }
+   }
+
+   auto vertex_stride(vertex_layout layout) noexcept -> std::uint32_t
+   {
+      switch (layout)
+      {
+         case vertex_layout::compact:
+            return sizeof(detail::compact_vertex);
+         default:
+            return sizeof(vertex);
+      }
+   }
+
+   auto vertex_attributes(vertex_layout layout) noexcept -> std::span<const vertex_attribute>
+   {
+      switch (layout)
+      {
+         case vertex_layout::compact:
+            return detail::compact_attributes;
+         default:
+            return detail::position_colour_attributes;
+      }
+   }
+
+   auto vertex_input_binding(vertex_layout layout, std::uint32_t binding)
+      -> vk::VertexInputBindingDescription
+   {
+      return {.binding = binding,
+              .stride = vertex_stride(layout),
+              .inputRate = vk::VertexInputRate::eVertex};
+   }
+
+   auto vertex_input_attributes(vertex_layout layout, std::uint32_t binding)
+      -> util::small_dynamic_array<vk::VertexInputAttributeDescription, 4>
+   {
+      util::small_dynamic_array<vk::VertexInputAttributeDescription, 4> descriptions;
+      for (const auto& attribute : vertex_attributes(layout))
+      {
+         descriptions.push_back({.location = static_cast<std::uint32_t>(attribute.semantic),
+                                 .binding = binding,
+                                 .format = attribute.format,
+                                 .offset = attribute.offset});
+      }
+
+      return descriptions;
+   }
+
+   void pack_vertices(vertex_layout layout, std::span<const vertex> vertices,
+                      std::span<std::byte> output) noexcept
+   {
+      // The layout is dispatched once for the whole array
+      switch (layout)
+      {
+         case vertex_layout::compact:
+            detail::pack_compact(vertices, output);
+            break;
+         default:
+            std::memcpy(std::data(output), std::data(vertices), vertices.size_bytes());
+            break;
+      }
+   }
+
+   auto pack_vertices(vertex_layout layout, std::span<const vertex> vertices)
+      -> util::dynamic_array<std::byte>
+   {
+      util::dynamic_array<std::byte> output(std::size(vertices) * vertex_stride(layout));
+      pack_vertices(layout, vertices, output);
+
+      return output;
+   }
+
+   auto to_half(float value) noexcept -> std::uint16_t
+   {
+      static constexpr std::uint32_t float_infinity = 255U << 23U;
+      static constexpr std::uint32_t half_overflow = (127U + 16U) << 23U;
+      static constexpr std::uint32_t smallest_normal = 113U << 23U;
+      static constexpr std::uint32_t denormal_magic = ((127U - 15U) + (23U - 10U) + 1U) << 23U;
+
+      std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+      const std::uint32_t sign = bits & 0x8000'0000U;
+      bits ^= sign;
+
+      std::uint32_t result = 0;
+      if (bits >= half_overflow)
+      {
+         // Infinities stay infinities and NaNs stay quiet NaNs
+         result = bits > float_infinity ? 0x7E00U : 0x7C00U;
+      }
+      else if (bits < smallest_normal)
+      {
+         // Adding the magic number makes the FPU round the mantissa into the denormal range
+         const float shifted =
+            std::bit_cast<float>(bits) + std::bit_cast<float>(denormal_magic);
+         result = std::bit_cast<std::uint32_t>(shifted) - denormal_magic;
+      }
+      else
+      {
+         const std::uint32_t is_mantissa_odd = (bits >> 13U) & 1U;
+
+         // Rebias the exponent and round to nearest, ties to even
+         bits += ((15U - 127U) << 23U) + 0xFFFU;
+         bits += is_mantissa_odd;
+         result = bits >> 13U;
+      }
+
+      return static_cast<std::uint16_t>(result | (sign >> 16U));
+   }
+
+   auto from_half(std::uint16_t value) noexcept -> float
+   {
+      static constexpr std::uint32_t exponent_mask = 0x7C00U << 13U;
+      static constexpr float denormal_bias = 0x1.0p-14F;
+
+      std::uint32_t bits = (value & 0x7FFFU) << 13U;
+      const std::uint32_t exponent = bits & exponent_mask;
+
+      bits += (127U - 15U) << 23U;
+      if (exponent == exponent_mask)
+      {
+         bits += (128U - 16U) << 23U;
+      }
+      else if (exponent == 0)
+      {
+         bits += 1U << 23U;
+         bits = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits) - denormal_bias);
+      }
+
+      return std::bit_cast<float>(bits | (std::uint32_t{value} & 0x8000U) << 16U);
+   }
+} // namespace gfx
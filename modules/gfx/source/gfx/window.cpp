@@ -53,6 +53,11 @@ namespace gfx
 
    auto window::is_open() -> bool { return !glfwWindowShouldClose(p_wnd.get()); }
 
+   auto window::is_key_pressed(int key) const -> bool
+   {
+      return glfwGetKey(p_wnd.get(), key) == GLFW_PRESS;
+   }
+
    auto window::get_surface(vk::Instance instance) const -> vkn::result<vk::SurfaceKHR>
    {
       VkSurfaceKHR surface = VK_NULL_HANDLE;
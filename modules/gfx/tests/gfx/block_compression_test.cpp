@@ -0,0 +1,202 @@
+#include <gfx/block_compression.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdlib>
+#include <limits>
+#include <random>
+
+struct channel_error
+{
+   std::array<int, 4> max{};
+   std::array<double, 4> mean{};
+};
+
+// An odd sized image so the blocks on the right & bottom edges hang over it
+static constexpr vk::Extent2D test_extent{37, 29};
+
+static auto make_gradient(const vk::Extent2D& extent) -> util::dynamic_array<std::byte>
+{
+   util::dynamic_array<std::byte> texels(gfx::image_size(gfx::texel_format::rgba8, extent));
+   for (std::uint32_t y = 0; y < extent.height; ++y)
+   {
+      for (std::uint32_t x = 0; x < extent.width; ++x)
+      {
+         auto* p_texel = &texels[(std::size_t{y} * extent.width + x) * 4];
+         p_texel[0] = static_cast<std::byte>(x * 255 / (extent.width - 1));  // NOLINT
+         p_texel[1] = static_cast<std::byte>(y * 255 / (extent.height - 1)); // NOLINT
+         p_texel[2] = static_cast<std::byte>((x + y) * 4);                   // NOLINT
+         p_texel[3] = static_cast<std::byte>(255 - x * 6);                   // NOLINT
+      }
+   }
+
+   return texels;
+}
+
+static auto make_noise(const vk::Extent2D& extent) -> util::dynamic_array<std::byte>
+{
+   std::mt19937 engine{3}; // NOLINT
+   std::uniform_int_distribution<int> distribution{0, 255}; // NOLINT
+
+   util::dynamic_array<std::byte> texels(gfx::image_size(gfx::texel_format::rgba8, extent));
+   for (auto& texel : texels)
+   {
+      texel = static_cast<std::byte>(distribution(engine));
+   }
+
+   return texels;
+}
+
+static auto round_trip_error(gfx::texel_format format, const vk::Extent2D& extent,
+                             const util::dynamic_array<std::byte>& texels) -> channel_error
+{
+   const auto compressed = gfx::compress_from_rgba8(format, extent, texels);
+   EXPECT_EQ(std::size(compressed), gfx::image_size(format, extent));
+
+   const auto decompressed = gfx::decompress_to_rgba8(format, extent, compressed);
+   EXPECT_EQ(std::size(decompressed), std::size(texels));
+
+   channel_error error{};
+   for (std::size_t i = 0; i < std::size(decompressed); ++i)
+   {
+      const int diff =
+         std::abs(std::to_integer<int>(decompressed[i]) - std::to_integer<int>(texels[i]));
+
+      error.max[i % 4] = std::max(error.max[i % 4], diff);
+      error.mean[i % 4] += diff;
+   }
+
+   for (auto& mean : error.mean)
+   {
+      mean /= static_cast<double>(std::size(decompressed) / 4);
+   }
+
+   return error;
+}
+
+TEST(block_compression, image_size)
+{
+   EXPECT_EQ(gfx::image_size(gfx::texel_format::rgba8, {3, 5}), 3 * 5 * 4);
+   EXPECT_EQ(gfx::image_size(gfx::texel_format::bc1, {1, 1}), 8);
+   EXPECT_EQ(gfx::image_size(gfx::texel_format::bc1, {5, 4}), 16);
+   EXPECT_EQ(gfx::image_size(gfx::texel_format::bc7, {8, 9}), 16 * 2 * 3);
+
+   // The block count of the largest extents must not wrap around
+   constexpr std::uint32_t max_extent = std::numeric_limits<std::uint32_t>::max();
+   EXPECT_EQ(gfx::image_size(gfx::texel_format::bc1, {max_extent, 4}),
+             (std::size_t{max_extent} + 3) / 4 * 8);
+}
+
+TEST(block_compression, bc1_decode)
+{
+   // Red and blue endpoints, then one texel per palette entry on the first row
+   const std::array<std::byte, 8> block{std::byte{0x00}, std::byte{0xF8}, std::byte{0x1F},
+                                        std::byte{0x00}, std::byte{0xE4}, std::byte{0x00},
+                                        std::byte{0x00}, std::byte{0x00}};
+
+   const auto texels = gfx::decompress_to_rgba8(gfx::texel_format::bc1, {4, 1}, block);
+   ASSERT_EQ(std::size(texels), 4 * 4);
+
+   const std::array<std::array<int, 4>, 4> expected{{{255, 0, 0, 255},
+                                                     {0, 0, 255, 255},
+                                                     {170, 0, 85, 255},
+                                                     {85, 0, 170, 255}}};
+   for (std::size_t i = 0; i < 4; ++i)
+   {
+      for (std::size_t c = 0; c < 4; ++c)
+      {
+         EXPECT_NEAR(std::to_integer<int>(texels[i * 4 + c]), expected[i][c], 1);
+      }
+   }
+}
+
+TEST(block_compression, bc1_round_trip)
+{
+   const auto gradient = round_trip_error(gfx::texel_format::bc1, test_extent,
+                                          make_gradient(test_extent));
+   for (std::size_t c = 0; c < 3; ++c)
+   {
+      EXPECT_LE(gradient.max[c], 20);
+      EXPECT_LE(gradient.mean[c], 8.0);
+   }
+
+   // Encoded opaque
+   const auto decompressed = gfx::decompress_to_rgba8(
+      gfx::texel_format::bc1, test_extent,
+      gfx::compress_from_rgba8(gfx::texel_format::bc1, test_extent, make_gradient(test_extent)));
+   for (std::size_t i = 3; i < std::size(decompressed); i += 4)
+   {
+      ASSERT_EQ(std::to_integer<int>(decompressed[i]), 255);
+   }
+}
+
+TEST(block_compression, bc1_solid_block_is_exact)
+{
+   // 0x00 and 0xFF survive the R5G6B5 quantisation unchanged
+   util::dynamic_array<std::byte> texels(4 * 4 * 4);
+   for (std::size_t i = 0; i < std::size(texels); i += 4)
+   {
+      texels[i + 0] = std::byte{0xFF};
+      texels[i + 1] = std::byte{0x00};
+      texels[i + 2] = std::byte{0xFF};
+      texels[i + 3] = std::byte{0xFF};
+   }
+
+   const auto error = round_trip_error(gfx::texel_format::bc1, {4, 4}, texels);
+
+   EXPECT_EQ(error.max, (std::array<int, 4>{0, 0, 0, 0}));
+}
+
+TEST(block_compression, bc3_round_trip)
+{
+   const auto gradient = round_trip_error(gfx::texel_format::bc3, test_extent,
+                                          make_gradient(test_extent));
+   for (std::size_t c = 0; c < 3; ++c)
+   {
+      EXPECT_LE(gradient.max[c], 20);
+      EXPECT_LE(gradient.mean[c], 8.0);
+   }
+   EXPECT_LE(gradient.max[3], 4);
+
+   // Eight interpolated levels leave at most 255 / 14 of error whatever the alpha values
+   const auto noise =
+      round_trip_error(gfx::texel_format::bc3, test_extent, make_noise(test_extent));
+   EXPECT_LE(noise.max[3], 20);
+}
+
+TEST(block_compression, bc5_round_trip)
+{
+   const auto gradient = round_trip_error(gfx::texel_format::bc5, test_extent,
+                                          make_gradient(test_extent));
+   EXPECT_LE(gradient.max[0], 4);
+   EXPECT_LE(gradient.max[1], 4);
+
+   const auto noise =
+      round_trip_error(gfx::texel_format::bc5, test_extent, make_noise(test_extent));
+   EXPECT_LE(noise.max[0], 20);
+   EXPECT_LE(noise.max[1], 20);
+}
+
+TEST(block_compression, small_extents)
+{
+   for (const vk::Extent2D extent : {vk::Extent2D{1, 1}, vk::Extent2D{2, 3}, vk::Extent2D{5, 1}})
+   {
+      util::dynamic_array<std::byte> texels(gfx::image_size(gfx::texel_format::rgba8, extent),
+                                            std::byte{0x80});
+
+      const auto error = round_trip_error(gfx::texel_format::bc3, extent, texels);
+      for (std::size_t c = 0; c < 4; ++c)
+      {
+         EXPECT_LE(error.max[c], 4);
+      }
+   }
+}
+
+TEST(block_compression, short_input)
+{
+   util::dynamic_array<std::byte> data(gfx::image_size(gfx::texel_format::bc1, test_extent) - 1);
+
+   EXPECT_TRUE(gfx::decompress_to_rgba8(gfx::texel_format::bc1, test_extent, data).empty());
+   EXPECT_TRUE(gfx::compress_from_rgba8(gfx::texel_format::bc1, test_extent, data).empty());
+}
@@ -0,0 +1,224 @@
+#include <gfx/bvh.hpp>
+#include <gfx/culling.hpp>
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <random>
+
+struct bvh_test : public testing::Test
+{
+   struct object
+   {
+      std::uint32_t proxy;
+      gfx::aabb bounds;
+   };
+
+   bvh_test()
+   {
+      for (std::uint32_t i = 0; i < 2000; ++i) // NOLINT
+      {
+         const auto bounds = random_box();
+         objects[i] = {.proxy = tree.insert(bounds, i), .bounds = bounds};
+      }
+
+      // Move, remove and insert objects so the tree is checked after it has been rebalanced
+      std::uniform_int_distribution<std::uint32_t> action{0, 2};
+      std::uniform_real_distribution<float> offset{-1.0F, 1.0F};
+      for (std::uint32_t i = 0; i < 6000; ++i) // NOLINT
+      {
+         auto it = std::next(objects.begin(),
+                             std::uniform_int_distribution<std::ptrdiff_t>{
+                                0, static_cast<std::ptrdiff_t>(objects.size()) - 1}(engine));
+
+         switch (action(engine))
+         {
+            case 0:
+            {
+               const glm::vec3 delta{offset(engine), offset(engine), offset(engine)};
+               it->second.bounds = {it->second.bounds.min + delta, it->second.bounds.max + delta};
+               tree.move(it->second.proxy, it->second.bounds);
+               break;
+            }
+            case 1:
+            {
+               tree.remove(it->second.proxy);
+               objects.erase(it);
+               break;
+            }
+            default:
+            {
+               const auto bounds = random_box();
+               const std::uint32_t user_data = 2000 + i; // NOLINT
+               objects[user_data] = {.proxy = tree.insert(bounds, user_data), .bounds = bounds};
+               break;
+            }
+         }
+      }
+   }
+
+   auto random_box() -> gfx::aabb
+   {
+      std::uniform_real_distribution<float> position{-100.0F, 100.0F}; // NOLINT
+      std::uniform_real_distribution<float> extent{0.1F, 3.0F};       // NOLINT
+
+      const glm::vec3 center{position(engine), position(engine), position(engine)};
+      const glm::vec3 half_extent{extent(engine), extent(engine), extent(engine)};
+
+      return {center - half_extent, center + half_extent};
+   }
+
+   static auto sorted(const util::dynamic_array<std::uint32_t>& values)
+      -> util::dynamic_array<std::uint32_t>
+   {
+      auto result = values;
+      std::sort(result.begin(), result.end());
+      return result;
+   }
+
+   std::mt19937 engine{7}; // NOLINT
+
+   gfx::bvh tree{0.5F}; // NOLINT
+   std::map<std::uint32_t, object> objects;
+};
+
+TEST_F(bvh_test, size)
+{
+   EXPECT_EQ(tree.size(), objects.size());
+
+   for (const auto& [user_data, obj] : objects)
+   {
+      EXPECT_EQ(tree.user_data(obj.proxy), user_data);
+      EXPECT_TRUE(tree.fat_bounds(obj.proxy).contains(obj.bounds));
+   }
+}
+
+TEST_F(bvh_test, query_aabb_matches_brute_force)
+{
+   for (int i = 0; i < 200; ++i) // NOLINT
+   {
+      auto query = random_box();
+      query.min -= glm::vec3{10.0F}; // NOLINT
+      query.max += glm::vec3{10.0F}; // NOLINT
+
+      util::dynamic_array<std::uint32_t> found;
+      tree.query_aabb(query, found);
+
+      util::dynamic_array<std::uint32_t> expected;
+      for (const auto& [user_data, obj] : objects)
+      {
+         if (obj.bounds.overlaps(query))
+         {
+            expected.push_back(user_data);
+         }
+      }
+
+      EXPECT_EQ(sorted(found), expected);
+   }
+}
+
+TEST_F(bvh_test, query_frustum_matches_brute_force)
+{
+   const auto projection = glm::perspective(glm::radians(60.0F), 1.5F, 0.1F, 150.0F); // NOLINT
+
+   std::uniform_real_distribution<float> position{-50.0F, 50.0F}; // NOLINT
+   for (int i = 0; i < 50; ++i)                                    // NOLINT
+   {
+      const glm::vec3 eye{position(engine), position(engine), position(engine)};
+      const glm::vec3 target{position(engine), position(engine), position(engine)};
+      const auto frustum =
+         gfx::extract_frustum(projection * glm::lookAt(eye, target, glm::vec3{0.0F, 1.0F, 0.0F}));
+
+      util::dynamic_array<std::uint32_t> found;
+      tree.query_frustum(frustum, found);
+
+      // A box is culled when its corner furthest along a plane normal is behind that plane
+      util::dynamic_array<std::uint32_t> expected;
+      for (const auto& [user_data, obj] : objects)
+      {
+         const bool is_outside =
+            std::any_of(frustum.planes.begin(), frustum.planes.end(), [&](const glm::vec4& p) {
+               const glm::vec3 corner{p.x >= 0.0F ? obj.bounds.max.x : obj.bounds.min.x,
+                                      p.y >= 0.0F ? obj.bounds.max.y : obj.bounds.min.y,
+                                      p.z >= 0.0F ? obj.bounds.max.z : obj.bounds.min.z};
+               return glm::dot(glm::vec3{p}, corner) + p.w < 0.0F;
+            });
+
+         if (!is_outside)
+         {
+            expected.push_back(user_data);
+         }
+      }
+
+      EXPECT_EQ(sorted(found), expected);
+   }
+}
+
+TEST_F(bvh_test, raycast_matches_brute_force)
+{
+   std::uniform_real_distribution<float> position{-100.0F, 100.0F}; // NOLINT
+   for (int i = 0; i < 200; ++i)                                     // NOLINT
+   {
+      const glm::vec3 origin{position(engine), position(engine), position(engine)};
+      const glm::vec3 direction = glm::normalize(
+         glm::vec3{position(engine), position(engine), position(engine)});
+      const glm::vec3 inv_direction = 1.0F / direction;
+
+      float closest = std::numeric_limits<float>::max();
+      for (const auto& [user_data, obj] : objects)
+      {
+         float t_min = 0.0F;
+         float t_max = std::numeric_limits<float>::max();
+         for (int axis = 0; axis < 3; ++axis)
+         {
+            float t0 = (obj.bounds.min[axis] - origin[axis]) * inv_direction[axis];
+            float t1 = (obj.bounds.max[axis] - origin[axis]) * inv_direction[axis];
+            if (t0 > t1)
+            {
+               std::swap(t0, t1);
+            }
+
+            t_min = std::max(t_min, t0);
+            t_max = std::min(t_max, t1);
+         }
+
+         if (t_min <= t_max)
+         {
+            closest = std::min(closest, t_min);
+         }
+      }
+
+      const auto hit = tree.raycast(origin, direction);
+      if (closest == std::numeric_limits<float>::max())
+      {
+         EXPECT_FALSE(hit.has_value());
+      }
+      else
+      {
+         ASSERT_TRUE(hit.has_value());
+         EXPECT_NEAR(hit->distance, closest, 1e-3F); // NOLINT
+
+         const auto& bounds = objects.at(hit->user_data).bounds;
+         EXPECT_TRUE(bounds.overlaps(
+            {origin + direction * hit->distance - glm::vec3{1e-3F},   // NOLINT
+             origin + direction * hit->distance + glm::vec3{1e-3F}})); // NOLINT
+      }
+   }
+}
+
+TEST_F(bvh_test, clear)
+{
+   tree.clear();
+
+   util::dynamic_array<std::uint32_t> found;
+   tree.query_aabb({glm::vec3{-1000.0F}, glm::vec3{1000.0F}}, found); // NOLINT
+
+   EXPECT_EQ(tree.size(), 0);
+   EXPECT_TRUE(found.empty());
+   EXPECT_FALSE(tree.raycast(glm::vec3{0.0F}, glm::vec3{1.0F, 0.0F, 0.0F}).has_value());
+}
@@ -0,0 +1,196 @@
+#include <gfx/culling.hpp>
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+
+struct culling_test : public testing::Test
+{
+   culling_test()
+   {
+      // Not a multiple of the SIMD widths so the scalar tail is exercised
+      std::uniform_real_distribution<float> position{-60.0F, 60.0F}; // NOLINT
+      std::uniform_real_distribution<float> radius{0.1F, 4.0F};      // NOLINT
+      for (int i = 0; i < 1003; ++i)                                  // NOLINT
+      {
+         spheres.push_back({.center = {position(engine), position(engine), position(engine)},
+                            .radius = radius(engine)});
+      }
+
+      // One sphere around the camera
+      spheres.push_back({.center = eye, .radius = 2.0F});
+   }
+
+   [[nodiscard]] auto expected_visible() const -> util::dynamic_array<std::uint32_t>
+   {
+      util::dynamic_array<std::uint32_t> visible;
+      for (std::uint32_t i = 0; i < spheres.size(); ++i)
+      {
+         const gfx::bounding_sphere sphere{
+            .center = {spheres.center_x[i], spheres.center_y[i], spheres.center_z[i]},
+            .radius = spheres.radius[i]};
+         if (gfx::intersects(view_frustum, sphere))
+         {
+            visible.push_back(i);
+         }
+      }
+
+      return visible;
+   }
+
+   std::mt19937 engine{5}; // NOLINT
+
+   const glm::vec3 eye{3.0F, 2.0F, 10.0F};
+   const glm::mat4 perspective = glm::perspective(glm::radians(70.0F), 1.5F, 0.1F, 80.0F);
+   const glm::mat4 view = glm::lookAt(eye, glm::vec3{0.0F}, glm::vec3{0.0F, 1.0F, 0.0F});
+   const gfx::frustum view_frustum = gfx::extract_frustum(perspective * view);
+   const gfx::sphere_projection projection =
+      gfx::make_sphere_projection(view, gfx::projection_scale(perspective, 720.0F)); // NOLINT
+
+   gfx::sphere_soa spheres;
+};
+
+TEST(culling, compute_bounding_sphere)
+{
+   const std::array<gfx::vertex, 3> vertices{{{.position = {-1.0F, 0.0F, 0.0F}},
+                                              {.position = {3.0F, 0.0F, 0.0F}},
+                                              {.position = {1.0F, 1.0F, 0.0F}}}};
+
+   const auto sphere = gfx::compute_bounding_sphere(vertices);
+
+   EXPECT_FLOAT_EQ(sphere.center.x, 1.0F);
+   EXPECT_FLOAT_EQ(sphere.center.y, 0.5F);
+   for (const auto& v : vertices)
+   {
+      EXPECT_LE(glm::length(v.position - sphere.center), sphere.radius + 1e-5F); // NOLINT
+   }
+}
+
+TEST(culling, transform_sphere)
+{
+   const glm::mat4 model = glm::scale(glm::translate(glm::mat4{1.0F}, glm::vec3{1.0F, 2.0F, 3.0F}),
+                                      glm::vec3{1.0F, 4.0F, 2.0F});
+
+   const auto sphere = gfx::transform_sphere({.center = glm::vec3{1.0F}, .radius = 0.5F}, model);
+
+   EXPECT_FLOAT_EQ(sphere.center.x, 2.0F);
+   EXPECT_FLOAT_EQ(sphere.center.y, 6.0F);
+   EXPECT_FLOAT_EQ(sphere.center.z, 5.0F);
+   EXPECT_FLOAT_EQ(sphere.radius, 2.0F); // Scaled by the largest axis
+}
+
+TEST(culling, projection_scale)
+{
+   // A 90 degree field of view covers two units at a depth of one
+   const auto perspective = glm::perspective(glm::radians(90.0F), 1.0F, 0.1F, 10.0F);
+
+   EXPECT_NEAR(gfx::projection_scale(perspective, 1000.0F), 500.0F, 1e-2F); // NOLINT
+}
+
+TEST(culling, select_lod)
+{
+   const std::array<gfx::mesh_lod, 3> lods{
+      {{.first_index = 0, .index_count = 300, .error = 0.0F},
+       {.first_index = 300, .index_count = 150, .error = 0.01F}, // NOLINT
+       {.first_index = 450, .index_count = 75, .error = 0.1F}}}; // NOLINT
+
+   EXPECT_EQ(gfx::select_lod(lods, 5.0F), 2);   // NOLINT
+   EXPECT_EQ(gfx::select_lod(lods, 50.0F), 1);  // NOLINT
+   EXPECT_EQ(gfx::select_lod(lods, 500.0F), 0); // NOLINT
+   EXPECT_EQ(gfx::select_lod(lods, std::numeric_limits<float>::infinity()), 0);
+   EXPECT_EQ(gfx::select_lod(lods, 50.0F, 0.1F), 0); // NOLINT
+   EXPECT_EQ(gfx::select_lod({}, 5.0F), 0);          // NOLINT
+}
+
+TEST_F(culling_test, cull_spheres_matches_intersects)
+{
+   util::dynamic_array<std::uint32_t> visible;
+   gfx::cull_spheres(view_frustum, spheres, visible);
+
+   const auto expected = expected_visible();
+   ASSERT_FALSE(expected.empty());
+   ASSERT_LT(std::size(expected), spheres.size());
+   EXPECT_EQ(visible, expected);
+}
+
+TEST_F(culling_test, every_implementation_matches)
+{
+   const auto expected = expected_visible();
+
+   util::dynamic_array<std::uint32_t> visible;
+   util::dynamic_array<float> projected_radii;
+   gfx::detail::cull_spheres_scalar(view_frustum, nullptr, spheres, 0, visible, projected_radii);
+   EXPECT_EQ(visible, expected);
+   EXPECT_TRUE(projected_radii.empty());
+
+#if defined(__SSE2__) || defined(_M_X64)
+   visible.clear();
+   gfx::detail::cull_spheres_sse(view_frustum, nullptr, spheres, visible, projected_radii);
+   EXPECT_EQ(visible, expected);
+   EXPECT_TRUE(projected_radii.empty());
+#endif
+#if defined(__AVX__)
+   visible.clear();
+   gfx::detail::cull_spheres_avx(view_frustum, nullptr, spheres, visible, projected_radii);
+   EXPECT_EQ(visible, expected);
+   EXPECT_TRUE(projected_radii.empty());
+#endif
+}
+
+TEST_F(culling_test, cull_spheres_projects_visible_spheres)
+{
+   util::dynamic_array<std::uint32_t> visible;
+   util::dynamic_array<float> projected_radii;
+   gfx::cull_spheres(view_frustum, projection, spheres, visible, projected_radii);
+
+   ASSERT_EQ(visible, expected_visible());
+   ASSERT_EQ(std::size(projected_radii), std::size(visible));
+
+   // The same radii as projecting the spheres after culling them, the projection covering 720
+   // pixels over a 70 degree field of view
+   const float scale = 360.0F / std::tan(glm::radians(35.0F)); // NOLINT
+
+   util::dynamic_array<float> expected_radii;
+   gfx::project_spheres(projection, spheres, visible, expected_radii);
+
+   for (std::size_t i = 0; i < std::size(visible); ++i)
+   {
+      const std::uint32_t index = visible[i];
+      if (std::isinf(expected_radii[i]))
+      {
+         EXPECT_TRUE(std::isinf(projected_radii[i])) << index;
+         continue;
+      }
+
+      EXPECT_FLOAT_EQ(projected_radii[i], expected_radii[i]) << index;
+
+      const glm::vec3 center{spheres.center_x[index], spheres.center_y[index],
+                             spheres.center_z[index]};
+      const float depth = -(view * glm::vec4{center, 1.0F}).z;
+      EXPECT_NEAR(projected_radii[i], spheres.radius[index] * scale / depth,
+                  projected_radii[i] * 1e-4F); // NOLINT
+   }
+
+   // The camera is inside of the last sphere
+   ASSERT_EQ(visible.back(), spheres.size() - 1);
+   EXPECT_TRUE(std::isinf(projected_radii.back()));
+}
+
+TEST_F(culling_test, cull_spheres_appends)
+{
+   util::dynamic_array<std::uint32_t> visible;
+   util::dynamic_array<float> projected_radii;
+   visible.push_back(42); // NOLINT
+   projected_radii.push_back(1.0F);
+
+   gfx::cull_spheres(view_frustum, projection, spheres, visible, projected_radii);
+
+   EXPECT_EQ(visible.front(), 42);
+   EXPECT_EQ(projected_radii.front(), 1.0F);
+   EXPECT_EQ(std::size(visible), std::size(projected_radii));
+}
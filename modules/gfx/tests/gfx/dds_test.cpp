@@ -0,0 +1,159 @@
+#include <gfx/dds.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+// Byte offsets of the header fields the tests tamper with, the magic included
+static constexpr std::size_t height_offset = 12;
+static constexpr std::size_t width_offset = 16;
+static constexpr std::size_t header_size = 128 + 20;
+
+static void write_u32(util::dynamic_array<std::byte>& bytes, std::size_t offset,
+                      std::uint32_t value)
+{
+   for (std::size_t i = 0; i < 4; ++i)
+   {
+      bytes[offset + i] = static_cast<std::byte>((value >> (8U * i)) & 0xFFU);
+   }
+}
+
+static auto error_of(const gfx::result<gfx::dds_image>& res) -> std::error_code
+{
+   return res.error().value().value();
+}
+
+struct dds_test : public testing::Test
+{
+   dds_test()
+   {
+      // A 9x6 BC1 image and its full mip chain: 3x2, 2x1 and 1x1 blocks
+      gfx::dds_image image{.format = gfx::texel_format::bc1, .is_srgb = true};
+      for (vk::Extent2D extent{9, 6}; extent.width > 1 || extent.height > 1;
+           extent = {std::max(extent.width / 2, 1U), std::max(extent.height / 2, 1U)})
+      {
+         image.mips.push_back({.extent = extent});
+      }
+      image.mips.push_back({.extent = {1, 1}});
+
+      std::size_t size = 0;
+      for (const auto& mip : image.mips)
+      {
+         size += gfx::image_size(image.format, mip.extent);
+      }
+
+      texels.resize(size);
+      for (std::size_t i = 0; i < std::size(texels); ++i)
+      {
+         texels[i] = static_cast<std::byte>(i * 7); // NOLINT
+      }
+
+      std::size_t offset = 0;
+      for (auto& mip : image.mips)
+      {
+         const std::size_t mip_size = gfx::image_size(image.format, mip.extent);
+         mip.data = std::span{texels}.subspan(offset, mip_size);
+         offset += mip_size;
+      }
+
+      file = gfx::write_dds(image);
+   }
+
+   util::dynamic_array<std::byte> texels;
+   util::dynamic_array<std::byte> file;
+};
+
+TEST_F(dds_test, round_trip)
+{
+   ASSERT_EQ(std::size(file), header_size + std::size(texels));
+
+   auto res = gfx::parse_dds(file);
+   ASSERT_TRUE(res);
+
+   const auto image = std::move(res).value().value();
+   EXPECT_EQ(image.format, gfx::texel_format::bc1);
+   EXPECT_TRUE(image.is_srgb);
+   ASSERT_EQ(std::size(image.mips), 4);
+   EXPECT_EQ(image.mips[0].extent, (vk::Extent2D{9, 6}));
+   EXPECT_EQ(image.mips[3].extent, (vk::Extent2D{1, 1}));
+
+   std::size_t offset = header_size;
+   for (const auto& mip : image.mips)
+   {
+      EXPECT_EQ(std::data(mip.data), std::data(file) + offset);
+      offset += std::size(mip.data);
+   }
+   EXPECT_EQ(offset, std::size(file));
+}
+
+TEST_F(dds_test, truncated_header)
+{
+   for (std::size_t size : {std::size_t{0}, std::size_t{4}, std::size_t{127}, std::size_t{140}})
+   {
+      const auto res = gfx::parse_dds(std::span{file}.first(size));
+
+      ASSERT_FALSE(res);
+      EXPECT_EQ(error_of(res), gfx::make_error(gfx::dds_error::file_too_small).value());
+   }
+}
+
+TEST_F(dds_test, truncated_data)
+{
+   const auto res = gfx::parse_dds(std::span{file}.first(std::size(file) - 1));
+
+   ASSERT_FALSE(res);
+   EXPECT_EQ(error_of(res), gfx::make_error(gfx::dds_error::truncated_data).value());
+}
+
+TEST_F(dds_test, invalid_magic)
+{
+   file[0] = std::byte{'X'};
+
+   const auto res = gfx::parse_dds(file);
+
+   ASSERT_FALSE(res);
+   EXPECT_EQ(error_of(res), gfx::make_error(gfx::dds_error::invalid_magic).value());
+}
+
+TEST_F(dds_test, oversized_extent)
+{
+   // Extents whose block count wraps around in 32 bits must not pass for a tiny image
+   for (std::uint32_t extent : {gfx::max_dds_extent + 1, 0xFFFFFFFDU, 0xFFFFFFFFU})
+   {
+      auto bytes = file;
+      write_u32(bytes, width_offset, extent);
+
+      const auto wide = gfx::parse_dds(bytes);
+      ASSERT_FALSE(wide);
+      EXPECT_EQ(error_of(wide), gfx::make_error(gfx::dds_error::unsupported_dimension).value());
+
+      bytes = file;
+      write_u32(bytes, height_offset, extent);
+
+      const auto tall = gfx::parse_dds(bytes);
+      ASSERT_FALSE(tall);
+      EXPECT_EQ(error_of(tall), gfx::make_error(gfx::dds_error::unsupported_dimension).value());
+   }
+}
+
+TEST_F(dds_test, largest_extent)
+{
+   // The header is accepted, the data of a 16384x16384 image is missing
+   write_u32(file, width_offset, gfx::max_dds_extent);
+   write_u32(file, height_offset, gfx::max_dds_extent);
+
+   const auto res = gfx::parse_dds(file);
+
+   ASSERT_FALSE(res);
+   EXPECT_EQ(error_of(res), gfx::make_error(gfx::dds_error::truncated_data).value());
+}
+
+TEST_F(dds_test, zero_extent)
+{
+   write_u32(file, width_offset, 0);
+
+   const auto res = gfx::parse_dds(file);
+
+   ASSERT_FALSE(res);
+   EXPECT_EQ(error_of(res), gfx::make_error(gfx::dds_error::unsupported_dimension).value());
+}
@@ -0,0 +1,211 @@
+#include <gfx/gltf.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+// A triangle: its positions, its u16 indices padded to 4 bytes, then its normals
+static constexpr std::array<float, 9> positions{0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F,
+                                                0.0F, 1.0F, 0.0F};
+static constexpr std::array<std::uint16_t, 4> indices{0, 1, 2, 0};
+static constexpr std::array<float, 9> normals{0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 1.0F,
+                                              0.0F, 0.0F, 1.0F};
+
+static const std::string positions_accessor =
+   R"({"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3"})";
+static const std::string indices_accessor =
+   R"({"bufferView": 1, "componentType": 5123, "count": 3, "type": "SCALAR"})";
+static const std::string normals_accessor =
+   R"({"bufferView": 2, "componentType": 5126, "count": 3, "type": "VEC3"})";
+
+static const std::string positions_view = R"({"buffer": 0, "byteLength": 36})";
+static const std::string indices_view = R"({"buffer": 0, "byteOffset": 36, "byteLength": 6})";
+static const std::string normals_view = R"({"buffer": 0, "byteOffset": 44, "byteLength": 36})";
+
+static const std::string default_attributes = R"({"POSITION": 0, "NORMAL": 2})";
+
+static auto error_of(const gfx::result<gfx::gltf_scene>& res) -> std::error_code
+{
+   return res.error().value().value();
+}
+
+struct gltf_test : public testing::Test
+{
+   gltf_test() :
+      directory{std::filesystem::temp_directory_path() /
+                ("gltf_test_" + std::to_string(testing::UnitTest::GetInstance()->random_seed()))}
+   {
+      std::filesystem::create_directories(directory);
+
+      std::array<std::byte, sizeof(positions) + sizeof(indices) + sizeof(normals)> bytes{};
+      std::memcpy(std::data(bytes), std::data(positions), sizeof(positions));
+      std::memcpy(std::data(bytes) + sizeof(positions), std::data(indices), sizeof(indices));
+      std::memcpy(std::data(bytes) + sizeof(positions) + sizeof(indices), std::data(normals),
+                  sizeof(normals));
+
+      std::ofstream bin{directory / "mesh.bin", std::ios::binary};
+      bin.write(reinterpret_cast<const char*>(std::data(bytes)), std::size(bytes)); // NOLINT
+   }
+   ~gltf_test() override { std::filesystem::remove_all(directory); }
+
+   struct document
+   {
+      std::array<std::string, 3> accessors{positions_accessor, indices_accessor,
+                                           normals_accessor};
+      std::array<std::string, 3> views{positions_view, indices_view, normals_view};
+      std::string attributes{default_attributes};
+      /**
+       * Meshes listed before the triangle, each followed by a comma
+       */
+      std::string leading_meshes{};
+      std::string nodes{R"([{"mesh": 0}])"};
+   };
+
+   auto import(const document& doc) -> gfx::result<gfx::gltf_scene>
+   {
+      const auto path = directory / "mesh.gltf";
+      std::ofstream{path} << R"({"asset": {"version": "2.0"},)"
+                          << R"("buffers": [{"uri": "mesh.bin", "byteLength": 80}],)"
+                          << R"("bufferViews": [)" << doc.views[0] << ',' << doc.views[1] << ','
+                          << doc.views[2] << "],"
+                          << R"("accessors": [)" << doc.accessors[0] << ','
+                          << doc.accessors[1] << ',' << doc.accessors[2] << "],"
+                          << R"("meshes": [)" << doc.leading_meshes
+                          << R"({"primitives": [{"attributes": )" << doc.attributes
+                          << R"(, "indices": 1}]}],)"
+                          << R"("nodes": )" << doc.nodes << '}';
+
+      return gfx::import_gltf(path, pool, nullptr);
+   }
+
+   void expect_error(const document& doc, gfx::gltf_error err)
+   {
+      const auto res = import(doc);
+
+      ASSERT_FALSE(res);
+      EXPECT_EQ(error_of(res), gfx::make_error(err).value());
+   }
+
+   std::filesystem::path directory;
+   util::thread_pool pool{1};
+};
+
+TEST_F(gltf_test, imports_triangle)
+{
+   auto res = import({});
+   ASSERT_TRUE(res);
+
+   const auto scene = std::move(res).value().value();
+   ASSERT_EQ(std::size(scene.meshes), 1);
+   ASSERT_EQ(std::size(scene.instances), 1);
+   EXPECT_EQ(std::size(scene.meshes[0].vertices), 3);
+   ASSERT_FALSE(scene.meshes[0].lods.empty());
+   EXPECT_EQ(scene.meshes[0].lods[0].index_count, 3);
+
+   // Shaded by the normal, mapped from [-1, 1] to [0, 1]
+   for (const auto& v : scene.meshes[0].vertices)
+   {
+      EXPECT_FLOAT_EQ(v.colour.z, 1.0F);
+   }
+}
+
+TEST_F(gltf_test, normal_must_be_vec3)
+{
+   for (const char* type : {"SCALAR", "VEC2"})
+   {
+      document doc;
+      doc.accessors[2] = R"({"bufferView": 2, "componentType": 5126, "count": 3, "type": ")" +
+         std::string{type} + R"("})";
+
+      expect_error(doc, gfx::gltf_error::invalid_accessor);
+   }
+}
+
+TEST_F(gltf_test, colour_must_be_vec3_or_vec4)
+{
+   document doc;
+   doc.attributes = R"({"POSITION": 0, "COLOR_0": 2})";
+   doc.accessors[2] = R"({"bufferView": 2, "componentType": 5126, "count": 3, "type": "VEC2"})";
+   expect_error(doc, gfx::gltf_error::invalid_accessor);
+
+   doc.accessors[2] = R"({"bufferView": 2, "componentType": 5121, "count": 3, "type": "VEC4",
+                          "normalized": true})";
+   EXPECT_TRUE(import(doc));
+}
+
+TEST_F(gltf_test, count_beyond_view)
+{
+   for (const char* count : {"4", "18446744073709551615"})
+   {
+      document doc;
+      doc.accessors[0] = R"({"bufferView": 0, "componentType": 5126, "type": "VEC3", "count": )" +
+         std::string{count} + "}";
+      expect_error(doc, gfx::gltf_error::invalid_accessor);
+
+      doc = {};
+      doc.accessors[1] =
+         R"({"bufferView": 1, "componentType": 5123, "type": "SCALAR", "count": )" +
+         std::string{count} + "}";
+      expect_error(doc, gfx::gltf_error::invalid_accessor);
+   }
+}
+
+TEST_F(gltf_test, offsets_must_not_wrap_around)
+{
+   document doc;
+   doc.views[0] = R"({"buffer": 0, "byteOffset": 18446744073709551608, "byteLength": 36})";
+   expect_error(doc, gfx::gltf_error::invalid_buffer_view);
+
+   doc = {};
+   doc.views[0] = R"({"buffer": 0, "byteLength": 18446744073709551615})";
+   expect_error(doc, gfx::gltf_error::invalid_buffer_view);
+
+   doc = {};
+   doc.accessors[0] = R"({"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3",
+                          "byteOffset": 18446744073709551608})";
+   expect_error(doc, gfx::gltf_error::invalid_accessor);
+}
+
+TEST_F(gltf_test, stride_must_not_wrap_around)
+{
+   // Two strides of 2^63 wrap around to 0 and would fit in the view
+   document doc;
+   doc.views[0] = R"({"buffer": 0, "byteLength": 36, "byteStride": 9223372036854775808})";
+   expect_error(doc, gfx::gltf_error::invalid_accessor);
+
+   doc.views[0] = R"({"buffer": 0, "byteLength": 36, "byteStride": 4})";
+   expect_error(doc, gfx::gltf_error::invalid_buffer_view);
+}
+
+TEST_F(gltf_test, normalized_must_be_boolean)
+{
+   document doc;
+   doc.accessors[2] = R"({"bufferView": 2, "componentType": 5126, "count": 3, "type": "VEC3",
+                          "normalized": "yes"})";
+
+   EXPECT_TRUE(import(doc));
+}
+
+TEST_F(gltf_test, drops_meshes_without_triangles)
+{
+   // A mesh of points, placed once, before the triangle placed twice
+   document doc;
+   doc.leading_meshes = R"({"primitives": [{"attributes": {"POSITION": 0}, "mode": 0}]},)";
+   doc.nodes = R"([{"mesh": 1}, {"mesh": 0}, {"mesh": 1}])";
+
+   auto res = import(doc);
+   ASSERT_TRUE(res);
+
+   const auto scene = std::move(res).value().value();
+   ASSERT_EQ(std::size(scene.meshes), 1);
+   EXPECT_EQ(std::size(scene.meshes[0].vertices), 3);
+
+   ASSERT_EQ(std::size(scene.instances), 2);
+   for (const auto& instance : scene.instances)
+   {
+      EXPECT_EQ(instance.mesh, 0);
+   }
+}
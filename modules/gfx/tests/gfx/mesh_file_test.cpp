@@ -0,0 +1,202 @@
+#include <gfx/mesh_file.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <string>
+
+// Offsets of the header fields, the LOD table follows the 80 byte header
+static constexpr std::size_t version_offset = 4;
+static constexpr std::size_t vertex_offset_offset = 64;
+static constexpr std::size_t lod_table_offset = 80;
+
+struct mesh_file_test : public testing::Test
+{
+   mesh_file_test() :
+      directory{std::filesystem::temp_directory_path() /
+                ("mesh_file_test_" +
+                 std::to_string(testing::UnitTest::GetInstance()->random_seed()))},
+      path{directory / "mesh.vmsh"}
+   {
+      std::filesystem::create_directories(directory);
+   }
+   ~mesh_file_test() override { std::filesystem::remove_all(directory); }
+
+   [[nodiscard]] auto write(gfx::vertex_layout layout = gfx::vertex_layout::position_colour) const
+      -> bool
+   {
+      return gfx::write_mesh_file(path, vertices, indices, lods, layout);
+   }
+
+   template <class any_>
+   [[nodiscard]] auto read(std::size_t offset) const -> any_
+   {
+      any_ value{};
+      std::ifstream stream{path, std::ios::binary};
+      stream.seekg(static_cast<std::streamoff>(offset));
+      stream.read(reinterpret_cast<char*>(&value), sizeof(value)); // NOLINT
+
+      return value;
+   }
+
+   /**
+    * Overwrite the bytes of the written file at the offset
+    */
+   template <class any_>
+   void patch(std::size_t offset, const any_& value) const
+   {
+      std::fstream stream{path, std::ios::binary | std::ios::in | std::ios::out};
+      stream.seekp(static_cast<std::streamoff>(offset));
+      stream.write(reinterpret_cast<const char*>(&value), sizeof(value)); // NOLINT
+   }
+
+   void expect_error(gfx::mesh_file_error err) const
+   {
+      const auto res = gfx::mesh_file::open(path);
+
+      ASSERT_FALSE(res);
+      EXPECT_EQ(res.error().value().value(), gfx::make_error(err).value());
+   }
+
+   std::filesystem::path directory;
+   std::filesystem::path path;
+
+   // A quad, then a coarser level of a single triangle
+   const std::array<gfx::vertex, 4> vertices{
+      {{.position = {-1.0F, -2.0F, 0.0F}, .colour = {1.0F, 0.0F, 0.0F}},
+       {.position = {3.0F, -2.0F, 5.0F}, .colour = {0.0F, 1.0F, 0.0F}},
+       {.position = {-1.0F, 4.0F, 0.0F}, .colour = {0.0F, 0.0F, 1.0F}},
+       {.position = {3.0F, 4.0F, 5.0F}, .colour = {1.0F, 1.0F, 1.0F}}}};
+   const std::array<std::uint32_t, 9> indices{0, 1, 2, 2, 1, 3, 0, 1, 3};
+   const std::array<gfx::mesh_lod, 2> lods{{{.first_index = 0, .index_count = 6, .error = 0.0F},
+                                            {.first_index = 6, .index_count = 3, .error = 0.5F}}};
+};
+
+TEST_F(mesh_file_test, round_trip)
+{
+   ASSERT_TRUE(write());
+
+   auto res = gfx::mesh_file::open(path);
+   ASSERT_TRUE(res);
+
+   const auto mesh = std::move(res).value().value();
+   EXPECT_EQ(mesh.layout(), gfx::vertex_layout::position_colour);
+   EXPECT_EQ(mesh.bounds().min, glm::vec3(-1.0F, -2.0F, 0.0F));
+   EXPECT_EQ(mesh.bounds().max, glm::vec3(3.0F, 4.0F, 5.0F));
+
+   ASSERT_EQ(mesh.vertex_count(), std::size(vertices));
+   ASSERT_EQ(std::size(mesh.vertices()), std::size(vertices));
+   for (std::size_t i = 0; i < std::size(vertices); ++i)
+   {
+      EXPECT_EQ(mesh.vertices()[i].position, vertices[i].position);
+      EXPECT_EQ(mesh.vertices()[i].colour, vertices[i].colour);
+   }
+
+   EXPECT_TRUE(std::equal(std::begin(mesh.indices()), std::end(mesh.indices()),
+                          std::begin(indices), std::end(indices)));
+
+   ASSERT_EQ(std::size(mesh.lods()), std::size(lods));
+   for (std::size_t i = 0; i < std::size(lods); ++i)
+   {
+      EXPECT_EQ(mesh.lods()[i].first_index, lods[i].first_index);
+      EXPECT_EQ(mesh.lods()[i].index_count, lods[i].index_count);
+      EXPECT_EQ(mesh.lods()[i].error, lods[i].error);
+   }
+}
+
+TEST_F(mesh_file_test, round_trip_compact)
+{
+   ASSERT_TRUE(write(gfx::vertex_layout::compact));
+
+   auto res = gfx::mesh_file::open(path);
+   ASSERT_TRUE(res);
+
+   const auto mesh = std::move(res).value().value();
+   EXPECT_EQ(mesh.layout(), gfx::vertex_layout::compact);
+   EXPECT_EQ(mesh.vertex_count(), std::size(vertices));
+
+   // Packed 12 bytes per vertex, so they can't be viewed as gfx::vertex
+   const auto packed = gfx::pack_vertices(gfx::vertex_layout::compact, vertices);
+   ASSERT_EQ(std::size(mesh.vertex_data()),
+             std::size(vertices) * gfx::vertex_stride(gfx::vertex_layout::compact));
+   EXPECT_TRUE(std::equal(std::begin(mesh.vertex_data()), std::end(mesh.vertex_data()),
+                          std::begin(packed), std::end(packed)));
+   EXPECT_TRUE(mesh.vertices().empty());
+
+   EXPECT_EQ(std::size(mesh.indices()), std::size(indices));
+   EXPECT_EQ(std::size(mesh.lods()), std::size(lods));
+}
+
+TEST_F(mesh_file_test, single_lod_by_default)
+{
+   ASSERT_TRUE(gfx::write_mesh_file(path, vertices, indices));
+
+   auto res = gfx::mesh_file::open(path);
+   ASSERT_TRUE(res);
+
+   const auto mesh = std::move(res).value().value();
+   ASSERT_EQ(std::size(mesh.lods()), 1);
+   EXPECT_EQ(mesh.lods()[0].first_index, 0);
+   EXPECT_EQ(mesh.lods()[0].index_count, std::size(indices));
+}
+
+TEST_F(mesh_file_test, missing_file)
+{
+   expect_error(gfx::mesh_file_error::failed_to_map_file);
+}
+
+TEST_F(mesh_file_test, invalid_magic)
+{
+   ASSERT_TRUE(write());
+   patch(0, std::uint32_t{0x4654'6C67}); // NOLINT
+
+   expect_error(gfx::mesh_file_error::invalid_magic);
+}
+
+TEST_F(mesh_file_test, unsupported_version)
+{
+   ASSERT_TRUE(write());
+   patch(version_offset, gfx::mesh_file::version + 1);
+
+   expect_error(gfx::mesh_file_error::unsupported_version);
+}
+
+TEST_F(mesh_file_test, truncated_payload)
+{
+   ASSERT_TRUE(write());
+   std::filesystem::resize_file(path, std::filesystem::file_size(path) - sizeof(std::uint32_t));
+
+   expect_error(gfx::mesh_file_error::truncated_data);
+
+   std::filesystem::resize_file(path, lod_table_offset / 2);
+
+   expect_error(gfx::mesh_file_error::truncated_data);
+}
+
+TEST_F(mesh_file_test, misaligned_offset)
+{
+   ASSERT_TRUE(write());
+   patch(vertex_offset_offset, read<std::uint64_t>(vertex_offset_offset) + 4);
+
+   expect_error(gfx::mesh_file_error::truncated_data);
+}
+
+TEST_F(mesh_file_test, lod_out_of_range)
+{
+   ASSERT_TRUE(write());
+
+   // The second level ends one index past the end
+   patch(lod_table_offset + sizeof(gfx::mesh_lod) + sizeof(std::uint32_t), std::uint32_t{4});
+
+   expect_error(gfx::mesh_file_error::truncated_data);
+}
+
+TEST_F(mesh_file_test, index_out_of_range)
+{
+   const std::array<std::uint32_t, 3> out_of_range{0, 1, 4};
+   ASSERT_TRUE(gfx::write_mesh_file(path, vertices, out_of_range));
+
+   expect_error(gfx::mesh_file_error::invalid_index);
+}
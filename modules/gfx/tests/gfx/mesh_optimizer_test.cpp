@@ -0,0 +1,176 @@
+#include <gfx/mesh_optimizer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+using triangle = std::array<std::uint32_t, 3>;
+
+static constexpr std::uint32_t grid_size = 64;
+
+/**
+ * A grid of quads with its triangles in a random order, the worst case for the vertex cache
+ */
+static auto make_shuffled_grid() -> util::dynamic_array<std::uint32_t>
+{
+   util::dynamic_array<triangle> triangles;
+   for (std::uint32_t y = 0; y < grid_size; ++y)
+   {
+      for (std::uint32_t x = 0; x < grid_size; ++x)
+      {
+         const std::uint32_t v = y * (grid_size + 1) + x;
+         triangles.push_back({v, v + 1, v + grid_size + 1});
+         triangles.push_back({v + 1, v + grid_size + 2, v + grid_size + 1});
+      }
+   }
+
+   std::mt19937 engine{11}; // NOLINT
+   std::shuffle(std::data(triangles), std::data(triangles) + std::size(triangles), engine);
+
+   util::dynamic_array<std::uint32_t> indices;
+   for (const auto& t : triangles)
+   {
+      for (const std::uint32_t index : t)
+      {
+         indices.push_back(index);
+      }
+   }
+
+   return indices;
+}
+
+/**
+ * The triangles of an index list, each rotated to start with its smallest index so the
+ * winding is kept, then sorted
+ */
+static auto sorted_triangles(std::span<const std::uint32_t> indices)
+   -> util::dynamic_array<triangle>
+{
+   util::dynamic_array<triangle> triangles;
+   for (std::size_t i = 0; i < std::size(indices); i += 3)
+   {
+      triangle t{indices[i], indices[i + 1], indices[i + 2]};
+      std::rotate(std::begin(t), std::min_element(std::begin(t), std::end(t)), std::end(t));
+      triangles.push_back(t);
+   }
+
+   std::sort(std::begin(triangles), std::end(triangles));
+
+   return triangles;
+}
+
+TEST(mesh_optimizer, analyze_vertex_cache)
+{
+   const std::array<std::uint32_t, 6> quad{0, 1, 2, 1, 3, 2};
+   EXPECT_FLOAT_EQ(gfx::analyze_vertex_cache(quad, 4), 2.0F);
+
+   // Every vertex is evicted before it is used again
+   const std::array<std::uint32_t, 9> strip{0, 1, 2, 3, 4, 5, 0, 1, 2};
+   EXPECT_FLOAT_EQ(gfx::analyze_vertex_cache(strip, 6, 4), 3.0F);
+
+   EXPECT_FLOAT_EQ(gfx::analyze_vertex_cache({}, 0), 0.0F);
+}
+
+TEST(mesh_optimizer, optimize_vertex_cache_lowers_acmr)
+{
+   constexpr std::size_t vertex_count = (grid_size + 1) * (grid_size + 1);
+
+   auto indices = make_shuffled_grid();
+   const auto original = sorted_triangles(indices);
+
+   const float before = gfx::analyze_vertex_cache(indices, vertex_count);
+   gfx::optimize_vertex_cache(indices, vertex_count);
+   const float after = gfx::analyze_vertex_cache(indices, vertex_count);
+
+   // A shuffled grid misses on nearly every corner, Tipsify gets close to one vertex per
+   // triangle on a 16 entry cache
+   EXPECT_GT(before, 2.5F);
+   EXPECT_LT(after, 0.8F);
+
+   // The same triangles are drawn, with the same winding
+   EXPECT_EQ(sorted_triangles(indices), original);
+}
+
+TEST(mesh_optimizer, larger_cache_lowers_acmr)
+{
+   constexpr std::size_t vertex_count = (grid_size + 1) * (grid_size + 1);
+
+   auto small = make_shuffled_grid();
+   gfx::optimize_vertex_cache(small, vertex_count, 8);
+
+   auto large = make_shuffled_grid();
+   gfx::optimize_vertex_cache(large, vertex_count, 32);
+
+   EXPECT_LE(gfx::analyze_vertex_cache(large, vertex_count, 32),
+             gfx::analyze_vertex_cache(small, vertex_count, 8));
+}
+
+TEST(mesh_optimizer, optimize_mesh_keeps_triangles)
+{
+   util::dynamic_array<gfx::vertex> vertices;
+   for (std::uint32_t y = 0; y <= grid_size; ++y)
+   {
+      for (std::uint32_t x = 0; x <= grid_size; ++x)
+      {
+         vertices.push_back({.position = {static_cast<float>(x), static_cast<float>(y), 0.0F},
+                             .colour = glm::vec3{1.0F}});
+      }
+   }
+
+   auto indices = make_shuffled_grid();
+   const float before = gfx::analyze_vertex_cache(indices, std::size(vertices));
+
+   // Compare the triangles by their positions, the vertices are reordered
+   const auto positions = [](std::span<const gfx::vertex> vs,
+                             std::span<const std::uint32_t> is) {
+      util::dynamic_array<std::array<float, 6>> triangles;
+      for (std::size_t i = 0; i < std::size(is); i += 3)
+      {
+         std::array<std::array<float, 2>, 3> corners{};
+         for (std::size_t c = 0; c < 3; ++c)
+         {
+            corners[c] = {vs[is[i + c]].position.x, vs[is[i + c]].position.y};
+         }
+         const auto first = std::min_element(std::begin(corners), std::end(corners));
+         std::rotate(std::begin(corners), first, std::end(corners));
+
+         triangles.push_back({corners[0][0], corners[0][1], corners[1][0], corners[1][1],
+                              corners[2][0], corners[2][1]});
+      }
+
+      std::sort(std::begin(triangles), std::end(triangles));
+      return triangles;
+   };
+
+   const auto original = positions(vertices, indices);
+   gfx::optimize_mesh(vertices, indices);
+
+   EXPECT_EQ(positions(vertices, indices), original);
+   EXPECT_LT(gfx::analyze_vertex_cache(indices, std::size(vertices)), before);
+
+   // The vertex fetch pass stores the vertices in the order they are first referenced
+   std::uint32_t next = 0;
+   for (const std::uint32_t index : indices)
+   {
+      ASSERT_LE(index, next);
+      next = std::max(next, index + 1);
+   }
+   EXPECT_EQ(next, std::size(vertices));
+}
+
+TEST(mesh_optimizer, deduplicate_vertices)
+{
+   util::dynamic_array<gfx::vertex> vertices{
+      {.position = {0.0F, 0.0F, 0.0F}, .colour = glm::vec3{1.0F}},
+      {.position = {1.0F, 0.0F, 0.0F}, .colour = glm::vec3{1.0F}},
+      {.position = {0.0F, 0.0F, 0.0F}, .colour = glm::vec3{1.0F}},
+      {.position = {0.0F, 0.0F, 0.0F}, .colour = glm::vec3{0.0F}}};
+   std::array<std::uint32_t, 6> indices{0, 1, 2, 2, 3, 1};
+
+   gfx::deduplicate_vertices(vertices, indices);
+
+   ASSERT_EQ(std::size(vertices), 3);
+   EXPECT_EQ(indices, (std::array<std::uint32_t, 6>{0, 1, 0, 0, 2, 1}));
+}
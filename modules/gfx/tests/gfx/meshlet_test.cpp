@@ -0,0 +1,250 @@
+#include <gfx/meshlet.hpp>
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+
+/**
+ * Check that a viewpoint the cone of the meshlet rejects sees all its triangles from behind.
+ * Return whether the viewpoint was rejected
+ */
+static auto expect_backfacing_if_rejected(const gfx::meshlet& m, const glm::vec3& viewpoint,
+                                          std::span<const gfx::vertex> vertices,
+                                          std::span<const std::uint32_t> indices) -> bool
+{
+   const glm::vec3 offset = m.bounds.center - viewpoint;
+   if (glm::dot(offset, m.cone_axis) < m.cone_cutoff * glm::length(offset) + m.bounds.radius)
+   {
+      return false;
+   }
+
+   for (std::uint32_t t = m.first_index; t < m.first_index + m.index_count; t += 3)
+   {
+      const glm::vec3 p0 = vertices[indices[t]].position;
+      const glm::vec3 normal = glm::cross(vertices[indices[t + 1]].position - p0,
+                                          vertices[indices[t + 2]].position - p0);
+
+      EXPECT_LE(glm::dot(normal, viewpoint - p0), 1e-5F) << t; // NOLINT
+   }
+
+   return true;
+}
+
+struct meshlet_test : public testing::Test
+{
+   meshlet_test()
+   {
+      // A UV sphere of radius 1, its triangles wound counter clockwise seen from outside
+      constexpr std::uint32_t rings = 24;
+      constexpr std::uint32_t segments = 48;
+      for (std::uint32_t r = 0; r <= rings; ++r)
+      {
+         const float theta = std::numbers::pi_v<float> * static_cast<float>(r) / rings;
+         for (std::uint32_t s = 0; s <= segments; ++s)
+         {
+            const float phi = 2.0F * std::numbers::pi_v<float> * static_cast<float>(s) / segments;
+            vertices.push_back({.position = {std::sin(theta) * std::cos(phi), std::cos(theta),
+                                             -std::sin(theta) * std::sin(phi)},
+                                .colour = glm::vec3{1.0F}});
+         }
+      }
+
+      for (std::uint32_t r = 0; r < rings; ++r)
+      {
+         for (std::uint32_t s = 0; s < segments; ++s)
+         {
+            const std::uint32_t v = r * (segments + 1) + s;
+            const std::uint32_t below = v + segments + 1;
+            if (r != 0)
+            {
+               push_triangle(v, below, v + 1);
+            }
+            if (r != rings - 1)
+            {
+               push_triangle(v + 1, below, below + 1);
+            }
+         }
+      }
+   }
+
+   /**
+    * Check the meshlets cover the indices in order and respect the limits
+    */
+   void expect_valid(const util::dynamic_array<gfx::meshlet>& meshlets, std::size_t max_vertices,
+                     std::size_t max_triangles) const
+   {
+      std::uint32_t next_index = 0;
+      for (const auto& m : meshlets)
+      {
+         EXPECT_EQ(m.first_index, next_index);
+         EXPECT_EQ(m.index_count % 3, 0);
+         EXPECT_GT(m.index_count, 0);
+         EXPECT_LE(m.index_count / 3, max_triangles);
+
+         util::dynamic_array<std::uint32_t> unique(std::begin(indices) + m.first_index,
+                                                   std::begin(indices) + m.first_index +
+                                                      m.index_count);
+         std::sort(std::begin(unique), std::end(unique));
+         const auto count = static_cast<std::size_t>(
+            std::unique(std::begin(unique), std::end(unique)) - std::begin(unique));
+
+         EXPECT_EQ(m.vertex_count, count);
+         EXPECT_LE(m.vertex_count, max_vertices);
+
+         for (std::uint32_t i = m.first_index; i < m.first_index + m.index_count; ++i)
+         {
+            EXPECT_LE(glm::length(vertices[indices[i]].position - m.bounds.center),
+                      m.bounds.radius + 1e-5F); // NOLINT
+         }
+
+         next_index += m.index_count;
+      }
+
+      EXPECT_EQ(next_index, std::size(indices));
+   }
+
+   void push_triangle(std::uint32_t a, std::uint32_t b, std::uint32_t c)
+   {
+      indices.push_back(a);
+      indices.push_back(b);
+      indices.push_back(c);
+   }
+
+   std::mt19937 engine{13}; // NOLINT
+
+   util::dynamic_array<gfx::vertex> vertices;
+   util::dynamic_array<std::uint32_t> indices;
+};
+
+TEST_F(meshlet_test, default_limits)
+{
+   const auto meshlets = gfx::build_meshlets(indices, vertices);
+
+   ASSERT_GT(std::size(meshlets), 1);
+   expect_valid(meshlets, gfx::max_meshlet_vertices, gfx::max_meshlet_triangles);
+}
+
+TEST_F(meshlet_test, small_limits)
+{
+   for (const auto [max_vertices, max_triangles] :
+        {std::pair<std::size_t, std::size_t>{3, 1}, {4, 2}, {16, 64}, {64, 8}})
+   {
+      const auto meshlets = gfx::build_meshlets(indices, vertices, max_vertices, max_triangles);
+
+      expect_valid(meshlets, max_vertices, max_triangles);
+   }
+}
+
+TEST_F(meshlet_test, repeated_vertices_count_once)
+{
+   // Degenerate triangles must not count their repeated vertex twice against the limit
+   const std::array<std::uint32_t, 6> degenerate{0, 0, 1, 1, 2, 2};
+
+   const auto meshlets = gfx::build_meshlets(degenerate, vertices, 3, 2);
+
+   ASSERT_EQ(std::size(meshlets), 1);
+   EXPECT_EQ(meshlets[0].vertex_count, 3);
+   EXPECT_EQ(meshlets[0].index_count, 6);
+}
+
+TEST_F(meshlet_test, empty_input)
+{
+   EXPECT_TRUE(gfx::build_meshlets({}, vertices).empty());
+   EXPECT_TRUE(gfx::build_meshlets(std::span{indices}.first(2), vertices).empty());
+}
+
+TEST_F(meshlet_test, cones_are_conservative)
+{
+   const auto meshlets = gfx::build_meshlets(indices, vertices);
+
+   std::size_t rejected_count = 0;
+   std::uniform_real_distribution<float> position{-4.0F, 4.0F}; // NOLINT
+   for (int i = 0; i < 200; ++i)                                 // NOLINT
+   {
+      const glm::vec3 viewpoint{position(engine), position(engine), position(engine)};
+      for (const auto& m : meshlets)
+      {
+         rejected_count += expect_backfacing_if_rejected(m, viewpoint, vertices, indices) ? 1 : 0;
+      }
+   }
+
+   // The cones of a finely tessellated sphere are narrow enough to reject meshlets
+   EXPECT_GT(rejected_count, 0);
+}
+
+TEST(meshlet, cones_cover_every_triangle)
+{
+   // A strip facing +z whose last triangles are tilted by 60 degrees, past the first
+   // max_meshlet_triangles triangles of the meshlet
+   constexpr std::uint32_t flat_count = gfx::max_meshlet_triangles + 6;
+   constexpr std::uint32_t triangle_count = flat_count + 20;
+
+   util::dynamic_array<gfx::vertex> vertices;
+   util::dynamic_array<std::uint32_t> indices;
+   for (std::uint32_t i = 0; i < triangle_count; ++i)
+   {
+      const auto x = static_cast<float>(i);
+      const glm::vec3 top = i < flat_count ? glm::vec3{x, 1.0F, 0.0F}
+                                           : glm::vec3{x, 0.5F, std::sqrt(3.0F) * 0.5F};
+
+      for (const glm::vec3& position : {glm::vec3{x, 0.0F, 0.0F}, glm::vec3{x + 1, 0.0F, 0.0F},
+                                        top})
+      {
+         indices.push_back(static_cast<std::uint32_t>(std::size(vertices)));
+         vertices.push_back({.position = position, .colour = glm::vec3{1.0F}});
+      }
+   }
+
+   const auto meshlets = gfx::build_meshlets(indices, vertices, 1024, 1024); // NOLINT
+   ASSERT_EQ(std::size(meshlets), 1);
+   ASSERT_LT(meshlets[0].cone_cutoff, 1.0F);
+
+   // Far below the strip, where the tilted triangles are seen from the front
+   std::size_t rejected_count = 0;
+   for (float z = -10.0F; z >= -1000.0F; z *= 2.0F) // NOLINT
+   {
+      for (float y = -1000.0F; y <= 1000.0F; y += 100.0F) // NOLINT
+      {
+         const glm::vec3 viewpoint{static_cast<float>(triangle_count) * 0.5F, y, z};
+         rejected_count +=
+            expect_backfacing_if_rejected(meshlets[0], viewpoint, vertices, indices) ? 1 : 0;
+      }
+   }
+
+   EXPECT_GT(rejected_count, 0);
+}
+
+TEST_F(meshlet_test, cull_meshlets_matches_scalar)
+{
+   const auto meshlets = gfx::build_meshlets(indices, vertices, 16, 16); // NOLINT
+
+   gfx::meshlet_soa soa;
+   for (const auto& m : meshlets)
+   {
+      soa.push_back(m);
+   }
+
+   const auto projection = glm::perspective(glm::radians(60.0F), 1.0F, 0.1F, 20.0F); // NOLINT
+
+   std::uniform_real_distribution<float> position{-4.0F, 4.0F}; // NOLINT
+   for (int i = 0; i < 50; ++i)                                  // NOLINT
+   {
+      const glm::vec3 eye{position(engine), position(engine), position(engine)};
+      const auto frustum = gfx::extract_frustum(
+         projection * glm::lookAt(eye, glm::vec3{0.0F}, glm::vec3{0.0F, 1.0F, 0.0F}));
+
+      util::dynamic_array<std::uint32_t> expected;
+      gfx::detail::cull_meshlets_scalar(frustum, eye, soa, 0, expected);
+
+      util::dynamic_array<std::uint32_t> visible;
+      gfx::cull_meshlets(frustum, eye, soa, visible);
+
+      EXPECT_EQ(visible, expected);
+      EXPECT_LT(std::size(visible), std::size(meshlets));
+   }
+}
@@ -0,0 +1,96 @@
+#include <gfx/vertex_layout.hpp>
+
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cmath>
+#include <limits>
+
+static constexpr std::uint16_t half_max = 0x7BFF;
+static constexpr std::uint16_t half_infinity = 0x7C00;
+static constexpr std::uint16_t half_sign = 0x8000;
+
+TEST(vertex_layout, to_half_exact_values)
+{
+   EXPECT_EQ(gfx::to_half(0.0F), 0x0000);
+   EXPECT_EQ(gfx::to_half(-0.0F), half_sign);
+   EXPECT_EQ(gfx::to_half(1.0F), 0x3C00);
+   EXPECT_EQ(gfx::to_half(-2.0F), 0xC000);
+   EXPECT_EQ(gfx::to_half(0.5F), 0x3800);
+}
+
+TEST(vertex_layout, to_half_largest_value)
+{
+   EXPECT_EQ(gfx::to_half(65504.0F), half_max);              // NOLINT
+   EXPECT_EQ(gfx::to_half(-65504.0F), half_max | half_sign); // NOLINT
+
+   // Values below the halfway point to the next exponent still round down to the largest half
+   EXPECT_EQ(gfx::to_half(65519.0F), half_max);                // NOLINT
+   EXPECT_EQ(gfx::to_half(65520.0F), half_infinity);           // NOLINT
+   EXPECT_EQ(gfx::to_half(1e10F), half_infinity);              // NOLINT
+   EXPECT_EQ(gfx::to_half(-1e10F), half_infinity | half_sign); // NOLINT
+}
+
+TEST(vertex_layout, to_half_rounds_ties_to_even)
+{
+   // The spacing of halves in [1, 2) is 2^-10
+   EXPECT_EQ(gfx::to_half(1.0F + 0x1.0p-11F), 0x3C00);
+   EXPECT_EQ(gfx::to_half(1.0F + 0x3.0p-11F), 0x3C02);
+   EXPECT_EQ(gfx::to_half(1.0F + 0x1.8p-11F), 0x3C01);
+}
+
+TEST(vertex_layout, to_half_denormals)
+{
+   EXPECT_EQ(gfx::to_half(0x1.0p-14F), 0x0400);   // Smallest normal
+   EXPECT_EQ(gfx::to_half(0x1.FF8p-15F), 0x03FF); // Largest denormal
+   EXPECT_EQ(gfx::to_half(0x1.0p-24F), 0x0001);   // Smallest denormal
+   EXPECT_EQ(gfx::to_half(-0x1.0p-24F), 0x0001 | half_sign);
+
+   // Half the smallest denormal is a tie and rounds to zero, anything above it rounds up
+   EXPECT_EQ(gfx::to_half(0x1.0p-25F), 0x0000);
+   EXPECT_EQ(gfx::to_half(0x1.8p-25F), 0x0001);
+   EXPECT_EQ(gfx::to_half(0x1.0p-30F), 0x0000);
+   EXPECT_EQ(gfx::to_half(std::numeric_limits<float>::denorm_min()), 0x0000);
+}
+
+TEST(vertex_layout, to_half_infinities_and_nans)
+{
+   EXPECT_EQ(gfx::to_half(std::numeric_limits<float>::infinity()), half_infinity);
+   EXPECT_EQ(gfx::to_half(-std::numeric_limits<float>::infinity()), half_infinity | half_sign);
+
+   // NaNs must not collapse to infinities when their payload is lost
+   const std::uint16_t nan = gfx::to_half(std::numeric_limits<float>::quiet_NaN());
+   EXPECT_EQ(nan & half_infinity, half_infinity);
+   EXPECT_NE(nan & 0x03FFU, 0);
+   EXPECT_NE(gfx::to_half(std::bit_cast<float>(0x7F80'0001U)) & 0x03FFU, 0);
+}
+
+TEST(vertex_layout, from_half)
+{
+   EXPECT_EQ(gfx::from_half(half_max), 65504.0F);
+   EXPECT_EQ(gfx::from_half(0x0001), 0x1.0p-24F);
+   EXPECT_EQ(gfx::from_half(0x03FF), 0x1.FF8p-15F);
+   EXPECT_EQ(gfx::from_half(0x0400), 0x1.0p-14F);
+   EXPECT_EQ(gfx::from_half(half_infinity), std::numeric_limits<float>::infinity());
+   EXPECT_EQ(gfx::from_half(half_infinity | half_sign), -std::numeric_limits<float>::infinity());
+   EXPECT_TRUE(std::isnan(gfx::from_half(0x7E00)));
+   EXPECT_TRUE(std::signbit(gfx::from_half(half_sign)));
+}
+
+TEST(vertex_layout, every_half_round_trips)
+{
+   for (std::uint32_t i = 0; i <= 0xFFFFU; ++i)
+   {
+      const auto half = static_cast<std::uint16_t>(i);
+      const float value = gfx::from_half(half);
+
+      if (std::isnan(value))
+      {
+         EXPECT_TRUE(std::isnan(gfx::from_half(gfx::to_half(value)))) << i;
+      }
+      else
+      {
+         ASSERT_EQ(gfx::to_half(value), half) << i;
+      }
+   }
+}
@@ -0,0 +1,146 @@
+#include <util/random_keys.hpp>
+
+#include <util/containers/dense_hash_map.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace
+{
+   // Sizes up to 64 keep their nodes in the inline buffer, larger ones move to the heap
+   using small_map = util::small_dense_hash_map<std::uint64_t, std::uint64_t, 64>;
+   using heap_map = util::dense_hash_map<std::uint64_t, std::uint64_t>;
+   using std_map = std::unordered_map<std::uint64_t, std::uint64_t>;
+
+   template <class map_>
+   auto make_filled(std::size_t count) -> map_
+   {
+      map_ map;
+      for (auto key : bench::random_keys(count))
+      {
+         map.insert({key, key});
+      }
+
+      return map;
+   }
+
+   template <class map_>
+   void insert(benchmark::State& state)
+   {
+      const auto keys = bench::random_keys(static_cast<std::size_t>(state.range(0)));
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         map_ map;
+         for (auto key : keys)
+         {
+            map.insert({key, key});
+         }
+
+         benchmark::DoNotOptimize(map);
+         benchmark::ClobberMemory();
+      }
+
+      state.SetItemsProcessed(state.iterations() * state.range(0));
+   }
+
+   template <class map_>
+   void find_hit(benchmark::State& state)
+   {
+      const auto count = static_cast<std::size_t>(state.range(0));
+      const auto map = make_filled<map_>(count);
+      const auto keys = bench::random_keys(count);
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         for (auto key : keys)
+         {
+            benchmark::DoNotOptimize(map.find(key));
+         }
+      }
+
+      state.SetItemsProcessed(state.iterations() * state.range(0));
+   }
+
+   template <class map_>
+   void find_miss(benchmark::State& state)
+   {
+      const auto count = static_cast<std::size_t>(state.range(0));
+      const auto map = make_filled<map_>(count);
+      const auto keys = bench::missing_keys(count);
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         for (auto key : keys)
+         {
+            benchmark::DoNotOptimize(map.find(key));
+         }
+      }
+
+      state.SetItemsProcessed(state.iterations() * state.range(0));
+   }
+
+   template <class map_>
+   void erase(benchmark::State& state)
+   {
+      const auto count = static_cast<std::size_t>(state.range(0));
+      const auto source = make_filled<map_>(count);
+      const auto keys = bench::random_keys(count);
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         state.PauseTiming();
+         map_ map = source;
+         state.ResumeTiming();
+
+         for (auto key : keys)
+         {
+            benchmark::DoNotOptimize(map.erase(key));
+         }
+
+         benchmark::ClobberMemory();
+      }
+
+      state.SetItemsProcessed(state.iterations() * state.range(0));
+   }
+
+   /**
+    * Grow the bucket array to twice its size and shrink it back, each step reinserting every
+    * node
+    */
+   template <class map_>
+   void rehash(benchmark::State& state)
+   {
+      auto map = make_filled<map_>(static_cast<std::size_t>(state.range(0)));
+      const auto bucket_count = map.bucket_count();
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         map.rehash(bucket_count * 2);
+         map.rehash(bucket_count);
+
+         benchmark::ClobberMemory();
+      }
+
+      state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+   }
+} // namespace
+
+#define DENSE_HASH_MAP_BENCHMARK(function)                                                         \
+   BENCHMARK_TEMPLATE(function, small_map)                                                         \
+      ->RangeMultiplier(bench::size_multiplier)                                                    \
+      ->Range(bench::min_size, bench::max_size);                                                   \
+   BENCHMARK_TEMPLATE(function, heap_map)                                                          \
+      ->RangeMultiplier(bench::size_multiplier)                                                    \
+      ->Range(bench::min_size, bench::max_size);                                                   \
+   BENCHMARK_TEMPLATE(function, std_map)                                                           \
+      ->RangeMultiplier(bench::size_multiplier)                                                    \
+      ->Range(bench::min_size, bench::max_size)
+
+DENSE_HASH_MAP_BENCHMARK(insert);
+DENSE_HASH_MAP_BENCHMARK(find_hit);
+DENSE_HASH_MAP_BENCHMARK(find_miss);
+DENSE_HASH_MAP_BENCHMARK(erase);
+DENSE_HASH_MAP_BENCHMARK(rehash);
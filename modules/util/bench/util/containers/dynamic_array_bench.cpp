@@ -0,0 +1,134 @@
+#include <util/random_keys.hpp>
+
+#include <util/containers/dynamic_array.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+   // Sizes up to 64 stay in the inline buffer, larger ones move to the heap
+   using small_array = util::small_dynamic_array<std::uint64_t, 64>;
+   using heap_array = util::dynamic_array<std::uint64_t>;
+   using std_vector = std::vector<std::uint64_t>;
+
+   template <class container_>
+   auto make_filled(std::size_t count) -> container_
+   {
+      const auto keys = bench::random_keys(count);
+
+      container_ c;
+      for (auto key : keys)
+      {
+         c.push_back(key);
+      }
+
+      return c;
+   }
+
+   template <class container_>
+   void push_back(benchmark::State& state)
+   {
+      const auto count = static_cast<std::size_t>(state.range(0));
+      const auto keys = bench::random_keys(count);
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         container_ c;
+         for (auto key : keys)
+         {
+            c.push_back(key);
+         }
+
+         benchmark::DoNotOptimize(c.data());
+         benchmark::ClobberMemory();
+      }
+
+      state.SetItemsProcessed(state.iterations() * state.range(0));
+   }
+
+   /**
+    * Insert every element at the front, the worst case since the whole array shifts each time
+    */
+   template <class container_>
+   void insert(benchmark::State& state)
+   {
+      const auto count = static_cast<std::size_t>(state.range(0));
+      const auto keys = bench::random_keys(count);
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         container_ c;
+         for (auto key : keys)
+         {
+            c.insert(c.cbegin(), key);
+         }
+
+         benchmark::DoNotOptimize(c.data());
+         benchmark::ClobberMemory();
+      }
+
+      state.SetItemsProcessed(state.iterations() * state.range(0));
+   }
+
+   /**
+    * Erase every element from the front, the worst case since the whole array shifts each time
+    */
+   template <class container_>
+   void erase(benchmark::State& state)
+   {
+      const auto source = make_filled<container_>(static_cast<std::size_t>(state.range(0)));
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         state.PauseTiming();
+         container_ c = source;
+         state.ResumeTiming();
+
+         while (!c.empty())
+         {
+            c.erase(c.cbegin());
+         }
+
+         benchmark::DoNotOptimize(c.data());
+         benchmark::ClobberMemory();
+      }
+
+      state.SetItemsProcessed(state.iterations() * state.range(0));
+   }
+
+   template <class container_>
+   void copy(benchmark::State& state)
+   {
+      const auto source = make_filled<container_>(static_cast<std::size_t>(state.range(0)));
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         container_ c = source;
+
+         benchmark::DoNotOptimize(c.data());
+         benchmark::ClobberMemory();
+      }
+
+      state.SetBytesProcessed(state.iterations() * state.range(0) *
+                              static_cast<std::int64_t>(sizeof(std::uint64_t)));
+   }
+} // namespace
+
+#define DYNAMIC_ARRAY_BENCHMARK(function)                                                          \
+   BENCHMARK_TEMPLATE(function, small_array)                                                       \
+      ->RangeMultiplier(bench::size_multiplier)                                                    \
+      ->Range(bench::min_size, bench::max_size);                                                   \
+   BENCHMARK_TEMPLATE(function, heap_array)                                                        \
+      ->RangeMultiplier(bench::size_multiplier)                                                    \
+      ->Range(bench::min_size, bench::max_size);                                                   \
+   BENCHMARK_TEMPLATE(function, std_vector)                                                        \
+      ->RangeMultiplier(bench::size_multiplier)                                                    \
+      ->Range(bench::min_size, bench::max_size)
+
+DYNAMIC_ARRAY_BENCHMARK(push_back);
+DYNAMIC_ARRAY_BENCHMARK(insert);
+DYNAMIC_ARRAY_BENCHMARK(erase);
+DYNAMIC_ARRAY_BENCHMARK(copy);
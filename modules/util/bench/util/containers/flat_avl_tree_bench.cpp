@@ -0,0 +1,126 @@
+#include <util/random_keys.hpp>
+
+#include <util/containers/flat_avl_tree.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace
+{
+   // Sizes up to 64 stay in the inline buffer, larger ones move to the heap
+   using small_tree = util::small_avl_tree<std::uint64_t, std::uint64_t, 64>;
+   using heap_tree = util::small_avl_tree<std::uint64_t, std::uint64_t, 0>;
+   using std_map = std::map<std::uint64_t, std::uint64_t>;
+
+   template <class map_>
+   auto make_filled(std::size_t count) -> map_
+   {
+      map_ map;
+      for (auto key : bench::random_keys(count))
+      {
+         map.insert({key, key});
+      }
+
+      return map;
+   }
+
+   template <class map_>
+   void insert(benchmark::State& state)
+   {
+      const auto keys = bench::random_keys(static_cast<std::size_t>(state.range(0)));
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         map_ map;
+         for (auto key : keys)
+         {
+            map.insert({key, key});
+         }
+
+         benchmark::DoNotOptimize(map);
+         benchmark::ClobberMemory();
+      }
+
+      state.SetItemsProcessed(state.iterations() * state.range(0));
+   }
+
+   template <class map_>
+   void find_hit(benchmark::State& state)
+   {
+      const auto count = static_cast<std::size_t>(state.range(0));
+      const auto map = make_filled<map_>(count);
+      const auto keys = bench::random_keys(count);
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         for (auto key : keys)
+         {
+            benchmark::DoNotOptimize(map.find(key));
+         }
+      }
+
+      state.SetItemsProcessed(state.iterations() * state.range(0));
+   }
+
+   template <class map_>
+   void find_miss(benchmark::State& state)
+   {
+      const auto count = static_cast<std::size_t>(state.range(0));
+      const auto map = make_filled<map_>(count);
+      const auto keys = bench::missing_keys(count);
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         for (auto key : keys)
+         {
+            benchmark::DoNotOptimize(map.find(key));
+         }
+      }
+
+      state.SetItemsProcessed(state.iterations() * state.range(0));
+   }
+
+   template <class map_>
+   void erase(benchmark::State& state)
+   {
+      const auto count = static_cast<std::size_t>(state.range(0));
+      const auto source = make_filled<map_>(count);
+      const auto keys = bench::random_keys(count);
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         state.PauseTiming();
+         map_ map = source;
+         state.ResumeTiming();
+
+         for (auto key : keys)
+         {
+            map.erase(std::as_const(map).find(key));
+         }
+
+         benchmark::DoNotOptimize(map);
+         benchmark::ClobberMemory();
+      }
+
+      state.SetItemsProcessed(state.iterations() * state.range(0));
+   }
+} // namespace
+
+#define AVL_TREE_BENCHMARK(function)                                                               \
+   BENCHMARK_TEMPLATE(function, small_tree)                                                        \
+      ->RangeMultiplier(bench::size_multiplier)                                                    \
+      ->Range(bench::min_size, bench::max_size);                                                   \
+   BENCHMARK_TEMPLATE(function, heap_tree)                                                         \
+      ->RangeMultiplier(bench::size_multiplier)                                                    \
+      ->Range(bench::min_size, bench::max_size);                                                   \
+   BENCHMARK_TEMPLATE(function, std_map)                                                           \
+      ->RangeMultiplier(bench::size_multiplier)                                                    \
+      ->Range(bench::min_size, bench::max_size)
+
+AVL_TREE_BENCHMARK(insert);
+AVL_TREE_BENCHMARK(find_hit);
+AVL_TREE_BENCHMARK(find_miss);
+AVL_TREE_BENCHMARK(erase);
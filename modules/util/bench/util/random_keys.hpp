@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace bench
+{
+   /**
+    * The sizes every container benchmark runs at. The smallest ones fit in the inline buffers
+    * of the small containers, the largest ones spill far out of them
+    */
+   static constexpr std::int64_t min_size = 8;
+   static constexpr std::int64_t max_size = 4096;
+   static constexpr int size_multiplier = 8;
+
+   /**
+    * Generate count pseudo random even keys. The same seed always yields the same keys, so runs
+    * stay comparable
+    */
+   inline auto random_keys(std::size_t count, std::uint64_t seed = 0) -> std::vector<std::uint64_t>
+   {
+      std::mt19937_64 engine{seed};
+
+      std::vector<std::uint64_t> keys;
+      keys.reserve(count);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+         keys.push_back(engine() & ~std::uint64_t{1});
+      }
+
+      return keys;
+   }
+
+   /**
+    * Generate count pseudo random odd keys, none of which is ever returned by random_keys
+    */
+   inline auto missing_keys(std::size_t count, std::uint64_t seed = 1)
+      -> std::vector<std::uint64_t>
+   {
+      auto keys = random_keys(count, seed);
+      for (auto& key : keys)
+      {
+         key |= 1U;
+      }
+
+      return keys;
+   }
+} // namespace bench
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <util/containers/dynamic_array.hpp>
+#include <util/mapped_file.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+namespace util
+{
+   /**
+    * A read-only archive of named blobs packed in a single memory mapped file. Only the index
+    * is read when the pack is opened, the blobs are paged in as they are accessed.
+    *
+    * The file starts with a header holding the entry count and the offset of the index, followed
+    * by the blobs, each aligned to asset_pack::alignment, and ends with the index: the offset,
+    * size and name of every entry
+    */
+   class asset_pack
+   {
+   public:
+      static constexpr std::size_t alignment = 16;
+
+      /**
+       * Map the pack at the path, or return nothing if it cannot be mapped or is malformed
+       */
+      static auto open(const std::filesystem::path& path) -> std::optional<asset_pack>;
+
+      /**
+       * Get the content of the entry with the given name. The bytes live as long as the pack
+       */
+      [[nodiscard]] auto find(const std::string& name) const
+         -> std::optional<std::span<const std::byte>>;
+      [[nodiscard]] auto contains(const std::string& name) const -> bool;
+
+      [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+   private:
+      mapped_file m_file;
+      std::unordered_map<std::string, std::span<const std::byte>> m_entries;
+   };
+
+   /**
+    * Gathers named blobs in memory and writes them as an asset_pack
+    */
+   class asset_pack_writer
+   {
+   public:
+      /**
+       * Copy a blob into the pack. Returns false if an entry with the same name was already added
+       */
+      auto add(const std::string& name, std::span<const std::byte> data) -> bool;
+
+      /**
+       * Write the pack to the path, replacing any existing file. Returns false on failure
+       */
+      [[nodiscard]] auto write(const std::filesystem::path& path) const -> bool;
+
+      [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+   private:
+      struct entry
+      {
+         std::string name;
+         dynamic_array<std::byte> data{};
+      };
+
+   private:
+      dynamic_array<entry> m_entries;
+   };
+} // namespace util
@@ -35,6 +35,19 @@ namespace util
          std::allocator_traits<allocator_>::propagate_on_container_swap::value ||
          std::allocator_traits<allocator_>::is_always_equal::value;
 
+      /**
+       * Elements that are copied, filled & relocated as raw memory instead of one at a time. Only
+       * the standard allocators are known not to give construct & destroy a meaning of their own
+       */
+      static inline constexpr bool is_trivially_relocatable =
+         std::is_trivially_copyable_v<any_> &&
+         (std::same_as<allocator_, std::allocator<any_>> ||
+          std::same_as<allocator_, std::pmr::polymorphic_allocator<any_>>);
+
+      template <class it_>
+      static inline constexpr bool is_contiguous_source = is_trivially_relocatable &&
+         std::contiguous_iterator<it_> && std::same_as<std::iter_value_t<it_>, any_>;
+
    public:
       using value_type = any_;
       using size_type = std::size_t;
@@ -162,6 +175,23 @@ namespace util
       constexpr void assign(size_type count, const_reference value) noexcept
          requires std::copyable<value_type>
       {
+         if constexpr (is_trivially_relocatable)
+         {
+            // The value may be one of the elements, which growing would free
+            const value_type copy = value;
+
+            m_size = 0;
+            if (count > m_capacity)
+            {
+               grow(count);
+            }
+
+            std::fill_n(m_pbegin, count, copy);
+            m_size = count;
+
+            return;
+         }
+
          clear();
 
          if (count > m_capacity)
@@ -187,7 +217,18 @@ namespace util
 
          m_size = new_count;
 
-         std::uninitialized_copy(first, last, begin());
+         if constexpr (is_contiguous_source<it_>)
+         {
+            // The source may overlap the elements when it is a part of the array itself
+            if (new_count > 0)
+            {
+               std::memmove(m_pbegin, std::to_address(first), new_count * sizeof(value_type));
+            }
+         }
+         else
+         {
+            std::uninitialized_copy(first, last, begin());
+         }
       }
 
       // clang-format off
@@ -406,6 +447,25 @@ namespace util
       {
          size_type start_index = pos - cbegin();
 
+         if constexpr (is_trivially_relocatable)
+         {
+            assert(pos >= cbegin() && "Insertion iterator is out of bounds");
+            assert(pos <= cend() && "Insertion iterator is past the end");
+
+            // The value may be one of the elements, which the growth & the shift would move
+            const value_type copy = value;
+
+            reserve(size() + count);
+
+            pointer p_pos = offset(start_index);
+            std::memmove(p_pos + count, p_pos, (size() - start_index) * sizeof(value_type));
+            std::fill_n(p_pos, count, copy);
+
+            m_size += count;
+
+            return begin() + start_index;
+         }
+
          if (pos == cend())
          {
             if (size() + count >= capacity())
@@ -566,6 +626,16 @@ namespace util
 
          auto it = begin() + (pos - cbegin());
 
+         if constexpr (is_trivially_relocatable)
+         {
+            const size_type index = pos - cbegin();
+            std::memmove(offset(index), offset(index + 1),
+                         (size() - index - 1) * sizeof(value_type));
+            --m_size;
+
+            return it;
+         }
+
          std::move(it + 1, end(), it);
          pop_back();
 
@@ -585,6 +655,16 @@ namespace util
 
          size_type const distance = std::distance(first, last);
 
+         if constexpr (is_trivially_relocatable)
+         {
+            const size_type index = first - cbegin();
+            std::memmove(offset(index), offset(index + distance),
+                         (size() - index - distance) * sizeof(value_type));
+            m_size -= distance;
+
+            return begin() + index;
+         }
+
          auto it_f = begin() + (first - cbegin());
          auto it_l = begin() + (last - cbegin());
          auto it = std::move(it_l, end(), it_f);
@@ -702,16 +782,28 @@ namespace util
          {
             auto new_elements = allocator_traits::allocate(m_allocator, new_capacity);
 
-            if constexpr (std::movable<value_type>)
+            if constexpr (is_trivially_relocatable)
             {
-               std::uninitialized_move(begin(), end(), iterator{new_elements});
+               // Neither standard allocator can extend a block in place, relocating the elements
+               // is a copy of their bytes and the old ones need no destruction
+               if (!empty())
+               {
+                  std::memcpy(new_elements, m_pbegin, size() * sizeof(value_type));
+               }
             }
             else
             {
-               std::uninitialized_copy(begin(), end(), iterator{new_elements});
-            }
+               if constexpr (std::movable<value_type>)
+               {
+                  std::uninitialized_move(begin(), end(), iterator{new_elements});
+               }
+               else
+               {
+                  std::uninitialized_copy(begin(), end(), iterator{new_elements});
+               }
 
-            destroy(begin(), end());
+               destroy(begin(), end());
+            }
 
             if (!is_static())
             {
@@ -0,0 +1,225 @@
+/**
+ * @file slot_map.hpp.
+ * @copyright MIT License.
+ */
+
+#pragma once
+
+#include <util/containers/dynamic_array.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace util
+{
+   /**
+    * A stable handle to a value stored in a slot_map. The generation is bumped every time the
+    * slot is freed, so keys to erased values are detected instead of aliasing new ones
+    */
+   struct slot_key
+   {
+      static constexpr std::uint32_t invalid_index = std::numeric_limits<std::uint32_t>::max();
+
+      std::uint32_t index{invalid_index};
+      std::uint32_t generation{0};
+
+      auto operator==(const slot_key& other) const -> bool = default;
+   };
+
+   /**
+    * A container handing out generational keys to values kept densely packed in memory.
+    * Insertion, lookup and removal by key are O(1). Removal moves the last value into the hole
+    * left by the erased one, keys to every other value remain valid
+    */
+   template <class any_>
+   class slot_map
+   {
+      using container_type = dynamic_array<any_>;
+
+   public:
+      using key_type = slot_key;
+      using value_type = any_;
+      using size_type = std::size_t;
+      using reference = value_type&;
+      using const_reference = const value_type&;
+      using pointer = value_type*;
+      using const_pointer = const value_type*;
+      using iterator = typename container_type::iterator;
+      using const_iterator = typename container_type::const_iterator;
+
+      constexpr auto begin() noexcept -> iterator { return m_values.begin(); }
+      constexpr auto begin() const noexcept -> const_iterator { return m_values.cbegin(); }
+      constexpr auto cbegin() const noexcept -> const_iterator { return m_values.cbegin(); }
+      constexpr auto end() noexcept -> iterator { return m_values.end(); }
+      constexpr auto end() const noexcept -> const_iterator { return m_values.cend(); }
+      constexpr auto cend() const noexcept -> const_iterator { return m_values.cend(); }
+
+      [[nodiscard]] constexpr auto size() const noexcept -> size_type { return m_values.size(); }
+      [[nodiscard]] constexpr auto empty() const noexcept -> bool { return m_values.empty(); }
+
+      constexpr auto data() noexcept -> pointer { return m_values.data(); }
+      constexpr auto data() const noexcept -> const_pointer { return m_values.data(); }
+
+      /**
+       * View the values in the order they are stored in, for use with index_of
+       */
+      constexpr auto values() noexcept -> std::span<value_type>
+      {
+         return {m_values.data(), m_values.size()};
+      }
+      constexpr auto values() const noexcept -> std::span<const value_type>
+      {
+         return {m_values.data(), m_values.size()};
+      }
+
+      constexpr void reserve(size_type new_cap)
+      {
+         m_values.reserve(new_cap);
+         m_dense_to_slot.reserve(new_cap);
+         m_slots.reserve(new_cap);
+      }
+
+      constexpr auto insert(const value_type& value) -> key_type { return emplace(value); }
+      constexpr auto insert(value_type&& value) -> key_type { return emplace(std::move(value)); }
+
+      template <class... args_>
+      constexpr auto emplace(args_&&... args) -> key_type
+      {
+         m_values.emplace_back(std::forward<args_>(args)...);
+
+         const auto dense_index = static_cast<std::uint32_t>(m_values.size() - 1);
+
+         std::uint32_t slot_index = m_free_head;
+         if (slot_index != slot_key::invalid_index)
+         {
+            m_free_head = m_slots[slot_index].dense_index;
+            m_slots[slot_index].dense_index = dense_index;
+         }
+         else
+         {
+            slot_index = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.push_back(slot{.dense_index = dense_index, .generation = 0});
+         }
+
+         m_dense_to_slot.push_back(slot_index);
+
+         return {.index = slot_index, .generation = m_slots[slot_index].generation};
+      }
+
+      /**
+       * Remove the value referred to by the key. The last value is moved into its place, use
+       * index_of beforehand to mirror the move in containers kept parallel to this one
+       */
+      constexpr auto erase(const key_type& key) -> bool
+      {
+         if (!contains(key))
+         {
+            return false;
+         }
+
+         auto& erased = m_slots[key.index];
+
+         const std::uint32_t dense_index = erased.dense_index;
+         const auto last_index = static_cast<std::uint32_t>(m_values.size() - 1);
+         if (dense_index != last_index)
+         {
+            m_values[dense_index] = std::move(m_values[last_index]);
+            m_dense_to_slot[dense_index] = m_dense_to_slot[last_index];
+            m_slots[m_dense_to_slot[dense_index]].dense_index = dense_index;
+         }
+
+         m_values.pop_back();
+         m_dense_to_slot.pop_back();
+
+         ++erased.generation;
+         erased.dense_index = m_free_head;
+         m_free_head = key.index;
+
+         return true;
+      }
+
+      /**
+       * Remove every value. All previously issued keys are invalidated
+       */
+      constexpr void clear()
+      {
+         for (const std::uint32_t slot_index : m_dense_to_slot)
+         {
+            ++m_slots[slot_index].generation;
+            m_slots[slot_index].dense_index = m_free_head;
+            m_free_head = slot_index;
+         }
+
+         m_values.clear();
+         m_dense_to_slot.clear();
+      }
+
+      [[nodiscard]] constexpr auto contains(const key_type& key) const noexcept -> bool
+      {
+         return key.index < m_slots.size() && m_slots[key.index].generation == key.generation;
+      }
+
+      /**
+       * Get a pointer to the value referred to by the key, or nullptr if it was erased
+       */
+      constexpr auto find(const key_type& key) noexcept -> pointer
+      {
+         return contains(key) ? &m_values[m_slots[key.index].dense_index] : nullptr;
+      }
+      constexpr auto find(const key_type& key) const noexcept -> const_pointer
+      {
+         return contains(key) ? &m_values[m_slots[key.index].dense_index] : nullptr;
+      }
+
+      /**
+       * Access the value referred to by the key without checking that it is still alive
+       */
+      constexpr auto operator[](const key_type& key) noexcept -> reference
+      {
+         return m_values[m_slots[key.index].dense_index];
+      }
+      constexpr auto operator[](const key_type& key) const noexcept -> const_reference
+      {
+         return m_values[m_slots[key.index].dense_index];
+      }
+
+      /**
+       * Get the position of the value referred to by the key in the dense storage
+       */
+      [[nodiscard]] constexpr auto index_of(const key_type& key) const noexcept
+         -> std::optional<size_type>
+      {
+         if (!contains(key))
+         {
+            return std::nullopt;
+         }
+
+         return m_slots[key.index].dense_index;
+      }
+
+      /**
+       * Get the key of the value at a position of the dense storage
+       */
+      [[nodiscard]] constexpr auto key_at(size_type dense_index) const noexcept -> key_type
+      {
+         const std::uint32_t slot_index = m_dense_to_slot[dense_index];
+         return {.index = slot_index, .generation = m_slots[slot_index].generation};
+      }
+
+   private:
+      struct slot
+      {
+         std::uint32_t dense_index; // next free slot while the slot is unused
+         std::uint32_t generation;
+      };
+
+      container_type m_values;
+      dynamic_array<std::uint32_t> m_dense_to_slot;
+      dynamic_array<slot> m_slots;
+
+      std::uint32_t m_free_head{slot_key::invalid_index};
+   };
+} // namespace util
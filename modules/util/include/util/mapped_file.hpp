@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+namespace util
+{
+   /**
+    * A read-only view of a whole file mapped into the address space. Pages are loaded by the OS
+    * on first access, so only the parts of the file actually read are brought into memory
+    */
+   class mapped_file
+   {
+   public:
+      /**
+       * Map the file at the path, or return nothing if it cannot be opened or mapped
+       */
+      static auto open(const std::filesystem::path& path) -> std::optional<mapped_file>;
+
+      mapped_file() = default;
+      mapped_file(const mapped_file&) = delete;
+      mapped_file(mapped_file&& other) noexcept;
+      ~mapped_file();
+
+      auto operator=(const mapped_file&) -> mapped_file& = delete;
+      auto operator=(mapped_file&& rhs) noexcept -> mapped_file&;
+
+      [[nodiscard]] auto data() const noexcept -> const std::byte*;
+      [[nodiscard]] auto size() const noexcept -> std::size_t;
+      [[nodiscard]] auto bytes() const noexcept -> std::span<const std::byte>;
+
+   private:
+      void unmap() noexcept;
+
+   private:
+      const std::byte* mp_data{nullptr};
+      std::size_t m_size{0};
+
+#if defined(_WIN32)
+      void* mp_file_handle{nullptr};
+      void* mp_mapping_handle{nullptr};
+#endif
+   };
+} // namespace util
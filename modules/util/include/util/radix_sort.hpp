@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace util
+{
+   namespace detail
+   {
+      static constexpr std::size_t radix_bits = 8;
+      static constexpr std::size_t radix_size = std::size_t{1} << radix_bits;
+   } // namespace detail
+
+   /**
+    * Stable LSD radix sort of values on the unsigned integer key returned by the projection,
+    * eight bits at a time. The histograms of every digit are built in a single pass and digits
+    * shared by all keys are skipped. The scratch span must be at least as large as values, the
+    * sorted result always ends up in values
+    */
+   template <class any_, class projection_>
+      requires std::is_trivially_copyable_v<any_> &&
+         std::unsigned_integral<std::invoke_result_t<projection_, const any_&>>
+   void radix_sort(std::span<any_> values, std::span<any_> scratch, projection_ key)
+   {
+      using key_type = std::invoke_result_t<projection_, const any_&>;
+
+      constexpr std::size_t digit_count = sizeof(key_type) * 8 / detail::radix_bits;
+
+      const std::size_t count = std::size(values);
+      if (count < 2)
+      {
+         return;
+      }
+
+      std::array<std::array<std::size_t, detail::radix_size>, digit_count> histograms{};
+      for (const auto& value : values)
+      {
+         const key_type k = key(value);
+         for (std::size_t digit = 0; digit < digit_count; ++digit)
+         {
+            ++histograms[digit][(k >> (digit * detail::radix_bits)) & (detail::radix_size - 1)];
+         }
+      }
+
+      any_* p_src = std::data(values);
+      any_* p_dst = std::data(scratch);
+
+      for (std::size_t digit = 0; digit < digit_count; ++digit)
+      {
+         auto& histogram = histograms[digit];
+
+         const std::size_t first_bucket =
+            (key(p_src[0]) >> (digit * detail::radix_bits)) & (detail::radix_size - 1);
+         if (histogram[first_bucket] == count)
+         {
+            continue;
+         }
+
+         std::size_t offset = 0;
+         for (auto& bucket : histogram)
+         {
+            const std::size_t bucket_count = bucket;
+            bucket = offset;
+            offset += bucket_count;
+         }
+
+         for (std::size_t i = 0; i < count; ++i)
+         {
+            const std::size_t bucket =
+               (key(p_src[i]) >> (digit * detail::radix_bits)) & (detail::radix_size - 1);
+            p_dst[histogram[bucket]++] = p_src[i];
+         }
+
+         std::swap(p_src, p_dst);
+      }
+
+      if (p_src != std::data(values))
+      {
+         std::memcpy(std::data(values), p_src, count * sizeof(any_));
+      }
+   }
+} // namespace util
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+namespace util::stats
+{
+   /**
+    * Monotonic event counters. The registry keeps both the running total and the value
+    * reached during the last completed frame
+    */
+   enum struct counter : std::uint32_t
+   {
+      draw_calls,
+      pipeline_binds,
+      descriptor_binds,
+      elided_binds,
+      bytes_uploaded,
+      shader_cache_hits,
+      shader_cache_misses,
+      count
+   };
+
+   /**
+    * Values that are set rather than accumulated
+    */
+   enum struct gauge : std::uint32_t
+   {
+      live_buffers,
+      fence_wait_us,
+      acquire_latency_us,
+      resident_texture_bytes,
+      count
+   };
+
+   static constexpr std::size_t counter_count = static_cast<std::size_t>(counter::count);
+   static constexpr std::size_t gauge_count = static_cast<std::size_t>(gauge::count);
+   /**
+    * Matches VK_MAX_MEMORY_HEAPS
+    */
+   static constexpr std::size_t max_memory_heaps = 16;
+
+   auto to_string(counter c) -> std::string_view;
+   auto to_string(gauge g) -> std::string_view;
+
+   /**
+    * A copy of the registry at a given point in time
+    */
+   struct snapshot
+   {
+      std::uint64_t frame_count{0};
+
+      std::array<std::uint64_t, counter_count> last_frame{};
+      std::array<std::uint64_t, counter_count> totals{};
+      std::array<std::int64_t, gauge_count> gauges{};
+      std::array<std::int64_t, max_memory_heaps> heap_usage{};
+
+      [[nodiscard]] auto operator[](counter c) const noexcept -> std::uint64_t
+      {
+         return last_frame[static_cast<std::size_t>(c)];
+      }
+      [[nodiscard]] auto operator[](gauge g) const noexcept -> std::int64_t
+      {
+         return gauges[static_cast<std::size_t>(g)];
+      }
+      [[nodiscard]] auto total(counter c) const noexcept -> std::uint64_t
+      {
+         return totals[static_cast<std::size_t>(c)];
+      }
+   };
+
+   namespace detail
+   {
+      struct registry
+      {
+         std::atomic<std::uint64_t> frame_count{0};
+
+         std::array<std::atomic<std::uint64_t>, counter_count> current_frame{};
+         std::array<std::atomic<std::uint64_t>, counter_count> last_frame{};
+         std::array<std::atomic<std::uint64_t>, counter_count> totals{};
+         std::array<std::atomic<std::int64_t>, gauge_count> gauges{};
+         std::array<std::atomic<std::int64_t>, max_memory_heaps> heap_usage{};
+      };
+
+      inline registry global_registry{}; // NOLINT
+   } // namespace detail
+
+   inline void increment(counter c, std::uint64_t value = 1) noexcept
+   {
+      detail::global_registry.current_frame[static_cast<std::size_t>(c)].fetch_add(
+         value, std::memory_order_relaxed);
+   }
+
+   inline void set(gauge g, std::int64_t value) noexcept
+   {
+      detail::global_registry.gauges[static_cast<std::size_t>(g)].store(value,
+                                                                        std::memory_order_relaxed);
+   }
+   inline void add(gauge g, std::int64_t delta) noexcept
+   {
+      detail::global_registry.gauges[static_cast<std::size_t>(g)].fetch_add(
+         delta, std::memory_order_relaxed);
+   }
+
+   /**
+    * Add (or remove with a negative delta) bytes of device memory allocated on a heap
+    */
+   inline void add_heap_usage(std::uint32_t heap_index, std::int64_t delta) noexcept
+   {
+      if (heap_index < max_memory_heaps)
+      {
+         detail::global_registry.heap_usage[heap_index].fetch_add(delta,
+                                                                  std::memory_order_relaxed);
+      }
+   }
+
+   /**
+    * Close the current frame: the per frame counters are published to the snapshot and reset
+    */
+   void end_frame() noexcept;
+
+   /**
+    * Copy the current state of the registry. Each value is read atomically, the snapshot as a
+    * whole is not
+    */
+   [[nodiscard]] auto take_snapshot() noexcept -> snapshot;
+
+   /**
+    * Reset every counter and gauge
+    */
+   void reset() noexcept;
+} // namespace util::stats
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <util/containers/dynamic_array.hpp>
+
+#include <concepts>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace util
+{
+   /**
+    * A fixed set of worker threads running submitted tasks in submission order. Tasks still
+    * queued when the pool is destroyed are run before the workers are joined
+    */
+   class thread_pool
+   {
+   public:
+      /**
+       * Create a pool with one worker per hardware thread, minus the calling one
+       */
+      thread_pool();
+      explicit thread_pool(std::size_t thread_count);
+      thread_pool(const thread_pool&) = delete;
+      thread_pool(thread_pool&&) = delete;
+      ~thread_pool();
+
+      auto operator=(const thread_pool&) -> thread_pool& = delete;
+      auto operator=(thread_pool&&) -> thread_pool& = delete;
+
+      /**
+       * Queue a task and get a future to its result. Exceptions thrown by the task are
+       * rethrown by the future
+       */
+      template <std::invocable fun_>
+      auto submit(fun_&& fun) -> std::future<std::invoke_result_t<fun_>>
+      {
+         using result_type = std::invoke_result_t<fun_>;
+
+         // std::function must be copyable, the task is shared to get around it
+         auto p_task =
+            std::make_shared<std::packaged_task<result_type()>>(std::forward<fun_>(fun));
+         auto future = p_task->get_future();
+
+         enqueue([p_task] {
+            (*p_task)();
+         });
+
+         return future;
+      }
+
+      /**
+       * Block until every queued task has been run
+       */
+      void wait_idle();
+
+      [[nodiscard]] auto thread_count() const noexcept -> std::size_t;
+      /**
+       * Get the number of tasks waiting for a worker
+       */
+      [[nodiscard]] auto pending_count() const -> std::size_t;
+
+   private:
+      void enqueue(std::function<void()>&& task);
+      void work();
+
+   private:
+      util::dynamic_array<std::thread> m_workers;
+
+      std::deque<std::function<void()>> m_tasks;
+      std::size_t m_active_count{0};
+      bool m_is_stopping{false};
+
+      mutable std::mutex m_mutex;
+      std::condition_variable m_task_available;
+      std::condition_variable m_idle;
+   };
+} // namespace util
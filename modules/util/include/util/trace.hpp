@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string_view>
+
+namespace util::trace
+{
+   namespace detail
+   {
+      inline std::atomic<bool> is_tracing_enabled{false}; // NOLINT
+
+      auto now_ns() noexcept -> std::int64_t;
+      auto push_depth() noexcept -> std::uint32_t;
+      void pop_depth() noexcept;
+      void record(const char* name, const char* category, std::int64_t start_ns,
+                  std::int64_t end_ns, std::uint32_t depth) noexcept;
+   } // namespace detail
+
+   /**
+    * Number of zones each thread keeps between two dumps. Once a thread's buffer is full, each new
+    * zone overwrites the oldest one, so a dump always holds the most recent zones
+    */
+   static constexpr std::size_t thread_buffer_capacity = 1U << 14U;
+
+   /**
+    * Turn the recording of zones on or off. Tracing is off by default
+    */
+   void set_enabled(bool enabled) noexcept;
+   [[nodiscard]] inline auto is_enabled() noexcept -> bool
+   {
+      return detail::is_tracing_enabled.load(std::memory_order_relaxed);
+   }
+
+   /**
+    * Name the calling thread in the exported traces
+    */
+   void set_thread_name(std::string_view name);
+
+   /**
+    * Write every zone recorded since the last dump to the stream, using the Chrome trace event
+    * JSON format (readable by chrome://tracing and Perfetto). The recorded zones are consumed
+    */
+   void dump_chrome_trace(std::ostream& os);
+   /**
+    * Write every zone recorded since the last dump to a file using the Chrome trace event JSON
+    * format. Returns false if the file could not be opened
+    */
+   auto dump_chrome_trace(const std::filesystem::path& path) -> bool;
+
+   /**
+    * Discard every zone recorded since the last dump
+    */
+   void clear();
+
+   /**
+    * Get the number of zones overwritten since the start of the program because a thread buffer
+    * was full
+    */
+   [[nodiscard]] auto overwritten_zone_count() -> std::uint64_t;
+
+   /**
+    * Time the enclosing scope. Both strings must outlive the tracer, string literals are
+    * expected
+    */
+   class zone
+   {
+   public:
+      zone(const char* name, const char* category = "engine") noexcept :
+         m_name{name}, m_category{category}
+      {
+         if (is_enabled())
+         {
+            m_depth = detail::push_depth();
+            m_start = detail::now_ns();
+         }
+      }
+      zone(const zone&) = delete;
+      zone(zone&&) = delete;
+      ~zone()
+      {
+         if (m_start >= 0)
+         {
+            detail::record(m_name, m_category, m_start, detail::now_ns(), m_depth);
+            detail::pop_depth();
+         }
+      }
+
+      auto operator=(const zone&) -> zone& = delete;
+      auto operator=(zone&&) -> zone& = delete;
+
+   private:
+      const char* m_name;
+      const char* m_category;
+
+      std::int64_t m_start{-1};
+      std::uint32_t m_depth{0};
+   };
+} // namespace util::trace
+
+#define UTIL_TRACE_CONCAT_IMPL(a, b) a##b
+#define UTIL_TRACE_CONCAT(a, b) UTIL_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * Time the enclosing scope under the given name
+ */
+#define UTIL_TRACE_ZONE(name)                                                                      \
+   const ::util::trace::zone UTIL_TRACE_CONCAT(trace_zone_, __LINE__) { name }
+/**
+ * Time the enclosing scope under the given name and category
+ */
+#define UTIL_TRACE_ZONE_CAT(name, category)                                                        \
+   const ::util::trace::zone UTIL_TRACE_CONCAT(trace_zone_, __LINE__) { name, category }
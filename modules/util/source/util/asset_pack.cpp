@@ -0,0 +1,199 @@
+#include <util/asset_pack.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+
+namespace util
+{
+   namespace
+   {
+      constexpr std::uint32_t magic = 0x4B50'4D56; // "VMPK"
+      constexpr std::uint32_t version = 1;
+
+      // magic, version, entry count, padding and index offset
+      constexpr std::size_t header_size = 24;
+      constexpr std::size_t index_offset_offset = 16;
+      // offset, size and name length, followed by the name
+      constexpr std::size_t index_entry_size = 20;
+
+      template <std::unsigned_integral any_>
+      auto read_le(std::span<const std::byte> bytes, std::size_t offset) noexcept -> any_
+      {
+         any_ value = 0;
+         for (std::size_t i = 0; i < sizeof(any_); ++i)
+         {
+            value |= static_cast<any_>(std::to_integer<any_>(bytes[offset + i]) << (8U * i));
+         }
+
+         return value;
+      }
+
+      template <std::unsigned_integral any_>
+      void write_le(std::ofstream& stream, any_ value)
+      {
+         std::array<char, sizeof(any_)> bytes{};
+         for (std::size_t i = 0; i < sizeof(any_); ++i)
+         {
+            bytes[i] = static_cast<char>((value >> (8U * i)) & 0xFFU);
+         }
+
+         stream.write(std::data(bytes), static_cast<std::streamsize>(std::size(bytes)));
+      }
+
+      auto align_up(std::uint64_t offset) noexcept -> std::uint64_t
+      {
+         constexpr std::uint64_t alignment = asset_pack::alignment;
+
+         return (offset + alignment - 1) / alignment * alignment;
+      }
+   } // namespace
+
+   auto asset_pack::open(const std::filesystem::path& path) -> std::optional<asset_pack>
+   {
+      auto file = mapped_file::open(path);
+      if (!file)
+      {
+         return std::nullopt;
+      }
+
+      const auto bytes = file->bytes();
+      if (std::size(bytes) < header_size || read_le<std::uint32_t>(bytes, 0) != magic ||
+          read_le<std::uint32_t>(bytes, 4) != version)
+      {
+         return std::nullopt;
+      }
+
+      const auto entry_count = read_le<std::uint32_t>(bytes, 8);
+      auto offset = read_le<std::uint64_t>(bytes, index_offset_offset);
+
+      // Every entry takes at least index_entry_size bytes, a count the index can't hold is
+      // rejected before anything is reserved for it
+      if (offset > std::size(bytes) || (std::size(bytes) - offset) / index_entry_size < entry_count)
+      {
+         return std::nullopt;
+      }
+
+      asset_pack pack;
+      pack.m_entries.reserve(entry_count);
+
+      for (std::uint32_t i = 0; i < entry_count; ++i)
+      {
+         if (offset > std::size(bytes) || std::size(bytes) - offset < index_entry_size)
+         {
+            return std::nullopt;
+         }
+
+         const auto data_offset = read_le<std::uint64_t>(bytes, offset);
+         const auto data_size = read_le<std::uint64_t>(bytes, offset + 8);
+         const auto name_size = read_le<std::uint32_t>(bytes, offset + 16);
+         offset += index_entry_size;
+
+         if (std::size(bytes) - offset < name_size || data_offset > std::size(bytes) ||
+             std::size(bytes) - data_offset < data_size)
+         {
+            return std::nullopt;
+         }
+
+         const auto* p_name = reinterpret_cast<const char*>(&bytes[offset]); // NOLINT
+         pack.m_entries.emplace(std::string{p_name, name_size},
+                                bytes.subspan(data_offset, data_size));
+
+         offset += name_size;
+      }
+
+      // The entries point into the mapping, which stays in place when moved
+      pack.m_file = std::move(file).value();
+
+      return pack;
+   }
+
+   auto asset_pack::find(const std::string& name) const
+      -> std::optional<std::span<const std::byte>>
+   {
+      if (const auto it = m_entries.find(name); it != std::end(m_entries))
+      {
+         return it->second;
+      }
+
+      return std::nullopt;
+   }
+   auto asset_pack::contains(const std::string& name) const -> bool
+   {
+      return m_entries.contains(name);
+   }
+
+   auto asset_pack::size() const noexcept -> std::size_t { return std::size(m_entries); }
+
+   auto asset_pack_writer::add(const std::string& name, std::span<const std::byte> data) -> bool
+   {
+      const bool is_duplicate =
+         std::any_of(std::begin(m_entries), std::end(m_entries), [&](const entry& e) {
+            return e.name == name;
+         });
+      if (is_duplicate)
+      {
+         return false;
+      }
+
+      m_entries.push_back(
+         {.name = name, .data = dynamic_array<std::byte>(std::begin(data), std::end(data))});
+
+      return true;
+   }
+
+   auto asset_pack_writer::write(const std::filesystem::path& path) const -> bool
+   {
+      std::ofstream stream{path, std::ios::binary | std::ios::trunc};
+      if (!stream)
+      {
+         return false;
+      }
+
+      dynamic_array<std::uint64_t> offsets;
+      offsets.reserve(std::size(m_entries));
+
+      std::uint64_t offset = header_size;
+      for (const auto& e : m_entries)
+      {
+         offset = align_up(offset);
+         offsets.push_back(offset);
+         offset += std::size(e.data);
+      }
+
+      write_le(stream, magic);
+      write_le(stream, version);
+      write_le(stream, static_cast<std::uint32_t>(std::size(m_entries)));
+      write_le(stream, std::uint32_t{0});
+      write_le(stream, offset);
+
+      const std::array<char, asset_pack::alignment> padding{};
+
+      std::uint64_t position = header_size;
+      for (std::size_t i = 0; i < std::size(m_entries); ++i)
+      {
+         const auto& data = m_entries[i].data;
+
+         stream.write(std::data(padding), static_cast<std::streamsize>(offsets[i] - position));
+         stream.write(reinterpret_cast<const char*>(std::data(data)), // NOLINT
+                      static_cast<std::streamsize>(std::size(data)));
+
+         position = offsets[i] + std::size(data);
+      }
+
+      for (std::size_t i = 0; i < std::size(m_entries); ++i)
+      {
+         const auto& e = m_entries[i];
+
+         write_le(stream, offsets[i]);
+         write_le(stream, static_cast<std::uint64_t>(std::size(e.data)));
+         write_le(stream, static_cast<std::uint32_t>(std::size(e.name)));
+         stream.write(std::data(e.name), static_cast<std::streamsize>(std::size(e.name)));
+      }
+
+      return static_cast<bool>(stream);
+   }
+
+   auto asset_pack_writer::size() const noexcept -> std::size_t { return std::size(m_entries); }
+} // namespace util
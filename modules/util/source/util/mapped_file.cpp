@@ -0,0 +1,162 @@
+#include <util/mapped_file.hpp>
+
+#include <utility>
+
+#if defined(_WIN32)
+#   define WIN32_LEAN_AND_MEAN
+#   define NOMINMAX
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace util
+{
+   auto mapped_file::open(const std::filesystem::path& path) -> std::optional<mapped_file>
+   {
+      mapped_file file;
+
+#if defined(_WIN32)
+      HANDLE file_handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (file_handle == INVALID_HANDLE_VALUE)
+      {
+         return std::nullopt;
+      }
+
+      file.mp_file_handle = file_handle;
+
+      LARGE_INTEGER size{};
+      if (!GetFileSizeEx(file_handle, &size))
+      {
+         return std::nullopt;
+      }
+
+      // Empty files cannot be mapped, they are represented by an empty view instead
+      if (size.QuadPart == 0)
+      {
+         return file;
+      }
+
+      HANDLE mapping_handle =
+         CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (!mapping_handle)
+      {
+         return std::nullopt;
+      }
+
+      file.mp_mapping_handle = mapping_handle;
+
+      void* p_view = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+      if (!p_view)
+      {
+         return std::nullopt;
+      }
+
+      file.mp_data = static_cast<const std::byte*>(p_view);
+      file.m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+      const int fd = ::open(path.c_str(), O_RDONLY); // NOLINT
+      if (fd == -1)
+      {
+         return std::nullopt;
+      }
+
+      struct stat info{};
+      if (::fstat(fd, &info) == -1)
+      {
+         ::close(fd);
+         return std::nullopt;
+      }
+
+      // Empty files cannot be mapped, they are represented by an empty view instead
+      if (info.st_size == 0)
+      {
+         ::close(fd);
+         return file;
+      }
+
+      const auto size = static_cast<std::size_t>(info.st_size);
+      void* p_view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      // The mapping keeps its own reference to the file
+      ::close(fd);
+
+      if (p_view == MAP_FAILED) // NOLINT
+      {
+         return std::nullopt;
+      }
+
+      file.mp_data = static_cast<const std::byte*>(p_view);
+      file.m_size = size;
+#endif
+
+      return file;
+   }
+
+   mapped_file::mapped_file(mapped_file&& other) noexcept :
+      mp_data{std::exchange(other.mp_data, nullptr)}, m_size{std::exchange(other.m_size, 0)}
+#if defined(_WIN32)
+      ,
+      mp_file_handle{std::exchange(other.mp_file_handle, nullptr)},
+      mp_mapping_handle{std::exchange(other.mp_mapping_handle, nullptr)}
+#endif
+   {}
+   mapped_file::~mapped_file() { unmap(); }
+
+   auto mapped_file::operator=(mapped_file&& rhs) noexcept -> mapped_file&
+   {
+      if (this != &rhs)
+      {
+         unmap();
+
+         mp_data = std::exchange(rhs.mp_data, nullptr);
+         m_size = std::exchange(rhs.m_size, 0);
+#if defined(_WIN32)
+         mp_file_handle = std::exchange(rhs.mp_file_handle, nullptr);
+         mp_mapping_handle = std::exchange(rhs.mp_mapping_handle, nullptr);
+#endif
+      }
+
+      return *this;
+   }
+
+   auto mapped_file::data() const noexcept -> const std::byte* { return mp_data; }
+   auto mapped_file::size() const noexcept -> std::size_t { return m_size; }
+   auto mapped_file::bytes() const noexcept -> std::span<const std::byte>
+   {
+      return {mp_data, m_size};
+   }
+
+   void mapped_file::unmap() noexcept
+   {
+#if defined(_WIN32)
+      if (mp_data)
+      {
+         UnmapViewOfFile(mp_data);
+      }
+      if (mp_mapping_handle)
+      {
+         CloseHandle(mp_mapping_handle);
+      }
+      if (mp_file_handle)
+      {
+         CloseHandle(mp_file_handle);
+      }
+
+      mp_file_handle = nullptr;
+      mp_mapping_handle = nullptr;
+#else
+      if (mp_data)
+      {
+         ::munmap(const_cast<std::byte*>(mp_data), m_size); // NOLINT
+      }
+#endif
+
+      mp_data = nullptr;
+      m_size = 0;
+   }
+} // namespace util
@@ -0,0 +1,109 @@
+#include <util/stats.hpp>
+
+namespace util::stats
+{
+   auto to_string(counter c) -> std::string_view
+   {
+      switch (c)
+      {
+         case counter::draw_calls:
+            return "draw_calls";
+         case counter::pipeline_binds:
+            return "pipeline_binds";
+         case counter::descriptor_binds:
+            return "descriptor_binds";
+         case counter::elided_binds:
+            return "elided_binds";
+         case counter::bytes_uploaded:
+            return "bytes_uploaded";
+         case counter::shader_cache_hits:
+            return "shader_cache_hits";
+         case counter::shader_cache_misses:
+            return "shader_cache_misses";
+         default:
+            return "UNKNOWN";
+      }
+   }
+   auto to_string(gauge g) -> std::string_view
+   {
+      switch (g)
+      {
+         case gauge::live_buffers:
+            return "live_buffers";
+         case gauge::fence_wait_us:
+            return "fence_wait_us";
+         case gauge::acquire_latency_us:
+            return "acquire_latency_us";
+         case gauge::resident_texture_bytes:
+            return "resident_texture_bytes";
+         default:
+            return "UNKNOWN";
+      }
+   }
+
+   void end_frame() noexcept
+   {
+      auto& reg = detail::global_registry;
+
+      for (std::size_t i = 0; i < counter_count; ++i)
+      {
+         const auto value = reg.current_frame[i].exchange(0, std::memory_order_relaxed);
+
+         reg.last_frame[i].store(value, std::memory_order_relaxed);
+         reg.totals[i].fetch_add(value, std::memory_order_relaxed);
+      }
+
+      reg.frame_count.fetch_add(1, std::memory_order_relaxed);
+   }
+
+   auto take_snapshot() noexcept -> snapshot
+   {
+      const auto& reg = detail::global_registry;
+
+      snapshot snap{};
+      snap.frame_count = reg.frame_count.load(std::memory_order_relaxed);
+
+      for (std::size_t i = 0; i < counter_count; ++i)
+      {
+         snap.last_frame[i] = reg.last_frame[i].load(std::memory_order_relaxed);
+         snap.totals[i] = reg.totals[i].load(std::memory_order_relaxed) +
+            reg.current_frame[i].load(std::memory_order_relaxed);
+      }
+
+      for (std::size_t i = 0; i < gauge_count; ++i)
+      {
+         snap.gauges[i] = reg.gauges[i].load(std::memory_order_relaxed);
+      }
+
+      for (std::size_t i = 0; i < max_memory_heaps; ++i)
+      {
+         snap.heap_usage[i] = reg.heap_usage[i].load(std::memory_order_relaxed);
+      }
+
+      return snap;
+   }
+
+   void reset() noexcept
+   {
+      auto& reg = detail::global_registry;
+
+      reg.frame_count.store(0, std::memory_order_relaxed);
+
+      for (std::size_t i = 0; i < counter_count; ++i)
+      {
+         reg.current_frame[i].store(0, std::memory_order_relaxed);
+         reg.last_frame[i].store(0, std::memory_order_relaxed);
+         reg.totals[i].store(0, std::memory_order_relaxed);
+      }
+
+      for (auto& value : reg.gauges)
+      {
+         value.store(0, std::memory_order_relaxed);
+      }
+
+      for (auto& value : reg.heap_usage)
+      {
+         value.store(0, std::memory_order_relaxed);
+      }
+   }
+} // namespace util::stats
@@ -0,0 +1,92 @@
+#include <util/thread_pool.hpp>
+
+#include <algorithm>
+
+namespace util
+{
+   thread_pool::thread_pool() :
+      thread_pool{std::max(std::thread::hardware_concurrency(), 2U) - 1U}
+   {}
+   thread_pool::thread_pool(std::size_t thread_count)
+   {
+      m_workers.reserve(std::max<std::size_t>(thread_count, 1));
+      for (std::size_t i = 0; i < std::max<std::size_t>(thread_count, 1); ++i)
+      {
+         m_workers.emplace_back([this] {
+            work();
+         });
+      }
+   }
+   thread_pool::~thread_pool()
+   {
+      {
+         std::scoped_lock lock{m_mutex};
+         m_is_stopping = true;
+      }
+
+      m_task_available.notify_all();
+
+      for (auto& worker : m_workers)
+      {
+         worker.join();
+      }
+   }
+
+   void thread_pool::wait_idle()
+   {
+      std::unique_lock lock{m_mutex};
+      m_idle.wait(lock, [this] {
+         return std::empty(m_tasks) && m_active_count == 0;
+      });
+   }
+
+   auto thread_pool::thread_count() const noexcept -> std::size_t { return std::size(m_workers); }
+   auto thread_pool::pending_count() const -> std::size_t
+   {
+      std::scoped_lock lock{m_mutex};
+      return std::size(m_tasks);
+   }
+
+   void thread_pool::enqueue(std::function<void()>&& task)
+   {
+      {
+         std::scoped_lock lock{m_mutex};
+         m_tasks.emplace_back(std::move(task));
+      }
+
+      m_task_available.notify_one();
+   }
+
+   void thread_pool::work()
+   {
+      while (true)
+      {
+         std::function<void()> task;
+
+         {
+            std::unique_lock lock{m_mutex};
+            m_task_available.wait(lock, [this] {
+               return m_is_stopping || !std::empty(m_tasks);
+            });
+
+            if (std::empty(m_tasks))
+            {
+               return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            ++m_active_count;
+         }
+
+         task();
+
+         {
+            std::scoped_lock lock{m_mutex};
+            --m_active_count;
+         }
+
+         m_idle.notify_all();
+      }
+   }
+} // namespace util
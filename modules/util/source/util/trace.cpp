@@ -0,0 +1,293 @@
+#include <util/trace.hpp>
+
+#include <util/containers/dynamic_array.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace util::trace
+{
+   namespace
+   {
+      struct event
+      {
+         const char* name;
+         const char* category;
+         std::int64_t start_ns;
+         std::int64_t duration_ns;
+         std::uint32_t depth;
+      };
+
+      /**
+       * An event stored field by field in relaxed atomics. The thread dumping the trace may read
+       * a slot while its owning thread overwrites it, the copy is discarded afterwards but the
+       * reads must still not race
+       */
+      struct event_slot
+      {
+         std::atomic<const char*> name{nullptr};
+         std::atomic<const char*> category{nullptr};
+         std::atomic<std::int64_t> start_ns{0};
+         std::atomic<std::int64_t> duration_ns{0};
+         std::atomic<std::uint32_t> depth{0};
+
+         void store(const event& e) noexcept
+         {
+            name.store(e.name, std::memory_order_relaxed);
+            category.store(e.category, std::memory_order_relaxed);
+            start_ns.store(e.start_ns, std::memory_order_relaxed);
+            duration_ns.store(e.duration_ns, std::memory_order_relaxed);
+            depth.store(e.depth, std::memory_order_relaxed);
+         }
+
+         [[nodiscard]] auto load() const noexcept -> event
+         {
+            return {.name = name.load(std::memory_order_relaxed),
+                    .category = category.load(std::memory_order_relaxed),
+                    .start_ns = start_ns.load(std::memory_order_relaxed),
+                    .duration_ns = duration_ns.load(std::memory_order_relaxed),
+                    .depth = depth.load(std::memory_order_relaxed)};
+         }
+      };
+
+      /**
+       * One slot more than the zones kept: the slot the owning thread may be writing while the
+       * trace is dumped is never one of the zones read
+       */
+      constexpr std::size_t thread_buffer_slot_count = thread_buffer_capacity + 1;
+
+      /**
+       * Single producer (the owning thread), single consumer (the thread dumping the trace,
+       * serialized by the registry mutex) ring buffer of events. The producer never waits on the
+       * consumer: it overwrites the oldest events, and the consumer discards the ones that may
+       * have been overwritten while it was reading them
+       */
+      struct thread_buffer
+      {
+         std::array<event_slot, thread_buffer_slot_count> events{};
+
+         std::atomic<std::size_t> head{0};
+         std::size_t tail{0}; // guarded by the registry mutex
+
+         std::uint32_t depth{0};
+         std::uint32_t thread_id{0};
+
+         std::string name;
+      };
+
+      struct registry
+      {
+         std::mutex mutex;
+         util::dynamic_array<std::shared_ptr<thread_buffer>> buffers;
+
+         std::uint32_t next_thread_id{1};
+         std::uint64_t overwritten_count{0};
+
+         std::chrono::steady_clock::time_point epoch{std::chrono::steady_clock::now()};
+      };
+
+      auto get_registry() -> registry&
+      {
+         static registry reg;
+         return reg;
+      }
+
+      auto get_thread_buffer() -> thread_buffer&
+      {
+         // The registry keeps a reference so zones of exited threads can still be dumped
+         thread_local std::shared_ptr<thread_buffer> p_buffer = [] {
+            auto& reg = get_registry();
+            auto buffer = std::make_shared<thread_buffer>();
+
+            const std::scoped_lock lock{reg.mutex};
+            buffer->thread_id = reg.next_thread_id++;
+            buffer->name = "thread " + std::to_string(buffer->thread_id);
+            reg.buffers.push_back(buffer);
+
+            return buffer;
+         }();
+
+         return *p_buffer;
+      }
+
+      /**
+       * Index of the oldest event still held by a buffer whose head is at the given index
+       */
+      auto oldest_kept(std::size_t head) noexcept -> std::size_t
+      {
+         return head > thread_buffer_capacity ? head - thread_buffer_capacity : 0;
+      }
+
+      void write_escaped(std::ostream& os, std::string_view str)
+      {
+         for (char c : str)
+         {
+            if (c == '"' || c == '\\')
+            {
+               os << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+               os << ' ';
+            }
+            else
+            {
+               os << c;
+            }
+         }
+      }
+   } // namespace
+
+   namespace detail
+   {
+      auto now_ns() noexcept -> std::int64_t
+      {
+         return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - get_registry().epoch)
+            .count();
+      }
+
+      auto push_depth() noexcept -> std::uint32_t { return get_thread_buffer().depth++; }
+      void pop_depth() noexcept { --get_thread_buffer().depth; }
+
+      void record(const char* name, const char* category, std::int64_t start_ns,
+                  std::int64_t end_ns, std::uint32_t depth) noexcept
+      {
+         auto& buffer = get_thread_buffer();
+
+         const std::size_t head = buffer.head.load(std::memory_order_relaxed);
+
+         // Orders the last store of the head before the writes to the slot: a dump that reads
+         // any of them then sees a head showing the slot is being overwritten
+         std::atomic_thread_fence(std::memory_order_release);
+
+         buffer.events[head % thread_buffer_slot_count].store({.name = name,
+                                                               .category = category,
+                                                               .start_ns = start_ns,
+                                                               .duration_ns = end_ns - start_ns,
+                                                               .depth = depth});
+
+         buffer.head.store(head + 1, std::memory_order_release);
+      }
+   } // namespace detail
+
+   void set_enabled(bool enabled) noexcept
+   {
+      detail::is_tracing_enabled.store(enabled, std::memory_order_relaxed);
+   }
+
+   void set_thread_name(std::string_view name)
+   {
+      auto& buffer = get_thread_buffer();
+
+      const std::scoped_lock lock{get_registry().mutex};
+      buffer.name = name;
+   }
+
+   void dump_chrome_trace(std::ostream& os)
+   {
+      auto& reg = get_registry();
+      const std::scoped_lock lock{reg.mutex};
+
+      os << R"({"displayTimeUnit":"ms","traceEvents":[)";
+      os << std::fixed << std::setprecision(3);
+
+      bool first = true;
+      const auto separator = [&] {
+         if (!first)
+         {
+            os << ',';
+         }
+         first = false;
+      };
+
+      util::dynamic_array<event> events;
+      for (const auto& p_buffer : reg.buffers)
+      {
+         separator();
+         os << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << p_buffer->thread_id
+            << R"(,"args":{"name":")";
+         write_escaped(os, p_buffer->name);
+         os << R"("}})";
+
+         const std::size_t head = p_buffer->head.load(std::memory_order_acquire);
+         const std::size_t oldest = std::max(p_buffer->tail, oldest_kept(head));
+
+         events.clear();
+         for (std::size_t i = oldest; i < head; ++i)
+         {
+            events.push_back(p_buffer->events[i % thread_buffer_slot_count].load());
+         }
+
+         // Anything older than what the buffer holds now may have been overwritten while copying
+         std::atomic_thread_fence(std::memory_order_acquire);
+         const std::size_t oldest_valid =
+            std::max(oldest, oldest_kept(p_buffer->head.load(std::memory_order_relaxed)));
+
+         reg.overwritten_count += oldest_valid - p_buffer->tail;
+         p_buffer->tail = head;
+
+         for (std::size_t i = oldest_valid - oldest; i < events.size(); ++i)
+         {
+            const auto& e = events[i];
+
+            separator();
+            os << R"({"name":")";
+            write_escaped(os, e.name);
+            os << R"(","cat":")";
+            write_escaped(os, e.category);
+            os << R"(","ph":"X","pid":1,"tid":)" << p_buffer->thread_id
+               << R"(,"ts":)" << static_cast<double>(e.start_ns) / 1000.0
+               << R"(,"dur":)" << static_cast<double>(e.duration_ns) / 1000.0
+               << R"(,"args":{"depth":)" << e.depth << "}}";
+         }
+      }
+
+      os << "]}";
+   }
+
+   auto dump_chrome_trace(const std::filesystem::path& path) -> bool
+   {
+      std::ofstream file{path};
+      if (!file)
+      {
+         return false;
+      }
+
+      dump_chrome_trace(file);
+
+      return static_cast<bool>(file);
+   }
+
+   void clear()
+   {
+      auto& reg = get_registry();
+      const std::scoped_lock lock{reg.mutex};
+
+      for (const auto& p_buffer : reg.buffers)
+      {
+         p_buffer->tail = p_buffer->head.load(std::memory_order_acquire);
+      }
+   }
+
+   auto overwritten_zone_count() -> std::uint64_t
+   {
+      auto& reg = get_registry();
+      const std::scoped_lock lock{reg.mutex};
+
+      std::uint64_t count = reg.overwritten_count;
+      for (const auto& p_buffer : reg.buffers)
+      {
+         const std::size_t head = p_buffer->head.load(std::memory_order_acquire);
+         count += std::max(p_buffer->tail, oldest_kept(head)) - p_buffer->tail;
+      }
+
+      return count;
+   }
+} // namespace util::trace
@@ -0,0 +1,138 @@
+#include <util/asset_pack.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+struct asset_pack_test : public testing::Test
+{
+   asset_pack_test() :
+      path{std::filesystem::temp_directory_path() /
+           ("asset_pack_test_" + std::to_string(testing::UnitTest::GetInstance()->random_seed()))}
+   {}
+   ~asset_pack_test() override { std::filesystem::remove(path); }
+
+   static auto as_bytes(const std::string& content) -> std::span<const std::byte>
+   {
+      return std::as_bytes(std::span{content});
+   }
+   static auto as_string(std::span<const std::byte> bytes) -> std::string
+   {
+      return {reinterpret_cast<const char*>(std::data(bytes)), std::size(bytes)}; // NOLINT
+   }
+
+   std::filesystem::path path;
+};
+
+TEST_F(asset_pack_test, round_trip)
+{
+   util::asset_pack_writer writer;
+   EXPECT_TRUE(writer.add("textures/a.dds", as_bytes("first entry")));
+   EXPECT_TRUE(writer.add("textures/b.dds", as_bytes("second")));
+   EXPECT_TRUE(writer.add("empty", as_bytes("")));
+   EXPECT_EQ(writer.size(), 3);
+   ASSERT_TRUE(writer.write(path));
+
+   auto pack = util::asset_pack::open(path);
+   ASSERT_TRUE(pack.has_value());
+   EXPECT_EQ(pack->size(), 3);
+
+   const auto a = pack->find("textures/a.dds");
+   ASSERT_TRUE(a.has_value());
+   EXPECT_EQ(as_string(*a), "first entry");
+
+   const auto b = pack->find("textures/b.dds");
+   ASSERT_TRUE(b.has_value());
+   EXPECT_EQ(as_string(*b), "second");
+
+   ASSERT_TRUE(pack->contains("empty"));
+   EXPECT_TRUE(pack->find("empty")->empty());
+
+   EXPECT_FALSE(pack->contains("textures/c.dds"));
+   EXPECT_FALSE(pack->find("textures/c.dds").has_value());
+}
+
+TEST_F(asset_pack_test, entries_are_aligned)
+{
+   util::asset_pack_writer writer;
+   writer.add("a", as_bytes("abc"));
+   writer.add("b", as_bytes("defgh"));
+   ASSERT_TRUE(writer.write(path));
+
+   auto pack = util::asset_pack::open(path);
+   ASSERT_TRUE(pack.has_value());
+
+   for (const auto* p_name : {"a", "b"})
+   {
+      const auto entry = pack->find(p_name);
+      ASSERT_TRUE(entry.has_value());
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(std::data(*entry)) % // NOLINT
+                   util::asset_pack::alignment,
+                0);
+   }
+}
+
+TEST_F(asset_pack_test, duplicate_names)
+{
+   util::asset_pack_writer writer;
+   EXPECT_TRUE(writer.add("a", as_bytes("abc")));
+   EXPECT_FALSE(writer.add("a", as_bytes("def")));
+   EXPECT_EQ(writer.size(), 1);
+}
+
+TEST_F(asset_pack_test, survives_move)
+{
+   util::asset_pack_writer writer;
+   writer.add("a", as_bytes("abc"));
+   ASSERT_TRUE(writer.write(path));
+
+   auto pack = util::asset_pack::open(path).value();
+   util::asset_pack other = std::move(pack);
+
+   const auto entry = other.find("a");
+   ASSERT_TRUE(entry.has_value());
+   EXPECT_EQ(as_string(*entry), "abc");
+}
+
+TEST_F(asset_pack_test, rejects_malformed_files)
+{
+   EXPECT_FALSE(util::asset_pack::open(path / "missing").has_value());
+
+   {
+      std::ofstream file{path, std::ios::binary | std::ios::trunc};
+      file << "not a pack, just some text long enough for a header";
+   }
+   EXPECT_FALSE(util::asset_pack::open(path).has_value());
+
+   util::asset_pack_writer writer;
+   writer.add("a", as_bytes("abcdef"));
+   ASSERT_TRUE(writer.write(path));
+
+   // Cut the index short
+   std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+   EXPECT_FALSE(util::asset_pack::open(path).has_value());
+}
+
+TEST_F(asset_pack_test, rejects_oversized_entry_count)
+{
+   util::asset_pack_writer writer;
+   writer.add("a", as_bytes("abcdef"));
+   ASSERT_TRUE(writer.write(path));
+
+   // Claim far more entries than the index could hold
+   {
+      std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+      file.seekp(8);
+      file.write("\xFF\xFF\xFF\xFF", 4);
+   }
+   EXPECT_FALSE(util::asset_pack::open(path).has_value());
+
+   // One more entry than there is room for
+   {
+      std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+      file.seekp(8);
+      file.write("\x02\x00\x00\x00", 4);
+   }
+   EXPECT_FALSE(util::asset_pack::open(path).has_value());
+}
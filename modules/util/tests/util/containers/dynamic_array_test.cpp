@@ -535,6 +535,21 @@ TEST_F(small_dynamic_array, assign_n_values)
    }
 }
 
+TEST_F(small_dynamic_array, assign_n_values_self_reference)
+{
+   util::dynamic_array<int> vec{1, 2};
+
+   vec.assign(8, vec[1]);
+
+   EXPECT_EQ(vec.size(), 8);
+   EXPECT_EQ(vec.capacity(), 8);
+
+   for (auto& val : vec)
+   {
+      EXPECT_EQ(val, 2);
+   }
+}
+
 TEST_F(small_dynamic_array, assign_range)
 {
    {
@@ -905,6 +920,30 @@ TEST_F(small_dynamic_array, insert_n_values)
    }
 }
 
+TEST_F(small_dynamic_array, insert_n_values_self_reference)
+{
+   {
+      util::small_dynamic_array<int, 8> vec{1, 2, 3};
+
+      auto it = vec.insert(vec.cbegin() + 1, 2, vec[2]);
+
+      EXPECT_EQ(vec.size(), 5);
+      EXPECT_EQ(vec.capacity(), 8);
+      EXPECT_EQ(*it, 3);
+      EXPECT_EQ(vec, (util::small_dynamic_array<int, 8>{1, 3, 3, 2, 3}));
+   }
+   {
+      util::dynamic_array<int> vec{1, 2, 3};
+
+      auto it = vec.insert(vec.cbegin(), 3, vec[2]);
+
+      EXPECT_EQ(vec.size(), 6);
+      EXPECT_EQ(vec.capacity(), 8);
+      EXPECT_EQ(*it, 3);
+      EXPECT_EQ(vec, (util::dynamic_array<int>{3, 3, 3, 1, 2, 3}));
+   }
+}
+
 TEST_F(small_dynamic_array, insert_range)
 {
    util::small_dynamic_array<int, 0> vec{};
@@ -0,0 +1,106 @@
+#include <util/containers/slot_map.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+TEST(slot_map, insert_and_find)
+{
+   util::slot_map<std::string> map;
+
+   const auto a = map.insert("a");
+   const auto b = map.emplace(2U, 'b');
+
+   EXPECT_EQ(map.size(), 2);
+   EXPECT_TRUE(map.contains(a));
+   EXPECT_TRUE(map.contains(b));
+   ASSERT_NE(map.find(a), nullptr);
+   EXPECT_EQ(*map.find(a), "a");
+   EXPECT_EQ(map[b], "bb");
+   EXPECT_EQ(map.index_of(a), 0U);
+   EXPECT_EQ(map.index_of(b), 1U);
+   EXPECT_EQ(map.key_at(1), b);
+}
+
+TEST(slot_map, erase_swaps_last_value)
+{
+   util::slot_map<int> map;
+
+   const auto a = map.insert(1);
+   const auto b = map.insert(2);
+   const auto c = map.insert(3);
+
+   EXPECT_TRUE(map.erase(a));
+   EXPECT_FALSE(map.erase(a));
+
+   EXPECT_EQ(map.size(), 2);
+   EXPECT_FALSE(map.contains(a));
+   EXPECT_EQ(map.find(a), nullptr);
+   EXPECT_EQ(map.index_of(a), std::nullopt);
+
+   EXPECT_EQ(map[b], 2);
+   EXPECT_EQ(map[c], 3);
+   EXPECT_EQ(map.index_of(c), 0U);
+   EXPECT_EQ(*map.begin(), 3);
+}
+
+TEST(slot_map, stale_keys_do_not_alias_reused_slots)
+{
+   util::slot_map<int> map;
+
+   const auto a = map.insert(1);
+   map.erase(a);
+
+   const auto b = map.insert(2);
+
+   EXPECT_EQ(a.index, b.index);
+   EXPECT_NE(a, b);
+   EXPECT_FALSE(map.contains(a));
+   EXPECT_EQ(map[b], 2);
+}
+
+TEST(slot_map, clear_invalidates_keys)
+{
+   util::slot_map<std::unique_ptr<int>> map;
+
+   const auto a = map.insert(std::make_unique<int>(1));
+   const auto b = map.insert(std::make_unique<int>(2));
+
+   map.clear();
+
+   EXPECT_TRUE(map.empty());
+   EXPECT_FALSE(map.contains(a));
+   EXPECT_FALSE(map.contains(b));
+
+   const auto c = map.insert(std::make_unique<int>(3));
+   EXPECT_TRUE(map.contains(c));
+   EXPECT_EQ(*map[c], 3);
+   EXPECT_EQ(map.size(), 1);
+}
+
+TEST(slot_map, many_operations)
+{
+   util::slot_map<int> map;
+   util::dynamic_array<util::slot_key> keys;
+
+   for (int i = 0; i < 100; ++i)
+   {
+      keys.push_back(map.insert(i));
+   }
+
+   for (int i = 0; i < 100; i += 2)
+   {
+      EXPECT_TRUE(map.erase(keys[static_cast<std::size_t>(i)]));
+   }
+
+   EXPECT_EQ(map.size(), 50);
+   for (int i = 1; i < 100; i += 2)
+   {
+      const auto& key = keys[static_cast<std::size_t>(i)];
+
+      ASSERT_TRUE(map.contains(key));
+      EXPECT_EQ(map[key], i);
+      EXPECT_EQ(map.key_at(map.index_of(key).value()), key);
+   }
+}
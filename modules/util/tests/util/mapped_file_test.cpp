@@ -0,0 +1,72 @@
+#include <util/mapped_file.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+struct mapped_file_test : public testing::Test
+{
+   mapped_file_test() :
+      path{std::filesystem::temp_directory_path() /
+           ("mapped_file_test_" + std::to_string(testing::UnitTest::GetInstance()->random_seed()))}
+   {}
+   ~mapped_file_test() override { std::filesystem::remove(path); }
+
+   void write(const std::string& content) const
+   {
+      std::ofstream file{path, std::ios::binary | std::ios::trunc};
+      file << content;
+   }
+
+   std::filesystem::path path;
+};
+
+TEST_F(mapped_file_test, maps_content)
+{
+   const std::string content = "vermillon mapped file";
+   write(content);
+
+   auto file = util::mapped_file::open(path);
+   ASSERT_TRUE(file.has_value());
+   ASSERT_EQ(file->size(), std::size(content));
+
+   EXPECT_TRUE(std::equal(std::begin(content), std::end(content), file->bytes().begin(),
+                          [](char lhs, std::byte rhs) {
+                             return static_cast<std::byte>(lhs) == rhs;
+                          }));
+}
+
+TEST_F(mapped_file_test, missing_file)
+{
+   EXPECT_FALSE(util::mapped_file::open(path / "missing").has_value());
+}
+
+TEST_F(mapped_file_test, empty_file)
+{
+   write("");
+
+   auto file = util::mapped_file::open(path);
+   ASSERT_TRUE(file.has_value());
+   EXPECT_EQ(file->size(), 0);
+   EXPECT_TRUE(file->bytes().empty());
+}
+
+TEST_F(mapped_file_test, move)
+{
+   write("abcd");
+
+   auto file = util::mapped_file::open(path).value();
+   const auto* p_data = file.data();
+
+   util::mapped_file other = std::move(file);
+   EXPECT_EQ(file.data(), nullptr); // NOLINT
+   EXPECT_EQ(file.size(), 0);       // NOLINT
+   EXPECT_EQ(other.data(), p_data);
+   EXPECT_EQ(other.size(), 4);
+
+   file = std::move(other);
+   EXPECT_EQ(file.data(), p_data); // NOLINT
+   EXPECT_EQ(static_cast<char>(file.bytes()[3]), 'd');
+}
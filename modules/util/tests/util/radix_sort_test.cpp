@@ -0,0 +1,76 @@
+#include <util/containers/dynamic_array.hpp>
+#include <util/radix_sort.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+struct keyed
+{
+   std::uint64_t key;
+   std::uint32_t payload;
+};
+
+TEST(radix_sort, matches_stable_sort)
+{
+   std::mt19937_64 engine{42}; // NOLINT
+   std::uniform_int_distribution<std::uint64_t> distribution{0, 1024}; // NOLINT
+
+   util::dynamic_array<keyed> values;
+   for (std::uint32_t i = 0; i < 10000; ++i) // NOLINT
+   {
+      values.push_back({.key = distribution(engine) << 40U | distribution(engine), .payload = i});
+   }
+
+   auto expected = values;
+   std::stable_sort(expected.begin(), expected.end(), [](const keyed& lhs, const keyed& rhs) {
+      return lhs.key < rhs.key;
+   });
+
+   util::dynamic_array<keyed> scratch(values.size());
+   util::radix_sort(std::span{values.data(), values.size()},
+                    std::span{scratch.data(), scratch.size()}, [](const keyed& k) {
+                       return k.key;
+                    });
+
+   ASSERT_EQ(values.size(), expected.size());
+   for (std::size_t i = 0; i < values.size(); ++i)
+   {
+      EXPECT_EQ(values[i].key, expected[i].key);
+      EXPECT_EQ(values[i].payload, expected[i].payload);
+   }
+}
+
+TEST(radix_sort, narrow_keys)
+{
+   util::dynamic_array<std::uint32_t> values{5, 3, 0xFFFF0000, 3, 1, 0};
+   util::dynamic_array<std::uint32_t> scratch(values.size());
+
+   util::radix_sort(std::span{values.data(), values.size()},
+                    std::span{scratch.data(), scratch.size()}, [](std::uint32_t v) {
+                       return v;
+                    });
+
+   EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+}
+
+TEST(radix_sort, identical_keys)
+{
+   util::dynamic_array<keyed> values;
+   for (std::uint32_t i = 0; i < 64; ++i) // NOLINT
+   {
+      values.push_back({.key = 7, .payload = i});
+   }
+
+   util::dynamic_array<keyed> scratch(values.size());
+   util::radix_sort(std::span{values.data(), values.size()},
+                    std::span{scratch.data(), scratch.size()}, [](const keyed& k) {
+                       return k.key;
+                    });
+
+   for (std::uint32_t i = 0; i < 64; ++i) // NOLINT
+   {
+      EXPECT_EQ(values[i].payload, i);
+   }
+}
@@ -0,0 +1,85 @@
+#include <util/stats.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+struct stats_test : public testing::Test
+{
+   stats_test() { util::stats::reset(); }
+};
+
+TEST_F(stats_test, counters_per_frame)
+{
+   using util::stats::counter;
+
+   util::stats::increment(counter::draw_calls);
+   util::stats::increment(counter::draw_calls, 4);
+   util::stats::increment(counter::bytes_uploaded, 256);
+
+   auto snap = util::stats::take_snapshot();
+
+   EXPECT_EQ(snap.frame_count, 0);
+   EXPECT_EQ(snap[counter::draw_calls], 0);
+   EXPECT_EQ(snap.total(counter::draw_calls), 5);
+
+   util::stats::end_frame();
+   util::stats::increment(counter::draw_calls, 2);
+
+   snap = util::stats::take_snapshot();
+
+   EXPECT_EQ(snap.frame_count, 1);
+   EXPECT_EQ(snap[counter::draw_calls], 5);
+   EXPECT_EQ(snap[counter::bytes_uploaded], 256);
+   EXPECT_EQ(snap.total(counter::draw_calls), 7);
+
+   util::stats::end_frame();
+
+   snap = util::stats::take_snapshot();
+
+   EXPECT_EQ(snap[counter::draw_calls], 2);
+   EXPECT_EQ(snap[counter::bytes_uploaded], 0);
+   EXPECT_EQ(snap.total(counter::bytes_uploaded), 256);
+}
+
+TEST_F(stats_test, gauges_and_heaps)
+{
+   using util::stats::gauge;
+
+   util::stats::add(gauge::live_buffers, 3);
+   util::stats::add(gauge::live_buffers, -1);
+   util::stats::set(gauge::fence_wait_us, 120);
+   util::stats::add_heap_usage(1, 1024);
+   util::stats::add_heap_usage(1, -256);
+   util::stats::add_heap_usage(util::stats::max_memory_heaps, 1024);
+
+   const auto snap = util::stats::take_snapshot();
+
+   EXPECT_EQ(snap[gauge::live_buffers], 2);
+   EXPECT_EQ(snap[gauge::fence_wait_us], 120);
+   EXPECT_EQ(snap.heap_usage[0], 0);
+   EXPECT_EQ(snap.heap_usage[1], 768);
+
+   util::stats::end_frame();
+
+   EXPECT_EQ(util::stats::take_snapshot()[gauge::live_buffers], 2);
+}
+
+TEST_F(stats_test, concurrent_increments)
+{
+   using util::stats::counter;
+
+   const auto work = [] {
+      for (int i = 0; i < 10000; ++i)
+      {
+         util::stats::increment(counter::descriptor_binds);
+      }
+   };
+
+   std::thread a{work};
+   std::thread b{work};
+   a.join();
+   b.join();
+
+   EXPECT_EQ(util::stats::take_snapshot().total(counter::descriptor_binds), 20000);
+}
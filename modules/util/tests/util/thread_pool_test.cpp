@@ -0,0 +1,79 @@
+#include <util/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+TEST(thread_pool_test, returns_results)
+{
+   util::thread_pool pool{4};
+
+   EXPECT_EQ(pool.thread_count(), 4);
+
+   util::dynamic_array<std::future<int>> futures;
+   for (int i = 0; i < 64; ++i)
+   {
+      futures.emplace_back(pool.submit([i] {
+         return i * i;
+      }));
+   }
+
+   for (int i = 0; auto& future : futures)
+   {
+      EXPECT_EQ(future.get(), i * i);
+      ++i;
+   }
+}
+
+TEST(thread_pool_test, wait_idle)
+{
+   util::thread_pool pool{3};
+
+   std::atomic<int> count{0};
+   for (int i = 0; i < 1000; ++i)
+   {
+      pool.submit([&count] {
+         count.fetch_add(1, std::memory_order_relaxed);
+      });
+   }
+
+   pool.wait_idle();
+
+   EXPECT_EQ(count.load(), 1000);
+   EXPECT_EQ(pool.pending_count(), 0);
+}
+
+TEST(thread_pool_test, exceptions_reach_future)
+{
+   util::thread_pool pool{1};
+
+   auto future = pool.submit([]() -> int {
+      throw std::runtime_error{"task failed"};
+   });
+
+   EXPECT_THROW(future.get(), std::runtime_error);
+
+   // The worker survives the exception
+   EXPECT_EQ(pool.submit([] {
+                    return 7;
+                 }).get(),
+             7);
+}
+
+TEST(thread_pool_test, destructor_drains_queue)
+{
+   std::atomic<int> count{0};
+
+   {
+      util::thread_pool pool{2};
+      for (int i = 0; i < 100; ++i)
+      {
+         pool.submit([&count] {
+            count.fetch_add(1, std::memory_order_relaxed);
+         });
+      }
+   }
+
+   EXPECT_EQ(count.load(), 100);
+}
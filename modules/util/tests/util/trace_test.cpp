@@ -0,0 +1,157 @@
+#include <util/trace.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+
+struct trace_test : public testing::Test
+{
+   trace_test() { util::trace::clear(); }
+   ~trace_test() override { util::trace::set_enabled(false); }
+};
+
+static auto count_occurrences(const std::string& str, const std::string& pattern) -> std::size_t
+{
+   std::size_t count = 0;
+   for (auto pos = str.find(pattern); pos != std::string::npos;
+        pos = str.find(pattern, pos + pattern.size()))
+   {
+      ++count;
+   }
+
+   return count;
+}
+
+TEST_F(trace_test, disabled_by_default)
+{
+   EXPECT_FALSE(util::trace::is_enabled());
+
+   {
+      UTIL_TRACE_ZONE("disabled_zone");
+   }
+
+   std::stringstream ss;
+   util::trace::dump_chrome_trace(ss);
+
+   EXPECT_EQ(ss.str().find("disabled_zone"), std::string::npos);
+}
+
+TEST_F(trace_test, nested_zones)
+{
+   util::trace::set_enabled(true);
+
+   {
+      UTIL_TRACE_ZONE("outer");
+      {
+         UTIL_TRACE_ZONE_CAT("inner", "test");
+      }
+   }
+
+   std::stringstream ss;
+   util::trace::dump_chrome_trace(ss);
+   const std::string json = ss.str();
+
+   EXPECT_EQ(json.find(R"({"displayTimeUnit":"ms","traceEvents":[)"), 0);
+   EXPECT_EQ(json.back(), '}');
+   EXPECT_NE(json.find(R"("name":"outer","cat":"engine","ph":"X")"), std::string::npos);
+   EXPECT_NE(json.find(R"("name":"inner","cat":"test","ph":"X")"), std::string::npos);
+   EXPECT_NE(json.find(R"("depth":1)"), std::string::npos);
+
+   // Zones are consumed by the dump
+   std::stringstream second;
+   util::trace::dump_chrome_trace(second);
+
+   EXPECT_EQ(second.str().find("outer"), std::string::npos);
+}
+
+TEST_F(trace_test, multiple_threads)
+{
+   util::trace::set_enabled(true);
+
+   const auto work = [](const char* name) {
+      util::trace::set_thread_name(name);
+      for (int i = 0; i < 100; ++i)
+      {
+         UTIL_TRACE_ZONE("worker_zone");
+      }
+   };
+
+   std::thread a{work, "worker \"a\""};
+   std::thread b{work, "worker_b"};
+   a.join();
+   b.join();
+
+   std::stringstream ss;
+   util::trace::dump_chrome_trace(ss);
+   const std::string json = ss.str();
+
+   EXPECT_EQ(count_occurrences(json, R"("name":"worker_zone")"), 200);
+   EXPECT_NE(json.find(R"("name":"worker \"a\"")"), std::string::npos);
+   EXPECT_NE(json.find(R"("name":"worker_b")"), std::string::npos);
+}
+
+TEST_F(trace_test, full_buffer_overwrites_oldest_zones)
+{
+   util::trace::set_enabled(true);
+
+   const auto overwritten = util::trace::overwritten_zone_count();
+
+   for (std::size_t i = 0; i < 10; ++i)
+   {
+      UTIL_TRACE_ZONE("oldest_zone");
+   }
+
+   for (std::size_t i = 0; i < util::trace::thread_buffer_capacity; ++i)
+   {
+      UTIL_TRACE_ZONE("newest_zone");
+   }
+
+   EXPECT_EQ(util::trace::overwritten_zone_count() - overwritten, 10);
+
+   std::stringstream ss;
+   util::trace::dump_chrome_trace(ss);
+
+   EXPECT_EQ(count_occurrences(ss.str(), R"("name":"oldest_zone")"), 0);
+   EXPECT_EQ(count_occurrences(ss.str(), R"("name":"newest_zone")"),
+             util::trace::thread_buffer_capacity);
+   EXPECT_EQ(util::trace::overwritten_zone_count() - overwritten, 10);
+}
+
+TEST_F(trace_test, dump_while_recording)
+{
+   util::trace::set_enabled(true);
+
+   std::atomic<bool> done{false};
+   std::atomic<std::size_t> zone_count{0};
+   std::thread worker{[&] {
+      while (!done.load())
+      {
+         UTIL_TRACE_ZONE("busy_zone");
+         zone_count.fetch_add(1, std::memory_order_relaxed);
+      }
+   }};
+
+   // Let the worker wrap around its buffer so the dumps read slots while they are overwritten
+   while (zone_count.load(std::memory_order_relaxed) <= 2 * util::trace::thread_buffer_capacity)
+   {
+      std::this_thread::yield();
+   }
+
+   for (int i = 0; i < 50; ++i)
+   {
+      std::stringstream ss;
+      util::trace::dump_chrome_trace(ss);
+
+      const auto json = ss.str();
+
+      EXPECT_EQ(json.back(), '}');
+      EXPECT_LE(count_occurrences(json, R"("name":"busy_zone")"),
+                util::trace::thread_buffer_capacity);
+   }
+
+   done.store(true);
+   worker.join();
+}
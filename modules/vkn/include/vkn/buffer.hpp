@@ -14,21 +14,50 @@ namespace vkn
    {
       failed_to_create_buffer,
       failed_to_allocate_memory,
-      failed_to_find_desired_memory_type
+      failed_to_find_desired_memory_type,
+      failed_to_map_memory
    };
 
    class buffer : public owning_handle<vk::Buffer>
    {
    public:
+      buffer() = default;
+      buffer(const buffer&) = delete;
+      buffer(buffer&&) noexcept = default;
+      ~buffer();
+
+      auto operator=(const buffer&) -> buffer& = delete;
+      auto operator=(buffer&& rhs) noexcept -> buffer&;
+
       [[nodiscard]] auto memory() const noexcept -> vk::DeviceMemory;
+      /**
+       * Get the size of the device memory bound to the buffer
+       */
+      [[nodiscard]] auto memory_size() const noexcept -> vk::DeviceSize;
+      /**
+       * Get the host address of the buffer's memory, or nullptr if the buffer was not built as
+       * persistently mapped
+       */
+      [[nodiscard]] auto mapped_data() const noexcept -> void*;
       /**
        * Get the device used to create the underlying handle
        */
       [[nodiscard]] auto device() const noexcept -> vk::Device;
 
+   private:
+      /**
+       * Remove the buffer's memory from the engine statistics
+       */
+      void release_stats() noexcept;
+
    private:
       vk::UniqueDeviceMemory m_memory;
 
+      vk::DeviceSize m_memory_size{0};
+      std::uint32_t m_heap_index{0};
+
+      void* mp_mapped_data{nullptr};
+
    public:
       class builder
       {
@@ -42,11 +71,23 @@ namespace vkn
          auto set_concurrent() noexcept -> builder&;
          auto set_desired_memory_type(const vk::MemoryPropertyFlags& flags) noexcept -> builder&;
          auto add_fallback_memory_type(const vk::MemoryPropertyFlags& flags) noexcept -> builder&;
+         /**
+          * Keep the memory of the buffer mapped for its whole lifetime. The memory types used
+          * must be host visible
+          */
+         auto set_persistently_mapped() noexcept -> builder&;
 
       private:
          [[nodiscard]] auto create_buffer() const -> vkn::result<vk::UniqueBuffer>;
-         [[nodiscard]] auto allocate_memory(vk::Buffer buffer) const
-            -> vkn::result<vk::UniqueDeviceMemory>;
+         struct allocation
+         {
+            vk::UniqueDeviceMemory memory;
+            vk::DeviceSize size{0};
+            std::uint32_t heap_index{0};
+         };
+
+         [[nodiscard]] auto allocate_memory(vk::Buffer buffer) const -> vkn::result<allocation>;
+         [[nodiscard]] auto map_memory(vk::DeviceMemory memory) const -> vkn::result<void*>;
 
          [[nodiscard]] auto
          find_memory_requirements(std::uint32_t type_filter,
@@ -67,6 +108,8 @@ namespace vkn
 
             vk::MemoryPropertyFlags desired_mem_flags;
             vk::MemoryPropertyFlags fallback_mem_flags;
+
+            bool is_persistently_mapped{false};
          } m_info;
       };
    };
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <vkn/core.hpp>
+#include <vkn/device.hpp>
+
+#include <util/strong_type.hpp>
+
+namespace vkn
+{
+   /**
+    * The possible errors that may occur during the construction or use of the
+    * descriptor_allocator object
+    */
+   enum struct descriptor_allocator_error
+   {
+      failed_to_create_descriptor_pool,
+      failed_to_allocate_descriptor_set,
+      no_pool_sizes_provided
+   };
+
+   /**
+    * Convert a descriptor_allocator_error enum to a string
+    */
+   auto to_string(descriptor_allocator_error err) -> std::string;
+   /**
+    * Convert a descriptor_allocator_error enum value and an error code from a vulkan error into
+    * a vkn::error
+    */
+   auto make_error(descriptor_allocator_error err, std::error_code ec) -> vkn::error;
+
+   /**
+    * Allocates descriptor sets of any layout from a growing chain of descriptor pools. When a
+    * pool runs out of memory the next one in the chain is used, creating it if needed with twice
+    * as many sets as the previous one. Resetting the allocator resets every pool at once and
+    * keeps them around for reuse, which makes it suited to per-frame allocations
+    */
+   class descriptor_allocator final
+   {
+      static constexpr std::uint32_t max_sets_per_pool = 4096U;
+
+   public:
+      /**
+       * The number of descriptors of a type to reserve per set in each pool
+       */
+      struct pool_ratio
+      {
+         vk::DescriptorType type;
+         float ratio;
+      };
+
+      /**
+       * Allocate a descriptor set with the given layout
+       */
+      auto allocate(vk::DescriptorSetLayout layout) -> vkn::result<vk::DescriptorSet>;
+      /**
+       * Return every set allocated so far to their pools
+       */
+      void reset();
+
+      [[nodiscard]] auto device() const noexcept -> vk::Device;
+      /**
+       * Get the number of pools created so far
+       */
+      [[nodiscard]] auto pool_count() const noexcept -> std::size_t;
+
+   private:
+      auto create_pool() -> vkn::result<vk::UniqueDescriptorPool>;
+
+   private:
+      vk::Device m_device;
+
+      std::shared_ptr<util::logger> mp_logger;
+
+      util::small_dynamic_array<pool_ratio, 8> m_ratios;
+      vk::DescriptorPoolCreateFlags m_flags;
+      std::uint32_t m_next_set_count{0};
+
+      util::dynamic_array<vk::UniqueDescriptorPool> m_pools;
+      std::size_t m_current_pool{0};
+
+   public:
+      /**
+       * Helper class to simplify the building of a descriptor_allocator object
+       */
+      class builder final
+      {
+      public:
+         builder(const vkn::device& device, std::shared_ptr<util::logger> p_logger) noexcept;
+
+         /**
+          * Attempt to create the descriptor_allocator along with its first pool. Returns an
+          * error otherwise
+          */
+         [[nodiscard]] auto build() const -> vkn::result<descriptor_allocator>;
+
+         /**
+          * Set the number of sets of the first pool. Defaults to 64
+          */
+         auto set_initial_set_count(util::count32_t count) noexcept -> builder&;
+         /**
+          * Reserve `ratio` descriptors of the given type per set in every pool
+          */
+         auto add_pool_ratio(vk::DescriptorType type, float ratio) -> builder&;
+         /**
+          * Set the flags the pools are created with
+          */
+         auto set_pool_flags(vk::DescriptorPoolCreateFlags flags) noexcept -> builder&;
+
+      private:
+         vk::Device m_device;
+
+         std::shared_ptr<util::logger> mp_logger;
+
+         struct info
+         {
+            util::count32_t initial_set_count{64U}; // NOLINT
+
+            util::small_dynamic_array<pool_ratio, 8> ratios;
+            vk::DescriptorPoolCreateFlags flags;
+         } m_info;
+      };
+   };
+} // namespace vkn
+
+namespace std
+{
+   template <>
+   struct is_error_code_enum<vkn::descriptor_allocator_error> : true_type
+   {
+   };
+} // namespace std
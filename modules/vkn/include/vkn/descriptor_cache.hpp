@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vkn/descriptor_allocator.hpp>
+
+#include <span>
+#include <unordered_map>
+
+namespace vkn
+{
+   /**
+    * A single descriptor to write in a set. Only the info matching the type is used
+    */
+   struct descriptor_write
+   {
+      std::uint32_t binding{0};
+      vk::DescriptorType type{vk::DescriptorType::eUniformBuffer};
+
+      vk::DescriptorBufferInfo buffer_info{};
+      vk::DescriptorImageInfo image_info{};
+
+      auto operator==(const descriptor_write& rhs) const -> bool = default;
+   };
+
+   /**
+    * Hands out descriptor sets that are never written to after creation. Sets are looked up by
+    * their layout and writes, so asking twice for the same bindings returns the same set without
+    * calling vkUpdateDescriptorSets again
+    */
+   class descriptor_cache final
+   {
+   public:
+      descriptor_cache() = default;
+      explicit descriptor_cache(descriptor_allocator&& allocator) noexcept;
+
+      /**
+       * Get the set of the given layout holding the given descriptors, allocating and writing it
+       * on the first request
+       */
+      auto get(vk::DescriptorSetLayout layout, std::span<const descriptor_write> writes)
+         -> vkn::result<vk::DescriptorSet>;
+      /**
+       * Forget every cached set and return them to the allocator. To be called once the sets are
+       * no longer in use, for example when the resources they point to are recreated
+       */
+      void clear();
+
+      [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+   private:
+      struct key
+      {
+         vk::DescriptorSetLayout layout;
+         util::small_dynamic_array<descriptor_write, 4> writes;
+
+         auto operator==(const key& rhs) const -> bool;
+      };
+
+      struct key_hash
+      {
+         auto operator()(const key& k) const noexcept -> std::size_t;
+      };
+
+      descriptor_allocator m_allocator;
+
+      std::unordered_map<key, vk::DescriptorSet, key_hash> m_sets;
+   };
+} // namespace vkn
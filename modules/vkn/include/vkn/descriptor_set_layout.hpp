@@ -36,11 +36,21 @@ namespace vkn
          auto
          set_bindings(const util::dynamic_array<vk::DescriptorSetLayoutBinding>& bindings) noexcept
             -> builder&;
+         /**
+          * Set the descriptor indexing flags of each binding, in the same order as the bindings.
+          * Requires the matching Vulkan 1.2 features to be enabled on the device
+          */
+         auto set_binding_flags(const util::dynamic_array<vk::DescriptorBindingFlags>& flags)
+            -> builder&;
+         auto set_flags(vk::DescriptorSetLayoutCreateFlags flags) noexcept -> builder&;
 
       private:
          struct build_info
          {
             util::dynamic_array<vk::DescriptorSetLayoutBinding> bindings;
+            util::dynamic_array<vk::DescriptorBindingFlags> binding_flags;
+
+            vk::DescriptorSetLayoutCreateFlags flags;
          } m_info;
 
          vk::Device m_device;
@@ -75,6 +75,8 @@ namespace vkn
          vk::Device device{};
          uint32_t version{0u};
 
+         vk::PhysicalDeviceVulkan12Features vulkan12_features{};
+
          util::dynamic_array<const char*> extensions{};
       };
 
@@ -127,6 +129,11 @@ namespace vkn
        * Get the version of the current vulkan session.
        */
       [[nodiscard]] auto get_vulkan_version() const noexcept -> uint32_t;
+      /**
+       * Get the Vulkan 1.2 features enabled on the device.
+       */
+      [[nodiscard]] auto vulkan12_features() const noexcept
+         -> const vk::PhysicalDeviceVulkan12Features&;
 
    private:
       vk::Device m_device{nullptr};
@@ -134,6 +141,8 @@ namespace vkn
 
       uint32_t m_version{0};
 
+      vk::PhysicalDeviceVulkan12Features m_vulkan12_features{};
+
       util::dynamic_array<const char*> m_extensions;
 
    public:
@@ -161,6 +170,12 @@ namespace vkn
           * Add a device extension that should be enabled with the device construction
           */
          auto add_desired_extension(const std::string& extension_name) -> builder&;
+         /**
+          * Set the Vulkan 1.2 features to enable with the device construction. Only features
+          * supported by the physical device should be requested
+          */
+         auto set_vulkan12_features(const vk::PhysicalDeviceVulkan12Features& features)
+            -> builder&;
 
       private:
          const loader& m_loader;
@@ -175,6 +190,8 @@ namespace vkn
 
             util::dynamic_array<queue::description> queue_descriptions;
             util::dynamic_array<const char*> desired_extensions;
+
+            vk::PhysicalDeviceVulkan12Features vulkan12_features{};
          } m_info;
       };
    };
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <vkn/device.hpp>
+
+#include <util/strong_type.hpp>
+
+#include <monads/maybe.hpp>
+
+namespace vkn
+{
+   /**
+    * The possible errors that may occur during the construction of the image object
+    */
+   enum struct image_error
+   {
+      failed_to_create_image,
+      failed_to_allocate_memory,
+      failed_to_find_desired_memory_type,
+      invalid_extent
+   };
+
+   /**
+    * Convert an image_error enum to a string
+    */
+   auto to_string(image_error err) -> std::string;
+   /**
+    * Convert an image_error enum value and an error code from a vulkan error into a vkn::error
+    */
+   auto make_error(image_error err, std::error_code ec) -> vkn::error;
+
+   /**
+    * Wrapper class around a 2D vulkan image and the device memory bound to it. May only be
+    * built using the inner builder class
+    */
+   class image final : public owning_handle<vk::Image>
+   {
+   public:
+      image() = default;
+      image(const image&) = delete;
+      image(image&&) noexcept = default;
+      ~image();
+
+      auto operator=(const image&) -> image& = delete;
+      auto operator=(image&& rhs) noexcept -> image&;
+
+      [[nodiscard]] auto memory() const noexcept -> vk::DeviceMemory;
+      /**
+       * Get the size of the device memory bound to the image
+       */
+      [[nodiscard]] auto memory_size() const noexcept -> vk::DeviceSize;
+      [[nodiscard]] auto format() const noexcept -> vk::Format;
+      [[nodiscard]] auto extent() const noexcept -> vk::Extent2D;
+      [[nodiscard]] auto mip_levels() const noexcept -> std::uint32_t;
+      /**
+       * Get the device used to create the underlying handle
+       */
+      [[nodiscard]] auto device() const noexcept -> vk::Device;
+
+   private:
+      /**
+       * Remove the image's memory from the engine statistics
+       */
+      void release_stats() noexcept;
+
+   private:
+      vk::UniqueDeviceMemory m_memory;
+
+      vk::DeviceSize m_memory_size{0};
+      std::uint32_t m_heap_index{0};
+
+      vk::Format m_format{vk::Format::eUndefined};
+      vk::Extent2D m_extent{};
+      std::uint32_t m_mip_levels{1};
+
+   public:
+      /**
+       * Helper class to simplify the building of an image object
+       */
+      class builder
+      {
+      public:
+         builder(const vkn::device& device, std::shared_ptr<util::logger> p_logger) noexcept;
+
+         /**
+          * Attempt to create the image and bind memory to it. Returns an error otherwise
+          */
+         [[nodiscard]] auto build() const noexcept -> vkn::result<image>;
+
+         auto set_format(vk::Format format) noexcept -> builder&;
+         auto set_extent(const vk::Extent2D& extent) noexcept -> builder&;
+         /**
+          * Set the number of mip levels of the image. Defaults to a single level
+          */
+         auto set_mip_levels(util::count32_t count) noexcept -> builder&;
+         auto set_usage(const vk::ImageUsageFlags& flags) noexcept -> builder&;
+         /**
+          * Set the memory properties of the image's memory. Defaults to device local memory
+          */
+         auto set_desired_memory_type(const vk::MemoryPropertyFlags& flags) noexcept -> builder&;
+
+      private:
+         struct allocation
+         {
+            vk::UniqueDeviceMemory memory;
+            vk::DeviceSize size{0};
+            std::uint32_t heap_index{0};
+         };
+
+         [[nodiscard]] auto create_image() const -> vkn::result<vk::UniqueImage>;
+         [[nodiscard]] auto allocate_memory(vk::Image image) const -> vkn::result<allocation>;
+
+         [[nodiscard]] auto
+         find_memory_type(std::uint32_t type_filter,
+                          const vk::MemoryPropertyFlags& properties) const noexcept
+            -> monad::maybe<std::uint32_t>;
+
+      private:
+         std::shared_ptr<util::logger> mp_logger;
+
+         struct info
+         {
+            vk::Device device;
+            vk::PhysicalDevice physical_device;
+
+            vk::Format format{vk::Format::eR8G8B8A8Srgb};
+            vk::Extent2D extent{};
+            util::count32_t mip_levels{1};
+            vk::ImageUsageFlags usage{};
+
+            vk::MemoryPropertyFlags desired_mem_flags{vk::MemoryPropertyFlagBits::eDeviceLocal};
+         } m_info;
+      };
+   };
+
+   /**
+    * Get the number of mip levels of a full mip chain down to 1x1 for the given extent
+    */
+   auto full_mip_chain_length(const vk::Extent2D& extent) noexcept -> std::uint32_t;
+} // namespace vkn
+
+namespace std
+{
+   template <>
+   struct is_error_code_enum<vkn::image_error> : true_type
+   {
+   };
+} // namespace std
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vkn/device.hpp>
+#include <vkn/image.hpp>
+
+namespace vkn
+{
+   /**
+    * The possible errors that may occur during the construction of the image_view object
+    */
+   enum struct image_view_error
+   {
+      failed_to_create_image_view,
+      no_image_provided
+   };
+
+   /**
+    * Convert an image_view_error enum to a string
+    */
+   auto to_string(image_view_error err) -> std::string;
+   /**
+    * Convert an image_view_error enum value and an error code from a vulkan error into a
+    * vkn::error
+    */
+   auto make_error(image_view_error err, std::error_code ec) -> vkn::error;
+
+   /**
+    * Wrapper class around a vulkan image view of a 2D image. May only be built using the inner
+    * builder class
+    */
+   class image_view final : public owning_handle<vk::ImageView>
+   {
+   public:
+      /**
+       * Get the device used to create the underlying handle
+       */
+      [[nodiscard]] auto device() const noexcept -> vk::Device;
+
+   public:
+      /**
+       * Helper class to simplify the building of an image_view object
+       */
+      class builder
+      {
+      public:
+         builder(const vkn::device& device, std::shared_ptr<util::logger> p_logger) noexcept;
+
+         /**
+          * Attempt to create the image_view object. Returns an error otherwise
+          */
+         [[nodiscard]] auto build() const noexcept -> vkn::result<image_view>;
+
+         /**
+          * Set the image viewed. The format & every mip level of the image are used
+          */
+         auto set_image(const vkn::image& image) noexcept -> builder&;
+         /**
+          * Set the aspect of the image that is viewed. Defaults to the colour aspect
+          */
+         auto set_aspect(vk::ImageAspectFlags aspect) noexcept -> builder&;
+
+      private:
+         std::shared_ptr<util::logger> mp_logger;
+
+         struct info
+         {
+            vk::Device device;
+
+            vk::Image image;
+            vk::Format format{vk::Format::eUndefined};
+            std::uint32_t mip_levels{1};
+            vk::ImageAspectFlags aspect{vk::ImageAspectFlagBits::eColor};
+         } m_info;
+      };
+   };
+} // namespace vkn
+
+namespace std
+{
+   template <>
+   struct is_error_code_enum<vkn::image_view_error> : true_type
+   {
+   };
+} // namespace std
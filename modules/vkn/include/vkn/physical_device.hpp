@@ -93,6 +93,7 @@ namespace vkn
       {
          std::string_view name{};
          vk::PhysicalDeviceFeatures features{};
+         vk::PhysicalDeviceVulkan12Features vulkan12_features{};
          vk::PhysicalDeviceProperties properties{};
          vk::PhysicalDeviceMemoryProperties mem_properties{};
          vk::Instance instance{nullptr};
@@ -137,6 +138,20 @@ namespace vkn
        * Get a const reference to features of the graphics card
        */
       [[nodiscard]] auto features() const noexcept -> const vk::PhysicalDeviceFeatures&;
+      /**
+       * Get a const reference to the Vulkan 1.2 features supported by the graphics card
+       */
+      [[nodiscard]] auto vulkan12_features() const noexcept
+         -> const vk::PhysicalDeviceVulkan12Features&;
+      /**
+       * Get a const reference to the properties & limits of the graphics card
+       */
+      [[nodiscard]] auto properties() const noexcept -> const vk::PhysicalDeviceProperties&;
+      /**
+       * Get a const reference to the memory heaps & types of the graphics card
+       */
+      [[nodiscard]] auto memory_properties() const noexcept
+         -> const vk::PhysicalDeviceMemoryProperties&;
       /**
        * Get a const reference to the surface used by the graphics card
        */
@@ -151,6 +166,7 @@ namespace vkn
       std::string m_name{};
 
       vk::PhysicalDeviceFeatures m_features{};
+      vk::PhysicalDeviceVulkan12Features m_vulkan12_features{};
       vk::PhysicalDeviceProperties m_properties{};
       vk::PhysicalDeviceMemoryProperties m_mem_properties{};
 
@@ -244,6 +260,7 @@ namespace vkn
             util::small_dynamic_array<vk::QueueFamilyProperties, 16> queue_families{};
 
             vk::PhysicalDeviceFeatures features{};
+            vk::PhysicalDeviceVulkan12Features vulkan12_features{};
             vk::PhysicalDeviceProperties properties{};
             vk::PhysicalDeviceMemoryProperties mem_properties{};
          };
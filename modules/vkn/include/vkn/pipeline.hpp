@@ -58,9 +58,20 @@ namespace vkn
          auto add_vertex_binding(vk::VertexInputBindingDescription&& binding) noexcept -> builder&;
          auto add_vertex_attribute(vk::VertexInputAttributeDescription&& attribute) noexcept
             -> builder&;
+         /**
+          * Add a descriptor set layout. Sets are numbered in the order their layouts are added
+          */
          auto add_set_layout(const std::string& name,
                              const util::dynamic_array<vk::DescriptorSetLayoutBinding>& binding)
             -> builder&;
+         /**
+          * Add a descriptor set layout using descriptor indexing, with one set of flags per
+          * binding
+          */
+         auto add_set_layout(const std::string& name,
+                             const util::dynamic_array<vk::DescriptorSetLayoutBinding>& binding,
+                             const util::dynamic_array<vk::DescriptorBindingFlags>& binding_flags,
+                             vk::DescriptorSetLayoutCreateFlags flags) -> builder&;
          auto add_push_constant(const std::string& name, vkn::shader_type shader_type,
                                 util::size_t offset, util::size_t size) -> builder&;
 
@@ -83,6 +94,8 @@ namespace vkn
          {
             std::string name;
             util::dynamic_array<vk::DescriptorSetLayoutBinding> binding;
+            util::dynamic_array<vk::DescriptorBindingFlags> binding_flags;
+            vk::DescriptorSetLayoutCreateFlags flags;
          };
 
          struct push_constant_info
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <vkn/core.hpp>
+#include <vkn/device.hpp>
+
+namespace vkn
+{
+   /**
+    * The possible errors that may occur during the construction of the
+    * query_pool object
+    */
+   enum struct query_pool_error
+   {
+      failed_to_create_query_pool,
+      invalid_query_count
+   };
+
+   /**
+    * Convert a query_pool_error enum to a string
+    */
+   auto to_string(query_pool_error err) -> std::string;
+   /**
+    * Convert a query_pool_error enum value and an error code from a vulkan error into
+    * a vkn::error
+    */
+   auto make_error(query_pool_error err, std::error_code ec) -> vkn::error;
+
+   /**
+    * Wrapper class around the vulkan query pool handle. May only be built using
+    * the inner builder class
+    */
+   class query_pool final : public owning_handle<vk::QueryPool>
+   {
+   public:
+      /**
+       * Get the device used to create the underlying handle
+       */
+      [[nodiscard]] auto device() const noexcept -> vk::Device;
+      /**
+       * Get the type of queries held by the pool
+       */
+      [[nodiscard]] auto type() const noexcept -> vk::QueryType;
+      /**
+       * Get the number of queries held by the pool
+       */
+      [[nodiscard]] auto query_count() const noexcept -> util::count32_t;
+
+   private:
+      vk::QueryType m_type{vk::QueryType::eTimestamp};
+      util::count32_t m_query_count{0};
+
+   public:
+      /**
+       * Helper class to simplify the building of a query_pool object
+       */
+      class builder
+      {
+      public:
+         builder(const vkn::device& device, std::shared_ptr<util::logger> p_logger) noexcept;
+
+         /**
+          * Attempt to create the query_pool object. Returns an error
+          * otherwise
+          */
+         [[nodiscard]] auto build() const noexcept -> vkn::result<query_pool>;
+
+         /**
+          * Set the type of queries stored in the pool. Defaults to timestamp queries
+          */
+         auto set_query_type(vk::QueryType type) noexcept -> builder&;
+         /**
+          * Set the number of queries available in the pool
+          */
+         auto set_query_count(util::count32_t count) noexcept -> builder&;
+
+      private:
+         std::shared_ptr<util::logger> mp_logger;
+
+         struct info
+         {
+            vk::Device device;
+
+            vk::QueryType type{vk::QueryType::eTimestamp};
+            util::count32_t query_count{0};
+         } m_info;
+      };
+   };
+} // namespace vkn
+
+namespace std
+{
+   template <>
+   struct is_error_code_enum<vkn::query_pool_error> : true_type
+   {
+   };
+} // namespace std
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vkn/device.hpp>
+
+namespace vkn
+{
+   /**
+    * The possible errors that may occur during the construction of the sampler object
+    */
+   enum struct sampler_error
+   {
+      failed_to_create_sampler
+   };
+
+   /**
+    * Convert a sampler_error enum to a string
+    */
+   auto to_string(sampler_error err) -> std::string;
+   /**
+    * Convert a sampler_error enum value and an error code from a vulkan error into a vkn::error
+    */
+   auto make_error(sampler_error err, std::error_code ec) -> vkn::error;
+
+   /**
+    * Wrapper class around a vulkan sampler. May only be built using the inner builder class
+    */
+   class sampler final : public owning_handle<vk::Sampler>
+   {
+   public:
+      /**
+       * Get the device used to create the underlying handle
+       */
+      [[nodiscard]] auto device() const noexcept -> vk::Device;
+
+   public:
+      /**
+       * Helper class to simplify the building of a sampler object. Defaults to trilinear
+       * filtering with repeating addressing
+       */
+      class builder
+      {
+      public:
+         builder(const vkn::device& device, std::shared_ptr<util::logger> p_logger) noexcept;
+
+         /**
+          * Attempt to create the sampler object. Returns an error otherwise
+          */
+         [[nodiscard]] auto build() const noexcept -> vkn::result<sampler>;
+
+         auto set_filter(vk::Filter filter) noexcept -> builder&;
+         auto set_mipmap_mode(vk::SamplerMipmapMode mode) noexcept -> builder&;
+         auto set_address_mode(vk::SamplerAddressMode mode) noexcept -> builder&;
+         /**
+          * Enable anisotropic filtering if the device supports it. The value is clamped to the
+          * device's limit
+          */
+         auto set_max_anisotropy(float anisotropy) noexcept -> builder&;
+
+      private:
+         std::shared_ptr<util::logger> mp_logger;
+
+         struct info
+         {
+            vk::Device device;
+
+            bool is_anisotropy_supported{false};
+            float max_supported_anisotropy{1.0F};
+
+            vk::Filter filter{vk::Filter::eLinear};
+            vk::SamplerMipmapMode mipmap_mode{vk::SamplerMipmapMode::eLinear};
+            vk::SamplerAddressMode address_mode{vk::SamplerAddressMode::eRepeat};
+            float max_anisotropy{1.0F};
+         } m_info;
+      };
+   };
+} // namespace vkn
+
+namespace std
+{
+   template <>
+   struct is_error_code_enum<vkn::sampler_error> : true_type
+   {
+   };
+} // namespace std
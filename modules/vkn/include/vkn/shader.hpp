@@ -13,6 +13,7 @@
 
 #include <spirv_cross.hpp>
 
+#include <chrono>
 #include <filesystem>
 #include <string_view>
 
@@ -102,6 +103,7 @@ namespace vkn
           * Set the compiled SPIRV shader bytecode for the shader module
           */
          auto set_spirv_binary(const util::dynamic_array<std::uint32_t>& spirv_binary) -> builder&;
+         auto set_spirv_binary(util::dynamic_array<std::uint32_t>&& spirv_binary) -> builder&;
          /**
           * Set the name of the shader
           */
@@ -111,6 +113,15 @@ namespace vkn
           */
          auto set_type(shader_type shader_type) -> builder&;
 
+         /**
+          * Time the last call to build spent reflecting the SPIRV bytecode
+          */
+         [[nodiscard]] auto reflection_time() const noexcept -> std::chrono::nanoseconds;
+         /**
+          * Time the last call to build spent creating the shader module
+          */
+         [[nodiscard]] auto module_creation_time() const noexcept -> std::chrono::nanoseconds;
+
       private:
          [[nodiscard]] auto create_shader() const noexcept -> vkn::result<vk::UniqueShaderModule>;
 
@@ -137,6 +148,9 @@ namespace vkn
             shader_type type{shader_type::count};
             std::string name{};
          } m_info;
+
+         std::chrono::nanoseconds m_reflection_time{0};
+         std::chrono::nanoseconds m_module_creation_time{0};
       };
    };
 
@@ -3,6 +3,8 @@
 
 #include <vkn/core.hpp>
 
+#include <util/stats.hpp>
+
 #include <monads/try.hpp>
 
 namespace vkn
@@ -32,6 +34,10 @@ namespace vkn
             return "failed_to_create_buffer";
          case buffer_error::failed_to_allocate_memory:
             return "failed_to_allocate_memory";
+         case buffer_error::failed_to_find_desired_memory_type:
+            return "failed_to_find_desired_memory_type";
+         case buffer_error::failed_to_map_memory:
+            return "failed_to_map_memory";
          default:
             return "UNKNOWN";
       }
@@ -42,9 +48,38 @@ namespace vkn
                         static_cast<vk::Result>(ec.value())};
    }
 
+   buffer::~buffer() { release_stats(); }
+
+   auto buffer::operator=(buffer&& rhs) noexcept -> buffer&
+   {
+      if (this != &rhs)
+      {
+         release_stats();
+
+         m_value = std::move(rhs.m_value);
+         m_memory = std::move(rhs.m_memory);
+         m_memory_size = rhs.m_memory_size;
+         m_heap_index = rhs.m_heap_index;
+         mp_mapped_data = std::exchange(rhs.mp_mapped_data, nullptr);
+      }
+
+      return *this;
+   }
+
    auto buffer::memory() const noexcept -> vk::DeviceMemory { return m_memory.get(); }
+   auto buffer::memory_size() const noexcept -> vk::DeviceSize { return m_memory_size; }
+   auto buffer::mapped_data() const noexcept -> void* { return mp_mapped_data; }
    auto buffer::device() const noexcept -> vk::Device { return m_value.getOwner(); }
 
+   void buffer::release_stats() noexcept
+   {
+      if (m_memory)
+      {
+         util::stats::add(util::stats::gauge::live_buffers, -1);
+         util::stats::add_heap_usage(m_heap_index, -static_cast<std::int64_t>(m_memory_size));
+      }
+   }
+
    using builder = buffer::builder;
 
    builder::builder(const vkn::device& device, std::shared_ptr<util::logger> p_logger) noexcept :
@@ -57,16 +92,25 @@ namespace vkn
    auto builder::build() const noexcept -> vkn::result<buffer>
    {
       const auto allocate_n_construct = [&](vk::UniqueBuffer buffer) noexcept {
-         return allocate_memory(buffer.get()).map([&](vk::UniqueDeviceMemory memory) noexcept {
-            util::log_info(mp_logger, "[vkn] buffer of size {} created", m_info.size);
+         return allocate_memory(buffer.get()).and_then([&](allocation&& alloc) noexcept {
+            m_info.device.bindBufferMemory(buffer.get(), alloc.memory.get(), 0);
 
-            m_info.device.bindBufferMemory(buffer.get(), memory.get(), 0);
+            return map_memory(alloc.memory.get()).map([&](void* p_mapped_data) noexcept {
+               util::log_info(mp_logger, "[vkn] buffer of size {} created", m_info.size);
 
-            class buffer b;
-            b.m_value = std::move(buffer);
-            b.m_memory = std::move(memory);
+               util::stats::add(util::stats::gauge::live_buffers, 1);
+               util::stats::add_heap_usage(alloc.heap_index,
+                                           static_cast<std::int64_t>(alloc.size));
 
-            return b;
+               class buffer b;
+               b.m_value = std::move(buffer);
+               b.m_memory = std::move(alloc.memory);
+               b.m_memory_size = alloc.size;
+               b.m_heap_index = alloc.heap_index;
+               b.mp_mapped_data = p_mapped_data;
+
+               return b;
+            });
          });
       };
 
@@ -99,6 +143,12 @@ namespace vkn
       return *this;
    }
 
+   auto builder::set_persistently_mapped() noexcept -> builder&
+   {
+      m_info.is_persistently_mapped = true;
+      return *this;
+   }
+
    auto builder::create_buffer() const -> vkn::result<vk::UniqueBuffer>
    {
       return monad::try_wrap<vk::SystemError>([&] {
@@ -110,10 +160,10 @@ namespace vkn
          });
    }
 
-   auto builder::allocate_memory(vk::Buffer buffer) const -> vkn::result<vk::UniqueDeviceMemory>
+   auto builder::allocate_memory(vk::Buffer buffer) const -> vkn::result<allocation>
    {
       const auto requirements = m_info.device.getBufferMemoryRequirements(buffer);
-      auto error_res = vkn::result<vk::UniqueDeviceMemory>{
+      auto error_res = vkn::result<allocation>{
          monad::make_error(make_error(buffer_error::failed_to_find_desired_memory_type, {}))};
 
       const auto alloc_memory = [&](uint32_t index) noexcept {
@@ -123,6 +173,14 @@ namespace vkn
                 })
             .map_error([](const vk::SystemError& err) {
                return make_error(buffer_error::failed_to_allocate_memory, err.code());
+            })
+            .map([&](vk::UniqueDeviceMemory&& memory) noexcept {
+               const auto heap_index =
+                  m_info.physical_device.getMemoryProperties().memoryTypes[index].heapIndex;
+
+               return allocation{.memory = std::move(memory),
+                                 .size = requirements.size,
+                                 .heap_index = heap_index};
             });
       };
 
@@ -131,6 +189,20 @@ namespace vkn
                  find_memory_requirements(requirements.memoryTypeBits, m_info.fallback_mem_flags)
                     .map_or(alloc_memory, std::move(error_res)));
    }
+   auto builder::map_memory(vk::DeviceMemory memory) const -> vkn::result<void*>
+   {
+      if (!m_info.is_persistently_mapped)
+      {
+         return static_cast<void*>(nullptr);
+      }
+
+      return monad::try_wrap<vk::SystemError>([&] {
+                return m_info.device.mapMemory(memory, 0, VK_WHOLE_SIZE, {});
+             })
+         .map_error([](const vk::SystemError& err) {
+            return make_error(buffer_error::failed_to_map_memory, err.code());
+         });
+   }
    auto builder::find_memory_requirements(std::uint32_t type_filter,
                                           const vk::MemoryPropertyFlags& properties) const noexcept
       -> monad::maybe<std::uint32_t>
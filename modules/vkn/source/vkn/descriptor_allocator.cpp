@@ -0,0 +1,182 @@
+#include <vkn/descriptor_allocator.hpp>
+
+#include <monads/try.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace vkn
+{
+   struct descriptor_allocator_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override
+      {
+         return "vkn_descriptor_allocator";
+      }
+
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return to_string(static_cast<descriptor_allocator_error>(err));
+      }
+   };
+
+   inline static const descriptor_allocator_error_category descriptor_allocator_error_category{};
+
+   auto to_string(descriptor_allocator_error err) -> std::string
+   {
+      switch (err)
+      {
+         case descriptor_allocator_error::failed_to_create_descriptor_pool:
+            return "failed_to_create_descriptor_pool";
+         case descriptor_allocator_error::failed_to_allocate_descriptor_set:
+            return "failed_to_allocate_descriptor_set";
+         case descriptor_allocator_error::no_pool_sizes_provided:
+            return "no_pool_sizes_provided";
+         default:
+            return "UNKNOWN";
+      }
+   }
+   auto make_error(descriptor_allocator_error err, std::error_code ec) -> vkn::error
+   {
+      return {{static_cast<int>(err), descriptor_allocator_error_category},
+              static_cast<vk::Result>(ec.value())};
+   }
+
+   auto descriptor_allocator::allocate(vk::DescriptorSetLayout layout)
+      -> vkn::result<vk::DescriptorSet>
+   {
+      while (true)
+      {
+         const bool is_new_pool = m_current_pool == std::size(m_pools);
+         if (is_new_pool)
+         {
+            if (auto pool = create_pool())
+            {
+               m_pools.emplace_back(std::move(pool).value().value());
+            }
+            else
+            {
+               return monad::make_error(pool.error().value());
+            }
+         }
+
+         const vk::DescriptorSetAllocateInfo info{.descriptorPool = m_pools[m_current_pool].get(),
+                                                  .descriptorSetCount = 1,
+                                                  .pSetLayouts = &layout};
+
+         // Running out of pool memory is expected, use the non-throwing overload to detect it
+         vk::DescriptorSet set{};
+         const vk::Result res = m_device.allocateDescriptorSets(&info, &set);
+         if (res == vk::Result::eSuccess)
+         {
+            return set;
+         }
+
+         // A fresh pool that cannot fit the set means the ratios do not cover its layout
+         if (is_new_pool ||
+             (res != vk::Result::eErrorOutOfPoolMemory && res != vk::Result::eErrorFragmentedPool))
+         {
+            return monad::make_error(
+               make_error(descriptor_allocator_error::failed_to_allocate_descriptor_set,
+                          make_error_code(res)));
+         }
+
+         ++m_current_pool;
+      }
+   }
+
+   void descriptor_allocator::reset()
+   {
+      const auto used_count = std::min(m_current_pool + 1, std::size(m_pools));
+      for (std::size_t i = 0; i < used_count; ++i)
+      {
+         m_device.resetDescriptorPool(m_pools[i].get());
+      }
+
+      m_current_pool = 0;
+   }
+
+   auto descriptor_allocator::device() const noexcept -> vk::Device { return m_device; }
+   auto descriptor_allocator::pool_count() const noexcept -> std::size_t
+   {
+      return std::size(m_pools);
+   }
+
+   auto descriptor_allocator::create_pool() -> vkn::result<vk::UniqueDescriptorPool>
+   {
+      const std::uint32_t set_count = m_next_set_count;
+
+      util::small_dynamic_array<vk::DescriptorPoolSize, 8> sizes;
+      for (const auto& ratio : m_ratios)
+      {
+         const auto count = static_cast<std::uint32_t>(
+            std::ceil(ratio.ratio * static_cast<float>(set_count)));
+         sizes.emplace_back(vk::DescriptorPoolSize{.type = ratio.type,
+                                                   .descriptorCount = std::max(count, 1U)});
+      }
+
+      return try_wrap([&] {
+                return m_device.createDescriptorPoolUnique(
+                   {.flags = m_flags,
+                    .maxSets = set_count,
+                    .poolSizeCount = static_cast<std::uint32_t>(std::size(sizes)),
+                    .pPoolSizes = std::data(sizes)});
+             })
+         .map_error([](const vk::SystemError& e) {
+            return make_error(descriptor_allocator_error::failed_to_create_descriptor_pool,
+                              e.code());
+         })
+         .map([&](auto&& handle) {
+            util::log_info(mp_logger, "[vkn] descriptor pool of {} sets created", set_count);
+
+            m_next_set_count = std::min(set_count * 2, max_sets_per_pool);
+
+            return std::move(handle);
+         });
+   }
+
+   using builder = descriptor_allocator::builder;
+
+   builder::builder(const vkn::device& device, std::shared_ptr<util::logger> p_logger) noexcept :
+      m_device{device.value()}, mp_logger{std::move(p_logger)}
+   {}
+
+   auto builder::build() const -> vkn::result<descriptor_allocator>
+   {
+      if (std::empty(m_info.ratios))
+      {
+         return monad::make_error(
+            make_error(descriptor_allocator_error::no_pool_sizes_provided, {}));
+      }
+
+      descriptor_allocator allocator{};
+      allocator.m_device = m_device;
+      allocator.mp_logger = mp_logger;
+      allocator.m_ratios = m_info.ratios;
+      allocator.m_flags = m_info.flags;
+      allocator.m_next_set_count =
+         std::clamp(m_info.initial_set_count.value(), 1U, max_sets_per_pool);
+
+      return allocator.create_pool().map([&](vk::UniqueDescriptorPool&& pool) {
+         allocator.m_pools.emplace_back(std::move(pool));
+
+         return std::move(allocator);
+      });
+   }
+
+   auto builder::set_initial_set_count(util::count32_t count) noexcept -> builder&
+   {
+      m_info.initial_set_count = count;
+      return *this;
+   }
+   auto builder::add_pool_ratio(vk::DescriptorType type, float ratio) -> builder&
+   {
+      m_info.ratios.emplace_back(pool_ratio{.type = type, .ratio = ratio});
+      return *this;
+   }
+   auto builder::set_pool_flags(vk::DescriptorPoolCreateFlags flags) noexcept -> builder&
+   {
+      m_info.flags = flags;
+      return *this;
+   }
+} // namespace vkn
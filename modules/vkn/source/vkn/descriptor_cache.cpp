@@ -0,0 +1,100 @@
+#include <vkn/descriptor_cache.hpp>
+
+#include <algorithm>
+
+namespace vkn
+{
+   namespace
+   {
+      template <typename any_>
+      void hash_combine(std::size_t& seed, const any_& value) noexcept
+      {
+         seed ^= std::hash<any_>{}(value) + 0x9e3779b9 + (seed << 6U) + (seed >> 2U); // NOLINT
+      }
+   } // namespace
+
+   descriptor_cache::descriptor_cache(descriptor_allocator&& allocator) noexcept :
+      m_allocator{std::move(allocator)}
+   {}
+
+   auto descriptor_cache::get(vk::DescriptorSetLayout layout,
+                              std::span<const descriptor_write> writes)
+      -> vkn::result<vk::DescriptorSet>
+   {
+      key k{.layout = layout};
+      k.writes.assign(std::begin(writes), std::end(writes));
+
+      if (const auto it = m_sets.find(k); it != std::end(m_sets))
+      {
+         return it->second;
+      }
+
+      auto set_res = m_allocator.allocate(layout);
+      if (!set_res)
+      {
+         return monad::make_error(set_res.error().value());
+      }
+
+      const vk::DescriptorSet set = set_res.value().value();
+
+      util::small_dynamic_array<vk::WriteDescriptorSet, 4> vk_writes;
+      vk_writes.reserve(std::size(writes));
+      for (const auto& write : writes)
+      {
+         const bool is_image = write.type == vk::DescriptorType::eCombinedImageSampler ||
+            write.type == vk::DescriptorType::eSampledImage ||
+            write.type == vk::DescriptorType::eStorageImage ||
+            write.type == vk::DescriptorType::eSampler ||
+            write.type == vk::DescriptorType::eInputAttachment;
+
+         vk_writes.emplace_back(vk::WriteDescriptorSet{
+            .dstSet = set,
+            .dstBinding = write.binding,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = write.type,
+            .pImageInfo = is_image ? &write.image_info : nullptr,
+            .pBufferInfo = is_image ? nullptr : &write.buffer_info});
+      }
+
+      m_allocator.device().updateDescriptorSets(
+         static_cast<std::uint32_t>(std::size(vk_writes)), std::data(vk_writes), 0, nullptr);
+
+      m_sets.emplace(std::move(k), set);
+
+      return set;
+   }
+
+   void descriptor_cache::clear()
+   {
+      m_sets.clear();
+      m_allocator.reset();
+   }
+
+   auto descriptor_cache::size() const noexcept -> std::size_t { return std::size(m_sets); }
+
+   auto descriptor_cache::key::operator==(const key& rhs) const -> bool
+   {
+      return layout == rhs.layout &&
+         std::equal(std::begin(writes), std::end(writes), std::begin(rhs.writes),
+                    std::end(rhs.writes));
+   }
+
+   auto descriptor_cache::key_hash::operator()(const key& k) const noexcept -> std::size_t
+   {
+      std::size_t seed = std::hash<VkDescriptorSetLayout>{}(k.layout);
+      for (const auto& write : k.writes)
+      {
+         hash_combine(seed, write.binding);
+         hash_combine(seed, static_cast<std::uint32_t>(write.type));
+         hash_combine(seed, static_cast<VkBuffer>(write.buffer_info.buffer));
+         hash_combine(seed, write.buffer_info.offset);
+         hash_combine(seed, write.buffer_info.range);
+         hash_combine(seed, static_cast<VkImageView>(write.image_info.imageView));
+         hash_combine(seed, static_cast<VkSampler>(write.image_info.sampler));
+         hash_combine(seed, static_cast<std::uint32_t>(write.image_info.imageLayout));
+      }
+
+      return seed;
+   }
+} // namespace vkn
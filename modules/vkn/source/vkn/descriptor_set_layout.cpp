@@ -52,9 +52,15 @@ namespace vkn
 
    auto builder::build() const noexcept -> vkn::result<descriptor_set_layout>
    {
+      const vk::DescriptorSetLayoutBindingFlagsCreateInfo flags_info{
+         .bindingCount = static_cast<uint32_t>(std::size(m_info.binding_flags)),
+         .pBindingFlags = m_info.binding_flags.data()};
+
       return try_wrap([&] {
                 return m_device.createDescriptorSetLayoutUnique(
-                   {.bindingCount = static_cast<uint32_t>(std::size(m_info.bindings)),
+                   {.pNext = std::empty(m_info.binding_flags) ? nullptr : &flags_info,
+                    .flags = m_info.flags,
+                    .bindingCount = static_cast<uint32_t>(std::size(m_info.bindings)),
                     .pBindings = m_info.bindings.data()});
              })
          .map_error([](const vk::SystemError& err) {
@@ -84,4 +90,15 @@ namespace vkn
       m_info.bindings = bindings;
       return *this;
    }
+   auto builder::set_binding_flags(const util::dynamic_array<vk::DescriptorBindingFlags>& flags)
+      -> builder&
+   {
+      m_info.binding_flags = flags;
+      return *this;
+   }
+   auto builder::set_flags(vk::DescriptorSetLayoutCreateFlags flags) noexcept -> builder&
+   {
+      m_info.flags = flags;
+      return *this;
+   }
 } // namespace vkn
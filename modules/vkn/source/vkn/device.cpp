@@ -99,11 +99,11 @@ namespace vkn
 
    device::device(physical_device&& physical_device, const create_info& info) :
       m_device{info.device}, m_physical_device{std::move(physical_device)}, m_version{info.version},
-      m_extensions{info.extensions}
+      m_vulkan12_features{info.vulkan12_features}, m_extensions{info.extensions}
    {}
    device::device(physical_device&& physical_device, create_info&& info) :
       m_device{info.device}, m_physical_device{std::move(physical_device)}, m_version{info.version},
-      m_extensions{std::move(info.extensions)}
+      m_vulkan12_features{info.vulkan12_features}, m_extensions{std::move(info.extensions)}
    {}
    device::device(device&& rhs) noexcept { *this = std::move(rhs); }
    device::~device()
@@ -123,6 +123,7 @@ namespace vkn
          std::swap(m_device, rhs.m_device);
 
          m_version = rhs.m_version;
+         m_vulkan12_features = rhs.m_vulkan12_features;
          m_extensions = std::move(rhs.m_extensions);
       }
 
@@ -289,6 +290,10 @@ namespace vkn
    auto device::value() const noexcept -> vk::Device { return m_device; }
    auto device::physical() const noexcept -> const physical_device& { return m_physical_device; }
    auto device::get_vulkan_version() const noexcept -> uint32_t { return m_version; }
+   auto device::vulkan12_features() const noexcept -> const vk::PhysicalDeviceVulkan12Features&
+   {
+      return m_vulkan12_features;
+   }
 
    device::builder::builder(const loader& vk_loader, physical_device&& phys_device,
                             uint32_t version, std::shared_ptr<util::logger> p_logger) :
@@ -357,9 +362,12 @@ namespace vkn
          log_info(mp_logger, "[vkn] device extension: {0} - ENABLED", name);
       }
 
+      auto vulkan12_features = m_info.vulkan12_features;
+      vulkan12_features.pNext = nullptr;
+
       // clang-format off
       const auto device_create_info = vk::DeviceCreateInfo{}
-         .setPNext(nullptr)
+         .setPNext(&vulkan12_features)
          .setFlags({})
          .setQueueCreateInfoCount(static_cast<uint32_t>(queue_create_infos.size()))
          .setPQueueCreateInfos(queue_create_infos.data())
@@ -379,7 +387,7 @@ namespace vkn
          m_loader.load_device(dev);
 
          return device{std::move(m_info.phys_device),
-                       {dev, m_info.api_version, std::move(extensions)}};
+                       {dev, m_info.api_version, vulkan12_features, std::move(extensions)}};
       });
       // clang-format on
    } // namespace vkn
@@ -391,4 +399,10 @@ namespace vkn
       m_info.queue_descriptions = descriptions;
       return *this;
    }
+   auto device::builder::set_vulkan12_features(const vk::PhysicalDeviceVulkan12Features& features)
+      -> device::builder&
+   {
+      m_info.vulkan12_features = features;
+      return *this;
+   }
 } // namespace vkn
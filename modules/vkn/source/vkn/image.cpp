@@ -0,0 +1,218 @@
+#include <vkn/image.hpp>
+
+#include <util/stats.hpp>
+
+#include <monads/try.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace vkn
+{
+   struct image_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override { return "vkn_image"; }
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return to_string(static_cast<image_error>(err));
+      }
+   };
+
+   inline static const image_error_category image_category{};
+
+   auto to_string(image_error err) -> std::string
+   {
+      switch (err)
+      {
+         case image_error::failed_to_create_image:
+            return "failed_to_create_image";
+         case image_error::failed_to_allocate_memory:
+            return "failed_to_allocate_memory";
+         case image_error::failed_to_find_desired_memory_type:
+            return "failed_to_find_desired_memory_type";
+         case image_error::invalid_extent:
+            return "invalid_extent";
+         default:
+            return "UNKNOWN";
+      }
+   }
+   auto make_error(image_error err, std::error_code ec) -> vkn::error
+   {
+      return vkn::error{{static_cast<int>(err), image_category},
+                        static_cast<vk::Result>(ec.value())};
+   }
+
+   auto full_mip_chain_length(const vk::Extent2D& extent) noexcept -> std::uint32_t
+   {
+      return static_cast<std::uint32_t>(std::bit_width(std::max(extent.width, extent.height)));
+   }
+
+   image::~image() { release_stats(); }
+
+   auto image::operator=(image&& rhs) noexcept -> image&
+   {
+      if (this != &rhs)
+      {
+         release_stats();
+
+         m_value = std::move(rhs.m_value);
+         m_memory = std::move(rhs.m_memory);
+         m_memory_size = std::exchange(rhs.m_memory_size, 0);
+         m_heap_index = rhs.m_heap_index;
+         m_format = rhs.m_format;
+         m_extent = rhs.m_extent;
+         m_mip_levels = rhs.m_mip_levels;
+      }
+
+      return *this;
+   }
+
+   auto image::memory() const noexcept -> vk::DeviceMemory { return m_memory.get(); }
+   auto image::memory_size() const noexcept -> vk::DeviceSize { return m_memory_size; }
+   auto image::format() const noexcept -> vk::Format { return m_format; }
+   auto image::extent() const noexcept -> vk::Extent2D { return m_extent; }
+   auto image::mip_levels() const noexcept -> std::uint32_t { return m_mip_levels; }
+   auto image::device() const noexcept -> vk::Device { return m_value.getOwner(); }
+
+   void image::release_stats() noexcept
+   {
+      if (m_memory)
+      {
+         util::stats::add_heap_usage(m_heap_index, -static_cast<std::int64_t>(m_memory_size));
+      }
+   }
+
+   using builder = image::builder;
+
+   builder::builder(const vkn::device& device, std::shared_ptr<util::logger> p_logger) noexcept :
+      mp_logger{std::move(p_logger)}
+   {
+      m_info.device = device.value();
+      m_info.physical_device = device.physical().value();
+   }
+
+   auto builder::build() const noexcept -> vkn::result<image>
+   {
+      if (m_info.extent.width == 0 || m_info.extent.height == 0)
+      {
+         return monad::make_error(make_error(image_error::invalid_extent, {}));
+      }
+
+      const auto allocate_n_construct = [&](vk::UniqueImage handle) noexcept {
+         return allocate_memory(handle.get()).map([&](allocation&& alloc) noexcept {
+            m_info.device.bindImageMemory(handle.get(), alloc.memory.get(), 0);
+
+            util::log_info(mp_logger, "[vkn] image of {}x{} with {} mips created",
+                           m_info.extent.width, m_info.extent.height,
+                           m_info.mip_levels.value());
+
+            util::stats::add_heap_usage(alloc.heap_index, static_cast<std::int64_t>(alloc.size));
+
+            class image img;
+            img.m_value = std::move(handle);
+            img.m_memory = std::move(alloc.memory);
+            img.m_memory_size = alloc.size;
+            img.m_heap_index = alloc.heap_index;
+            img.m_format = m_info.format;
+            img.m_extent = m_info.extent;
+            img.m_mip_levels = m_info.mip_levels.value();
+
+            return img;
+         });
+      };
+
+      return create_image().and_then(allocate_n_construct);
+   }
+
+   auto builder::set_format(vk::Format format) noexcept -> builder&
+   {
+      m_info.format = format;
+      return *this;
+   }
+   auto builder::set_extent(const vk::Extent2D& extent) noexcept -> builder&
+   {
+      m_info.extent = extent;
+      return *this;
+   }
+   auto builder::set_mip_levels(util::count32_t count) noexcept -> builder&
+   {
+      m_info.mip_levels = count;
+      return *this;
+   }
+   auto builder::set_usage(const vk::ImageUsageFlags& flags) noexcept -> builder&
+   {
+      m_info.usage = flags;
+      return *this;
+   }
+   auto builder::set_desired_memory_type(const vk::MemoryPropertyFlags& flags) noexcept -> builder&
+   {
+      m_info.desired_mem_flags = flags;
+      return *this;
+   }
+
+   auto builder::create_image() const -> vkn::result<vk::UniqueImage>
+   {
+      return monad::try_wrap<vk::SystemError>([&] {
+                return m_info.device.createImageUnique(
+                   {.imageType = vk::ImageType::e2D,
+                    .format = m_info.format,
+                    .extent = {m_info.extent.width, m_info.extent.height, 1},
+                    .mipLevels = m_info.mip_levels.value(),
+                    .arrayLayers = 1,
+                    .samples = vk::SampleCountFlagBits::e1,
+                    .tiling = vk::ImageTiling::eOptimal,
+                    .usage = m_info.usage,
+                    .sharingMode = vk::SharingMode::eExclusive,
+                    .initialLayout = vk::ImageLayout::eUndefined});
+             })
+         .map_error([](const vk::SystemError& err) {
+            return make_error(image_error::failed_to_create_image, err.code());
+         });
+   }
+
+   auto builder::allocate_memory(vk::Image image) const -> vkn::result<allocation>
+   {
+      const auto requirements = m_info.device.getImageMemoryRequirements(image);
+      const auto type_index =
+         find_memory_type(requirements.memoryTypeBits, m_info.desired_mem_flags);
+      if (!type_index.has_value())
+      {
+         return monad::make_error(make_error(image_error::failed_to_find_desired_memory_type, {}));
+      }
+
+      const std::uint32_t index = type_index.value();
+
+      return monad::try_wrap<vk::SystemError>([&] {
+                return m_info.device.allocateMemoryUnique(
+                   {.allocationSize = requirements.size, .memoryTypeIndex = index});
+             })
+         .map_error([](const vk::SystemError& err) {
+            return make_error(image_error::failed_to_allocate_memory, err.code());
+         })
+         .map([&](vk::UniqueDeviceMemory&& memory) noexcept {
+            const auto heap_index =
+               m_info.physical_device.getMemoryProperties().memoryTypes[index].heapIndex;
+
+            return allocation{
+               .memory = std::move(memory), .size = requirements.size, .heap_index = heap_index};
+         });
+   }
+
+   auto builder::find_memory_type(std::uint32_t type_filter,
+                                  const vk::MemoryPropertyFlags& properties) const noexcept
+      -> monad::maybe<std::uint32_t>
+   {
+      const auto mem_properties = m_info.physical_device.getMemoryProperties();
+
+      for (std::uint32_t i = 0; i < mem_properties.memoryTypeCount; ++i)
+      {
+         if ((type_filter & (1U << i)) &&
+             (mem_properties.memoryTypes[i].propertyFlags & properties) == properties)
+         {
+            return i;
+         }
+      }
+
+      return monad::none;
+   }
+} // namespace vkn
@@ -0,0 +1,92 @@
+#include <vkn/image_view.hpp>
+
+#include <monads/try.hpp>
+
+namespace vkn
+{
+   struct image_view_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override
+      {
+         return "vkn_image_view";
+      }
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return to_string(static_cast<image_view_error>(err));
+      }
+   };
+
+   inline static const image_view_error_category image_view_category{};
+
+   auto to_string(image_view_error err) -> std::string
+   {
+      switch (err)
+      {
+         case image_view_error::failed_to_create_image_view:
+            return "failed_to_create_image_view";
+         case image_view_error::no_image_provided:
+            return "no_image_provided";
+         default:
+            return "UNKNOWN";
+      }
+   }
+   auto make_error(image_view_error err, std::error_code ec) -> vkn::error
+   {
+      return vkn::error{{static_cast<int>(err), image_view_category},
+                        static_cast<vk::Result>(ec.value())};
+   }
+
+   auto image_view::device() const noexcept -> vk::Device { return m_value.getOwner(); }
+
+   using builder = image_view::builder;
+
+   builder::builder(const vkn::device& device, std::shared_ptr<util::logger> p_logger) noexcept :
+      mp_logger{std::move(p_logger)}
+   {
+      m_info.device = device.value();
+   }
+
+   auto builder::build() const noexcept -> vkn::result<image_view>
+   {
+      if (!m_info.image)
+      {
+         return monad::make_error(make_error(image_view_error::no_image_provided, {}));
+      }
+
+      return monad::try_wrap<vk::SystemError>([&] {
+                return m_info.device.createImageViewUnique(
+                   {.image = m_info.image,
+                    .viewType = vk::ImageViewType::e2D,
+                    .format = m_info.format,
+                    .subresourceRange = {.aspectMask = m_info.aspect,
+                                         .baseMipLevel = 0,
+                                         .levelCount = m_info.mip_levels,
+                                         .baseArrayLayer = 0,
+                                         .layerCount = 1}});
+             })
+         .map_error([](const vk::SystemError& err) {
+            return make_error(image_view_error::failed_to_create_image_view, err.code());
+         })
+         .map([&](vk::UniqueImageView&& handle) {
+            util::log_debug(mp_logger, "[vkn] image view created");
+
+            image_view view;
+            view.m_value = std::move(handle);
+
+            return view;
+         });
+   }
+
+   auto builder::set_image(const vkn::image& image) noexcept -> builder&
+   {
+      m_info.image = image.value();
+      m_info.format = image.format();
+      m_info.mip_levels = image.mip_levels();
+      return *this;
+   }
+   auto builder::set_aspect(vk::ImageAspectFlags aspect) noexcept -> builder&
+   {
+      m_info.aspect = aspect;
+      return *this;
+   }
+} // namespace vkn
@@ -168,7 +168,8 @@ namespace vkn
    } // namespace detail
 
    physical_device::physical_device(const create_info& info) :
-      m_name{info.name}, m_features{info.features}, m_properties{info.properties},
+      m_name{info.name}, m_features{info.features},
+      m_vulkan12_features{info.vulkan12_features}, m_properties{info.properties},
       m_mem_properties{info.mem_properties}, m_physical_device{info.device},
       m_instance{info.instance}, m_surface{info.surface}, m_queue_families{info.queue_families}
    {}
@@ -188,6 +189,7 @@ namespace vkn
          m_name = std::move(rhs.m_name);
 
          m_features = rhs.m_features;
+         m_vulkan12_features = rhs.m_vulkan12_features;
          m_properties = rhs.m_properties;
          m_mem_properties = rhs.m_mem_properties;
 
@@ -228,6 +230,20 @@ namespace vkn
    {
       return m_features;
    }
+   auto physical_device::vulkan12_features() const noexcept
+      -> const vk::PhysicalDeviceVulkan12Features&
+   {
+      return m_vulkan12_features;
+   }
+   auto physical_device::properties() const noexcept -> const vk::PhysicalDeviceProperties&
+   {
+      return m_properties;
+   }
+   auto physical_device::memory_properties() const noexcept
+      -> const vk::PhysicalDeviceMemoryProperties&
+   {
+      return m_mem_properties;
+   }
    auto physical_device::surface() const noexcept -> const vk::SurfaceKHR& { return m_surface; }
    auto physical_device::queue_families() const
       -> const util::dynamic_array<vk::QueueFamilyProperties>
@@ -304,6 +320,7 @@ namespace vkn
       return physical_device{
          {.name = static_cast<const char*>(selected.properties.deviceName),
           .features = selected.features,
+          .vulkan12_features = selected.vulkan12_features,
           .properties = selected.properties,
           .mem_properties = selected.mem_properties,
           .instance = m_system_info.instance,
@@ -388,6 +405,13 @@ namespace vkn
       }
 
       desc.features = device.getFeatures();
+
+      // The instance requires Vulkan 1.2, so the 1.2 features can always be queried
+      const auto feature_chain =
+         device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>();
+      desc.vulkan12_features = feature_chain.get<vk::PhysicalDeviceVulkan12Features>();
+      desc.vulkan12_features.pNext = nullptr;
+
       desc.properties = device.getProperties();
       desc.mem_properties = device.getMemoryProperties();
 
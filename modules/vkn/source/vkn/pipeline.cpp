@@ -159,6 +159,15 @@ namespace vkn
       m_info.set_layouts.emplace_back(descriptor_set_layout_info{.name = name, .binding = binding});
       return *this;
    }
+   auto graphics_pipeline::builder::add_set_layout(
+      const std::string& name, const util::dynamic_array<vk::DescriptorSetLayoutBinding>& binding,
+      const util::dynamic_array<vk::DescriptorBindingFlags>& binding_flags,
+      vk::DescriptorSetLayoutCreateFlags flags) -> builder&
+   {
+      m_info.set_layouts.emplace_back(descriptor_set_layout_info{
+         .name = name, .binding = binding, .binding_flags = binding_flags, .flags = flags});
+      return *this;
+   }
 
    auto graphics_pipeline::builder::add_push_constant(const std::string& name,
                                                       vkn::shader_type shader_type,
@@ -180,6 +189,8 @@ namespace vkn
       {
          auto result = vkn::descriptor_set_layout::builder{m_info.device, mp_logger}
                           .set_bindings(set_info.binding)
+                          .set_binding_flags(set_info.binding_flags)
+                          .set_flags(set_info.flags)
                           .build();
 
          if (result)
@@ -219,9 +230,10 @@ namespace vkn
       util::dynamic_array<vk::DescriptorSetLayout> layouts;
       layouts.reserve(std::size(pipeline.m_set_layouts));
 
-      for (const auto& [name, layout] : pipeline.m_set_layouts)
+      // Set indices follow the order in which the layouts were added
+      for (const auto& set_info : m_info.set_layouts)
       {
-         layouts.emplace_back(layout.value());
+         layouts.emplace_back(pipeline.m_set_layouts.at(set_info.name).value());
       }
 
       util::dynamic_array<vk::PushConstantRange> push_constants;
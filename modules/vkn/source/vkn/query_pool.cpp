@@ -0,0 +1,84 @@
+#include <vkn/query_pool.hpp>
+
+#include <monads/try.hpp>
+
+namespace vkn
+{
+   struct query_pool_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override { return "vkn_query_pool"; }
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return to_string(static_cast<query_pool_error>(err));
+      }
+   };
+
+   inline static const query_pool_error_category query_pool_category{};
+
+   auto to_string(query_pool_error err) -> std::string
+   {
+      switch (err)
+      {
+         case query_pool_error::failed_to_create_query_pool:
+            return "failed_to_create_query_pool";
+         case query_pool_error::invalid_query_count:
+            return "invalid_query_count";
+         default:
+            return "UNKNOWN";
+      }
+   }
+   auto make_error(query_pool_error err, std::error_code ec) -> vkn::error
+   {
+      return {{static_cast<int>(err), query_pool_category}, static_cast<vk::Result>(ec.value())};
+   }
+
+   auto query_pool::device() const noexcept -> vk::Device { return m_value.getOwner(); }
+   auto query_pool::type() const noexcept -> vk::QueryType { return m_type; }
+   auto query_pool::query_count() const noexcept -> util::count32_t { return m_query_count; }
+
+   using builder = query_pool::builder;
+
+   builder::builder(const vkn::device& device, std::shared_ptr<util::logger> p_logger) noexcept :
+      mp_logger{std::move(p_logger)}
+   {
+      m_info.device = device.value();
+   }
+
+   auto builder::build() const noexcept -> vkn::result<query_pool>
+   {
+      if (m_info.query_count.value() == 0U)
+      {
+         return monad::make_error(make_error(query_pool_error::invalid_query_count, {}));
+      }
+
+      return monad::try_wrap<vk::SystemError>([&] {
+                return m_info.device.createQueryPoolUnique(
+                   {.queryType = m_info.type, .queryCount = m_info.query_count.value()});
+             })
+         .map_error([](vk::SystemError&& err) {
+            return make_error(query_pool_error::failed_to_create_query_pool, err.code());
+         })
+         .map([&](vk::UniqueQueryPool&& handle) {
+            util::log_info(mp_logger, "[vkn] {} query pool of {} queries created",
+                           vk::to_string(m_info.type), m_info.query_count.value());
+
+            query_pool pool{};
+            pool.m_value = std::move(handle);
+            pool.m_type = m_info.type;
+            pool.m_query_count = m_info.query_count;
+
+            return pool;
+         });
+   }
+
+   auto builder::set_query_type(vk::QueryType type) noexcept -> builder&
+   {
+      m_info.type = type;
+      return *this;
+   }
+   auto builder::set_query_count(util::count32_t count) noexcept -> builder&
+   {
+      m_info.query_count = count;
+      return *this;
+   }
+} // namespace vkn
@@ -0,0 +1,106 @@
+#include <vkn/sampler.hpp>
+
+#include <monads/try.hpp>
+
+#include <algorithm>
+
+namespace vkn
+{
+   struct sampler_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override { return "vkn_sampler"; }
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return to_string(static_cast<sampler_error>(err));
+      }
+   };
+
+   inline static const sampler_error_category sampler_category{};
+
+   auto to_string(sampler_error err) -> std::string
+   {
+      switch (err)
+      {
+         case sampler_error::failed_to_create_sampler:
+            return "failed_to_create_sampler";
+         default:
+            return "UNKNOWN";
+      }
+   }
+   auto make_error(sampler_error err, std::error_code ec) -> vkn::error
+   {
+      return vkn::error{{static_cast<int>(err), sampler_category},
+                        static_cast<vk::Result>(ec.value())};
+   }
+
+   auto sampler::device() const noexcept -> vk::Device { return m_value.getOwner(); }
+
+   using builder = sampler::builder;
+
+   builder::builder(const vkn::device& device, std::shared_ptr<util::logger> p_logger) noexcept :
+      mp_logger{std::move(p_logger)}
+   {
+      m_info.device = device.value();
+      m_info.is_anisotropy_supported = device.physical().features().samplerAnisotropy;
+      m_info.max_supported_anisotropy =
+         device.physical().properties().limits.maxSamplerAnisotropy;
+   }
+
+   auto builder::build() const noexcept -> vkn::result<sampler>
+   {
+      const bool use_anisotropy = m_info.is_anisotropy_supported && m_info.max_anisotropy > 1.0F;
+
+      return monad::try_wrap<vk::SystemError>([&] {
+                return m_info.device.createSamplerUnique(
+                   {.magFilter = m_info.filter,
+                    .minFilter = m_info.filter,
+                    .mipmapMode = m_info.mipmap_mode,
+                    .addressModeU = m_info.address_mode,
+                    .addressModeV = m_info.address_mode,
+                    .addressModeW = m_info.address_mode,
+                    .mipLodBias = 0.0F,
+                    .anisotropyEnable = use_anisotropy,
+                    .maxAnisotropy = use_anisotropy ? std::min(m_info.max_anisotropy,
+                                                               m_info.max_supported_anisotropy)
+                                                    : 1.0F,
+                    .compareEnable = false,
+                    .compareOp = vk::CompareOp::eAlways,
+                    .minLod = 0.0F,
+                    .maxLod = VK_LOD_CLAMP_NONE,
+                    .borderColor = vk::BorderColor::eIntOpaqueBlack,
+                    .unnormalizedCoordinates = false});
+             })
+         .map_error([](const vk::SystemError& err) {
+            return make_error(sampler_error::failed_to_create_sampler, err.code());
+         })
+         .map([&](vk::UniqueSampler&& handle) {
+            util::log_info(mp_logger, "[vkn] sampler created");
+
+            sampler s;
+            s.m_value = std::move(handle);
+
+            return s;
+         });
+   }
+
+   auto builder::set_filter(vk::Filter filter) noexcept -> builder&
+   {
+      m_info.filter = filter;
+      return *this;
+   }
+   auto builder::set_mipmap_mode(vk::SamplerMipmapMode mode) noexcept -> builder&
+   {
+      m_info.mipmap_mode = mode;
+      return *this;
+   }
+   auto builder::set_address_mode(vk::SamplerAddressMode mode) noexcept -> builder&
+   {
+      m_info.address_mode = mode;
+      return *this;
+   }
+   auto builder::set_max_anisotropy(float anisotropy) noexcept -> builder&
+   {
+      m_info.max_anisotropy = anisotropy;
+      return *this;
+   }
+} // namespace vkn
@@ -96,13 +96,22 @@ namespace vkn
 
    auto builder::build() -> result<shader>
    {
+      using clock = std::chrono::steady_clock;
+
+      const auto reflection_start = clock::now();
+
       spirv_cross::Compiler glsl{{std::begin(m_info.spirv_binary), std::end(m_info.spirv_binary)}};
       const auto resources = glsl.get_shader_resources();
 
       const shader_data shader_data{.inputs = populate_shader_input(glsl, resources),
                                     .uniforms = populate_uniform_buffer(glsl, resources)};
 
+      const auto module_start = clock::now();
+      m_reflection_time = module_start - reflection_start;
+
       return create_shader().map([&](auto&& handle) {
+         m_module_creation_time = clock::now() - module_start;
+
          util::log_info(mp_logger, "[vkn] shader module created");
 
          shader s{};
@@ -121,6 +130,11 @@ namespace vkn
       m_info.spirv_binary = spirv_binary;
       return *this;
    }
+   auto builder::set_spirv_binary(util::dynamic_array<std::uint32_t>&& spirv_binary) -> builder&
+   {
+      m_info.spirv_binary = std::move(spirv_binary);
+      return *this;
+   }
    auto builder::set_name(const std::string& name) -> builder&
    {
       m_info.name = name;
@@ -132,6 +146,15 @@ namespace vkn
       return *this;
    }
 
+   auto builder::reflection_time() const noexcept -> std::chrono::nanoseconds
+   {
+      return m_reflection_time;
+   }
+   auto builder::module_creation_time() const noexcept -> std::chrono::nanoseconds
+   {
+      return m_module_creation_time;
+   }
+
    auto builder::create_shader() const noexcept -> vkn::result<vk::UniqueShaderModule>
    {
       return monad::try_wrap<vk::SystemError>([&] {
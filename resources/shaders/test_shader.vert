@@ -2,16 +2,21 @@
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_GOOGLE_include_directive : enable
 
-layout(binding = 0) uniform camera_buffer_object
+layout(set = 0, binding = 0) uniform camera_buffer_object
 {
    mat4 proj;
    mat4 view;
 } cbo;
 
-layout(push_constant) uniform mesh_data
+struct object_data
 {
    mat4 model;
-} mesh;
+};
+
+layout(std430, set = 1, binding = 0) readonly buffer object_buffer
+{
+   object_data objects[];
+};
 
 layout(location = 0) in vec3 in_position;
 layout(location = 1) in vec3 in_colour;
@@ -20,6 +25,6 @@ layout(location = 0) out vec3 frag_colour;
 
 void main()
 {
-   gl_Position = cbo.proj * cbo.view * mesh.model * vec4(in_position, 1.0);
+   gl_Position = cbo.proj * cbo.view * objects[gl_InstanceIndex].model * vec4(in_position, 1.0);
    frag_colour = in_colour;
 }
@@ -0,0 +1,41 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_GOOGLE_include_directive : enable
+#extension GL_EXT_nonuniform_qualifier : enable
+
+struct object_data
+{
+   mat4 model;
+};
+
+// Both blocks alias the storage buffer binding of the bindless table
+layout(std430, set = 0, binding = 0) readonly buffer camera_buffer_object
+{
+   mat4 proj;
+   mat4 view;
+} cameras[];
+
+layout(std430, set = 0, binding = 0) readonly buffer object_buffer
+{
+   object_data objects[];
+} object_buffers[];
+
+layout(push_constant) uniform bindless_indices
+{
+   uint camera;
+   uint objects;
+} indices;
+
+layout(location = 0) in vec3 in_position;
+layout(location = 1) in vec3 in_colour;
+
+layout(location = 0) out vec3 frag_colour;
+
+void main()
+{
+   const mat4 model = object_buffers[indices.objects].objects[gl_InstanceIndex].model;
+
+   gl_Position = cameras[indices.camera].proj * cameras[indices.camera].view * model *
+      vec4(in_position, 1.0);
+   frag_colour = in_colour;
+}
@@ -12,6 +12,7 @@
 #include <gfx/stb_image.h>
 
 #include <util/logger.hpp>
+#include <util/trace.hpp>
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -27,30 +28,91 @@ util::dynamic_array<gfx::vertex> m_triangle_1_vertices{{{-0.5F, -0.5F, 0.0F}, {0
 
 util::dynamic_array<std::uint32_t> m_triangle_indices{0, 1, 2, 2, 3, 0};
 
+/**
+ * Write the zones recorded since the last dump to a numbered trace file
+ */
+void dump_trace(const std::shared_ptr<util::logger>& logger)
+{
+   static int dump_index = 0;
+
+   const std::filesystem::path path{"vermillon_trace_" + std::to_string(dump_index++) + ".json"};
+   if (util::trace::dump_chrome_trace(path))
+   {
+      util::log_info(logger, R"(trace written to "{}")", path.string());
+   }
+   else
+   {
+      util::log_warn(logger, R"(failed to write trace "{}")", path.string());
+   }
+}
+
 auto main() -> int
 {
    auto main_logger = std::make_shared<util::logger>("vermillon");
 
+   // With tracing on, F12 dumps the most recent zones, and VERMILLON_TRACE_DUMP_FRAMES=N dumps
+   // them every N frames
+   std::uint64_t trace_dump_period = 0;
+   if (std::getenv("VERMILLON_TRACE") != nullptr)
+   {
+      util::trace::set_enabled(true);
+      util::trace::set_thread_name("main");
+
+      if (const char* p_period = std::getenv("VERMILLON_TRACE_DUMP_FRAMES"))
+      {
+         trace_dump_period = std::strtoull(p_period, nullptr, 10);
+      }
+   }
+
    core::initialize(main_logger);
 
    gfx::context rendering_ctx{main_logger};
    gfx::window rendering_wnd{"Engine", 1080, 720}; // NOLINT
    gfx::render_manager rendering_manager{rendering_ctx, rendering_wnd, main_logger};
 
-   rendering_manager.subscribe_renderable(
+   const auto triangle_0 = rendering_manager.subscribe_renderable(
       "triangle_0",
       {.vertices = m_triangle_0_vertices, .indices = m_triangle_indices, .model = glm::mat4{1}});
 
-   rendering_manager.subscribe_renderable(
+   const auto triangle_1 = rendering_manager.subscribe_renderable(
       "triangle_1",
       {.vertices = m_triangle_1_vertices, .indices = m_triangle_indices, .model = glm::mat4{1}});
 
+   if (!(triangle_0 && triangle_1))
+   {
+      util::log_error(main_logger, "failed to subscribe renderables");
+
+      return -1;
+   }
+
+   if (const char* p_scene = std::getenv("VERMILLON_SCENE"))
+   {
+      if (!rendering_manager.load_scene(p_scene))
+      {
+         util::log_warn(main_logger, R"(failed to load scene "{}")", p_scene);
+      }
+   }
+
    rendering_manager.bake();
 
+   std::uint64_t frame_index = 0;
+   bool was_dump_key_pressed = false;
    while (rendering_wnd.is_open())
    {
       rendering_wnd.poll_events();
 
+      if (util::trace::is_enabled())
+      {
+         const bool is_dump_key_pressed = rendering_wnd.is_key_pressed(GLFW_KEY_F12);
+         if ((is_dump_key_pressed && !was_dump_key_pressed) ||
+             (trace_dump_period != 0 && frame_index != 0 && frame_index % trace_dump_period == 0))
+         {
+            dump_trace(main_logger);
+         }
+
+         was_dump_key_pressed = is_dump_key_pressed;
+      }
+
       static auto startTime = std::chrono::high_resolution_clock::now();
 
       auto currentTime = std::chrono::high_resolution_clock::now();
@@ -60,17 +122,24 @@ auto main() -> int
 
       auto triangle_0_model =
          glm::rotate(glm::mat4{1.0F}, time * glm::radians(90.0F), glm::vec3(0.0F, 0.0F, 1.0F));
-      rendering_manager.update_model_matrix("triangle_0", triangle_0_model);
+      rendering_manager.update_model_matrix(*triangle_0, triangle_0_model);
 
       auto triangle_1_model = glm::translate(
          glm::rotate(glm::mat4{1.0F}, time * glm::radians(90.0F), glm::vec3{0.0F, 0.0F, 1.0F}),
          glm::vec3{0.0F, 0.0F, 1.0F});
-      rendering_manager.update_model_matrix("triangle_1", triangle_1_model);
+      rendering_manager.update_model_matrix(*triangle_1, triangle_1_model);
 
       rendering_manager.render_frame();
+      ++frame_index;
    }
 
    rendering_manager.wait();
+   rendering_manager.profiler().log_report();
+
+   if (util::trace::is_enabled())
+   {
+      dump_trace(main_logger);
+   }
 
    return 0;
 }
@@ -0,0 +1,160 @@
+/**
+ * Cooks the meshes of glTF scenes into the engine's binary mesh format. The meshes go through
+ * the same conversion and optimisation passes as at import time, so the runtime only maps the
+ * result and copies it to the GPU
+ */
+
+#include <gfx/gltf.hpp>
+#include <gfx/mesh_file.hpp>
+#include <gfx/mesh_optimizer.hpp>
+#include <gfx/vertex_layout.hpp>
+
+#include <util/logger.hpp>
+#include <util/thread_pool.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace
+{
+   struct options
+   {
+      std::filesystem::path output{std::filesystem::current_path()};
+      std::size_t thread_count{0};
+      gfx::vertex_layout layout{gfx::vertex_layout::position_colour};
+
+      util::dynamic_array<std::filesystem::path> inputs{};
+   };
+
+   void print_usage()
+   {
+      std::puts("usage: mesh_cooker [options] <scenes...>\n"
+                "\n"
+                "options:\n"
+                "   -o, --output <dir>      the directory the meshes are written to, defaults to\n"
+                "                           the working directory\n"
+                "   -j, --jobs <count>      the number of worker threads, defaults to one per core\n"
+                "   -c, --compact           store the vertices in the compact layout: half float\n"
+                "                           positions and 8 bit colours");
+   }
+
+   auto parse_options(std::span<char*> args) -> std::optional<options>
+   {
+      options opts;
+
+      for (std::size_t i = 0; i < std::size(args); ++i)
+      {
+         const std::string_view arg = args[i];
+         const bool has_value = i + 1 < std::size(args);
+
+         if ((arg == "-o" || arg == "--output") && has_value)
+         {
+            opts.output = args[++i];
+         }
+         else if ((arg == "-j" || arg == "--jobs") && has_value)
+         {
+            opts.thread_count = std::strtoull(args[++i], nullptr, 10); // NOLINT
+         }
+         else if (arg == "-c" || arg == "--compact")
+         {
+            opts.layout = gfx::vertex_layout::compact;
+         }
+         else if (arg.starts_with('-'))
+         {
+            return std::nullopt;
+         }
+         else
+         {
+            opts.inputs.emplace_back(arg);
+         }
+      }
+
+      if (std::empty(opts.inputs))
+      {
+         return std::nullopt;
+      }
+
+      return opts;
+   }
+
+   /**
+    * Name a cooked mesh after its scene and its own name, replacing the characters that can't
+    * appear in a file name
+    */
+   auto mesh_file_name(const std::filesystem::path& scene, const gfx::gltf_mesh& mesh,
+                       std::size_t index) -> std::string
+   {
+      std::string name = scene.stem().string() + "_";
+      name += std::empty(mesh.name) ? "mesh_" + std::to_string(index) : mesh.name;
+
+      for (char& c : name)
+      {
+         if (c == '/' || c == '\\' || c == ':' || c == ' ')
+         {
+            c = '_';
+         }
+      }
+
+      return name + ".vmesh";
+   }
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+   auto p_logger = std::make_shared<util::logger>("mesh_cooker");
+
+   const auto opts = parse_options(std::span{argv, static_cast<std::size_t>(argc)}.subspan(1));
+   if (!opts)
+   {
+      print_usage();
+
+      return 1;
+   }
+
+   auto p_pool = opts->thread_count > 0 ? std::make_unique<util::thread_pool>(opts->thread_count)
+                                        : std::make_unique<util::thread_pool>();
+
+   std::error_code err;
+   std::filesystem::create_directories(opts->output, err);
+
+   std::size_t failure_count = 0;
+   for (const auto& input : opts->inputs)
+   {
+      auto scene_res = gfx::import_gltf(input, *p_pool, p_logger);
+      if (!scene_res)
+      {
+         ++failure_count;
+
+         continue;
+      }
+
+      const auto scene = std::move(scene_res).value().value();
+      const auto& meshes = scene.meshes;
+      for (std::size_t i = 0; i < std::size(meshes); ++i)
+      {
+         const auto& mesh = meshes[i];
+         const auto path = opts->output / mesh_file_name(input, mesh, i);
+
+         if (!gfx::write_mesh_file(path, mesh.vertices, mesh.indices, mesh.lods, opts->layout))
+         {
+            util::log_error(p_logger, R"(failed to write "{}")", path.generic_string());
+            ++failure_count;
+
+            continue;
+         }
+
+         const auto full_detail = std::span{mesh.indices}.first(mesh.lods[0].index_count);
+         util::log_info(p_logger,
+                        R"(cooked "{}": {} vertices, {} triangles, {} LODs, ACMR {:.3f})",
+                        path.generic_string(), std::size(mesh.vertices),
+                        std::size(full_detail) / 3, std::size(mesh.lods),
+                        gfx::analyze_vertex_cache(full_detail, std::size(mesh.vertices)));
+      }
+   }
+
+   return failure_count > 0 ? 1 : 0;
+}
@@ -0,0 +1,385 @@
+/**
+ * Cooks source images into an asset pack of DDS textures the texture cache uploads as they are.
+ * The mip chains are generated offline and every level is block compressed in bands spread
+ * over all the cores, so the runtime never decodes a PNG nor blits a mip
+ */
+
+#include <gfx/block_compression.hpp>
+#include <gfx/dds.hpp>
+#include <gfx/stb_image.h>
+
+#include <util/asset_pack.hpp>
+#include <util/logger.hpp>
+#include <util/thread_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace
+{
+   // Levels are compressed in bands of this many rows, a multiple of the block height
+   constexpr std::uint32_t band_height = 64;
+
+   struct options
+   {
+      gfx::texel_format format{gfx::texel_format::bc7};
+      bool is_srgb{true};
+
+      std::filesystem::path output;
+      std::filesystem::path root{std::filesystem::current_path()};
+      std::size_t thread_count{0};
+
+      util::dynamic_array<std::filesystem::path> inputs{};
+   };
+
+   struct mip_chain
+   {
+      util::small_dynamic_array<vk::Extent2D, 16> extents{};
+      util::small_dynamic_array<util::dynamic_array<std::byte>, 16> levels{};
+   };
+
+   void print_usage()
+   {
+      std::puts(
+         "usage: texture_cooker [options] -o <pack> <images...>\n"
+         "\n"
+         "options:\n"
+         "   -o, --output <pack>     the asset pack to write\n"
+         "   -f, --format <format>   rgba8, bc1, bc3, bc5 or bc7, defaults to bc7\n"
+         "   -r, --root <dir>        the directory the texture paths are relative to at runtime,\n"
+         "                           defaults to the working directory\n"
+         "   -j, --jobs <count>      the number of worker threads, defaults to one per core\n"
+         "   --linear                store the images as linear rather than sRGB");
+   }
+
+   auto parse_format(std::string_view name) -> std::optional<gfx::texel_format>
+   {
+      constexpr std::array<std::pair<std::string_view, gfx::texel_format>, 5> formats{
+         {{"rgba8", gfx::texel_format::rgba8},
+          {"bc1", gfx::texel_format::bc1},
+          {"bc3", gfx::texel_format::bc3},
+          {"bc5", gfx::texel_format::bc5},
+          {"bc7", gfx::texel_format::bc7}}};
+
+      for (const auto& [format_name, format] : formats)
+      {
+         if (format_name == name)
+         {
+            return format;
+         }
+      }
+
+      return std::nullopt;
+   }
+
+   auto parse_options(std::span<char*> args) -> std::optional<options>
+   {
+      options opts;
+
+      for (std::size_t i = 0; i < std::size(args); ++i)
+      {
+         const std::string_view arg = args[i];
+         const bool has_value = i + 1 < std::size(args);
+
+         if ((arg == "-o" || arg == "--output") && has_value)
+         {
+            opts.output = args[++i];
+         }
+         else if ((arg == "-f" || arg == "--format") && has_value)
+         {
+            const auto format = parse_format(args[++i]);
+            if (!format)
+            {
+               return std::nullopt;
+            }
+
+            opts.format = format.value();
+         }
+         else if ((arg == "-r" || arg == "--root") && has_value)
+         {
+            opts.root = args[++i];
+         }
+         else if ((arg == "-j" || arg == "--jobs") && has_value)
+         {
+            opts.thread_count = std::strtoull(args[++i], nullptr, 10); // NOLINT
+         }
+         else if (arg == "--linear")
+         {
+            opts.is_srgb = false;
+         }
+         else if (arg.starts_with('-'))
+         {
+            return std::nullopt;
+         }
+         else
+         {
+            opts.inputs.emplace_back(arg);
+         }
+      }
+
+      if (opts.output.empty() || std::empty(opts.inputs))
+      {
+         return std::nullopt;
+      }
+
+      // BC5 holds two unsigned normalised channels, it has no sRGB variant
+      if (opts.format == gfx::texel_format::bc5)
+      {
+         opts.is_srgb = false;
+      }
+
+      return opts;
+   }
+
+   auto srgb_to_linear(std::uint8_t value) noexcept -> float
+   {
+      static const auto table = [] {
+         std::array<float, 256> values{};
+         for (std::size_t i = 0; i < std::size(values); ++i)
+         {
+            const float c = static_cast<float>(i) / 255.0F;
+            values[i] = c <= 0.04045F ? c / 12.92F : std::pow((c + 0.055F) / 1.055F, 2.4F);
+         }
+
+         return values;
+      }();
+
+      return table[value];
+   }
+   auto linear_to_srgb(float value) noexcept -> float
+   {
+      const float c = value <= 0.0031308F ? value * 12.92F
+                                          : 1.055F * std::pow(value, 1.0F / 2.4F) - 0.055F;
+
+      return c * 255.0F;
+   }
+
+   /**
+    * Halve an RGBA8 image, each texel averaging the block of source texels it covers. The colour
+    * of sRGB images is averaged in linear space, otherwise the mips come out darker
+    */
+   auto downsample(std::span<const std::byte> texels, const vk::Extent2D& extent, bool is_srgb)
+      -> util::dynamic_array<std::byte>
+   {
+      const vk::Extent2D next{std::max(extent.width / 2, 1U), std::max(extent.height / 2, 1U)};
+
+      util::dynamic_array<std::byte> result(std::size_t{next.width} * next.height * 4);
+
+      for (std::uint32_t y = 0; y < next.height; ++y)
+      {
+         // Odd extents make the last texel of a row or column cover three source texels
+         const std::uint32_t y_begin = y * extent.height / next.height;
+         const std::uint32_t y_end = (y + 1) * extent.height / next.height;
+
+         for (std::uint32_t x = 0; x < next.width; ++x)
+         {
+            const std::uint32_t x_begin = x * extent.width / next.width;
+            const std::uint32_t x_end = (x + 1) * extent.width / next.width;
+
+            std::array<float, 4> sum{};
+            for (std::uint32_t sy = y_begin; sy < y_end; ++sy)
+            {
+               for (std::uint32_t sx = x_begin; sx < x_end; ++sx)
+               {
+                  const std::size_t texel = (std::size_t{sy} * extent.width + sx) * 4;
+                  for (std::size_t c = 0; c < 4; ++c)
+                  {
+                     const auto value = std::to_integer<std::uint8_t>(texels[texel + c]);
+                     sum[c] += is_srgb && c < 3 ? srgb_to_linear(value) : value;
+                  }
+               }
+            }
+
+            const auto count = static_cast<float>((y_end - y_begin) * (x_end - x_begin));
+            const std::size_t texel = (std::size_t{y} * next.width + x) * 4;
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+               const float average = sum[c] / count;
+               const float value = is_srgb && c < 3 ? linear_to_srgb(average) : average;
+
+               result[texel + c] = static_cast<std::byte>(std::clamp(value + 0.5F, 0.0F, 255.0F));
+            }
+         }
+      }
+
+      return result;
+   }
+
+   /**
+    * Decode an image and generate its full mip chain
+    */
+   auto build_mip_chain(const std::filesystem::path& path, bool is_srgb) -> std::optional<mip_chain>
+   {
+      int width = 0;
+      int height = 0;
+      int channels = 0;
+      stbi_uc* p_pixels =
+         stbi_load(path.string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
+      if (!p_pixels)
+      {
+         return std::nullopt;
+      }
+
+      vk::Extent2D extent{static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height)};
+
+      const auto* p_first = reinterpret_cast<const std::byte*>(p_pixels); // NOLINT
+      mip_chain chain;
+      chain.extents.push_back(extent);
+      chain.levels.emplace_back(p_first, p_first + std::size_t{extent.width} * extent.height * 4);
+
+      stbi_image_free(p_pixels);
+
+      while (extent.width > 1 || extent.height > 1)
+      {
+         chain.levels.push_back(downsample(chain.levels.back(), extent, is_srgb));
+
+         extent = {std::max(extent.width / 2, 1U), std::max(extent.height / 2, 1U)};
+         chain.extents.push_back(extent);
+      }
+
+      return chain;
+   }
+
+   auto encode_band(gfx::texel_format format, const vk::Extent2D& extent,
+                    std::span<const std::byte> texels) -> util::dynamic_array<std::byte>
+   {
+      if (!gfx::is_block_compressed(format))
+      {
+         return util::dynamic_array<std::byte>(std::begin(texels), std::end(texels));
+      }
+
+      return gfx::compress_from_rgba8(format, extent, texels);
+   }
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+   auto p_logger = std::make_shared<util::logger>("texture_cooker");
+
+   const auto opts = parse_options(std::span{argv, static_cast<std::size_t>(argc)}.subspan(1));
+   if (!opts)
+   {
+      print_usage();
+
+      return 1;
+   }
+
+   auto p_pool = opts->thread_count > 0 ? std::make_unique<util::thread_pool>(opts->thread_count)
+                                        : std::make_unique<util::thread_pool>();
+
+   util::dynamic_array<std::future<std::optional<mip_chain>>> decoding;
+   for (const auto& input : opts->inputs)
+   {
+      decoding.push_back(p_pool->submit([&input, is_srgb = opts->is_srgb] {
+         return build_mip_chain(input, is_srgb);
+      }));
+   }
+
+   util::dynamic_array<std::optional<mip_chain>> chains;
+   for (auto& future : decoding)
+   {
+      chains.push_back(future.get());
+   }
+
+   // Every level is split in bands of rows, the blocks of a band are contiguous in the level
+   using band_future = std::future<util::dynamic_array<std::byte>>;
+   util::dynamic_array<util::dynamic_array<band_future>> encoding;
+   for (const auto& chain : chains)
+   {
+      util::dynamic_array<band_future> bands;
+      if (chain)
+      {
+         for (std::size_t level = 0; level < std::size(chain->levels); ++level)
+         {
+            const auto& extent = chain->extents[level];
+            const std::span<const std::byte> texels = chain->levels[level];
+
+            for (std::uint32_t y = 0; y < extent.height; y += band_height)
+            {
+               const vk::Extent2D band{extent.width, std::min(band_height, extent.height - y)};
+               const auto band_texels = texels.subspan(std::size_t{y} * extent.width * 4,
+                                                       std::size_t{band.width} * band.height * 4);
+
+               bands.push_back(p_pool->submit([format = opts->format, band, band_texels] {
+                  return encode_band(format, band, band_texels);
+               }));
+            }
+         }
+      }
+
+      encoding.push_back(std::move(bands));
+   }
+
+   util::asset_pack_writer writer;
+   std::size_t failure_count = 0;
+
+   for (std::size_t i = 0; i < std::size(opts->inputs); ++i)
+   {
+      const auto& input = opts->inputs[i];
+      const auto& chain = chains[i];
+
+      if (!chain)
+      {
+         util::log_error(p_logger, R"(failed to decode "{}")", input.generic_string());
+         ++failure_count;
+
+         continue;
+      }
+
+      util::small_dynamic_array<util::dynamic_array<std::byte>, 16> levels;
+
+      auto band_it = std::begin(encoding[i]);
+      for (const auto& extent : chain->extents)
+      {
+         util::dynamic_array<std::byte> level;
+         level.reserve(gfx::image_size(opts->format, extent));
+
+         for (std::uint32_t y = 0; y < extent.height; y += band_height, ++band_it)
+         {
+            const auto band = band_it->get();
+            level.insert(std::cend(level), std::begin(band), std::end(band));
+         }
+
+         levels.push_back(std::move(level));
+      }
+
+      gfx::dds_image image{.format = opts->format, .is_srgb = opts->is_srgb};
+      for (std::size_t level = 0; level < std::size(levels); ++level)
+      {
+         image.mips.push_back({.extent = chain->extents[level], .data = levels[level]});
+      }
+
+      // Entries are named after the path the runtime loads the texture from
+      const auto name = std::filesystem::relative(input, opts->root).generic_string();
+      const auto dds = gfx::write_dds(image);
+      if (!writer.add(name, dds))
+      {
+         util::log_warn(p_logger, R"("{}" was given twice, only the first one is kept)", name);
+
+         continue;
+      }
+
+      util::log_info(p_logger, R"(cooked "{}": {}x{}, {} mips, {} bytes)", name,
+                     chain->extents[0].width, chain->extents[0].height, std::size(levels),
+                     std::size(dds));
+   }
+
+   if (!writer.write(opts->output))
+   {
+      util::log_error(p_logger, R"(failed to write "{}")", opts->output.generic_string());
+
+      return 1;
+   }
+
+   util::log_info(p_logger, R"(wrote {} textures to "{}")", writer.size(),
+                  opts->output.generic_string());
+
+   return failure_count > 0 ? 1 : 0;
+}